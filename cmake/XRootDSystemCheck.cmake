@@ -21,6 +21,9 @@ compiler_define_if_found( HAVE_STRLCPY HAVE_STRLCPY )
 check_function_exists( fstatat HAVE_FSTATAT )
 compiler_define_if_found( HAVE_FSTATAT HAVE_FSTATAT )
 
+check_function_exists( sendmmsg HAVE_SENDMMSG )
+compiler_define_if_found( HAVE_SENDMMSG HAVE_SENDMMSG )
+
 check_function_exists( sigwaitinfo HAVE_SIGWTI )
 compiler_define_if_found( HAVE_SIGWTI HAVE_SIGWTI )
 if( NOT HAVE_SIGWTI )
@@ -31,6 +34,9 @@ endif()
 check_include_file( shadow.h HAVE_SHADOWPW )
 compiler_define_if_found( HAVE_SHADOWPW HAVE_SHADOWPW )
 
+check_symbol_exists( IORING_FEAT_RW_CUR_POS linux/io_uring.h HAVE_IO_URING )
+compiler_define_if_found( HAVE_IO_URING HAVE_IO_URING )
+
 #-------------------------------------------------------------------------------
 # Some socket related functions
 #-------------------------------------------------------------------------------
@@ -161,6 +161,8 @@ XrdConfig::XrdConfig() : Log(&Logger, "Xrd"), Trace(&Log), Sched(&Log, &Trace),
    Police   = 0;
    Net_Blen = 0;  // Accept OS default (leave Linux autotune in effect)
    Net_Opts = XRDNET_KEEPALIVE;
+   Net_Accept = 1;
+   Net_Pollers= XRD_NUMPOLLERS;
    Wan_Blen = 1024*1024; // Default window size 1M
    Wan_Opts = XRDNET_KEEPALIVE;
    repDest[0] = 0;
@@ -172,6 +174,8 @@ XrdConfig::XrdConfig() : Log(&Logger, "Xrd"), Trace(&Log), Sched(&Log, &Trace),
    NetADM     = 0;
    coreV      = 1;
    memset(NetTCP, 0, sizeof(NetTCP));
+   NetAcc     = 0;
+   NetAccMax  = 0;
 
    Firstcp = Lastcp = 0;
 
@@ -652,6 +656,48 @@ int XrdConfig::ASocket(const char *path, const char *fname, mode_t mode)
    return 0;
 }
 
+/******************************************************************************/
+/*                            B i n d A c c e p t                             */
+/******************************************************************************/
+
+// Bind additional sockets to the port of NetTCP[pnum] so that the kernel can
+// spread incomming connections across them (SO_REUSEPORT). Each socket gets
+// its own accept thread and its links are attached to their own poller group.
+// Failures are not fatal; we simply continue with the sockets we have.
+
+void XrdConfig::BindAccept(int pnum)
+{
+   XrdInet *netP;
+   int i, port = NetTCP[pnum]->Port();
+
+// Allocate the socket table if we have not done so yet
+//
+   if (!NetAcc)
+      {NetAccMax = XrdProtLoad::ProtoMax * Net_Accept;
+       NetAcc = new XrdInet *[NetAccMax];
+       memset(NetAcc, 0, sizeof(XrdInet *)*NetAccMax);
+      }
+
+// Bind each additional socket
+//
+   for (i = 1; i < Net_Accept; i++)
+       {netP = new XrdInet(&Log, &Trace, Police);
+        netP->setDefaults(Net_Opts | XRDNET_REUSEPORT, Net_Blen);
+        if (myDomain) netP->setDomain(myDomain);
+        if (netP->Bind(port, "tcp"))
+           {char buff[16];
+            sprintf(buff, "%d", port);
+            Log.Say("Config warning: unable to share port ", buff,
+                    "; accepts will not be fully sharded.");
+            delete netP;
+            return;
+           }
+        netP->setPollGroup(i);
+        NetAcc[pnum*Net_Accept + i] = netP;
+       }
+   TRACE(NET, "LCL port " <<port <<" accepts sharded " <<Net_Accept <<" ways");
+}
+
 /******************************************************************************/
 /*                            C o n f i g P r o c                             */
 /******************************************************************************/
@@ -957,7 +1003,7 @@ int XrdConfig::Setup(char *dfltp)
    XrdLink::Init(&Log, &Trace, &Sched);
    XrdPoll::Init(&Log, &Trace, &Sched);
    if (!XrdLink::Setup(ProtInfo.ConnMax, ProtInfo.idleWait)
-   ||  !XrdPoll::Setup(ProtInfo.ConnMax)) return 1;
+   ||  !XrdPoll::Setup(ProtInfo.ConnMax, Net_Pollers, Net_Accept)) return 1;
 
 // Modify the AdminPath to account for any instance name. Note that there is
 // a negligible memory leak under ceratin path combinations. Not enough to
@@ -1021,10 +1067,12 @@ int XrdConfig::Setup(char *dfltp)
                      {if (cp->port == NetTCP[i]->Port()) break;}
          if (i >= XrdProtLoad::ProtoMax || !NetTCP[i])
             {NetTCP[++NetTCPlep] = new XrdInet(&Log, &Trace, Police);
-             if (Net_Opts || Net_Blen)
-                NetTCP[NetTCPlep]->setDefaults(Net_Opts, Net_Blen);
+             if (Net_Opts || Net_Blen || Net_Accept > 1)
+                NetTCP[NetTCPlep]->setDefaults(Net_Opts | (Net_Accept > 1 ?
+                                               XRDNET_REUSEPORT : 0), Net_Blen);
              if (myDomain) NetTCP[NetTCPlep]->setDomain(myDomain);
              if (NetTCP[NetTCPlep]->BindSD(cp->port, "tcp")) return 1;
+             if (Net_Accept > 1) BindAccept(NetTCPlep);
              ProtInfo.Port   = NetTCP[NetTCPlep]->Port();
              ProtInfo.NetTCP = NetTCP[NetTCPlep];
              wsz             = NetTCP[NetTCPlep]->WSize();
@@ -1252,7 +1300,8 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
    Purpose:  To parse directive: network [wan] [[no]keepalive] [buffsz <blen>]
                                          [kaparms parms] [cache <ct>] [[no]dnr]
                                          [routes <rtype> [use <ifn1>,<ifn2>]]
-                                         [[no]rpipa]
+                                         [[no]rpipa] [accepters <na>]
+                                         [pollers {<np> | cpu}]
 
              <rtype>: split | common | local
 
@@ -1264,6 +1313,10 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
              [no]dnr   do [not] perform a reverse DNS lookup if not needed.
              routes    specifies the network configuration (see reference)
              [no]rpipa do [not] resolve private IP addresses.
+             <na>      the number of sockets bound to each port via
+                       SO_REUSEPORT, each with its own accept thread feeding
+                       its own group of pollers. The default is 1.
+             <np>      the number of pollers to use; cpu uses one per core.
 
    Output: 0 upon success or !0 upon failure.
 */
@@ -1272,12 +1325,13 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
 {
     char *val;
     int  i, n, V_keep = -1, V_nodnr = 0, V_iswan = 0, V_blen = -1, V_ct = -1, V_assumev4;
-    int  v_rpip = -1;
+    int  v_rpip = -1, V_acc = -1, V_poll = -1;
     long long llp;
     struct netopts {const char *opname; int hasarg; int opval;
                            int *oploc;  const char *etxt;}
            ntopts[] =
        {
+        {"accepters",  1, 0, &V_acc,    "network accepters"},
         {"assumev4",   0, 1, &V_assumev4, "option"},
         {"keepalive",  0, 1, &V_keep,   "option"},
         {"nokeepalive",0, 0, &V_keep,   "option"},
@@ -1289,6 +1343,7 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
         {"routes",     3, 1, 0,         "routes"},
         {"rpipa",      0, 1, &v_rpip,   "rpipa"},
         {"norpipa",    0, 0, &v_rpip,   "norpipa"},
+        {"pollers",    5, 0, &V_poll,   "network pollers"},
         {"wan",        0, 1, &V_iswan,  "option"}
        };
     int numopts = sizeof(ntopts)/sizeof(struct netopts);
@@ -1309,6 +1364,14 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
                          {if (xnkap(eDest, val)) return 1;
                           break;
                          }
+                      if (ntopts[i].hasarg == 5)
+                         {if (!strcmp(val, "cpu"))
+                             {if ((n = sysconf(_SC_NPROCESSORS_ONLN)) < 1) n = 1;
+                             } else if (XrdOuca2x::a2i(*eDest,ntopts[i].etxt,
+                                               val,&n,1,XRD_MAXPOLLERS)) return 1;
+                          *ntopts[i].oploc = n;
+                          break;
+                         }
                       if (ntopts[i].hasarg == 3)
                          {     if (!strcmp(val, "split"))
                                   XrdNetIF::Routing(XrdNetIF::netSplit);
@@ -1348,6 +1411,16 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
       val = Config.GetWord();
      }
 
+     if (V_acc > 0)
+        {if (V_acc > 255)
+            {eDest->Emsg("Config", "network accepters may not exceed 255");
+             return 1;
+            }
+         Net_Accept = V_acc;
+        }
+     if (V_poll > 0) Net_Pollers = (V_poll > XRD_MAXPOLLERS ? XRD_MAXPOLLERS
+                                                            : V_poll);
+
      if (V_iswan)
         {if (V_blen >= 0) Wan_Blen = V_blen;
          if (V_keep >= 0) Wan_Opts = (V_keep  ? XRDNET_KEEPALIVE : 0);
@@ -1667,6 +1740,7 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
 
    Purpose:  To parse directive: sched [mint <mint>] [maxt <maxt>] [avlt <at>]
                                        [idle <idle>] [stksz <qnt>] [core <cv>]
+                                       [queues <nq>] [numa]
 
              <mint>   is the minimum number of threads that we need. Once
                       this number of threads is created, it does not decrease.
@@ -1683,6 +1757,12 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
              <idle>   The time (in time spec) between checks for underused
                       threads. Those found will be terminated. Default is 780.
              <qnt>    The thread stack size in bytes or K, M, or G.
+             <nq>     The number of run queues. Jobs go to the queue of the
+                      thread that schedules them and idle threads steal work
+                      from other queues. The default is 1.
+             numa     Bind threads serving a run queue to the CPUs of a NUMA
+                      node; nodes are assigned to queues round-robin. Unless
+                      queues is specified there is one queue per node.
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -1692,7 +1772,8 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
     char *val;
     long long lpp;
     int  i, ppp = 0;
-    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1;
+    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1, V_queues = -1;
+    bool V_numa = false;
     struct schedopts {const char *opname; int minv; int *oploc;
                       const char *opmsg;} scopts[] =
        {
@@ -1701,7 +1782,8 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
         {"maxt",       1, &V_maxt, "sched maxt"},
         {"avlt",       1, &V_avlt, "sched avlt"},
         {"core",       1,       0, "sched core"},
-        {"idle",       0, &V_idle, "sched idle"}
+        {"idle",       0, &V_idle, "sched idle"},
+        {"queues",     1, &V_queues, "sched queues"}
        };
     int numopts = sizeof(scopts)/sizeof(struct schedopts);
 
@@ -1709,7 +1791,9 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
        {eDest->Emsg("Config", "sched option not specified"); return 1;}
 
     while (val)
-          {for (i = 0; i < numopts; i++)
+          {if (!strcmp(val, "numa"))
+              {V_numa = true; val = Config.GetWord(); continue;}
+           for (i = 0; i < numopts; i++)
                if (!strcmp(val, scopts[i].opname))
                   {if (!(val = Config.GetWord()))
                       {eDest->Emsg("Config", "sched", scopts[i].opname,
@@ -1757,9 +1841,18 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
          }
      }
 
+  if (V_queues > MAX_SCHED_QUEUES)
+     {eDest->Emsg("Config", "sched queues may not exceed 256");
+      return 1;
+     }
+
 // Establish scheduler options
 //
    Sched.setParms(V_mint, V_maxt, V_avlt, V_idle);
+   if ((V_queues > 0 || V_numa) && Sched.setQueues(V_queues > 0 ? V_queues : 0, V_numa))
+      {eDest->Emsg("Config", "unable to set sched queues");
+       return 1;
+      }
    return 0;
 }
 
@@ -59,10 +59,13 @@ int         ConfigXeq(char *var, XrdOucStream &Config, XrdSysError *eDest=0);
 XrdProtocol_Config  ProtInfo;
 XrdInet            *NetADM;
 XrdInet            *NetTCP[XrdProtLoad::ProtoMax+1];
+XrdInet           **NetAcc;       // Extra accept sockets [port*Net_Accept+n]
+int                 NetAccMax;    // Number of slots in NetAcc
 
 private:
 
 int   ASocket(const char *path, const char *fname, mode_t mode);
+void  BindAccept(int pnum);
 int   ConfigProc(void);
 int   getUG(char *parm, uid_t &theUid, gid_t &theGid);
 void  Manifest(const char *pidfn);
@@ -108,6 +111,8 @@ XrdConfigProt      *Firstcp;
 XrdConfigProt      *Lastcp;
 int                 Net_Blen;
 int                 Net_Opts;
+int                 Net_Accept;   // Number of accept sockets per port
+int                 Net_Pollers;  // Number of pollers
 int                 Wan_Blen;
 int                 Wan_Opts;
 
@@ -115,6 +115,7 @@ XrdLink *XrdInet::Accept(int opts, int timeout, XrdSysSemaphore *theSem)
       {eDest->Emsg("Accept", ENOMEM, "allocate new link for", myAddr.Name(unk));
        close(myAddr.SockFD());
       } else {
+       lp->setPollGroup(PollGrp);
        TRACE(NET, "Accepted connection from " <<myAddr.SockFD()
                   <<'@' <<myAddr.Name(unk));
       }
@@ -57,8 +57,13 @@ XrdLink    *Connect(const char *host, int port, int opts=0, int timeout=-1);
 
 void        Secure(XrdNetSecurity *secp);
 
+// Links accepted via this object are attached to pollers of this group
+//
+void        setPollGroup(int grp) {PollGrp = grp;}
+
             XrdInet(XrdSysError *erp, XrdOucTrace *tP, XrdNetSecurity *secp=0)
-                      : XrdNet(erp,0), Patrol(secp), XrdTrace(tP) {}
+                      : XrdNet(erp,0), Patrol(secp), XrdTrace(tP),
+                        PollGrp(0) {}
            ~XrdInet() {}
 
 static void SetAssumeV4(bool newVal) {AssumeV4 = newVal;}
@@ -73,6 +78,7 @@ int Listen();
 
 XrdNetSecurity    *Patrol;
 XrdOucTrace       *XrdTrace;
+int                PollGrp;
 static const char *TraceID;
 static  bool       AssumeV4;
 };
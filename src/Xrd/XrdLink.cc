@@ -189,6 +189,7 @@ void XrdLink::Reset()
   Instance = 0;
   KillcvP  = 0;
   KillCnt  = 0;
+  PollGrp  = 0;
 }
 
 /******************************************************************************/
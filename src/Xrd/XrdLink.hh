@@ -226,6 +226,8 @@ static void   setKWT(int wkSec, int kwSec);
 
 void          setLocation(XrdNetAddrInfo::LocInfo &loc) {Addr.SetLocation(loc);}
 
+void          setPollGroup(int grp) {PollGrp = static_cast<unsigned char>(grp);}
+
 bool          setNB();
 
 XrdProtocol  *setProtocol(XrdProtocol *pp);
@@ -330,6 +332,7 @@ char                isIdle;
 char                inQ;    // Only used by PollPoll.icc
 char                isBridged;
 char                KillCnt;        // Protected by opMutex!
+unsigned char       PollGrp;        // Accept group used to pick a poller
 static const char   KillMax =   60;
 static const char   KillMsk = 0x7f;
 static const char   KillXwt = 0x80;
@@ -204,6 +204,20 @@ int main(int argc, char *argv[])
               }
           }
 
+// Start a thread for each additional socket sharing a port with the above
+//
+   for (i = 0; i < Main.Config.NetAccMax; i++)
+       if (Main.Config.NetAcc[i])
+          {XrdMain *Parms = new XrdMain(Main.Config.NetAcc[i]);
+           sprintf(buff, "Port %d handler %d", Parms->thePort,
+                   i % (Main.Config.NetAccMax / XrdProtLoad::ProtoMax));
+           if ((retc = XrdSysThread::Run(&tid, mainAccept, (void *)Parms,
+                                         XRDSYSTHREAD_BIND, strdup(buff))))
+              {Main.Config.ProtInfo.eDest->Emsg("main", retc, "create", buff);
+               _exit(3);
+              }
+          }
+
 // Finally, start accepting connections on the main port
 //
    Main.theNet  = Main.Config.NetTCP[0];
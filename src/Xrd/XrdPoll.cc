@@ -30,6 +30,7 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
   
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
@@ -76,7 +77,9 @@ int           Stats(char *buff, int blen, int do_sync=0) {return 0;}
 /*                           G l o b a l   D a t a                            */
 /******************************************************************************/
   
-       XrdPoll   *XrdPoll::Pollers[XRD_NUMPOLLERS] = {0, 0, 0};
+       XrdPoll  **XrdPoll::Pollers    = 0;
+       int        XrdPoll::numPollers = 0;
+       int        XrdPoll::numGroups  = 1;
 
        XrdSysMutex  XrdPoll::doingAttach;
 
@@ -139,17 +142,20 @@ int XrdPoll__Attach(XrdLink *lp) {return XrdPoll::Attach(lp);}
 
 int XrdPoll::Attach(XrdLink *lp)
 {
-   int i;
+   int i, step;
    XrdPoll *pp;
 
 // We allow only one attach at a time to simplify the processing
 //
    doingAttach.Lock();
 
-// Find a poller with the smallest number of entries
+// Find a poller with the smallest number of entries. When accepts are sharded
+// we only consider the pollers that belong to the link's accept group.
 //
-   pp = Pollers[0];
-   for (i = 1; i < XRD_NUMPOLLERS; i++)
+   if (numGroups > 1) {i = lp->PollGrp % numGroups % numPollers; step = numGroups;}
+      else {i = 0; step = 1;}
+   pp = Pollers[i];
+   for (i += step; i < numPollers; i += step)
        if (pp->numAttached > Pollers[i]->numAttached) pp = Pollers[i];
 
 // Include this FD into the poll set of the poller
@@ -286,19 +292,28 @@ char *XrdPoll::Poll2Text(short events)
 /*                                 S e t u p                                  */
 /******************************************************************************/
   
-int XrdPoll::Setup(int numfd)
+int XrdPoll::Setup(int numfd, int numpoll, int numgrp)
 {
    pthread_t tid;
    int maxfd, retc, i;
    struct XrdPollArg PArg;
 
+// Establish the number of pollers and accept groups
+//
+   if (numpoll < 1) numpoll = XRD_NUMPOLLERS;
+      else if (numpoll > XRD_MAXPOLLERS) numpoll = XRD_MAXPOLLERS;
+   numGroups  = (numgrp < 1 ? 1 : numgrp);
+   numPollers = numpoll;
+   Pollers    = new XrdPoll *[numpoll];
+   memset(Pollers, 0, sizeof(XrdPoll *)*numpoll);
+
 // Calculate the number of table entries per poller
 //
-   maxfd  = (numfd / XRD_NUMPOLLERS) + 16;
+   maxfd  = (numfd / numpoll) + 16;
 
 // Verify that we initialized the poller table
 //
-   for (i = 0; i < XRD_NUMPOLLERS; i++)
+   for (i = 0; i < numpoll; i++)
        {if (!(Pollers[i] = newPoller(i, maxfd))) return 0;
         Pollers[i]->PID = i;
 
@@ -330,19 +345,23 @@ int XrdPoll::Setup(int numfd)
 int XrdPoll::Stats(char *buff, int blen, int do_sync)
 {
    static const char statfmt[] = "<stats id=\"poll\"><att>%d</att>"
-   "<en>%d</en><ev>%d</ev><int>%d</int></stats>";
-   int i, numatt = 0, numen = 0, numev = 0, numint = 0;
+   "<en>%d</en><ev>%d</ev><int>%d</int>";
+   static const char pollfmt[] = "<poller id=\"%d\"><att>%d</att>"
+   "<en>%d</en><ev>%d</ev><int>%d</int></poller>";
+   static const char statend[] = "</stats>";
+   int i, n, bl, numatt = 0, numen = 0, numev = 0, numint = 0;
    XrdPoll *pp;
 
 // Return number of bytes if so wanted
 //
-   if (!buff) return (sizeof(statfmt)+(4*16))*XRD_NUMPOLLERS;
+   if (!buff) return sizeof(statfmt) + sizeof(statend) + (4*16)
+                  + (sizeof(pollfmt)+(5*16))*numPollers;
 
 // Get statistics. While we wish we could honor do_sync, doing so would be
 // costly and hardly worth it. So, we do not include code such as:
 //    x = pp->y; if (do_sync) while(x != pp->y) x = pp->y; tot += x;
 //
-   for (i = 0; i < XRD_NUMPOLLERS; i++)
+   for (i = 0; i < numPollers; i++)
        {pp = Pollers[i];
         numatt += pp->numAttached; 
         numen  += pp->numEnabled;
@@ -350,9 +369,24 @@ int XrdPoll::Stats(char *buff, int blen, int do_sync)
         numint += pp->numInterrupts;
        }
 
-// Format and return
+// Format the totals
+//
+   bl = snprintf(buff, blen, statfmt, numatt, numen, numev, numint);
+   if (bl >= blen) return blen;
+
+// Append the counters of each poller
+//
+   for (i = 0; i < numPollers; i++)
+       {pp = Pollers[i];
+        n = snprintf(buff+bl, blen-bl, pollfmt, i, pp->numAttached,
+                     pp->numEnabled, pp->numEvents, pp->numInterrupts);
+        if ((bl += n) >= blen) return blen;
+       }
+
+// Close the stats element and return
 //
-   return snprintf(buff, blen, statfmt, numatt, numen, numev, numint);
+   n = snprintf(buff+bl, blen-bl, "%s", statend);
+   return ((bl += n) >= blen ? blen : bl);
 }
   
 /******************************************************************************/
@@ -33,6 +33,7 @@
 #include "XrdSys/XrdSysPthread.hh"
 
 #define XRD_NUMPOLLERS 3
+#define XRD_MAXPOLLERS 256
 
 class XrdOucTrace;
 class XrdSysError;
@@ -73,9 +74,12 @@ static  void  Init(XrdSysError *eP, XrdOucTrace *tP, XrdScheduler *sP)
 //
 static  char *Poll2Text(short events); // Implementation supplied
 
-// Setup() is called at config time to perform poller configuration
+// Setup() is called at config time to perform poller configuration. The
+// numpoll argument gives the number of pollers to start and numgrp the number
+// of accept groups; links from a group are only attached to that group's
+// pollers (i.e. pollers whose index modulo numgrp equals the group number).
 //
-static  int   Setup(int numfd);        // Implementation supplied
+static  int   Setup(int numfd, int numpoll=XRD_NUMPOLLERS, int numgrp=1);
 
 // Start() is called via a thread for each poller that was created
 //
@@ -92,7 +96,9 @@ static  int   Stats(char *buff, int blen, int do_sync=0);
 
 // The following table reference the pollers in effect
 //
-static     XrdPoll   *Pollers[XRD_NUMPOLLERS];
+static     XrdPoll  **Pollers;
+static     int        numPollers;
+static     int        numGroups;
 
            XrdPoll();
 virtual   ~XrdPoll() {}
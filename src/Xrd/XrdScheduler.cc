@@ -38,9 +38,14 @@
 #ifdef __APPLE__
 #include <AvailabilityMacros.h>
 #endif
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 #include "Xrd/XrdJob.hh"
 #include "Xrd/XrdScheduler.hh"
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysError.hh"
 
 #define XRD_TRACE XrdTrace->
@@ -65,6 +70,25 @@ class XrdSchedulerPID
                         {next = prev; pid = newpid;}
      ~XrdSchedulerPID() {}
      };
+
+class XrdSchedulerQueue
+     {public:
+      XrdSysMutex      Lock;
+      XrdJob          *First;
+      XrdJob          *Last;
+#ifdef __linux__
+      cpu_set_t        CPUs;     // CPUs of the associated NUMA node
+      bool             doBind;   // Bind workers to CPUs
+#endif
+      char             Pad[64];  // Keep queue locks on separate cache lines
+
+      XrdSchedulerQueue() : First(0), Last(0)
+#ifdef __linux__
+                          , doBind(false)
+#endif
+                          {}
+     ~XrdSchedulerQueue() {}
+     };
   
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
@@ -114,8 +138,11 @@ XrdScheduler::XrdScheduler(XrdSysError *eP, XrdOucTrace *tP,
     num_TDestroy=  0;
     num_Layoffs =  0;
     num_Limited =  0;
+    num_Queues  =  1;
+    isStarted   =  false;
     firstPID    =  0;
-    WorkFirst = WorkLast = TimerQueue = 0;
+    TimerQueue  =  0;
+    WorkQueue   =  new XrdSchedulerQueue[1];
 
 // Make sure we are using the maximum number of threads allowed (Linux only)
 //
@@ -210,8 +237,9 @@ void XrdScheduler::DoIt()
 
 // Now check if there are too many idle threads (kill them if there are)
 //
-   if (!num_JobsinQ)
-      {DispatchMutex.Lock(); num_idle = idl_Workers; DispatchMutex.UnLock();
+   if (!AtomicGet(num_JobsinQ))
+      {AtomicBeg(DispatchMutex); num_idle = AtomicGet(idl_Workers);
+       AtomicEnd(DispatchMutex);
        num_kill = num_idle - min_Workers;
        TRACE(SCHED, num_Workers <<" threads; " <<num_idle <<" idle");
        if (num_kill > 0)
@@ -320,21 +348,32 @@ void *XrdScheduler::Reaper()
   
 void XrdScheduler::Run()
 {
-   int waiting;
+   int waiting, home;
    XrdJob *jp;
 
+// Our home run queue is the one jobs we schedule go to
+//
+   home = homeQueue();
+   bindWorker(home);
+
 // Wait for work then do it (an endless task for a worker thread)
 //
-   do {do {DispatchMutex.Lock();          idl_Workers++;DispatchMutex.UnLock();
+   do {do {AtomicBeg(DispatchMutex); AtomicInc(idl_Workers);
+           AtomicEnd(DispatchMutex);
            WorkAvail.Wait();
-           DispatchMutex.Lock();waiting = --idl_Workers;DispatchMutex.UnLock();
-           SchedMutex.Lock();
-           if ((jp = WorkFirst))
-              {if (!(WorkFirst = jp->NextJob)) WorkLast = 0;
-               if (num_JobsinQ) num_JobsinQ--;
-                  else XrdLog->Emsg("Scheduler","Job queue count underflow!");
-              } else {
-               num_JobsinQ = 0;
+           AtomicBeg(DispatchMutex); waiting = AtomicDec(idl_Workers) - 1;
+           AtomicEnd(DispatchMutex);
+
+    // Every post is matched by a job unless we are laying off threads. Our
+    // job may have been taken by a thread that came for one queued behind
+    // our back in a queue we had already looked at. Jobs are counted under
+    // the lock of their queue, so a non-zero count means a job can be taken
+    // right away and we look again. Each further miss means another thread
+    // took a job, so this is no busy wait.
+    //
+           while(!(jp = getJob(home)) && haveJob()) {}
+           if (!jp)
+              {SchedMutex.Lock();
                if (num_Layoffs > 0)
                   {num_Layoffs--;
                    if (waiting)
@@ -344,8 +383,8 @@ void XrdScheduler::Run()
                        return;
                       }
                   }
+               SchedMutex.UnLock();
               }
-           SchedMutex.UnLock();
           } while(!jp);
 
     // Check if we should hire a new worker (we always want 1 idle thread)
@@ -364,66 +403,76 @@ void XrdScheduler::Run()
   
 void XrdScheduler::Schedule(XrdJob *jp)
 {
-// Lock down our data area
+   XrdSchedulerQueue *wq;
+   int inQ;
+
+// Select the run queue of the calling thread and lock it
 //
-   SchedMutex.Lock();
+   wq = &WorkQueue[homeQueue()];
+   wq->Lock.Lock();
 
-// Place the request on the queue and broadcast it
+// Place the request on the queue
 //
    jp->NextJob  = 0;
-   if (WorkFirst)
-      {WorkLast->NextJob = jp;
-       WorkLast = jp;
+   if (wq->First)
+      {wq->Last->NextJob = jp;
+       wq->Last = jp;
       } else {
-       WorkFirst = jp;
-       WorkLast  = jp;
+       wq->First = jp;
+       wq->Last  = jp;
       }
-   WorkAvail.Post();
 
-// Calculate statistics
+// Calculate statistics (the maximum is only approximate). The job is counted
+// before it can be taken off the queue so the count never goes negative.
 //
-   num_Jobs++;
-   num_JobsinQ++;
-   if (num_JobsinQ > max_QLength) max_QLength = num_JobsinQ;
+   AtomicBeg(SchedMutex);
+   AtomicInc(num_Jobs);
+   inQ = AtomicInc(num_JobsinQ) + 1;
+   AtomicEnd(SchedMutex);
+   wq->Lock.UnLock();
+   if (inQ > max_QLength) max_QLength = inQ;
 
-// Unlock the data area and return
+// Broadcast it
 //
-   SchedMutex.UnLock();
+   WorkAvail.Post();
 }
 
 /******************************************************************************/
   
 void XrdScheduler::Schedule(int numjobs, XrdJob *jfirst, XrdJob *jlast)
 {
+   XrdSchedulerQueue *wq;
+   int inQ;
 
-// Lock down our data area
+// Select the run queue of the calling thread and lock it
 //
-   SchedMutex.Lock();
+   wq = &WorkQueue[homeQueue()];
+   wq->Lock.Lock();
 
 // Place the request list on the queue
 //
    jlast->NextJob = 0;
-   if (WorkFirst)
-      {WorkLast->NextJob = jfirst;
-       WorkLast = jlast;
+   if (wq->First)
+      {wq->Last->NextJob = jfirst;
+       wq->Last = jlast;
       } else {
-       WorkFirst = jfirst;
-       WorkLast  = jlast;
+       wq->First = jfirst;
+       wq->Last  = jlast;
       }
 
 // Calculate statistics
 //
-   num_Jobs    += numjobs;
-   num_JobsinQ += numjobs;
-   if (num_JobsinQ > max_QLength) max_QLength = num_JobsinQ;
+   AtomicBeg(SchedMutex);
+   AtomicAdd(num_Jobs, numjobs);
+   AtomicFAdd(inQ, num_JobsinQ, numjobs);
+   AtomicEnd(SchedMutex);
+   wq->Lock.UnLock();
+   inQ += numjobs;
+   if (inQ > max_QLength) max_QLength = inQ;
 
 // Indicate number of jobs to work on
 //
    while(numjobs--) WorkAvail.Post();
-
-// Unlock the data area and return
-//
-   SchedMutex.UnLock();
 }
 
 /******************************************************************************/
@@ -505,6 +554,105 @@ void XrdScheduler::setParms(int minw, int maxw, int avlw, int maxi, int once)
    TRACE(SCHED,"Set stk_Workers=" <<stk_Workers <<" max_Workidl=" <<max_Workidl);
 }
 
+/******************************************************************************/
+/*                             s e t Q u e u e s                              */
+/******************************************************************************/
+
+int XrdScheduler::setQueues(int numq, bool numa)
+{
+   XrdSchedulerQueue *newQ, *oldQ = WorkQueue;
+   int i, numNodes = 0;
+#ifdef __linux__
+   cpu_set_t *nodeCPUs = 0;
+#endif
+
+// This can only be done before any worker is running
+//
+   if (isStarted || numq < 0 || numq > MAX_SCHED_QUEUES || (!numq && !numa))
+      return -EINVAL;
+
+// Find the CPUs of each NUMA node. Nodes are later handed out to the queues
+// round-robin; absent a queue count we have one queue per node.
+//
+#ifdef __linux__
+   if (numa)
+      {char fn[64], buff[1024];
+       char *cP, *eP;
+       int fd, rlen, lo, hi;
+       nodeCPUs = new cpu_set_t[MAX_SCHED_QUEUES];
+       for (numNodes = 0; numNodes < MAX_SCHED_QUEUES; numNodes++)
+           {snprintf(fn, sizeof(fn), "/sys/devices/system/node/node%d/cpulist",
+                     numNodes);
+            if ((fd = open(fn, O_RDONLY)) < 0) break;
+            rlen = read(fd, buff, sizeof(buff)-1);
+            close(fd);
+            if (rlen <= 0) break;
+            buff[rlen] = 0;
+
+         // The list looks like "0-7,16-23"
+         //
+            CPU_ZERO(&nodeCPUs[numNodes]);
+            cP = buff;
+            while(*cP >= '0' && *cP <= '9')
+                 {lo = hi = strtol(cP, &eP, 10);
+                  if (*eP == '-') hi = strtol(eP+1, &eP, 10);
+                  while(lo <= hi && lo < CPU_SETSIZE)
+                       CPU_SET(lo++, &nodeCPUs[numNodes]);
+                  cP = (*eP == ',' ? eP+1 : eP);
+                 }
+           }
+       if (!numNodes)
+          XrdLog->Emsg("Scheduler", "NUMA topology not found; workers not bound.");
+      }
+#else
+   if (numa) XrdLog->Emsg("Scheduler", "NUMA binding not supported on this platform.");
+#endif
+   if (!numq) numq = (numNodes ? numNodes : 1);
+
+// Allocate the new queues and move over any work already scheduled
+//
+   newQ = new XrdSchedulerQueue[numq];
+   for (i = 0; i < num_Queues; i++)
+       {oldQ[i].Lock.Lock();
+        if (oldQ[i].First)
+           {if (newQ[0].First) newQ[0].Last->NextJob = oldQ[i].First;
+               else newQ[0].First = oldQ[i].First;
+            newQ[0].Last = oldQ[i].Last;
+            oldQ[i].First = oldQ[i].Last = 0;
+           }
+        oldQ[i].Lock.UnLock();
+       }
+
+// Associate each queue with a NUMA node
+//
+#ifdef __linux__
+   if (numNodes)
+      for (i = 0; i < numq; i++)
+          {newQ[i].CPUs   = nodeCPUs[i % numNodes];
+           newQ[i].doBind = true;
+          }
+   delete [] nodeCPUs;
+#endif
+
+// Threads remember their home queue so they need not look up their id each
+// time they schedule something
+//
+   if (numq > 1 && num_Queues <= 1 && (i = pthread_key_create(&homeKey, 0)))
+      {XrdLog->Emsg("Scheduler", i, "create run queue key");
+       delete [] newQ;
+       return -i;
+      }
+
+// Switch over. The old queues are not deleted as another thread may still be
+// looking at them; the scheduler is never deleted either.
+//
+   WorkQueue  = newQ;
+   num_Queues = numq;
+
+   TRACE(SCHED, "Using " <<numq <<" run queues on " <<numNodes <<" NUMA nodes");
+   return 0;
+}
+
 /******************************************************************************/
 /*                                 S t a r t                                  */
 /******************************************************************************/
@@ -514,6 +662,10 @@ void XrdScheduler::Start() // Serialized one time call!
     int retc, numw;
     pthread_t tid;
 
+// Run queues may no longer change
+//
+   isStarted = true;
+
 // Start a time based scheduler
 //
    if ((retc = XrdSysThread::Run(&tid, XrdStartTSched, (void *)this,
@@ -554,16 +706,16 @@ int XrdScheduler::Stats(char *buff, int blen, int do_sync)
 
 // Get values protected by the Dispatch lock (avoid lock if no sync needed)
 //
-   if (do_sync) DispatchMutex.Lock();
-   cnt_idl = idl_Workers;
-   if (do_sync) DispatchMutex.UnLock();
+   AtomicBeg(DispatchMutex);
+   cnt_idl = AtomicGet(idl_Workers);
+   AtomicEnd(DispatchMutex);
 
 // Get values protected by the Scheduler lock (avoid lock if no sync needed)
 //
    if (do_sync) SchedMutex.Lock();
    cnt_Workers = num_Workers;
-   cnt_Jobs    = num_Jobs;
-   cnt_JobsinQ = num_JobsinQ;
+   cnt_Jobs    = AtomicGet(num_Jobs);
+   cnt_JobsinQ = AtomicGet(num_JobsinQ);
    xam_QLength = max_QLength;
    cnt_TCreate = num_TCreate;
    cnt_TDestroy= num_TDestroy;
@@ -606,6 +758,87 @@ void XrdScheduler::TimeSched()
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
+/******************************************************************************/
+/*                            b i n d W o r k e r                             */
+/******************************************************************************/
+
+void XrdScheduler::bindWorker(int home)
+{
+#ifdef __linux__
+   int retc;
+
+   if (WorkQueue[home].doBind
+   &&  (retc = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t),
+                                      &WorkQueue[home].CPUs)))
+      XrdLog->Emsg("Scheduler", retc, "bind worker to NUMA node");
+#endif
+}
+
+/******************************************************************************/
+/*                                g e t J o b                                 */
+/******************************************************************************/
+
+XrdJob *XrdScheduler::getJob(int home)
+{
+   XrdSchedulerQueue *wq;
+   XrdJob *jp;
+   int i, qn = home;
+
+// Take the oldest job from our home queue or, if empty, steal it from the
+// next queue that has work.
+//
+   for (i = 0; i < num_Queues; i++)
+       {wq = &WorkQueue[qn];
+        wq->Lock.Lock();
+        if ((jp = wq->First))
+           {if (!(wq->First = jp->NextJob)) wq->Last = 0;
+            AtomicBeg(SchedMutex);
+            AtomicDec(num_JobsinQ);
+            AtomicEnd(SchedMutex);
+            wq->Lock.UnLock();
+            return jp;
+           }
+        wq->Lock.UnLock();
+        if (++qn >= num_Queues) qn = 0;
+       }
+   return 0;
+}
+
+/******************************************************************************/
+/*                               h a v e J o b                                */
+/******************************************************************************/
+
+bool XrdScheduler::haveJob()
+{
+   int inQ;
+
+   AtomicBeg(SchedMutex);
+   inQ = AtomicGet(num_JobsinQ);
+   AtomicEnd(SchedMutex);
+   return inQ > 0;
+}
+
+/******************************************************************************/
+/*                             h o m e Q u e u e                              */
+/******************************************************************************/
+
+int XrdScheduler::homeQueue()
+{
+   void *hP;
+   int home;
+
+// With a single queue there is nothing to remember
+//
+   if (num_Queues <= 1) return 0;
+
+// The home queue is set the first time a thread schedules or runs a job
+//
+   if ((hP = pthread_getspecific(homeKey))) return (int)((long)hP) - 1;
+   home = XrdSysThread::Num() % num_Queues;
+   pthread_setspecific(homeKey, (void *)((long)home + 1));
+   return home;
+}
+
 /******************************************************************************/
 /*                           h i r e   W o r k e r                            */
 /******************************************************************************/
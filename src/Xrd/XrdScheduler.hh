@@ -37,9 +37,11 @@
 
 class XrdOucTrace;
 class XrdSchedulerPID;
+class XrdSchedulerQueue;
 class XrdSysError;
 
 #define MAX_SCHED_PROCS 30000
+#define MAX_SCHED_QUEUES 256
 
 class XrdScheduler : public XrdJob
 {
@@ -66,6 +68,14 @@ void          Schedule(XrdJob *jp, time_t atime);
 
 void          setParms(int minw, int maxw, int avlt, int maxi, int once=0);
 
+// Set the number of run queues. Jobs are queued on the run queue of the thread
+// scheduling them and idle workers take jobs from other queues when theirs is
+// empty. When numa is true, workers are bound to the CPUs of the NUMA node
+// associated with their run queue and a numq of 0 means one queue per node.
+// Must be called prior to Start().
+//
+int           setQueues(int numq, bool numa=false);
+
 void          Start();
 
 int           Stats(char *buff, int blen, int do_sync=0);
@@ -91,7 +101,7 @@ private:
 XrdSysError *XrdLog;
 XrdOucTrace *XrdTrace;
 
-XrdSysMutex DispatchMutex; // Disp: Protects above area
+XrdSysMutex DispatchMutex; // Disp: Protects idl_Workers w/o atomics
 int        idl_Workers;    // Disp: Number of idle workers
 
 int        min_Workers;   // Sched: Min threads we need to have
@@ -99,11 +109,13 @@ int        max_Workers;   // Sched: Max threads we can start
 int        max_Workidl;   // Sched: Max idle time for threads above min_Workers
 int        num_Workers;   // Sched: Number of threads we have
 int        stk_Workers;   // Sched: Number of sticky workers we can have
-int        num_JobsinQ;   // Sched: Number of outstanding jobs in the queue
+int        num_JobsinQ;   // Sched: Number of outstanding jobs in the queues
 int        num_Layoffs;   // Sched: Number of threads to terminate
+int        num_Queues;    // Sched: Number of run queues
+bool       isStarted;     // Sched: Start() has been called
+pthread_key_t homeKey;    // Sched: Home run queue of a thread (plus 1)
 
-XrdJob                *WorkFirst;  // Pending work
-XrdJob                *WorkLast;
+XrdSchedulerQueue     *WorkQueue;  // Pending work, num_Queues run queues
 XrdSysSemaphore        WorkAvail;
 XrdSysMutex            SchedMutex; // Protects private area
 
@@ -115,6 +127,10 @@ XrdSchedulerPID       *firstPID;
 XrdSysMutex            ReaperMutex;
 
 void hireWorker(int dotrace=1);
+XrdJob *getJob(int home);
+bool haveJob();
+int  homeQueue();
+void bindWorker(int home);
 void Monitor();
 void traceExit(pid_t pid, int status);
 static const char *TraceID;
@@ -26,6 +26,30 @@ target_link_libraries(
   pthread
   ${ZLIB_LIBRARY} )
 
+#-------------------------------------------------------------------------------
+# xrdcksbench (not installed)
+#-------------------------------------------------------------------------------
+add_executable(
+  xrdcksbench
+  XrdApps/XrdCksBench.cc )
+
+target_link_libraries(
+  xrdcksbench
+  XrdUtils )
+
+#-------------------------------------------------------------------------------
+# xrdposcbench (not installed)
+#-------------------------------------------------------------------------------
+add_executable(
+  xrdposcbench
+  XrdApps/XrdPoscBench.cc )
+
+target_link_libraries(
+  xrdposcbench
+  XrdServer
+  XrdUtils
+  pthread )
+
 #-------------------------------------------------------------------------------
 # cconfig
 #-------------------------------------------------------------------------------
@@ -0,0 +1,207 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C k s B e n c h . c c                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+  
+/******************************************************************************/
+/* Compares the throughput of the portable and the CPU specific checksum      */
+/* kernels and verifies that both give identical results.                     */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCalccrc32c.hh"
+
+namespace
+{
+typedef const char *(*SetFunc)(bool);
+
+struct BenchItem
+      {XrdCksCalc *Calc;
+       SetFunc     Set;
+      };
+
+double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1e6;
+}
+
+/******************************************************************************/
+/*                                C k s u m                                   */
+/******************************************************************************/
+  
+// Compute a checksum over the buffer handed over in pieces of at most bsz
+// bytes and return the result as a hex string.
+//
+void Cksum(XrdCksCalc *csP, const char *buff, int blen, int bsz,
+           char *hex, int hexsz)
+{
+   const unsigned char *csV;
+   int csLen, n;
+
+   csP->Init();
+   while(blen > 0)
+        {n = (blen < bsz ? blen : bsz);
+         csP->Update(buff, n);
+         buff += n; blen -= n;
+        }
+   csV = (const unsigned char *)csP->Final();
+   csP->Type(csLen);
+   *hex = 0;
+   for (n = 0; n < csLen && n*2+2 < hexsz; n++) sprintf(hex+n*2, "%02x", csV[n]);
+}
+
+/******************************************************************************/
+/*                                V e r i f y                                 */
+/******************************************************************************/
+  
+// Check that the portable and the selected kernel agree for many lengths,
+// alignments and update sizes.
+//
+bool Verify(BenchItem &item, const char *buff, int bsize)
+{
+   char sRes[64], hRes[64];
+   int csLen, alen, off, bsz, i;
+   bool ok = true;
+
+   for (i = 0; i < 2000; i++)
+       {alen = (i < 600 ? i : rand() % (bsize/2));
+        off  = rand() % 64;
+        bsz  = (i & 1 ? alen+1 : 1 + rand() % 4096);
+        item.Set(false);
+        Cksum(item.Calc, buff+off, alen, bsz, sRes, sizeof(sRes));
+        item.Set(true);
+        Cksum(item.Calc, buff+off, alen, bsz, hRes, sizeof(hRes));
+        if (strcmp(sRes, hRes))
+           {fprintf(stderr, "xrdcksbench: %s mismatch len=%d off=%d bsz=%d "
+                            "%s != %s\n", item.Calc->Type(csLen),
+                            alen, off, bsz, sRes, hRes);
+            ok = false;
+           }
+       }
+   return ok;
+}
+
+/******************************************************************************/
+/*                                  R a t e                                   */
+/******************************************************************************/
+  
+// Return the throughput in MB/s of the currently selected kernel.
+//
+double Rate(XrdCksCalc *csP, const char *buff, int blen, int bsz, int reps)
+{
+   char hex[64];
+   double start = Now();
+
+   for (int i = 0; i < reps; i++) Cksum(csP, buff, blen, bsz, hex, sizeof(hex));
+   return (double)blen*reps / (Now() - start) / 1e6;
+}
+
+/******************************************************************************/
+/*                                 U s a g e                                  */
+/******************************************************************************/
+  
+void Usage(int rc)
+{
+   fprintf(stderr, "Usage: xrdcksbench [-b <bsz>] [-r <reps>] [-s <mb>] "
+                   "[<cksname> [...]]\n");
+   exit(rc);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char *argv[])
+{
+   BenchItem Items[] = {{new XrdCksCalcadler32, XrdCksCalcadler32::SetKernel},
+                        {new XrdCksCalccrc32,   XrdCksCalccrc32::SetKernel},
+                        {new XrdCksCalccrc32c,  XrdCksCalccrc32c::SetKernel}};
+   const int numItems = sizeof(Items)/sizeof(Items[0]);
+   const char *sName, *hName, *csName;
+   char *buff;
+   double sRate, hRate;
+   int bsz = 1024*1024, reps = 8, bsize = 64*1024*1024, c, csLen, i, j;
+   bool ok = true;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "b:hr:s:")) != -1)
+        {switch(c)
+               {case 'b': if ((bsz = atoi(optarg)) <= 0) Usage(1);
+                          break;
+                case 'h': Usage(0);
+                          break;
+                case 'r': if ((reps = atoi(optarg)) <= 0) Usage(1);
+                          break;
+                case 's': if ((bsize = atoi(optarg)) <= 0 || bsize > 1024)
+                             Usage(1);
+                          bsize *= 1024*1024;
+                          break;
+                default:  Usage(1);
+               }
+        }
+
+// Fill a buffer with pseudo-random data
+//
+   buff = (char *)malloc(bsize+64);
+   srand(1);
+   for (i = 0; i < bsize+64; i++) buff[i] = (char)(rand() >> 7);
+
+// Run each requested checksum
+//
+   printf("%-8s %-8s %10s %-8s %10s %7s\n", "cksum", "portable", "MB/s",
+          "kernel", "MB/s", "speedup");
+   for (i = 0; i < numItems; i++)
+       {csName = Items[i].Calc->Type(csLen);
+        if (optind < argc)
+           {for (j = optind; j < argc; j++) if (!strcmp(argv[j], csName)) break;
+            if (j >= argc) continue;
+           }
+        if (!Verify(Items[i], buff, bsize)) {ok = false; continue;}
+        sName = Items[i].Set(false);
+        sRate = Rate(Items[i].Calc, buff, bsize, bsz, reps);
+        hName = Items[i].Set(true);
+        hRate = Rate(Items[i].Calc, buff, bsize, bsz, reps);
+        printf("%-8s %-8s %10.1f %-8s %10.1f %6.2fx\n", csName, sName, sRate,
+               hName, hRate, hRate/sRate);
+       }
+
+// All done
+//
+   free(buff);
+   return (ok ? 0 : 1);
+}
@@ -0,0 +1,193 @@
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d P o s c B e n c h . c c                        */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+  
+/******************************************************************************/
+/* Measures how many persist-on-successful-close creates per second the       */
+/* XrdOfsPoscq journal sustains with several writers and checks that pending  */
+/* records survive for recovery.                                              */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "XrdOfs/XrdOfsPoscq.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+namespace
+{
+struct Writer
+      {XrdOfsPoscq *Queue;
+       int          Num;
+       int          Ops;
+       int          Errs;
+      };
+
+double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1e6;
+}
+
+/******************************************************************************/
+/*                                  W r i t e                                 */
+/******************************************************************************/
+
+// Go through the queue operations of a POSC create and close for every file,
+// then add one more file that is left pending as if the server had crashed.
+//
+void *Write(void *parg)
+{
+   Writer *wP = (Writer *)parg;
+   char lfn[64], tident[32];
+   int slot;
+
+   snprintf(tident, sizeof(tident), "bench.%d:1@localhost", wP->Num);
+   for (int i = 0; i <= wP->Ops; i++)
+       {snprintf(lfn, sizeof(lfn), "/posc/w%d/f%d", wP->Num, i);
+        if ((slot = wP->Queue->Add(tident, lfn)) < 0) {wP->Errs++; continue;}
+        if (i == wP->Ops) break;
+        if (wP->Queue->Commit(lfn, slot)
+        ||  wP->Queue->Del(lfn, slot)) wP->Errs++;
+       }
+   return 0;
+}
+
+/******************************************************************************/
+/*                                   R u n                                    */
+/******************************************************************************/
+  
+// Run nthr writers doing ops creates between them against a new queue file.
+// Returns false if anything failed or recovery does not see exactly one
+// pending record per writer.
+//
+bool Run(XrdSysError &eDest, const char *qfn, int nthr, int ops)
+{
+   XrdOfsPoscq *qP;
+   XrdOfsPoscq::recEnt *rP, *nP;
+   Writer *wP = new Writer[nthr];
+   pthread_t *tid = new pthread_t[nthr];
+   double start, elapsed;
+   int i, rc, errs = 0, pend = 0, isOK;
+
+   unlink(qfn);
+   qP = new XrdOfsPoscq(&eDest, 0, qfn);
+   qP->Init(isOK);
+   if (!isOK) return false;
+
+   start = Now();
+   for (i = 0; i < nthr; i++)
+       {wP[i].Queue = qP; wP[i].Num = i; wP[i].Errs = 0;
+        wP[i].Ops = ops/nthr;
+        if ((rc = XrdSysThread::Run(&tid[i], Write, &wP[i], XRDSYSTHREAD_HOLD,
+                                    "posc writer")))
+           {eDest.Emsg("Run", rc, "start writer thread"); return false;}
+       }
+   for (i = 0; i < nthr; i++)
+       {XrdSysThread::Join(tid[i], 0);
+        errs += wP[i].Errs;
+       }
+   elapsed = Now() - start;
+
+   rP = XrdOfsPoscq::List(&eDest, qfn);
+   while(rP) {pend++; nP = rP->Next; delete rP; rP = nP;}
+
+   printf("%7d %9d %10.2f %12.0f %8d %6d\n", nthr, (ops/nthr)*nthr, elapsed,
+          (ops/nthr)*nthr/elapsed, pend, errs);
+
+   delete qP;
+   delete [] wP;
+   delete [] tid;
+   return errs == 0 && pend == nthr;
+}
+
+/******************************************************************************/
+/*                                 U s a g e                                  */
+/******************************************************************************/
+  
+void Usage(int rc)
+{
+   fprintf(stderr, "Usage: xrdposcbench [-d <dir>] [-n <creates>] "
+                   "[<threads> [...]]\n");
+   exit(rc);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+  
+int main(int argc, char *argv[])
+{
+   XrdSysLogger myLogger;
+   XrdSysError  eDest(&myLogger, "poscbench_");
+   const char *dir = "/tmp";
+   char qfn[1024];
+   int defThreads[] = {1, 4, 16, 64};
+   int c, i, nthr, ops = 20000;
+   bool ok = true;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "d:hn:")) != -1)
+        {switch(c)
+               {case 'd': dir = optarg;
+                          break;
+                case 'h': Usage(0);
+                          break;
+                case 'n': if ((ops = atoi(optarg)) <= 0) Usage(1);
+                          break;
+                default:  Usage(1);
+               }
+        }
+   snprintf(qfn, sizeof(qfn), "%s/xrdposcbench.%d.log", dir, (int)getpid());
+
+// Run each requested number of writers
+//
+   printf("%7s %9s %10s %12s %8s %6s\n", "threads", "creates", "seconds",
+          "creates/s", "pending", "errors");
+   if (optind < argc)
+      {for (i = optind; i < argc; i++)
+           {if ((nthr = atoi(argv[i])) <= 0) Usage(1);
+            if (!Run(eDest, qfn, nthr, ops)) ok = false;
+           }
+      } else {
+       for (i = 0; i < (int)(sizeof(defThreads)/sizeof(int)); i++)
+           if (!Run(eDest, qfn, defThreads[i], ops)) ok = false;
+      }
+
+// All done
+//
+   unlink(qfn);
+   return (ok ? 0 : 1);
+}
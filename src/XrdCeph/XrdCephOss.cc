@@ -33,6 +33,7 @@
 #include "XrdOuc/XrdOucStream.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
 #include "XrdOuc/XrdOucN2NLoader.hh"
+#include "XrdOuc/XrdOuca2x.hh"
 #include "XrdVersion.hh"
 #include "XrdCeph/XrdCephOss.hh"
 #include "XrdCeph/XrdCephOssDir.hh"
@@ -90,6 +91,9 @@ XrdCephOss::~XrdCephOss() {
 
 // declared and used in XrdCephPosix.cc
 extern unsigned int g_maxCephPoolIdx;
+extern unsigned long long g_readvMergeGap;
+// declared and used in XrdCephOssFile.cc
+extern size_t g_readAheadSize;
 int XrdCephOss::Configure(const char *configfn, XrdSysError &Eroute) {
    int NoGo = 0;
    XrdOucEnv myEnv;
@@ -121,6 +125,45 @@ int XrdCephOss::Configure(const char *configfn, XrdSysError &Eroute) {
            return 1;
          }
        }
+       if (!strncmp(var, "ceph.readahead", 14)) {
+         var = Config.GetWord();
+         long long value;
+         if (!var) {
+           Eroute.Emsg("Config", "Missing value for ceph.readahead in config file", configfn);
+           return 1;
+         }
+         if (XrdOuca2x::a2sz(Eroute, "ceph.readahead size", var, &value, 0, 64*1024*1024)) {
+           return 1;
+         }
+         g_readAheadSize = value;
+       }
+       if (!strncmp(var, "ceph.readvgap", 13)) {
+         var = Config.GetWord();
+         long long value;
+         if (!var) {
+           Eroute.Emsg("Config", "Missing value for ceph.readvgap in config file", configfn);
+           return 1;
+         }
+         if (XrdOuca2x::a2sz(Eroute, "ceph.readvgap size", var, &value, 0)) {
+           return 1;
+         }
+         g_readvMergeGap = value;
+       }
+       if (!strncmp(var, "ceph.trace", 10)) {
+         var = Config.GetWord();
+         if (!var) {
+           Eroute.Emsg("Config", "Missing value for ceph.trace in config file", configfn);
+           return 1;
+         }
+         if (!strcmp(var, "debug") || !strcmp(var, "all")) {
+           XrdCephTrace.What |= TRACE_Debug;
+         } else if (!strcmp(var, "off")) {
+           XrdCephTrace.What = 0;
+         } else {
+           Eroute.Emsg("Config", "Invalid value for ceph.trace in config file (must be debug, all or off)", configfn, var);
+           return 1;
+         }
+       }
        if (!strncmp(var, "ceph.namelib", 12)) {
          var = Config.GetWord();
          if (var) {
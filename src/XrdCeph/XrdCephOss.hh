@@ -28,6 +28,9 @@
 #include <string>
 #include <XrdOss/XrdOss.hh>
 
+/// trace flag set by 'ceph.trace debug', see XrdCephTrace
+#define TRACE_Debug 0x0800
+
 //------------------------------------------------------------------------------
 //! This class implements XrdOss interface for usage with a CEPH storage.
 //! It should be loaded via the ofs.osslib directive.
@@ -23,6 +23,10 @@
 //------------------------------------------------------------------------------
 
 #include <sys/types.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "XrdCeph/XrdCephPosix.hh"
@@ -35,14 +39,29 @@
 #include "XrdCeph/XrdCephOss.hh"
 
 extern XrdSysError XrdCephEroute;
+extern XrdOucTrace XrdCephTrace;
 
-XrdCephOssFile::XrdCephOssFile(XrdCephOss *cephOss) : m_fd(-1), m_cephOss(cephOss) {}
+/// size of the per file read-ahead buffer, 0 (the default) disables read-ahead
+/// may be overwritten in the configuration file
+/// (See XrdCephOss::configure)
+size_t g_readAheadSize = 0;
+
+XrdCephOssFile::XrdCephOssFile(XrdCephOss *cephOss) :
+  m_fd(-1), m_cephOss(cephOss), m_raBuff(0), m_raOffset(0), m_raLength(0),
+  m_raNext(0), m_raFilling(false), m_raHits(0), m_raMisses(0) {}
+
+XrdCephOssFile::~XrdCephOssFile() {
+  free(m_raBuff);
+}
 
 int XrdCephOssFile::Open(const char *path, int flags, mode_t mode, XrdOucEnv &env) {
   try {
     int rc = ceph_posix_open(&env, path, flags, mode);
     if (rc < 0) return rc;
     m_fd = rc;
+    if (g_readAheadSize > 0 && (flags & O_ACCMODE) == O_RDONLY && !m_raBuff) {
+      m_raBuff = (char*)malloc(g_readAheadSize);
+    }
     return XrdOssOK;
   } catch (std::exception &e) {
     XrdCephEroute.Say("open : invalid syntax in file parameters");
@@ -51,6 +70,17 @@ int XrdCephOssFile::Open(const char *path, int flags, mode_t mode, XrdOucEnv &en
 }
 
 int XrdCephOssFile::Close(long long *retsz) {
+  if (m_raBuff) {
+    if (XrdCephTrace.What & TRACE_Debug) {
+      unsigned long long total = m_raHits + m_raMisses;
+      char msg[128];
+      snprintf(msg, sizeof(msg), "readahead for fd %d : %llu hits, %llu misses, %llu%% hit rate",
+               m_fd, m_raHits, m_raMisses, total ? (100 * m_raHits) / total : 0);
+      XrdCephEroute.Say(msg);
+    }
+    free(m_raBuff);
+    m_raBuff = 0;
+  }
   return ceph_posix_close(m_fd);
 }
 
@@ -59,9 +89,49 @@ ssize_t XrdCephOssFile::Read(off_t offset, size_t blen) {
 }
 
 ssize_t XrdCephOssFile::Read(void *buff, off_t offset, size_t blen) {
+  if (m_raBuff && blen < g_readAheadSize) {
+    return ReadAhead(buff, offset, blen);
+  }
   return ceph_posix_pread(m_fd, buff, blen, offset);
 }
 
+// Serves reads from the read-ahead buffer when possible. The buffer is only
+// refilled for reads continuing the previous one, so random access pays no
+// extra cost beyond the bookkeeping. The refill is done without holding the
+// lock; the buffer is empty meanwhile and other reads go straight to ceph.
+ssize_t XrdCephOssFile::ReadAhead(void *buff, off_t offset, size_t blen) {
+  XrdSysMutexHelper lock(m_raMutex);
+  bool sequential = (offset == m_raNext);
+  m_raNext = offset + blen;
+  if (offset >= m_raOffset && offset + blen <= m_raOffset + m_raLength) {
+    memcpy(buff, m_raBuff + (offset - m_raOffset), blen);
+    m_raHits++;
+    return blen;
+  }
+  m_raMisses++;
+  if (!sequential || m_raFilling) {
+    lock.UnLock();
+    return ceph_posix_pread(m_fd, buff, blen, offset);
+  }
+  m_raFilling = true;
+  m_raLength = 0;
+  lock.UnLock();
+
+  ssize_t rc = ceph_posix_pread(m_fd, m_raBuff, g_readAheadSize, offset);
+  size_t n = 0;
+  if (rc > 0) {
+    n = (size_t)rc < blen ? rc : blen;
+    memcpy(buff, m_raBuff, n);
+  }
+
+  lock.Lock(&m_raMutex);
+  m_raFilling = false;
+  if (rc < 0) return rc;
+  m_raOffset = offset;
+  m_raLength = rc;
+  return n;
+}
+
 static void aioReadCallback(XrdSfsAio *aiop, size_t rc) {
   aiop->Result = rc;
   aiop->doneRead();
@@ -75,6 +145,10 @@ ssize_t XrdCephOssFile::ReadRaw(void *buff, off_t offset, size_t blen) {
   return Read(buff, offset, blen);
 }
 
+ssize_t XrdCephOssFile::ReadV(XrdOucIOVec *readV, int n) {
+  return ceph_posix_preadv(m_fd, readV, n);
+}
+
 int XrdCephOssFile::Fstat(struct stat *buff) {
   return ceph_posix_fstat(m_fd, buff);
 }
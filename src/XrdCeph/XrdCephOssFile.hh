@@ -27,6 +27,7 @@
 
 #include "XrdOss/XrdOss.hh"
 #include "XrdCeph/XrdCephOss.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 //------------------------------------------------------------------------------
 //! This class implements XrdOssDF interface for usage with a CEPH storage.
@@ -47,6 +48,10 @@
 //! clash with one used in a ofs.xattrlib directive. In case both directives
 //! have a default and they are different, the behavior is not defined.
 //! In case one of the two only has a default, it will be applied for both plugins.
+//!
+//! Vector reads are issued to ceph in parallel, one read per group of elements
+//! lying in the same RADOS object. Files opened read only may also use a
+//! read-ahead buffer for sequential streams (ceph.readahead directive).
 //------------------------------------------------------------------------------
 
 class XrdCephOssFile : public XrdOssDF {
@@ -54,13 +59,14 @@ class XrdCephOssFile : public XrdOssDF {
 public:
 
   XrdCephOssFile(XrdCephOss *cephoss);
-  virtual ~XrdCephOssFile() {};
+  virtual ~XrdCephOssFile();
   virtual int Open(const char *path, int flags, mode_t mode, XrdOucEnv &env);
   virtual int Close(long long *retsz=0);
   virtual ssize_t Read(off_t offset, size_t blen);
   virtual ssize_t Read(void *buff, off_t offset, size_t blen);
   virtual int     Read(XrdSfsAio *aoip);
   virtual ssize_t ReadRaw(void *, off_t, size_t);
+  virtual ssize_t ReadV(XrdOucIOVec *readV, int n);
   virtual int Fstat(struct stat *buff);
   virtual ssize_t Write(const void *buff, off_t offset, size_t blen);
   virtual int Write(XrdSfsAio *aiop);
@@ -69,9 +75,21 @@ public:
 
 private:
 
+  ssize_t ReadAhead(void *buff, off_t offset, size_t blen);
+
   int m_fd;
   XrdCephOss *m_cephOss;
 
+  // read-ahead buffer, only allocated when enabled and the file is read only
+  XrdSysMutex m_raMutex;
+  char *m_raBuff;
+  off_t m_raOffset;
+  size_t m_raLength;
+  off_t m_raNext;
+  bool m_raFilling;
+  unsigned long long m_raHits;
+  unsigned long long m_raMisses;
+
 };
 
 #endif /* __XRD_CEPH_OSS_FILE_HH__ */
@@ -40,7 +40,9 @@
 #include <sstream>
 #include <sys/xattr.h>
 #include <time.h>
+#include <algorithm>
 #include <limits>
+#include <vector>
 #include <pthread.h>
 #include "XrdSfs/XrdSfsAio.hh"
 #include "XrdSys/XrdSysPthread.hh"
@@ -83,6 +85,19 @@ struct AioArgs {
   ceph::bufferlist *bl;
 };
 
+/// small struct describing one read of a vector read : a range of the file
+/// covering one or more of the (sorted) elements, within a single RADOS object
+struct ReadVExtent {
+  ReadVExtent(unsigned long long o, unsigned long long e, int f) :
+    offset(o), end(e), first(f), last(f+1), completion(0) {}
+  unsigned long long offset;
+  unsigned long long end;
+  int first;
+  int last;
+  ceph::bufferlist bl;
+  librados::AioCompletion *completion;
+};
+
 /// global variables holding stripers/ioCtxs/cluster objects
 /// Note that we have a pool of them to circumvent the limitation
 /// of having a single objecter/messenger per IoCtx
@@ -102,6 +117,11 @@ unsigned int g_maxCephPoolIdx = 1;
 /// pointer to library providing Name2Name interface. 0 be default
 /// populated in case of ceph.namelib entry in the config file in XrdCephOss
 XrdOucName2Name *g_namelib = 0;
+/// largest hole between two readv elements of the same RADOS object for them
+/// to still be fetched by a single read, defaults to 256 KB
+/// may be overwritten in the configuration file
+/// (See XrdCephOss::configure)
+unsigned long long g_readvMergeGap = 256 * 1024;
 
 /// global variable holding a list of files currently opened for write
 std::multiset<std::string> g_filesOpenForWrite;
@@ -878,6 +898,108 @@ ssize_t ceph_aio_read(int fd, XrdSfsAio *aiop, AioCB *cb) {
   }
 }
 
+/// orders the elements of a vector read by offset
+class ReadVOrder {
+public:
+  ReadVOrder(const XrdOucIOVec *readV) : m_readV(readV) {}
+  bool operator()(int a, int b) const {
+    return m_readV[a].offset < m_readV[b].offset;
+  }
+private:
+  const XrdOucIOVec *m_readV;
+};
+
+/// tells whether the range [start, end[ of a file lies within a single RADOS object
+static bool inSameObject(const CephFile &file, unsigned long long start, unsigned long long end) {
+  if (file.nbStripes <= 1) {
+    return start / file.objectSize == (end - 1) / file.objectSize;
+  }
+  // with several stripes, consecutive stripe units go to different objects
+  return start / file.stripeUnit == (end - 1) / file.stripeUnit;
+}
+
+ssize_t ceph_posix_preadv(int fd, XrdOucIOVec *readV, int n) {
+  CephFileRef* fr = getFileRef(fd);
+  if (fr) {
+    if ((fr->flags & O_WRONLY) != 0) {
+      return -EBADF;
+    }
+    if (n <= 0) return 0;
+    libradosstriper::RadosStriper *striper = getRadosStriper(*fr);
+    if (0 == striper) {
+      return -EINVAL;
+    }
+    int cephPoolIdx = getCephPoolIdxAndIncrease();
+    librados::Rados* cluster = checkAndCreateCluster(cephPoolIdx);
+    if (0 == cluster) {
+      return -EINVAL;
+    }
+    // sort the elements and merge neighbours falling in the same RADOS object
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), ReadVOrder(readV));
+    std::vector<ReadVExtent*> extents;
+    ReadVExtent *cur = 0;
+    for (int i = 0; i < n; i++) {
+      unsigned long long start = readV[order[i]].offset;
+      unsigned long long end = start + readV[order[i]].size;
+      if (cur && start <= cur->end + g_readvMergeGap &&
+          inSameObject(*fr, cur->offset, std::max(end, cur->end))) {
+        cur->end = std::max(end, cur->end);
+        cur->last = i+1;
+      } else {
+        cur = new ReadVExtent(start, end, i);
+        extents.push_back(cur);
+      }
+    }
+    // fan all reads out at once
+    ssize_t rc = 0;
+    for (size_t i = 0; i < extents.size(); i++) {
+      ReadVExtent *ext = extents[i];
+      if (ext->end == ext->offset) continue;
+      ext->completion = cluster->aio_create_completion();
+      int arc = striper->aio_read(fr->name, ext->completion, &ext->bl,
+                                  ext->end - ext->offset, ext->offset);
+      if (arc < 0) {
+        ext->completion->release();
+        ext->completion = 0;
+        rc = arc;
+        break;
+      }
+    }
+    // gather them, always waiting for every read issued as they own buffers
+    ssize_t nbytes = 0;
+    for (size_t i = 0; i < extents.size(); i++) {
+      ReadVExtent *ext = extents[i];
+      if (ext->completion) {
+        ext->completion->wait_for_complete();
+        int arc = ext->completion->get_return_value();
+        ext->completion->release();
+        if (arc < 0 && rc == 0) rc = arc;
+      }
+      if (rc == 0) {
+        unsigned long long got = ext->bl.length();
+        for (int k = ext->first; k < ext->last; k++) {
+          XrdOucIOVec &elem = readV[order[k]];
+          unsigned long long pos = elem.offset - ext->offset;
+          if (pos + elem.size > got) {
+            // same semantic as XrdOssDF::ReadV for short reads
+            rc = -ESPIPE;
+            break;
+          }
+          if (elem.size > 0) ext->bl.copy(pos, elem.size, elem.data);
+          nbytes += elem.size;
+        }
+      }
+      delete ext;
+    }
+    fr->rdcount += extents.size();
+    return rc ? rc : nbytes;
+  } else {
+    return -EBADF;
+  }
+}
+
 int ceph_posix_fstat(int fd, struct stat *buf) {
   CephFileRef* fr = getFileRef(fd);
   if (fr) {
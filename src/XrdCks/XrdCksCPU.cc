@@ -0,0 +1,74 @@
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d C k s C P U . c c                           */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include "XrdCks/XrdCksCPU.hh"
+
+/******************************************************************************/
+/*                              F e a t u r e s                               */
+/******************************************************************************/
+  
+int XrdCksCPU::Features()
+{
+   static volatile int features = 0;
+   int fv = features;
+
+// Return the cached answer if we have one. A race here is harmless as every
+// thread computes the same value.
+//
+   if (fv) return fv;
+   fv = Probed;
+
+#if defined(__x86_64__) || defined(__i386__)
+   unsigned int eax, ebx, ecx, edx;
+
+// Leaf 1 has SSE2 (edx bit 26), SSSE3 (ecx bit 9), SSE4.2 (bit 20),
+// PCLMULQDQ (bit 1) and OSXSAVE (bit 27) which is needed to check that the
+// OS saves AVX state.
+//
+   if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+      {if (edx & (1 << 26)) fv |= SSE2;
+       if (ecx & (1 << 20)) fv |= SSE42;
+       if ((ecx & (1 << 1)) && (ecx & (1 << 9))) fv |= PCLMUL;
+       if ((ecx & (1 << 27)) && __get_cpuid_max(0, 0) >= 7)
+          {unsigned int xlo, xhi;
+           __asm__ __volatile__ ("xgetbv" : "=a"(xlo), "=d"(xhi) : "c"(0));
+           if ((xlo & 6) == 6)
+              {__cpuid_count(7, 0, eax, ebx, ecx, edx);
+               if (ebx & (1 << 5)) fv |= AVX2;
+              }
+          }
+      }
+#endif
+
+   features = fv;
+   return fv;
+}
@@ -0,0 +1,57 @@
+#ifndef __XRDCKSCPU_HH__
+#define __XRDCKSCPU_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                          X r d C k s C P U . h h                           */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+// The XrdCksCPU class tells which instruction set extensions usable by the
+// checksum kernels are available on this CPU. The answers are computed once.
+// On non-x86 platforms all of them are false.
+//
+class XrdCksCPU
+{
+public:
+
+static bool hasAVX2()   {return Features() & AVX2;}  // AVX2 with OS support
+
+static bool hasPCLMUL() {return Features() & PCLMUL;}// PCLMULQDQ and SSSE3
+
+static bool hasSSE2()   {return Features() & SSE2;}
+
+static bool hasSSE42()  {return Features() & SSE42;} // SSE4.2 crc32
+
+private:
+
+static const int AVX2   = 0x01;
+static const int PCLMUL = 0x02;
+static const int SSE42  = 0x04;
+static const int SSE2   = 0x08;
+static const int Probed = 0x80;
+
+static int       Features();
+};
+#endif
@@ -0,0 +1,240 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d C k s C a l c a d l e r 3 2 . c c                   */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define XRDCKS_X86 1
+#endif
+
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdCks/XrdCksCPU.hh"
+
+/* The following implementation of adler32 was derived from zlib and is
+                   * Copyright (C) 1995-1998 Mark Adler
+   Below are the zlib license terms for this implementation.
+*/
+  
+/* zlib.h -- interface of the 'zlib' general purpose compression library
+  version 1.1.4, March 11th, 2002
+
+  Copyright (C) 1995-2002 Jean-loup Gailly and Mark Adler
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+
+  Jean-loup Gailly        Mark Adler
+  jloup@gzip.org          madler@alumni.caltech.edu
+
+
+  The data format used by the zlib library is described by RFCs (Request for
+  Comments) 1950 to 1952 in the files ftp://ds.internic.net/rfc/rfc1950.txt
+  (zlib format), rfc1951.txt (deflate format) and rfc1952.txt (gzip format).
+*/
+
+/* The vectorized kernels compute the same sums 32 bytes at a time. Within a
+   block of n bytes b[0..n-1] the sums advance as
+       sum2 += n*sum1 + n*b[0] + (n-1)*b[1] + ... + 1*b[n-1]
+       sum1 += b[0] + ... + b[n-1]
+   so the byte sums and the weighted sums can be formed in vector lanes and
+   folded back every AdlerNMax bytes, before any 32-bit lane can overflow.
+*/
+
+/******************************************************************************/
+/*                         L o c a l   D e f i n e s                          */
+/******************************************************************************/
+
+#define DO1(buf)  {unSum1 += *buf++; unSum2 += unSum1;}
+#define DO2(buf)  DO1(buf); DO1(buf);
+#define DO4(buf)  DO2(buf); DO2(buf);
+#define DO8(buf)  DO4(buf); DO4(buf);
+#define DO16(buf) DO8(buf); DO8(buf);
+
+namespace
+{
+const unsigned int AdlerBase  = 0xFFF1;
+const          int AdlerNMax  = 5552;
+const          int AdlerBlock = 32;
+
+/* NMAX is the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1 */
+
+/******************************************************************************/
+/*                           a d l e r S c a l a r                            */
+/******************************************************************************/
+  
+void adlerScalar(unsigned int &sum1, unsigned int &sum2,
+                 const unsigned char *buff, int BLen)
+{
+   unsigned int unSum1 = sum1, unSum2 = sum2;
+   int k;
+
+   while(BLen > 0)
+        {k = (BLen < AdlerNMax ? BLen : AdlerNMax);
+         BLen -= k;
+         while(k >= 16) {DO16(buff); k -= 16;}
+         if (k != 0) do {DO1(buff);} while (--k);
+         unSum1 %= AdlerBase; unSum2 %= AdlerBase;
+        }
+   sum1 = unSum1; sum2 = unSum2;
+}
+
+#ifdef XRDCKS_X86
+/******************************************************************************/
+/*                              h S u m 1 2 8                                 */
+/******************************************************************************/
+
+__attribute__((target("sse2")))
+inline unsigned int hSum128(__m128i v)
+{
+   v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1,0,3,2)));
+   v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2,3,0,1)));
+   return (unsigned int)_mm_cvtsi128_si32(v);
+}
+
+/******************************************************************************/
+/*                             a d l e r S S E 2                              */
+/******************************************************************************/
+
+__attribute__((target("sse2")))
+void adlerSSE2(unsigned int &sum1, unsigned int &sum2,
+               const unsigned char *buff, int BLen)
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i w1   = _mm_setr_epi16(32, 31, 30, 29, 28, 27, 26, 25);
+   const __m128i w2   = _mm_setr_epi16(24, 23, 22, 21, 20, 19, 18, 17);
+   const __m128i w3   = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10,  9);
+   const __m128i w4   = _mm_setr_epi16( 8,  7,  6,  5,  4,  3,  2,  1);
+   unsigned int s1 = sum1, s2 = sum2;
+   int n, blocks = BLen / AdlerBlock;
+
+   BLen -= blocks * AdlerBlock;
+   while(blocks)
+        {n = AdlerNMax / AdlerBlock;
+         if (n > blocks) n = blocks;
+         blocks -= n;
+         __m128i vps = _mm_setr_epi32(s1 * n, 0, 0, 0);
+         __m128i vs2 = _mm_setr_epi32(s2, 0, 0, 0);
+         __m128i vs1 = zero;
+         do {__m128i b1 = _mm_loadu_si128((const __m128i *)buff);
+             __m128i b2 = _mm_loadu_si128((const __m128i *)(buff + 16));
+             vps = _mm_add_epi32(vps, vs1);
+             vs1 = _mm_add_epi32(vs1, _mm_add_epi32(_mm_sad_epu8(b1, zero),
+                                                    _mm_sad_epu8(b2, zero)));
+             vs2 = _mm_add_epi32(vs2,
+                   _mm_madd_epi16(_mm_unpacklo_epi8(b1, zero), w1));
+             vs2 = _mm_add_epi32(vs2,
+                   _mm_madd_epi16(_mm_unpackhi_epi8(b1, zero), w2));
+             vs2 = _mm_add_epi32(vs2,
+                   _mm_madd_epi16(_mm_unpacklo_epi8(b2, zero), w3));
+             vs2 = _mm_add_epi32(vs2,
+                   _mm_madd_epi16(_mm_unpackhi_epi8(b2, zero), w4));
+             buff += AdlerBlock;
+            } while(--n);
+         vs2 = _mm_add_epi32(vs2, _mm_slli_epi32(vps, 5));
+         s1 = (s1 + hSum128(vs1)) % AdlerBase;
+         s2 = hSum128(vs2) % AdlerBase;
+        }
+
+   sum1 = s1; sum2 = s2;
+   if (BLen) adlerScalar(sum1, sum2, buff, BLen);
+}
+
+/******************************************************************************/
+/*                             a d l e r A V X 2                              */
+/******************************************************************************/
+
+__attribute__((target("avx2")))
+void adlerAVX2(unsigned int &sum1, unsigned int &sum2,
+               const unsigned char *buff, int BLen)
+{
+   const __m256i zero = _mm256_setzero_si256();
+   const __m256i ones = _mm256_set1_epi16(1);
+   const __m256i taps = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,
+                                         24, 23, 22, 21, 20, 19, 18, 17,
+                                         16, 15, 14, 13, 12, 11, 10,  9,
+                                          8,  7,  6,  5,  4,  3,  2,  1);
+   unsigned int s1 = sum1, s2 = sum2;
+   int n, blocks = BLen / AdlerBlock;
+
+   BLen -= blocks * AdlerBlock;
+   while(blocks)
+        {n = AdlerNMax / AdlerBlock;
+         if (n > blocks) n = blocks;
+         blocks -= n;
+         __m256i vps = _mm256_setr_epi32(s1 * n, 0, 0, 0, 0, 0, 0, 0);
+         __m256i vs2 = _mm256_setr_epi32(s2, 0, 0, 0, 0, 0, 0, 0);
+         __m256i vs1 = zero;
+         do {__m256i b = _mm256_loadu_si256((const __m256i *)buff);
+             vps = _mm256_add_epi32(vps, vs1);
+             vs1 = _mm256_add_epi32(vs1, _mm256_sad_epu8(b, zero));
+             vs2 = _mm256_add_epi32(vs2, _mm256_madd_epi16(
+                                   _mm256_maddubs_epi16(b, taps), ones));
+             buff += AdlerBlock;
+            } while(--n);
+         vs2 = _mm256_add_epi32(vs2, _mm256_slli_epi32(vps, 5));
+         s1 = (s1 + hSum128(_mm_add_epi32(_mm256_castsi256_si128(vs1),
+                            _mm256_extracti128_si256(vs1, 1)))) % AdlerBase;
+         s2 =       hSum128(_mm_add_epi32(_mm256_castsi256_si128(vs2),
+                            _mm256_extracti128_si256(vs2, 1)))  % AdlerBase;
+        }
+
+   sum1 = s1; sum2 = s2;
+   if (BLen) adlerScalar(sum1, sum2, buff, BLen);
+}
+#endif
+}
+
+/******************************************************************************/
+/*                           G l o b a l   D a t a                            */
+/******************************************************************************/
+
+const XrdCksKernel<XrdCksCalcadler32::KernelFunc>::Impl
+      XrdCksCalcadler32::KernelList[] =
+{
+#ifdef XRDCKS_X86
+   {"avx2",   adlerAVX2,   XrdCksCPU::hasAVX2},
+   {"sse2",   adlerSSE2,   XrdCksCPU::hasSSE2},
+#endif
+   {"scalar", adlerScalar, 0}
+};
+
+XrdCksKernel<XrdCksCalcadler32::KernelFunc> XrdCksCalcadler32::Kernel =
+   {XrdCksKernel<KernelFunc>::Resolve<XrdCksCalcadler32::Kernel>, KernelList,
+    sizeof(KernelList)/sizeof(KernelList[0])};
@@ -28,7 +28,12 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 #include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCPU.hh"
 
 /*
    C++ implementation of CRC-32 checksums.  Code is based
@@ -166,13 +171,123 @@ unsigned int XrdCksCalccrc32::crctable[256] =
      Include length bits at the end to correspond to the Posix 1003.2 spec.
      Make this a C++ class.
 */
-void XrdCksCalccrc32::Update(const char *p, int reclen)
+/******************************************************************************/
+/*                                S c a l a r                                 */
+/******************************************************************************/
+  
+unsigned int XrdCksCalccrc32::Scalar(unsigned int crc,
+                                     const unsigned char *p, int reclen)
 {
 
 // Process each byte
 //
-   TotLen += reclen;
    while(reclen-- > 0)
-        C32Result = (C32Result<<8) 
-                  ^ crctable[(unsigned char)((C32Result>>24)^*p++)];
+        crc = (crc<<8) ^ crctable[(unsigned char)((crc>>24)^*p++)];
+   return crc;
+}
+
+/******************************************************************************/
+/*                                P C L M U L                                 */
+/******************************************************************************/
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/* This is the folding method described in "Fast CRC Computation for Generic
+   Polynomials Using PCLMULQDQ Instruction" (Intel, 2009) for the non-reflected
+   polynomial P = 0x104C11DB7. Data is loaded in 16 byte chunks and byte
+   swapped so that bit i of a register is the coefficient of x^i. A 128 bit
+   value A = H*x^64 + L moved d bits further along the message is congruent to
+   H*(x^(d+64) mod P) + L*(x^d mod P), which is at most 96 bits long, so four
+   accumulators are folded 512 bits at a time and then into one. The final
+   A*x^32 mod P is obtained by two more folds and a Barrett reduction using
+   mu = x^64 div P.
+*/
+
+namespace
+{
+__attribute__((target("pclmul,ssse3")))
+inline __m128i crcFold(__m128i a, __m128i k)
+{
+   return _mm_xor_si128(_mm_clmulepi64_si128(a, k, 0x00),
+                        _mm_clmulepi64_si128(a, k, 0x11));
+}
+}
+
+__attribute__((target("pclmul,ssse3")))
+unsigned int XrdCksCalccrc32::PCLMUL(unsigned int crc,
+                                     const unsigned char *p, int reclen)
+{
+   const __m128i bswap = _mm_setr_epi8(15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0);
+   const __m128i k512  = _mm_set_epi64x(0x8833794c, 0xe6228b11);
+   const __m128i k128  = _mm_set_epi64x(0xc5b9cd4c, 0xe8a45605);
+   const __m128i k96   = _mm_set_epi64x(0x490d678d, 0xf200aa66);
+   const __m128i bar   = _mm_set_epi64x(0x104C11DB7LL, 0x104d101dfLL);
+   __m128i x0, x1, x2, x3;
+
+// Short records are not worth the setup
+//
+   if (reclen < 128) return Scalar(crc, p, reclen);
+
+// Load the first 64 bytes and fold in the current crc value
+//
+#define LOAD(n) _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p+n)),bswap)
+   x0 = _mm_xor_si128(LOAD(0), _mm_set_epi32(crc, 0, 0, 0));
+   x1 = LOAD(16); x2 = LOAD(32); x3 = LOAD(48);
+   p += 64; reclen -= 64;
+
+// Fold 64 bytes at a time
+//
+   while(reclen >= 64)
+        {x0 = _mm_xor_si128(crcFold(x0, k512), LOAD(0));
+         x1 = _mm_xor_si128(crcFold(x1, k512), LOAD(16));
+         x2 = _mm_xor_si128(crcFold(x2, k512), LOAD(32));
+         x3 = _mm_xor_si128(crcFold(x3, k512), LOAD(48));
+         p += 64; reclen -= 64;
+        }
+
+// Fold the four accumulators into one and then any remaining 16 byte chunks
+//
+   x0 = _mm_xor_si128(crcFold(x0, k128), x1);
+   x0 = _mm_xor_si128(crcFold(x0, k128), x2);
+   x0 = _mm_xor_si128(crcFold(x0, k128), x3);
+   while(reclen >= 16)
+        {x0 = _mm_xor_si128(crcFold(x0, k128), LOAD(0));
+         p += 16; reclen -= 16;
+        }
+#undef LOAD
+
+// Compute A*x^32 mod P: first reduce to 96 and then to 64 bits
+//
+   x1 = _mm_xor_si128(_mm_clmulepi64_si128(x0, k96, 0x01),
+                      _mm_slli_si128(_mm_move_epi64(x0), 4));
+   x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k96, 0x11),
+                      _mm_move_epi64(x1));
+
+// Barrett reduction of the 64 bit value to the 32 bit remainder
+//
+   x2 = _mm_clmulepi64_si128(_mm_srli_epi64(x1, 32), bar, 0x00);
+   x2 = _mm_clmulepi64_si128(_mm_srli_epi64(x2, 32), bar, 0x10);
+   crc = (unsigned int)_mm_cvtsi128_si32(_mm_xor_si128(x1, x2));
+
+// Finish off any remaining bytes
+//
+   return (reclen ? Scalar(crc, p, reclen) : crc);
 }
+#endif
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+const XrdCksKernel<XrdCksCalccrc32::KernelFunc>::Impl
+      XrdCksCalccrc32::KernelList[] =
+{
+#if defined(__x86_64__) || defined(__i386__)
+   {"pclmul", PCLMUL, XrdCksCPU::hasPCLMUL},
+#endif
+   {"scalar", Scalar, 0}
+};
+
+XrdCksKernel<XrdCksCalccrc32::KernelFunc> XrdCksCalccrc32::Kernel =
+   {XrdCksKernel<KernelFunc>::Resolve<XrdCksCalccrc32::Kernel>, KernelList,
+    sizeof(KernelList)/sizeof(KernelList[0])};
@@ -36,6 +36,7 @@
 #include <inttypes.h>
 
 #include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksKernel.hh"
 #include "XrdSys/XrdSysPlatform.hh"
   
 class XrdCksCalccrc32 : public XrdCksCalc
@@ -60,16 +61,35 @@ void        Init() {C32Result = CRC32_XINIT; TotLen = 0;}
 
 XrdCksCalc *New() {return (XrdCksCalc *)new XrdCksCalccrc32;}
 
-void        Update(const char *Buff, int BLen);
+void        Update(const char *Buff, int BLen)
+                  {TotLen += BLen;
+                   C32Result = Kernel.Code(C32Result, (const unsigned char *)Buff,
+                                      BLen);
+                  }
 
 const char *Type(int &csSz) {csSz = sizeof(TheResult); return "crc32";}
 
+// Select the implementation used by all crc32 objects. When hwOK is false
+// only the portable code is used, otherwise the fastest one the CPU supports.
+// Returns the name of the selected implementation.
+//
+static const char *SetKernel(bool hwOK=true) {return Kernel.Set(hwOK);}
+
             XrdCksCalccrc32() {Init();}
 virtual    ~XrdCksCalccrc32() {}
 
 private:
+typedef unsigned int (*KernelFunc)(unsigned int, const unsigned char *, int);
+
+static unsigned int Scalar(unsigned int crc, const unsigned char *p, int n);
+#if defined(__x86_64__) || defined(__i386__)
+static unsigned int PCLMUL(unsigned int crc, const unsigned char *p, int n);
+#endif
+
 static const unsigned int CRC32_XINIT = 0;
 static const unsigned int CRC32_XOROT = 0xffffffff;
+static       XrdCksKernel<KernelFunc>             Kernel;
+static const XrdCksKernel<KernelFunc>::Impl       KernelList[];
 static       unsigned int crctable[256];
              unsigned int C32Result;
              unsigned int TheResult;
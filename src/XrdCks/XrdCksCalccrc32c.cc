@@ -0,0 +1,137 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d C k s C a l c c r c 3 2 c . c c                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#define XRDCKS_X86 1
+#endif
+
+#include <string.h>
+
+#include "XrdCks/XrdCksCalccrc32c.hh"
+#include "XrdCks/XrdCksCPU.hh"
+
+/******************************************************************************/
+/*                         L o c a l   K e r n e l s                          */
+/******************************************************************************/
+
+namespace
+{
+// Portable version: slicing-by-8 over tables for the reflected polynomial
+// 0x82F63B78. The tables are built on first use.
+//
+struct crcTables
+      {unsigned int T[8][256];
+
+       crcTables()
+                {unsigned int crc;
+                 for (int i = 0; i < 256; i++)
+                     {crc = i;
+                      for (int j = 0; j < 8; j++)
+                          crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+                      T[0][i] = crc;
+                     }
+                 for (int i = 0; i < 256; i++)
+                     {crc = T[0][i];
+                      for (int k = 1; k < 8; k++)
+                          {crc = (crc >> 8) ^ T[0][crc & 0xff];
+                           T[k][i] = crc;
+                          }
+                     }
+                }
+      };
+
+unsigned int crcScalar(unsigned int crc, const unsigned char *p, int blen)
+{
+   static const crcTables Tab;
+   const unsigned int (*T)[256] = Tab.T;
+   unsigned int lo, hi;
+
+// Do 8 bytes at a time (the loads are done bytewise to stay endian neutral)
+//
+   while(blen >= 8)
+        {lo = crc ^ (p[0] | p[1] << 8 | p[2] << 16 | (unsigned int)p[3] << 24);
+         hi =        p[4] | p[5] << 8 | p[6] << 16 | (unsigned int)p[7] << 24;
+         crc = T[7][lo & 0xff] ^ T[6][(lo >> 8) & 0xff]
+             ^ T[5][(lo >> 16) & 0xff] ^ T[4][lo >> 24]
+             ^ T[3][hi & 0xff] ^ T[2][(hi >> 8) & 0xff]
+             ^ T[1][(hi >> 16) & 0xff] ^ T[0][hi >> 24];
+         p += 8; blen -= 8;
+        }
+
+// Do the remaining bytes
+//
+   while(blen-- > 0) crc = (crc >> 8) ^ T[0][(crc ^ *p++) & 0xff];
+   return crc;
+}
+
+#ifdef XRDCKS_X86
+
+// SSE4.2 version using the crc32 instruction, which implements exactly this
+// polynomial.
+//
+__attribute__((target("sse4.2")))
+unsigned int crcSSE42(unsigned int crc, const unsigned char *p, int blen)
+{
+#ifdef __x86_64__
+   unsigned long long crc64 = crc, v;
+   while(blen >= 8)
+        {memcpy(&v, p, sizeof(v));
+         crc64 = _mm_crc32_u64(crc64, v);
+         p += 8; blen -= 8;
+        }
+   crc = (unsigned int)crc64;
+#endif
+   unsigned int v32;
+   while(blen >= 4)
+        {memcpy(&v32, p, sizeof(v32));
+         crc = _mm_crc32_u32(crc, v32);
+         p += 4; blen -= 4;
+        }
+   while(blen-- > 0) crc = _mm_crc32_u8(crc, *p++);
+   return crc;
+}
+#endif
+}
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+const XrdCksKernel<XrdCksCalccrc32c::KernelFunc>::Impl
+      XrdCksCalccrc32c::KernelList[] =
+{
+#ifdef XRDCKS_X86
+   {"sse4.2", crcSSE42,  XrdCksCPU::hasSSE42},
+#endif
+   {"scalar", crcScalar, 0}
+};
+
+XrdCksKernel<XrdCksCalccrc32c::KernelFunc> XrdCksCalccrc32c::Kernel =
+   {XrdCksKernel<KernelFunc>::Resolve<XrdCksCalccrc32c::Kernel>, KernelList,
+    sizeof(KernelList)/sizeof(KernelList[0])};
@@ -0,0 +1,84 @@
+#ifndef __XRDCKSCALCCRC32C_HH__
+#define __XRDCKSCALCCRC32C_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d C k s C a l c c r c 3 2 c . h h                    */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <inttypes.h>
+
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksKernel.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+// Implements CRC-32C (Castagnoli, RFC 3720) as used by iSCSI, ext4 and many
+// object stores. The result is returned in network byte order.
+//
+class XrdCksCalccrc32c : public XrdCksCalc
+{
+public:
+
+char *Final()
+            {CrcValue = ~CrcState;
+#ifndef Xrd_Big_Endian
+             CrcValue = htonl(CrcValue);
+#endif
+             return (char *)&CrcValue;
+            }
+
+void        Init() {CrcState = 0xffffffff;}
+
+XrdCksCalc *New() {return (XrdCksCalc *)new XrdCksCalccrc32c;}
+
+void        Update(const char *Buff, int BLen)
+                  {CrcState = Kernel.Code(CrcState, (const unsigned char *)Buff,
+                                     BLen);
+                  }
+
+const char *Type(int &csSize) {csSize = sizeof(CrcValue); return "crc32c";}
+
+// Select the implementation used by all crc32c objects. When hwOK is false
+// only the portable code is used, otherwise the fastest one the CPU supports.
+// Returns the name of the selected implementation.
+//
+static const char *SetKernel(bool hwOK=true) {return Kernel.Set(hwOK);}
+
+            XrdCksCalccrc32c() {Init();}
+virtual    ~XrdCksCalccrc32c() {}
+
+private:
+
+typedef unsigned int (*KernelFunc)(unsigned int, const unsigned char *, int);
+
+static  XrdCksKernel<KernelFunc>               Kernel;
+static  const XrdCksKernel<KernelFunc>::Impl   KernelList[];
+
+             unsigned int CrcValue;
+             unsigned int CrcState;
+};
+#endif
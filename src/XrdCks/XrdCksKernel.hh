@@ -0,0 +1,67 @@
+#ifndef __XRDCKSKERNEL_HH__
+#define __XRDCKSKERNEL_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d C k s K e r n e l . h h                        */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+// A checksum kernel is the function doing the work for all objects of one
+// checksum type. Each type lists its implementations, the fastest first and
+// the portable one last, and starts out with Resolve() as its kernel. The
+// kernel is thus picked on first use, so that objects created during static
+// initialization work regardless of the order in which modules are set up.
+// For the same reason kernels are plain aggregates, initialized statically.
+//
+template<typename Func> struct XrdCksKernel;
+
+template<typename R, typename... Args>
+struct XrdCksKernel<R (*)(Args...)>
+{
+typedef R (*Func)(Args...);
+
+struct Impl {const char *Name;        // name reported by Set()
+             Func        Code;
+             bool      (*Usable)();   // CPU check, 0 for the portable one
+            };
+
+Func        Code;                     // the implementation in use
+const Impl *List;
+int         Count;
+
+// Select the fastest implementation the CPU supports or, when hwOK is false,
+// the portable one. Returns the name of the selected implementation.
+//
+const char *Set(bool hwOK)
+           {int i = 0;
+            while(i < Count-1 && (!hwOK || !List[i].Usable())) i++;
+            Code = List[i].Code;
+            return List[i].Name;
+           }
+
+template<XrdCksKernel &K>
+static R    Resolve(Args... args) {K.Set(true); return K.Code(args...);}
+};
+#endif
@@ -41,6 +41,7 @@
 #include "XrdCks/XrdCksCalc.hh"
 #include "XrdCks/XrdCksCalcadler32.hh"
 #include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCalccrc32c.hh"
 #include "XrdCks/XrdCksCalcmd5.hh"
 #include "XrdCks/XrdCksLoader.hh"
 #include "XrdCks/XrdCksManager.hh"
@@ -73,7 +74,8 @@ XrdCksManager::XrdCksManager(XrdSysError *erP, int rdsz, XrdVersionInfo &vInfo,
    strcpy(csTab[0].Name, "adler32");
    strcpy(csTab[1].Name, "crc32");
    strcpy(csTab[2].Name, "md5");
-   csLast = 2;
+   strcpy(csTab[3].Name, "crc32c");
+   csLast = 3;
 
 // Compute the i/o size
 //
@@ -285,6 +287,8 @@ int XrdCksManager::Init(const char *ConfigFN, const char *DfltCalc)
                          csTab[i].Obj = new XrdCksCalcadler32;
                  else if (!strcmp("crc32",   csTab[i].Name))
                          csTab[i].Obj = new XrdCksCalccrc32;
+                 else if (!strcmp("crc32c",  csTab[i].Name))
+                         csTab[i].Obj = new XrdCksCalccrc32c;
                  else if (!strcmp("md5",     csTab[i].Name))
                          csTab[i].Obj = new XrdCksCalcmd5;
                  else {eDest->Emsg("Config", "Invalid native checksum -",
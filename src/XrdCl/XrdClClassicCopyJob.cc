@@ -199,6 +199,15 @@ namespace
       //------------------------------------------------------------------------
       virtual XrdCl::XRootDStatus GetCheckSum( std::string &checkSum,
                                                std::string &checkSumType ) = 0;
+
+      //------------------------------------------------------------------------
+      //! Get a human readable summary of the transfer statistics, if the
+      //! source keeps any
+      //------------------------------------------------------------------------
+      virtual std::string GetStats()
+      {
+        return std::string();
+      }
   };
 
   //----------------------------------------------------------------------------
@@ -976,6 +985,14 @@ namespace
         return XrdCl::XRootDStatus( XrdCl::stError, XrdCl::errNoMoreReplicas );
       }
 
+      //------------------------------------------------------------------------
+      //! Get the per source statistics
+      //------------------------------------------------------------------------
+      virtual std::string GetStats()
+      {
+        return pXCpCtx ? pXCpCtx->GetStats() : std::string();
+      }
+
     private:
 
 
@@ -1437,6 +1454,10 @@ namespace XrdCl
     }
     pResults->Set( "size", processed );
 
+    std::string sourceStats = src->GetStats();
+    if( !sourceStats.empty() )
+      pResults->Set( "sourceStats", sourceStats );
+
     //--------------------------------------------------------------------------
     // Finalize the destination
     //--------------------------------------------------------------------------
@@ -71,6 +71,7 @@ namespace XrdCl
   const int DefaultAioSignal            = 0;
   const int DefaultPreferIPv4           = 0;
   const int DefaultMaxMetalinkWait      = 60;
+  const int DefaultSubStreamStripeUnit  = 0;
 
   const char * const DefaultPollerPreference   = "built-in";
   const char * const DefaultNetworkStack       = "IPAuto";
@@ -82,6 +83,7 @@ namespace XrdCl
   const char * const DefaultWriteRecovery      = "true";
   const char * const DefaultOpenRecovery       = "true";
   const char * const DefaultGlfnRedirector     = "";
+  const char * const DefaultSubStreamPolicy    = "roundrobin";
 }
 
 #endif // __XRD_CL_CONSTANTS_HH__
@@ -49,7 +49,8 @@ class ProgressDisplay: public XrdCl::CopyProgressHandler
     //! Constructor
     //--------------------------------------------------------------------------
     ProgressDisplay(): pPrevious(0), pPrintProgressBar(true),
-      pPrintSourceCheckSum(false), pPrintTargetCheckSum(false)
+      pPrintSourceCheckSum(false), pPrintTargetCheckSum(false),
+      pPrintSourceStats(false)
     {}
 
     //--------------------------------------------------------------------------
@@ -128,6 +129,13 @@ class ProgressDisplay: public XrdCl::CopyProgressHandler
         PrintCheckSum( d.target, checkSum, size );
       }
 
+      if( pPrintSourceStats )
+      {
+        std::string stats;
+        if( results->Get( "sourceStats", stats ) )
+          std::cerr << stats << std::flush;
+      }
+
       pOngoingJobs.erase(it);
     }
 
@@ -270,6 +278,7 @@ class ProgressDisplay: public XrdCl::CopyProgressHandler
     void PrintProgressBar( bool print )    { pPrintProgressBar    = print; }
     void PrintSourceCheckSum( bool print ) { pPrintSourceCheckSum = print; }
     void PrintTargetCheckSum( bool print ) { pPrintTargetCheckSum = print; }
+    void PrintSourceStats( bool print )    { pPrintSourceStats    = print; }
 
   private:
     struct JobData
@@ -287,6 +296,7 @@ class ProgressDisplay: public XrdCl::CopyProgressHandler
     bool                        pPrintProgressBar;
     bool                        pPrintSourceCheckSum;
     bool                        pPrintTargetCheckSum;
+    bool                        pPrintSourceStats;
     std::map<uint16_t, JobData> pOngoingJobs;
     XrdSysRecMutex              pMutex;
 };
@@ -621,6 +631,8 @@ int main( int argc, char **argv )
   {
     nbSources = config.nSrcs;
     xcp       = true;
+    if( config.Want( XrdCpConfig::DoVerbose ) )
+      progress.PrintSourceStats( true );
   }
 
   //----------------------------------------------------------------------------
@@ -291,6 +291,7 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "AioSignal",            DefaultAioSignal            );
     REGISTER_VAR_INT( varsInt, "PreferIPv4",           DefaultPreferIPv4           );
     REGISTER_VAR_INT( varsInt, "MaxMetalinkWait",      DefaultMaxMetalinkWait      );
+    REGISTER_VAR_INT( varsInt, "SubStreamStripeUnit",  DefaultSubStreamStripeUnit  );
 
     REGISTER_VAR_STR( varsStr, "PollerPreference",     DefaultPollerPreference     );
     REGISTER_VAR_STR( varsStr, "ClientMonitor",        DefaultClientMonitor        );
@@ -298,6 +299,7 @@ namespace XrdCl
     REGISTER_VAR_STR( varsStr, "NetworkStack",         DefaultNetworkStack         );
     REGISTER_VAR_STR( varsStr, "PlugIn",               DefaultPlugIn               );
     REGISTER_VAR_STR( varsStr, "PlugInConfDir",        DefaultPlugInConfDir        );
+    REGISTER_VAR_STR( varsStr, "SubStreamPolicy",      DefaultSubStreamPolicy      );
     REGISTER_VAR_STR( varsStr, "ReadRecovery",         DefaultReadRecovery         );
     REGISTER_VAR_STR( varsStr, "WriteRecovery",        DefaultWriteRecovery        );
     REGISTER_VAR_STR( varsStr, "OpenRecovery",         DefaultOpenRecovery         );
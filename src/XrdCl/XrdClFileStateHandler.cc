@@ -30,6 +30,7 @@
 #include "XrdCl/XrdClForkHandler.hh"
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClMessageUtils.hh"
+#include "XrdCl/XrdClPostMaster.hh"
 #include "XrdCl/XrdClXRootDTransport.hh"
 #include "XrdCl/XrdClXRootDResponses.hh"
 #include "XrdCl/XrdClMonitor.hh"
@@ -41,6 +42,8 @@
 
 #include <sstream>
 #include <memory>
+#include <algorithm>
+#include <vector>
 #include <sys/time.h>
 
 namespace
@@ -223,6 +226,135 @@ namespace
       XrdCl::Message           *pMessage;
       XrdCl::MessageSendParams  pSendParams;
   };
+
+  //----------------------------------------------------------------------------
+  // Collects the responses to the stripes of a split read. The stripes land
+  // directly in their slices of the user buffer, so once all of them are back
+  // the user handler gets a single chunk covering the whole read.
+  //----------------------------------------------------------------------------
+  class StripedReadHandler
+  {
+    public:
+      //------------------------------------------------------------------------
+      // Constructor
+      //------------------------------------------------------------------------
+      StripedReadHandler( XrdCl::ResponseHandler *userHandler,
+                          uint64_t                offset,
+                          uint32_t                size,
+                          void                   *buffer,
+                          uint32_t                stripeUnit,
+                          uint32_t                stripes ):
+        pUserHandler( userHandler ),
+        pOffset( offset ),
+        pSize( size ),
+        pBuffer( buffer ),
+        pStripeUnit( stripeUnit ),
+        pLength( stripes, 0 ),
+        pPending( stripes ),
+        pStatus( 0 ),
+        pHostList( 0 )
+      {
+      }
+
+      //------------------------------------------------------------------------
+      // Account for a returned stripe, the last one calls the user handler
+      //------------------------------------------------------------------------
+      void StripeDone( uint32_t             stripe,
+                       XrdCl::XRootDStatus *status,
+                       XrdCl::AnyObject    *response,
+                       XrdCl::HostList     *hostList )
+      {
+        using namespace XrdCl;
+        {
+          XrdSysMutexHelper scopedLock( pMutex );
+          if( status->IsOK() )
+          {
+            ChunkInfo *chunk = 0;
+            if( response ) response->Get( chunk );
+            if( chunk ) pLength[stripe] = chunk->length;
+          }
+          else if( !pStatus )
+          {
+            pStatus = status;
+            status  = 0;
+          }
+
+          if( stripe == 0 )
+          {
+            pHostList = hostList;
+            hostList  = 0;
+          }
+
+          delete status;
+          delete response;
+          delete hostList;
+          if( --pPending )
+            return;
+        }
+
+        if( !pHostList )
+          pHostList = new HostList();
+
+        if( pStatus )
+        {
+          pUserHandler->HandleResponseWithHosts( pStatus, 0, pHostList );
+          delete this;
+          return;
+        }
+
+        //----------------------------------------------------------------------
+        // Only the data up to the first short stripe is contiguous
+        //----------------------------------------------------------------------
+        uint32_t length = 0;
+        for( uint32_t i = 0; i < pLength.size(); ++i )
+        {
+          uint32_t expected = std::min( pStripeUnit, pSize - i * pStripeUnit );
+          length += pLength[i];
+          if( pLength[i] < expected )
+            break;
+        }
+
+        AnyObject *obj = new AnyObject();
+        obj->Set( new ChunkInfo( pOffset, length, pBuffer ) );
+        pUserHandler->HandleResponseWithHosts( new XRootDStatus(), obj,
+                                               pHostList );
+        delete this;
+      }
+
+    private:
+      XrdCl::ResponseHandler *pUserHandler;
+      uint64_t                pOffset;
+      uint32_t                pSize;
+      void                   *pBuffer;
+      uint32_t                pStripeUnit;
+      std::vector<uint32_t>   pLength;
+      uint32_t                pPending;
+      XrdCl::XRootDStatus    *pStatus;
+      XrdCl::HostList        *pHostList;
+      XrdSysMutex             pMutex;
+  };
+
+  //----------------------------------------------------------------------------
+  // Handles the response to a single stripe of a split read
+  //----------------------------------------------------------------------------
+  class StripeHandler: public XrdCl::ResponseHandler
+  {
+    public:
+      StripeHandler( StripedReadHandler *parent, uint32_t stripe ):
+        pParent( parent ), pStripe( stripe ) {}
+
+      virtual void HandleResponseWithHosts( XrdCl::XRootDStatus *status,
+                                            XrdCl::AnyObject    *response,
+                                            XrdCl::HostList     *hostList )
+      {
+        pParent->StripeDone( pStripe, status, response, hostList );
+        delete this;
+      }
+
+    private:
+      StripedReadHandler *pParent;
+      uint32_t            pStripe;
+  };
 }
 
 namespace XrdCl
@@ -341,8 +473,13 @@ namespace XrdCl
     pDoRecoverWrite( true ),
     pFollowRedirects( true ),
     pUseVirtRedirector( true ),
+    pStripeUnit( 0 ),
     pReOpenHandler( 0 )
   {
+    int stripeUnit = DefaultSubStreamStripeUnit;
+    DefaultEnv::GetEnv()->GetInt( "SubStreamStripeUnit", stripeUnit );
+    if( stripeUnit > 0 ) pStripeUnit = stripeUnit;
+
     pFileHandle = new uint8_t[4];
     ResetMonitoringVars();
     DefaultEnv::GetForkHandler()->RegisterFileObject( this );
@@ -371,8 +508,13 @@ namespace XrdCl
     pDoRecoverWrite( true ),
     pFollowRedirects( true ),
     pUseVirtRedirector( useVirtRedirector ),
+    pStripeUnit( 0 ),
     pReOpenHandler( 0 )
   {
+    int stripeUnit = DefaultSubStreamStripeUnit;
+    DefaultEnv::GetEnv()->GetInt( "SubStreamStripeUnit", stripeUnit );
+    if( stripeUnit > 0 ) pStripeUnit = stripeUnit;
+
     pFileHandle = new uint8_t[4];
     ResetMonitoringVars();
     DefaultEnv::GetForkHandler()->RegisterFileObject( this );
@@ -668,6 +810,61 @@ namespace XrdCl
                 "%s", this, pFileUrl->GetURL().c_str(),
                 *((uint32_t*)pFileHandle), pDataServer->GetHostId().c_str() );
 
+    uint32_t stripes = ReadStripes( size, buffer );
+    if( stripes <= 1 )
+      return SendRead( offset, size, buffer, handler, timeout );
+
+    //--------------------------------------------------------------------------
+    // Split the read into stripes, each one reading straight into its own
+    // slice of the user buffer
+    //--------------------------------------------------------------------------
+    log->Dump( FileMsg, "[0x%x@%s] Splitting a read of %d bytes into %d "
+               "stripes", this, pFileUrl->GetURL().c_str(), size, stripes );
+
+    StripedReadHandler *striped = new StripedReadHandler( handler, offset, size,
+                                                          buffer, pStripeUnit,
+                                                          stripes );
+    XRootDStatus st;
+    uint32_t     sent = 0;
+    for( ; sent < stripes; ++sent )
+    {
+      uint32_t stripeOff  = sent * pStripeUnit;
+      uint32_t stripeSize = std::min( pStripeUnit, size - stripeOff );
+      StripeHandler *stripeHandler = new StripeHandler( striped, sent );
+      st = SendRead( offset + stripeOff, stripeSize, (char*)buffer + stripeOff,
+                     stripeHandler, timeout );
+      if( !st.IsOK() )
+      {
+        delete stripeHandler;
+        break;
+      }
+    }
+
+    if( sent == 0 )
+    {
+      delete striped;
+      return st;
+    }
+
+    //--------------------------------------------------------------------------
+    // Some stripes are on their way, so the failure has to be reported
+    // through the handler, and not while holding the lock
+    //--------------------------------------------------------------------------
+    scopedLock.UnLock();
+    for( ; sent < stripes; ++sent )
+      striped->StripeDone( sent, new XRootDStatus( st ), 0, 0 );
+    return XRootDStatus();
+  }
+
+  //----------------------------------------------------------------------------
+  // Send a single kXR_read
+  //----------------------------------------------------------------------------
+  XRootDStatus FileStateHandler::SendRead( uint64_t         offset,
+                                           uint32_t         size,
+                                           void            *buffer,
+                                           ResponseHandler *handler,
+                                           uint16_t         timeout )
+  {
     Message           *msg;
     ClientReadRequest *req;
     MessageUtils::CreateRequest( msg, req );
@@ -692,6 +889,34 @@ namespace XrdCl
     return SendOrQueue( *pDataServer, msg, stHandler, params );
   }
 
+  //----------------------------------------------------------------------------
+  // Number of stripes to split a read into - reads are only split when they
+  // span more than one stripe unit and there are at least two bound
+  // substreams to carry them
+  //----------------------------------------------------------------------------
+  uint32_t FileStateHandler::ReadStripes( uint32_t size, void *buffer )
+  {
+    if( !pStripeUnit || size <= pStripeUnit || !buffer ||
+        pFileState != Opened || pDataServer->IsLocalFile() ||
+        pDataServer->IsMetalink() )
+      return 1;
+
+    AnyObject  qryResult;
+    int       *subStreams = 0;
+    Status st = DefaultEnv::GetPostMaster()->QueryTransport( *pDataServer,
+                                                  XRootDQuery::SubStreams,
+                                                  qryResult );
+    if( !st.IsOK() )
+      return 1;
+    qryResult.Get( subStreams );
+    int connected = subStreams ? *subStreams : 0;
+    delete subStreams;
+    if( connected < 2 )
+      return 1;
+
+    return ( size + pStripeUnit - 1 ) / pStripeUnit;
+  }
+
   //----------------------------------------------------------------------------
   // Write a data chunk at a given offset - async
   //----------------------------------------------------------------------------
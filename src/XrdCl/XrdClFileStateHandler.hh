@@ -362,6 +362,21 @@ namespace XrdCl
       };
       typedef std::list<RequestData> RequestList;
 
+      //------------------------------------------------------------------------
+      //! Send a single kXR_read for the given slice of the user buffer
+      //------------------------------------------------------------------------
+      XRootDStatus SendRead( uint64_t         offset,
+                             uint32_t         size,
+                             void            *buffer,
+                             ResponseHandler *handler,
+                             uint16_t         timeout );
+
+      //------------------------------------------------------------------------
+      //! Number of stripes a read of the given size should be split into,
+      //! one if the read should not be split at all
+      //------------------------------------------------------------------------
+      uint32_t ReadStripes( uint32_t size, void *buffer );
+
       //------------------------------------------------------------------------
       //! Send a message to a host or put it in the recovery queue
       //------------------------------------------------------------------------
@@ -475,6 +490,7 @@ namespace XrdCl
       bool                    pDoRecoverWrite;
       bool                    pFollowRedirects;
       bool                    pUseVirtRedirector;
+      uint32_t                pStripeUnit;
 
       //------------------------------------------------------------------------
       // Monitoring variables
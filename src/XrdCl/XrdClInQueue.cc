@@ -75,19 +75,19 @@ namespace XrdCl
 
     // Lookup the sid in the map of handlers
     pMutex.Lock();
-    HandlerMap::iterator it = pHandlers.find(msgSid);
+    HandlerAndExpire *entry = pHandlers.Find( msgSid );
 
-    if (it != pHandlers.end())
+    if( entry )
     {
-      handler = it->second.first;
+      handler = entry->first;
       action  = handler->Examine( msg );
 
       if( action & IncomingMsgHandler::RemoveHandler )
-        pHandlers.erase( it );
+        pHandlers.Erase( msgSid );
     }
 
     if( !(action & IncomingMsgHandler::Take) )
-      pMessages[msgSid] = msg;
+      pMessages.Insert( msgSid, msg );
 
     pMutex.UnLock();
 
@@ -105,23 +105,24 @@ namespace XrdCl
     uint16_t action = 0;
     uint16_t handlerSid = handler->GetSid();
     XrdSysMutexHelper scopedLock( pMutex );
-    MessageMap::iterator it = pMessages.find(handlerSid);
+    Message **msg = pMessages.Find( handlerSid );
 
-    if (it != pMessages.end())
+    if( msg )
     {
-      action = handler->Examine( it->second );
+      Message *m = *msg;
+      action = handler->Examine( m );
 
       if( action & IncomingMsgHandler::Take )
       {
         if( !(action & IncomingMsgHandler::NoProcess ) )
-          handler->Process( it->second );
+          handler->Process( m );
 
-        pMessages.erase( it );
+        pMessages.Erase( handlerSid );
       }
     }
 
     if( !(action & IncomingMsgHandler::RemoveHandler) )
-      pHandlers[handlerSid] = HandlerAndExpire( handler, expires );
+      pHandlers.Insert( handlerSid, HandlerAndExpire( handler, expires ) );
   }
 
   //----------------------------------------------------------------------------
@@ -143,16 +144,16 @@ namespace XrdCl
     }
 
     XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.find(msgSid);
+    HandlerAndExpire *entry = pHandlers.Find( msgSid );
 
-    if (it != pHandlers.end())
+    if( entry )
     {
-      handler = it->second.first;
+      handler = entry->first;
+      exp     = entry->second;
       act     = handler->Examine( msg );
-      exp     = it->second.second;
 
       if( act & IncomingMsgHandler::Take )
-        pHandlers.erase( it );
+        pHandlers.Erase( msgSid );
     }
 
     if( handler )
@@ -172,7 +173,7 @@ namespace XrdCl
   {
     uint16_t handlerSid = handler->GetSid();
     XrdSysMutexHelper scopedLock( pMutex );
-    pHandlers[handlerSid] = HandlerAndExpire( handler, expires );
+    pHandlers.Insert( handlerSid, HandlerAndExpire( handler, expires ) );
   }
 
   //----------------------------------------------------------------------------
@@ -182,7 +183,7 @@ namespace XrdCl
   {
     uint16_t handlerSid = handler->GetSid();
     XrdSysMutexHelper scopedLock( pMutex );
-    pHandlers.erase(handlerSid);
+    pHandlers.Erase( handlerSid );
   }
 
   //----------------------------------------------------------------------------
@@ -194,14 +195,13 @@ namespace XrdCl
   {
     uint8_t action = 0;
     XrdSysMutexHelper scopedLock( pMutex );
-    for( HandlerMap::iterator it = pHandlers.begin(); it != pHandlers.end(); )
+    for( uint32_t sid = 0; pHandlers.Next( sid ); ++sid )
     {
-      action = it->second.first->OnStreamEvent( event, streamNum, status );
+      HandlerAndExpire *entry = pHandlers.Find( sid );
+      action = entry->first->OnStreamEvent( event, streamNum, status );
 
       if( action & IncomingMsgHandler::RemoveHandler )
-        pHandlers.erase( it++ );
-      else
-        ++it;
+        pHandlers.Erase( sid );
     }
   }
 
@@ -214,17 +214,15 @@ namespace XrdCl
       now = ::time(0);
 
     XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.begin();
-    while( it != pHandlers.end() )
+    for( uint32_t sid = 0; pHandlers.Next( sid ); ++sid )
     {
-      if( it->second.second <= now )
+      HandlerAndExpire *entry = pHandlers.Find( sid );
+      if( entry->second <= now )
       {
-        it->second.first->OnStreamEvent( IncomingMsgHandler::Timeout, 0,
-                                         Status( stError, errOperationExpired ) );
-        pHandlers.erase( it++ );
+        entry->first->OnStreamEvent( IncomingMsgHandler::Timeout, 0,
+                                     Status( stError, errOperationExpired ) );
+        pHandlers.Erase( sid );
       }
-      else
-        ++it;
     }
   }
 }
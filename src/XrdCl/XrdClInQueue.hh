@@ -20,7 +20,8 @@
 #define __XRD_CL_IN_QUEUE_HH__
 
 #include <XrdSys/XrdSysPthread.hh>
-#include <map>
+#include <stdint.h>
+#include <string.h>
 #include <utility>
 #include "XrdCl/XrdClStatus.hh"
 #include "XrdCl/XrdClPostMasterInterfaces.hh"
@@ -29,6 +30,120 @@ namespace XrdCl
 {
   class Message;
 
+  //----------------------------------------------------------------------------
+  //! A map from 16-bit stream IDs to values. The values are kept in pages
+  //! of 256 slots, allocated on first use, each with an occupancy bitmap,
+  //! so lookups are two array indexations and iteration skips empty pages.
+  //----------------------------------------------------------------------------
+  template<typename T>
+  class SIDMap
+  {
+    public:
+      SIDMap()
+      {
+        memset( pPages, 0, sizeof( pPages ) );
+      }
+
+      ~SIDMap()
+      {
+        for( uint32_t i = 0; i < NumPages; ++i )
+          delete pPages[i];
+      }
+
+      //------------------------------------------------------------------------
+      //! Find the value for the sid or 0 if there is none
+      //------------------------------------------------------------------------
+      T *Find( uint16_t sid )
+      {
+        Page *page = pPages[sid >> 8];
+        if( !page || !( page->bits[(sid & 0xff) >> 6] & Bit( sid ) ) )
+          return 0;
+        return &page->slots[sid & 0xff];
+      }
+
+      //------------------------------------------------------------------------
+      //! Insert or overwrite the value for the sid
+      //------------------------------------------------------------------------
+      void Insert( uint16_t sid, const T &value )
+      {
+        Page *&page = pPages[sid >> 8];
+        if( !page )
+          page = new Page();
+        uint64_t &word = page->bits[(sid & 0xff) >> 6];
+        if( !( word & Bit( sid ) ) )
+        {
+          word |= Bit( sid );
+          ++page->count;
+        }
+        page->slots[sid & 0xff] = value;
+      }
+
+      //------------------------------------------------------------------------
+      //! Remove the value for the sid, if any
+      //------------------------------------------------------------------------
+      void Erase( uint16_t sid )
+      {
+        Page *page = pPages[sid >> 8];
+        if( !page )
+          return;
+        uint64_t &word = page->bits[(sid & 0xff) >> 6];
+        if( word & Bit( sid ) )
+        {
+          word &= ~Bit( sid );
+          --page->count;
+        }
+      }
+
+      //------------------------------------------------------------------------
+      //! Find the lowest sid in use that is not smaller than sid. Erasing or
+      //! inserting values while iterating this way is safe.
+      //!
+      //! @return true if found, false otherwise
+      //------------------------------------------------------------------------
+      bool Next( uint32_t &sid ) const
+      {
+        for( ; sid < NumPages * 256; sid = ( sid & ~0xffu ) + 256 )
+        {
+          const Page *page = pPages[sid >> 8];
+          if( !page || !page->count )
+            continue;
+          for( uint32_t w = ( sid & 0xff ) >> 6; w < 4; ++w )
+          {
+            uint64_t word = page->bits[w];
+            if( w == ( ( sid & 0xff ) >> 6 ) )
+              word &= ~( Bit( sid ) - 1 );
+            if( word )
+            {
+              sid = ( sid & ~0xffu ) + w * 64 + __builtin_ctzll( word );
+              return true;
+            }
+          }
+        }
+        return false;
+      }
+
+    private:
+      SIDMap( const SIDMap & );
+      SIDMap &operator=( const SIDMap & );
+
+      static uint64_t Bit( uint32_t sid )
+      {
+        return (uint64_t)1 << ( sid & 63 );
+      }
+
+      static const uint32_t NumPages = 256;
+
+      struct Page
+      {
+        Page(): count( 0 ) { memset( bits, 0, sizeof( bits ) ); }
+        uint64_t bits[4];
+        uint32_t count;
+        T        slots[256];
+      };
+
+      Page *pPages[NumPages];
+  };
+
   //----------------------------------------------------------------------------
   //! A synchronize queue for incoming data
   //----------------------------------------------------------------------------
@@ -99,8 +214,8 @@ namespace XrdCl
       bool DiscardMessage(Message* msg, uint16_t& sid) const;
 
       typedef std::pair<IncomingMsgHandler *, time_t> HandlerAndExpire;
-      typedef std::map<uint16_t, HandlerAndExpire> HandlerMap;
-      typedef std::map<uint16_t, Message*> MessageMap;
+      typedef SIDMap<HandlerAndExpire> HandlerMap;
+      typedef SIDMap<Message*> MessageMap;
       MessageMap pMessages;
       HandlerMap pHandlers;
       XrdSysRecMutex pMutex;
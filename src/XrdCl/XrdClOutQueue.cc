@@ -21,6 +21,21 @@
 
 namespace XrdCl
 {
+  //----------------------------------------------------------------------------
+  // Make room for at least one more element
+  //----------------------------------------------------------------------------
+  void OutQueue::Reserve()
+  {
+    if( pCount < pRing.size() )
+      return;
+
+    MessageRing ring( pRing.empty() ? 16 : pRing.size() * 2 );
+    for( uint32_t i = 0; i < pCount; ++i )
+      ring[i] = At( i );
+    pRing.swap( ring );
+    pHead = 0;
+  }
+
   //----------------------------------------------------------------------------
   // Add a message to the back of the queue
   //----------------------------------------------------------------------------
@@ -29,7 +44,8 @@ namespace XrdCl
                            time_t                expires,
                            bool                  stateful )
   {
-    pMessages.push_back( MsgHelper( msg, handler, expires, stateful ) );
+    Reserve();
+    At( pCount++ ) = MsgHelper( msg, handler, expires, stateful );
   }
 
   //----------------------------------------------------------------------------
@@ -40,7 +56,10 @@ namespace XrdCl
                             time_t                expires,
                             bool                  stateful )
   {
-    pMessages.push_front( MsgHelper( msg, handler, expires, stateful ) );
+    Reserve();
+    pHead = ( pHead - 1 ) & ( pRing.size() - 1 );
+    ++pCount;
+    At( 0 ) = MsgHelper( msg, handler, expires, stateful );
   }
 
   //----------------------------------------------------------------------------
@@ -50,15 +69,16 @@ namespace XrdCl
                                  time_t                &expires,
                                  bool                  &stateful )
   {
-    if( pMessages.empty() )
+    if( !pCount )
       return 0;
 
-    MsgHelper  m = pMessages.front();
+    MsgHelper &m = At( 0 );
     handler  = m.handler;
     expires  = m.expires;
     stateful = m.stateful;
-    pMessages.pop_front();
-    return m.msg;
+    Message *msg = m.msg;
+    PopFront();
+    return msg;
   }
 
   //----------------------------------------------------------------------------
@@ -66,7 +86,10 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void OutQueue::PopFront()
   {
-    pMessages.pop_front();
+    if( !pCount )
+      return;
+    pHead = ( pHead + 1 ) & ( pRing.size() - 1 );
+    --pCount;
   }
 
   //----------------------------------------------------------------------------
@@ -74,9 +97,8 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void OutQueue::Report( Status status )
   {
-    MessageList::iterator it;
-    for( it = pMessages.begin(); it != pMessages.end(); ++it )
-      it->handler->OnStatusReady( it->msg, status );
+    for( uint32_t i = 0; i < pCount; ++i )
+      At( i ).handler->OnStatusReady( At( i ).msg, status );
   }
 
   //------------------------------------------------------------------------
@@ -85,30 +107,73 @@ namespace XrdCl
   uint64_t OutQueue::GetSizeStateless() const
   {
     uint64_t size = 0;
-    MessageList::const_iterator it;
-    for( it = pMessages.begin(); it != pMessages.end(); ++it )
-      if( !it->stateful )
+    for( uint32_t i = 0; i < pCount; ++i )
+      if( !At( i ).stateful )
         ++size;
     return size;
   }
 
   //----------------------------------------------------------------------------
-  // Remove all the expired messages from the queue and put them in
-  // this one
+  // Move the matching elements of the queue to the back of this one
   //----------------------------------------------------------------------------
-  void OutQueue::GrabExpired( OutQueue &queue, time_t exp )
+  template<typename Pred>
+  void OutQueue::GrabIf( OutQueue &queue, Pred pred )
   {
-    MessageList::iterator it;
-    for( it = queue.pMessages.begin(); it != queue.pMessages.end(); )
+    uint32_t kept = 0;
+    for( uint32_t i = 0; i < queue.pCount; ++i )
     {
-      if( it->expires > exp )
+      MsgHelper &m = queue.At( i );
+      if( pred( m ) )
       {
-        ++it;
-        continue;
+        Reserve();
+        At( pCount++ ) = m;
+      }
+      else
+      {
+        if( kept != i )
+          queue.At( kept ) = m;
+        ++kept;
       }
-      pMessages.push_back( *it );
-      it = queue.pMessages.erase( it );
     }
+    queue.pCount = kept;
+  }
+
+  namespace
+  {
+    struct IsExpired
+    {
+      IsExpired( time_t e ): exp( e ) {}
+      template<typename T> bool operator()( const T &m ) const
+      {
+        return m.expires <= exp;
+      }
+      time_t exp;
+    };
+
+    struct IsStateful
+    {
+      template<typename T> bool operator()( const T &m ) const
+      {
+        return m.stateful;
+      }
+    };
+
+    struct IsAny
+    {
+      template<typename T> bool operator()( const T & ) const
+      {
+        return true;
+      }
+    };
+  }
+
+  //----------------------------------------------------------------------------
+  // Remove all the expired messages from the queue and put them in
+  // this one
+  //----------------------------------------------------------------------------
+  void OutQueue::GrabExpired( OutQueue &queue, time_t exp )
+  {
+    GrabIf( queue, IsExpired( exp ) );
   }
 
   //----------------------------------------------------------------------------
@@ -117,17 +182,7 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void OutQueue::GrabStateful( OutQueue &queue )
   {
-    MessageList::iterator it;
-    for( it = queue.pMessages.begin(); it != queue.pMessages.end(); )
-    {
-      if( !it->stateful )
-      {
-        ++it;
-        continue;
-      }
-      pMessages.push_back( *it );
-      it = queue.pMessages.erase( it );
-    }
+    GrabIf( queue, IsStateful() );
   }
 
   //----------------------------------------------------------------------------
@@ -135,10 +190,6 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void OutQueue::GrabItems( OutQueue &queue )
   {
-    MessageList::iterator it;
-    for( it = queue.pMessages.begin(); it != queue.pMessages.end(); ++it )
-      pMessages.push_back( *it );
-    queue.pMessages.clear();
+    GrabIf( queue, IsAny() );
   }
 }
-
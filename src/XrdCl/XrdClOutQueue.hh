@@ -19,7 +19,7 @@
 #ifndef __XRD_CL_OUT_QUEUE_HH__
 #define __XRD_CL_OUT_QUEUE_HH__
 
-#include <list>
+#include <vector>
 #include <utility>
 #include "XrdCl/XrdClStatus.hh"
 
@@ -29,11 +29,17 @@ namespace XrdCl
   class OutgoingMsgHandler;
 
   //----------------------------------------------------------------------------
-  //! A synchronized queue for the outgoing data
+  //! A synchronized queue for the outgoing data, kept in a ring buffer that
+  //! grows by doubling and is never shrunk
   //----------------------------------------------------------------------------
   class OutQueue
   {
     public:
+      //------------------------------------------------------------------------
+      //! Constructor
+      //------------------------------------------------------------------------
+      OutQueue(): pHead( 0 ), pCount( 0 ) {}
+
       //------------------------------------------------------------------------
       //! Add a message to the back the queue
       //!
@@ -90,7 +96,7 @@ namespace XrdCl
       //------------------------------------------------------------------------
       bool IsEmpty() const
       {
-        return pMessages.empty();
+        return pCount == 0;
       }
 
       //------------------------------------------------------------------------
@@ -98,7 +104,7 @@ namespace XrdCl
       //------------------------------------------------------------------------
       uint64_t GetSize() const
       {
-        return pMessages.size();
+        return pCount;
       }
 
       //------------------------------------------------------------------------
@@ -136,6 +142,7 @@ namespace XrdCl
       //------------------------------------------------------------------------
       struct MsgHelper
       {
+        MsgHelper(): msg( 0 ), handler( 0 ), expires( 0 ), stateful( false ) {}
         MsgHelper( Message *m, OutgoingMsgHandler *h, time_t r, bool s ):
           msg( m ), handler( h ), expires( r ), stateful( s ) {}
 
@@ -145,8 +152,35 @@ namespace XrdCl
         bool                  stateful;
       };
 
-      typedef std::list<MsgHelper> MessageList;
-      MessageList pMessages;
+      //------------------------------------------------------------------------
+      //! Access the n-th element counting from the front
+      //------------------------------------------------------------------------
+      MsgHelper &At( uint32_t n )
+      {
+        return pRing[( pHead + n ) & ( pRing.size() - 1 )];
+      }
+
+      const MsgHelper &At( uint32_t n ) const
+      {
+        return pRing[( pHead + n ) & ( pRing.size() - 1 )];
+      }
+
+      //------------------------------------------------------------------------
+      //! Make room for at least one more element
+      //------------------------------------------------------------------------
+      void Reserve();
+
+      //------------------------------------------------------------------------
+      //! Move the elements of queue for which pred is true to the back of
+      //! this queue, preserving the order of both
+      //------------------------------------------------------------------------
+      template<typename Pred>
+      void GrabIf( OutQueue &queue, Pred pred );
+
+      typedef std::vector<MsgHelper> MessageRing;
+      MessageRing pRing;     //!< capacity is always a power of two
+      uint32_t    pHead;
+      uint32_t    pCount;
   };
 }
 
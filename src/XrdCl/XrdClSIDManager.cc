@@ -30,12 +30,17 @@ namespace XrdCl
     uint16_t allocSID = 1;
 
     //--------------------------------------------------------------------------
-    // Get a SID from the list of free SIDs if it's not empty
+    // Get the lowest free SID if there is one
     //--------------------------------------------------------------------------
-    if( !pFreeSIDs.empty() )
+    if( pNumFree )
     {
-      allocSID = pFreeSIDs.front();
-      pFreeSIDs.pop_front();
+      uint32_t i = pFreeHint;
+      while( !pFreeSIDs[i] ) ++i;
+      uint64_t word = pFreeSIDs[i];
+      allocSID      = i * WordBits + __builtin_ctzll( word );
+      pFreeSIDs[i]  = word & ( word - 1 );
+      pFreeHint     = i;
+      --pNumFree;
     }
     //--------------------------------------------------------------------------
     // Allocate a new SID if possible
@@ -51,6 +56,21 @@ namespace XrdCl
     return Status();
   }
 
+  //----------------------------------------------------------------------------
+  // Mark a SID as free, the caller must hold the lock
+  //----------------------------------------------------------------------------
+  void SIDManager::Free( uint16_t sid )
+  {
+    uint32_t i   = sid / WordBits;
+    uint64_t bit = (uint64_t)1 << ( sid % WordBits );
+    if( pFreeSIDs[i] & bit )
+      return;
+    pFreeSIDs[i] |= bit;
+    ++pNumFree;
+    if( i < pFreeHint )
+      pFreeHint = i;
+  }
+
   //----------------------------------------------------------------------------
   // Release the SID that is no longer needed
   //----------------------------------------------------------------------------
@@ -59,7 +79,7 @@ namespace XrdCl
     XrdSysMutexHelper scopedLock( pMutex );
     uint16_t relSID = 0;
     memcpy( &relSID, sid, 2 );
-    pFreeSIDs.push_back( relSID );
+    Free( relSID );
   }
 
   //----------------------------------------------------------------------------
@@ -70,7 +90,12 @@ namespace XrdCl
     XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    pTimeOutSIDs.insert( tiSID );
+    uint64_t bit = (uint64_t)1 << ( tiSID % WordBits );
+    if( !( pTimeOutSIDs[tiSID / WordBits] & bit ) )
+    {
+      pTimeOutSIDs[tiSID / WordBits] |= bit;
+      ++pNumTimedOut;
+    }
   }
 
   //----------------------------------------------------------------------------
@@ -81,10 +106,7 @@ namespace XrdCl
     XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    std::set<uint16_t>::iterator it = pTimeOutSIDs.find( tiSID );
-    if( it != pTimeOutSIDs.end() )
-      return true;
-    return false;
+    return pTimeOutSIDs[tiSID / WordBits] & ( (uint64_t)1 << ( tiSID % WordBits ) );
   }
 
   //----------------------------------------------------------------------------
@@ -95,8 +117,13 @@ namespace XrdCl
     XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    pTimeOutSIDs.erase( tiSID );
-    pFreeSIDs.push_back( tiSID );
+    uint64_t bit = (uint64_t)1 << ( tiSID % WordBits );
+    if( pTimeOutSIDs[tiSID / WordBits] & bit )
+    {
+      pTimeOutSIDs[tiSID / WordBits] &= ~bit;
+      --pNumTimedOut;
+    }
+    Free( tiSID );
   }
 
   //------------------------------------------------------------------------
@@ -105,10 +132,21 @@ namespace XrdCl
   void SIDManager::ReleaseAllTimedOut()
   {
     XrdSysMutexHelper scopedLock( pMutex );
-    std::set<uint16_t>::iterator it;
-    for( it = pTimeOutSIDs.begin(); it != pTimeOutSIDs.end(); ++it )
-      pFreeSIDs.push_back( *it );
-    pTimeOutSIDs.clear();
+    if( !pNumTimedOut )
+      return;
+
+    for( uint32_t i = 0; i < NumWords; ++i )
+    {
+      uint64_t word = pTimeOutSIDs[i];
+      if( !word )
+        continue;
+      pNumFree      += __builtin_popcountll( word & ~pFreeSIDs[i] );
+      pFreeSIDs[i]  |= word;
+      pTimeOutSIDs[i] = 0;
+      if( i < pFreeHint )
+        pFreeHint = i;
+    }
+    pNumTimedOut = 0;
   }
 
   //----------------------------------------------------------------------------
@@ -117,6 +155,6 @@ namespace XrdCl
   uint16_t SIDManager::GetNumberOfAllocatedSIDs() const
   {
     XrdSysMutexHelper scopedLock( pMutex );
-    return pSIDCeiling - pFreeSIDs.size() - pTimeOutSIDs.size() - 1;
+    return pSIDCeiling - pNumFree - pNumTimedOut - 1;
   }
 }
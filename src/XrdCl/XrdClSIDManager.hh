@@ -19,9 +19,8 @@
 #ifndef __XRD_CL_SID_MANAGER_HH__
 #define __XRD_CL_SID_MANAGER_HH__
 
-#include <list>
-#include <set>
 #include <stdint.h>
+#include <string.h>
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdCl/XrdClStatus.hh"
 
@@ -29,6 +28,10 @@ namespace XrdCl
 {
   //----------------------------------------------------------------------------
   //! Handle XRootD stream IDs
+  //!
+  //! SIDs are dense 16-bit values, so the free and timed out sets are kept
+  //! as bitmaps. Freed SIDs are reused lowest first, which keeps the set of
+  //! SIDs in flight compact.
   //----------------------------------------------------------------------------
   class SIDManager
   {
@@ -37,7 +40,11 @@ namespace XrdCl
       //------------------------------------------------------------------------
       //! Constructor
       //------------------------------------------------------------------------
-      SIDManager(): pSIDCeiling(1) {}
+      SIDManager(): pSIDCeiling(1), pNumFree(0), pNumTimedOut(0), pFreeHint(0)
+      {
+        memset( pFreeSIDs,    0, sizeof( pFreeSIDs ) );
+        memset( pTimeOutSIDs, 0, sizeof( pTimeOutSIDs ) );
+      }
 
       //------------------------------------------------------------------------
       //! Allocate a SID
@@ -78,7 +85,7 @@ namespace XrdCl
       uint32_t NumberOfTimedOutSIDs() const
       {
         XrdSysMutexHelper scopedLock( pMutex );
-        return pTimeOutSIDs.size();
+        return pNumTimedOut;
       }
 
       //------------------------------------------------------------------------
@@ -87,9 +94,20 @@ namespace XrdCl
       uint16_t GetNumberOfAllocatedSIDs() const;
 
     private:
-      std::list<uint16_t>  pFreeSIDs;
-      std::set<uint16_t>   pTimeOutSIDs;
+      static const uint32_t WordBits = 64;
+      static const uint32_t NumWords = 65536 / WordBits;
+
+      //------------------------------------------------------------------------
+      //! Mark a SID as free
+      //------------------------------------------------------------------------
+      void Free( uint16_t sid );
+
+      uint64_t             pFreeSIDs[NumWords];
+      uint64_t             pTimeOutSIDs[NumWords];
       uint16_t             pSIDCeiling;
+      uint16_t             pNumFree;
+      uint16_t             pNumTimedOut;
+      uint16_t             pFreeHint;      //!< lowest word that may be free
       mutable XrdSysMutex  pMutex;
   };
 }
@@ -27,8 +27,10 @@
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClConstants.hh"
+#include "XrdCl/XrdClUtils.hh"
 
 #include <algorithm>
+#include <sstream>
 
 namespace XrdCl
 {
@@ -37,7 +39,7 @@ XCpCtx::XCpCtx( const std::vector<std::string> &urls, uint64_t blockSize, uint8_
       pUrls( std::deque<std::string>( urls.begin(), urls.end() ) ), pBlockSize( blockSize ),
       pParallelSrc( parallelSrc ), pChunkSize( chunkSize ), pParallelChunks( parallelChunks ),
       pOffset( 0 ), pFileSize( -1 ), pFileSizeCV( 0 ), pDataReceived( 0 ), pDone( false ),
-      pDoneCV( 0 ), pRefCount( 1 )
+      pDoneCV( 0 ), pRefCount( 1 ), pDuplicates( 0 )
 {
   SetFileSize( fileSize );
 }
@@ -84,11 +86,109 @@ XCpSrc* XCpCtx::WeakestLink( XCpSrc *exclude )
   return ret;
 }
 
+XCpSrc* XCpCtx::SlowestLink( XCpSrc *exclude )
+{
+  // take a reference to each candidate so we can query
+  // them without holding our own lock (the sources lock
+  // themselves and may call us while doing so)
+  std::vector<XCpSrc*> sources;
+  {
+    XrdSysMutexHelper lck( pMtx );
+    std::list<XCpSrc*>::iterator itr;
+    for( itr = pSources.begin() ; itr != pSources.end() ; ++itr )
+      if( *itr != exclude && (*itr)->IsRunning() )
+        sources.push_back( (*itr)->Self() );
+  }
+
+  uint64_t transferRate = -1; // set transferRate to max uint64 value
+  XCpSrc *ret = 0;
+
+  std::vector<XCpSrc*>::iterator itr;
+  for( itr = sources.begin() ; itr != sources.end() ; ++itr )
+  {
+    XCpSrc *src = *itr;
+    uint64_t tmp = src->TransferRate();
+    if( src->HasOngoing() && tmp < transferRate )
+    {
+      ret = src;
+      transferRate = tmp;
+    }
+  }
+
+  for( itr = sources.begin() ; itr != sources.end() ; ++itr )
+    if( *itr != ret ) (*itr)->Delete();
+
+  return ret;
+}
+
 void XCpCtx::PutChunk( ChunkInfo* chunk )
 {
+  if( chunk )
+  {
+    // a chunk that has been requested from two sources
+    // is only passed on the first time it arrives
+    XrdSysMutexHelper lck( pMtx );
+    std::map<uint64_t, bool>::iterator itr = pSpeculative.find( chunk->offset );
+    if( itr != pSpeculative.end() )
+    {
+      if( itr->second )
+      {
+        ++pDuplicates;
+        lck.UnLock();
+        XCpSrc::DeleteChunk( chunk );
+        return;
+      }
+      itr->second = true;
+    }
+  }
+
   pSink.Put( chunk );
 }
 
+bool XCpCtx::RegisterSpeculative( uint64_t offset, const std::string &host )
+{
+  XrdSysMutexHelper lck( pMtx );
+  if( !pSpeculative.insert( std::make_pair( offset, false ) ).second )
+    return false;
+  ++pStats[host].speculative;
+  return true;
+}
+
+void XCpCtx::UpdateStats( const std::string &host, uint64_t bytes, uint64_t rate,
+                          uint32_t chunk, uint64_t window, double rtt )
+{
+  XrdSysMutexHelper lck( pMtx );
+  SrcStats &stats = pStats[host];
+  stats.bytes  += bytes;
+  stats.chunks += 1;
+  stats.rate    = rate;
+  stats.chunk   = chunk;
+  stats.window  = window;
+  stats.rtt     = rtt;
+}
+
+std::string XCpCtx::GetStats()
+{
+  XrdSysMutexHelper lck( pMtx );
+  std::ostringstream o;
+
+  std::map<std::string, SrcStats>::iterator itr;
+  for( itr = pStats.begin() ; itr != pStats.end() ; ++itr )
+  {
+    SrcStats &s = itr->second;
+    o << "[xcp] " << itr->first << ": ";
+    o << Utils::BytesToString( s.bytes ) << "B in " << s.chunks << " chunks, ";
+    o << Utils::BytesToString( s.rate ) << "B/s, ";
+    o << "chunk " << Utils::BytesToString( s.chunk ) << "B, ";
+    o << "window " << Utils::BytesToString( s.window ) << "B, ";
+    o << "rtt " << uint64_t( s.rtt * 1000000 ) / 1000.0 << "ms, ";
+    o << s.speculative << " speculative\n";
+  }
+  o << "[xcp] duplicate chunks discarded: " << pDuplicates << "\n";
+
+  return o.str();
+}
+
 std::pair<uint64_t, uint64_t> XCpCtx::GetBlock()
 {
   XrdSysMutexHelper lck( pMtx );
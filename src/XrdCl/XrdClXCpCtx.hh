@@ -31,6 +31,8 @@
 
 #include <stdint.h>
 #include <iostream>
+#include <map>
+#include <string>
 
 namespace XrdCl
 {
@@ -100,12 +102,64 @@ class XCpCtx
     XCpSrc* WeakestLink( XCpSrc *exclude );
 
     /**
-     * Put a chunk into the sink
+     * Get the slowest running source that still has
+     * ongoing chunks
+     *
+     * @param exclude : the source that is excluded from the
+     *                  search
+     * @return        : the slowest source, the caller has to
+     *                  release it with Delete()
+     */
+    XCpSrc* SlowestLink( XCpSrc *exclude );
+
+    /**
+     * Put a chunk into the sink, chunks that have been
+     * requested speculatively are only passed on once
      *
      * @param chunk : the chunk
      */
     void PutChunk( ChunkInfo* chunk );
 
+    /**
+     * Register a chunk that is about to be requested speculatively
+     * from a second source
+     *
+     * @param offset : the chunk offset
+     * @param host   : host id of the source making the request
+     * @return       : true if the chunk may be requested, false if
+     *                 it has already been requested speculatively
+     */
+    bool RegisterSpeculative( uint64_t offset, const std::string &host );
+
+    /**
+     * Update the statistics of a source
+     *
+     * @param host   : the source host id
+     * @param bytes  : number of bytes delivered
+     * @param rate   : current bottleneck rate estimate [B/s]
+     * @param chunk  : current chunk size
+     * @param window : current in-flight window
+     * @param rtt    : current round trip time estimate [s]
+     */
+    void UpdateStats( const std::string &host, uint64_t bytes, uint64_t rate,
+                      uint32_t chunk, uint64_t window, double rtt );
+
+    /**
+     * Get a human readable summary of per source statistics
+     *
+     * @return : one line per source
+     */
+    std::string GetStats();
+
+    /**
+     * @return : true if all blocks have been given out
+     */
+    bool AllAllocated()
+    {
+      XrdSysMutexHelper lck( pMtx );
+      return pFileSize >= 0 && pOffset >= uint64_t( pFileSize );
+    }
+
     /**
      * Get next block that has to be transfered
      *
@@ -298,6 +352,39 @@ class XCpCtx
      * Reference counter
      */
     size_t                     pRefCount;
+
+    /**
+     * Chunks that have been requested from a second source
+     * (the offset is the key, the value is true once the first
+     * copy has been passed on)
+     */
+    std::map<uint64_t, bool>   pSpeculative;
+
+    /**
+     * Number of speculative copies that have been discarded
+     */
+    uint64_t                   pDuplicates;
+
+    /**
+     * Per source statistics
+     */
+    struct SrcStats
+    {
+      SrcStats() : bytes( 0 ), chunks( 0 ), rate( 0 ), chunk( 0 ),
+                   window( 0 ), rtt( 0 ), speculative( 0 ) { }
+      uint64_t bytes;
+      uint64_t chunks;
+      uint64_t rate;
+      uint32_t chunk;
+      uint64_t window;
+      double   rtt;
+      uint64_t speculative;
+    };
+
+    /**
+     * Statistics keyed by source host id
+     */
+    std::map<std::string, SrcStats> pStats;
 };
 
 } /* namespace XrdCl */
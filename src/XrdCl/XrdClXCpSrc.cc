@@ -28,12 +28,151 @@
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdCl/XrdClConstants.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <sys/time.h>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Parameters of the delivery model
+  //----------------------------------------------------------------------------
+  const double   kWindowGain     = 2.0;     // in-flight window = gain * BDP
+  const uint32_t kMinChunk       = 1048576; // smallest adaptive chunk
+  const uint32_t kChunkAlign     = 65536;   // chunk size granularity
+  const double   kMinRtt         = 0.0005;  // floor of the rtt estimate [s]
+  const double   kRttExpiry      = 10.0;    // re-probe the rtt that often [s]
+  const double   kSpecRateRatio  = 1.5;     // speculate if that much faster
+  const double   kSpecOverdue    = 4.0;     // or if overdue by that factor
+
+  double Now()
+  {
+    timeval tv;
+    gettimeofday( &tv, 0 );
+    return tv.tv_sec + tv.tv_usec / 1e6;
+  }
+}
 
 namespace XrdCl
 {
 
+XCpDeliveryModel::XCpDeliveryModel( uint32_t chunkSize, uint8_t parallel ) :
+  pChunkSize( chunkSize ), pParallel( parallel ), pDelivered( 0 )
+{
+  Reset();
+}
+
+void XCpDeliveryModel::Reset()
+{
+  pIssued.clear();
+  pLastDelivery = 0;
+  pSampleIdx    = 0;
+  pNbSamples    = 0;
+  pMinLatency   = 0;
+  pMinStamp     = 0;
+  pProbing      = false;
+  pBtlBw        = 0;
+  pRtProp       = 0;
+  pCurChunk     = pChunkSize;
+  pWindow       = uint64_t( pChunkSize ) * pParallel;
+}
+
+void XCpDeliveryModel::Issued( uint64_t offset, uint64_t ahead, double now )
+{
+  // with nothing in flight the delivery clock starts over,
+  // otherwise idle time would be taken for slow delivery
+  if( !ahead || !pLastDelivery ) pLastDelivery = now;
+
+  IssueInfo info;
+  info.time      = now;
+  info.delivered = pDelivered;
+  info.since     = pLastDelivery;
+  info.ahead     = ahead;
+  pIssued[offset] = info;
+}
+
+void XCpDeliveryModel::Cancelled( uint64_t offset )
+{
+  pIssued.erase( offset );
+}
+
+void XCpDeliveryModel::Delivered( uint64_t offset, uint64_t length, double now )
+{
+  pDelivered   += length;
+  pLastDelivery = now;
+
+  std::map<uint64_t, IssueInfo>::iterator itr = pIssued.find( offset );
+  if( itr == pIssued.end() ) return;
+  IssueInfo info = itr->second;
+  pIssued.erase( itr );
+
+  double elapsed = now - info.time;
+  double since   = now - info.since;
+  if( elapsed <= 0 || since <= 0 ) return;
+
+  // the delivery rate is the amount of data delivered while this chunk
+  // was outstanding over the time since the delivery preceding its
+  // request (as in BBR, so a full pipeline is measured at its rate and
+  // not at its latency), the bottleneck rate is the maximum of the
+  // recent samples
+  pRateSamples[pSampleIdx] = double( pDelivered - info.delivered ) / since;
+  uint64_t btlBw = 0;
+  size_t nbSamples = std::min( pNbSamples + 1, size_t( kSamples ) );
+  for( size_t i = 0; i < nbSamples; ++i )
+    btlBw = std::max( btlBw, uint64_t( pRateSamples[i] ) );
+  pSampleIdx = ( pSampleIdx + 1 ) % kSamples;
+  pNbSamples = nbSamples;
+  pBtlBw     = btlBw;
+
+  // the round trip time is the smallest latency seen; as long as the
+  // window is full every chunk waits behind the others, so once the
+  // estimate is old we let the pipeline drain (see Window()) and take
+  // the latency of a chunk that had nothing ahead of it
+  if( !pMinStamp || elapsed <= pMinLatency || ( pProbing && !info.ahead ) )
+  {
+    pMinLatency = elapsed;
+    pMinStamp   = now;
+    pProbing    = false;
+  }
+  else if( now - pMinStamp > kRttExpiry )
+    pProbing = true;
+  pRtProp = std::max( pMinLatency, kMinRtt );
+
+  // size the window after the bandwidth delay product and split it
+  // into the configured number of parallel chunks
+  uint32_t minChunk  = std::min( kMinChunk, pChunkSize );
+  uint64_t maxWindow = uint64_t( pChunkSize ) * pParallel * 2;
+  uint64_t window    = uint64_t( kWindowGain * btlBw * pRtProp );
+  window = std::max( window, uint64_t( minChunk ) * 2 );
+  window = std::min( window, maxWindow );
+
+  uint64_t chunk = window / pParallel;
+  chunk = std::max( chunk, uint64_t( minChunk ) );
+  chunk = std::min( chunk, uint64_t( pChunkSize ) );
+  if( chunk > kChunkAlign ) chunk -= chunk % kChunkAlign;
+
+  pWindow   = window;
+  pCurChunk = uint32_t( chunk );
+}
+
+bool XCpDeliveryModel::Overdue( uint64_t inFlight, double now ) const
+{
+  if( !pBtlBw || pIssued.empty() ) return false;
+
+  double oldest = now;
+  std::map<uint64_t, IssueInfo>::const_iterator itr;
+  for( itr = pIssued.begin() ; itr != pIssued.end() ; ++itr )
+    oldest = std::min( oldest, itr->second.time );
+  double expected = pRtProp + double( inFlight ) / pBtlBw;
+  return now - oldest > kSpecOverdue * expected;
+}
+
+bool XCpDeliveryModel::Outpaces( const XCpDeliveryModel &other ) const
+{
+  return pBtlBw > 0 && double( pBtlBw ) > kSpecRateRatio * double( other.pBtlBw );
+}
+
 class ChunkHandler: public ResponseHandler
 {
   public:
@@ -94,7 +233,7 @@ class ChunkHandler: public ResponseHandler
 XCpSrc::XCpSrc( uint32_t chunkSize, uint8_t parallel, int64_t fileSize, XCpCtx *ctx ) :
   pChunkSize( chunkSize ), pParallel( parallel ), pFileSize( fileSize ), pThread(),
   pCtx( ctx->Self() ), pFile( 0 ), pCurrentOffset( 0 ), pBlkEnd( 0 ), pDataTransfered( 0 ), pRefCount( 1 ),
-  pRunning( false ), pStartTime( 0 ), pTransferTime( 0 )
+  pRunning( false ), pStartTime( 0 ), pTransferTime( 0 ), pModel( chunkSize, parallel )
 {
 
 }
@@ -255,6 +394,8 @@ XRootDStatus XCpSrc::Initialize()
   }
   while( !st.IsOK() );
 
+  pHost = URL( pUrl ).GetHostId();
+
   std::pair<uint64_t, uint64_t> p = pCtx->GetBlock();
   pCurrentOffset = p.first;
   pBlkEnd        = p.second + p.first;
@@ -292,14 +433,18 @@ XRootDStatus XCpSrc::Recover()
   }
   while( !st.IsOK() );
 
+  pHost = URL( pUrl ).GetHostId();
+
   pRecovered.insert( pOngoing.begin(), pOngoing.end() );
   pOngoing.clear();
 
   // since we have a brand new source, we need
-  // to restart transfer rate statistics
+  // to restart transfer rate statistics and
+  // the delivery model
   pTransferTime   = 0;
   pStartTime      = time( 0 );
   pDataTransfered = 0;
+  pModel.Reset();
 
   return st;
 }
@@ -308,43 +453,37 @@ XRootDStatus XCpSrc::ReadChunks()
 {
   XrdSysMutexHelper lck( pMtx );
 
-  while( pOngoing.size() < pParallel && !pRecovered.empty() )
+  // the number of bytes in flight is bounded by our window,
+  // but we always keep at least one chunk in flight and never
+  // more than twice the configured number of parallel chunks
+  uint64_t inFlight = InFlight();
+  size_t   maxCount = size_t( pParallel ) * 2;
+
+  while( !pRecovered.empty() && pOngoing.size() < maxCount &&
+         ( pOngoing.empty() || inFlight < pModel.Window() ) )
   {
     std::pair<uint64_t, uint64_t> p;
     std::map<uint64_t, uint64_t>::iterator itr = pRecovered.begin();
     p = *itr;
-    pOngoing.insert( p );
     pRecovered.erase( itr );
 
-    char *buffer = new char[p.second];
-    ChunkHandler *handler = new ChunkHandler( this, p.first, p.second, buffer, pFile );
-    XRootDStatus st = pFile->Read( p.first, p.second, buffer, handler );
-    if( !st.IsOK() )
-    {
-      delete[] buffer;
-      delete   handler;
-      ReportResponse( new XRootDStatus( st ), 0, pFile );
-      return st;
-    }
+    XRootDStatus st = ReadChunk( p.first, p.second );
+    if( !st.IsOK() ) return st;
+    inFlight += p.second;
   }
 
-  while( pOngoing.size() < pParallel && pCurrentOffset < pBlkEnd )
+  while( pCurrentOffset < pBlkEnd && pOngoing.size() < maxCount &&
+         ( pOngoing.empty() || inFlight < pModel.Window() ) )
   {
-    uint64_t chunkSize = pChunkSize;
+    uint64_t chunkSize = pModel.ChunkSize();
     if( pCurrentOffset + chunkSize > pBlkEnd )
       chunkSize = pBlkEnd - pCurrentOffset;
-    pOngoing[pCurrentOffset] = chunkSize;
-    char *buffer = new char[chunkSize];
-    ChunkHandler *handler = new ChunkHandler( this, pCurrentOffset, chunkSize, buffer, pFile );
-    XRootDStatus st = pFile->Read( pCurrentOffset, chunkSize, buffer, handler );
+    uint64_t offset = pCurrentOffset;
     pCurrentOffset += chunkSize;
-    if( !st.IsOK() )
-    {
-      delete[] buffer;
-      delete   handler;
-      ReportResponse( new XRootDStatus( st ), 0, pFile );
-      return st;
-    }
+
+    XRootDStatus st = ReadChunk( offset, chunkSize );
+    if( !st.IsOK() ) return st;
+    inFlight += chunkSize;
   }
 
   if( pOngoing.empty() ) return XRootDStatus( stOK, suDone );
@@ -354,6 +493,33 @@ XRootDStatus XCpSrc::ReadChunks()
   return XRootDStatus( stOK, suContinue );
 }
 
+XRootDStatus XCpSrc::ReadChunk( uint64_t offset, uint64_t size )
+{
+  pModel.Issued( offset, InFlight(), Now() );
+  pOngoing[offset] = size;
+
+  char *buffer = new char[size];
+  ChunkHandler *handler = new ChunkHandler( this, offset, size, buffer, pFile );
+  XRootDStatus st = pFile->Read( offset, size, buffer, handler );
+  if( !st.IsOK() )
+  {
+    delete[] buffer;
+    delete   handler;
+    pModel.Cancelled( offset );
+    ReportResponse( new XRootDStatus( st ), 0, pFile );
+  }
+  return st;
+}
+
+uint64_t XCpSrc::InFlight()
+{
+  uint64_t inFlight = 0;
+  std::map<uint64_t, uint64_t>::iterator itr;
+  for( itr = pOngoing.begin() ; itr != pOngoing.end() ; ++itr )
+    inFlight += itr->second;
+  return inFlight;
+}
+
 void XCpSrc::ReportResponse( XRootDStatus *status, ChunkInfo *chunk, File *handle )
 {
   XrdSysMutexHelper lck( pMtx );
@@ -367,6 +533,7 @@ void XCpSrc::ReportResponse( XRootDStatus *status, ChunkInfo *chunk, File *handl
     // response (this could happen due to
     // source change or stealing)
     ignore = !pOngoing.erase( chunk->offset );
+    pModel.Delivered( chunk->offset, chunk->length, Now() );
   }
   else if( FilesEqual( pFile, handle ) )
   {
@@ -398,6 +565,9 @@ void XCpSrc::ReportResponse( XRootDStatus *status, ChunkInfo *chunk, File *handl
     }
   }
 
+  uint64_t btlBw  = pModel.BtlBw(), window = pModel.Window();
+  uint32_t cSize  = pModel.ChunkSize();
+  double   rtProp = pModel.RtProp();
   lck.UnLock();
 
   if( status ) pReports.Put( status );
@@ -411,6 +581,7 @@ void XCpSrc::ReportResponse( XRootDStatus *status, ChunkInfo *chunk, File *handl
   if( chunk )
   {
     pDataTransfered += chunk->length;
+    pCtx->UpdateStats( pHost, chunk->length, btlBw, cSize, window, rtProp );
     pCtx->PutChunk( chunk );
   }
 }
@@ -530,12 +701,72 @@ XRootDStatus XCpSrc::GetWork()
 
   // if we managed to steal something declare success
   if( pCurrentOffset < pBlkEnd || !pRecovered.empty() ) return XRootDStatus();
+
+  // near the end of the transfer (everything has been given out and
+  // there is nothing left to steal) help the slowest source by asking
+  // for its last outstanding chunks as well
+  if( pCtx->AllAllocated() && !HasOngoing() )
+  {
+    XCpSrc *sLink = pCtx->SlowestLink( this );
+    if( sLink )
+    {
+      Speculate( sLink );
+      sLink->Delete();
+    }
+    if( !pRecovered.empty() ) return XRootDStatus();
+  }
+
   // otherwise return an error
   return XRootDStatus( stError, errInvalidOp );
 }
 
+void XCpSrc::Speculate( XCpSrc *src )
+{
+  if( !src || src == this ) return;
+
+  XrdSysMutexHelper lck( pMtx );
+
+  // never block on the other source, it might be trying to lock us
+  if( !src->pMtx.CondLock() ) return;
+
+  size_t count = 0;
+  do
+  {
+    if( !pRunning || !pFile || !src->pRunning || src->pOngoing.empty() ) break;
+
+    // we need to be markedly faster, or the source has to be
+    // long overdue with its oldest chunk
+    if( !pModel.Outpaces( src->pModel ) &&
+        !src->pModel.Overdue( src->InFlight(), Now() ) ) break;
+
+    // duplicate the chunks that will arrive last, as many as fit in our window
+    uint64_t budget = pModel.Window();
+    std::map<uint64_t, uint64_t>::reverse_iterator ritr;
+    for( ritr = src->pOngoing.rbegin() ; ritr != src->pOngoing.rend() ; ++ritr )
+    {
+      if( count && ritr->second > budget ) break;
+      if( !pCtx->RegisterSpeculative( ritr->first, pHost ) ) continue;
+      pRecovered.insert( *ritr );
+      budget -= std::min( budget, ritr->second );
+      ++count;
+    }
+  }
+  while( 0 );
+
+  std::string srcHost = src->pHost;
+  src->pMtx.UnLock();
+
+  if( count )
+  {
+    Log *log = DefaultEnv::GetLog();
+    log->Debug( UtilityMsg, "%s: Speculatively requesting %d chunks of %s",
+                pHost.c_str(), int( count ), srcHost.c_str() );
+  }
+}
+
 uint64_t XCpSrc::TransferRate()
 {
+  if( pModel.BtlBw() ) return pModel.BtlBw();
   time_t duration = pTransferTime + time( 0 ) - pStartTime;
   return pDataTransfered / ( duration + 1 ); // add one to avoid floating point exception
 }
@@ -29,11 +29,198 @@
 #include "XrdCl/XrdClSyncQueue.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
+#include <map>
+
 namespace XrdCl
 {
 
 class XCpCtx;
 
+/**
+ * Model of the delivery path of a single source (after BBR).
+ *
+ * The bottleneck rate is the maximum of the recent delivery rate
+ * samples and the round trip time is the smallest latency of a chunk
+ * seen in the last few seconds; the pipeline is drained now and then
+ * to measure the latency of a chunk with nothing queued ahead of it.
+ * The in-flight window and the chunk size follow from the bandwidth
+ * delay product.
+ *
+ * Times are passed in explicitly (in seconds) and the object does no
+ * locking of its own, the owner has to serialise the calls.
+ */
+class XCpDeliveryModel
+{
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param chunkSize : configured (maximum) chunk size
+     * @param parallel  : number of parallel chunks
+     */
+    XCpDeliveryModel( uint32_t chunkSize, uint8_t parallel );
+
+    /**
+     * Forget everything learned so far (e.g. after a source
+     * has been replaced).
+     */
+    void Reset();
+
+    /**
+     * Record that a chunk has been requested.
+     *
+     * @param offset : chunk offset
+     * @param ahead  : number of bytes in flight ahead of the chunk
+     * @param now    : current time
+     */
+    void Issued( uint64_t offset, uint64_t ahead, double now );
+
+    /**
+     * Forget a chunk that has been requested but will
+     * never be delivered.
+     *
+     * @param offset : chunk offset
+     */
+    void Cancelled( uint64_t offset );
+
+    /**
+     * Update the model with a chunk that has just been delivered.
+     *
+     * @param offset : chunk offset
+     * @param length : chunk size
+     * @param now    : current time
+     */
+    void Delivered( uint64_t offset, uint64_t length, double now );
+
+    /**
+     * @param inFlight : number of bytes in flight
+     * @param now      : current time
+     * @return         : true if the oldest outstanding chunk is long
+     *                   overdue given the current estimates
+     */
+    bool Overdue( uint64_t inFlight, double now ) const;
+
+    /**
+     * @param other : model of another source
+     * @return      : true if we are markedly faster than the other source
+     */
+    bool Outpaces( const XCpDeliveryModel &other ) const;
+
+    /**
+     * @return : bottleneck rate [B/s] (0 if not known yet)
+     */
+    uint64_t BtlBw() const
+    {
+      return pBtlBw;
+    }
+
+    /**
+     * @return : round trip time [s] (0 if not known yet)
+     */
+    double RtProp() const
+    {
+      return pRtProp;
+    }
+
+    /**
+     * @return : current chunk size
+     */
+    uint32_t ChunkSize() const
+    {
+      return pCurChunk;
+    }
+
+    /**
+     * @return : current in-flight window [B], 0 while the round trip
+     *           time is being probed (one chunk at a time)
+     */
+    uint64_t Window() const
+    {
+      return pProbing ? 0 : pWindow;
+    }
+
+  private:
+
+    /**
+     * Information recorded when a chunk is requested: the time,
+     * the number of bytes delivered so far, the time of the last
+     * delivery and the number of bytes queued ahead of it.
+     */
+    struct IssueInfo
+    {
+      double   time;
+      uint64_t delivered;
+      double   since;
+      uint64_t ahead;
+    };
+
+    /**
+     * Number of recent samples the estimates are taken over.
+     */
+    enum { kSamples = 10 };
+
+    /**
+     * Configured chunk size and number of parallel chunks.
+     */
+    uint32_t                      pChunkSize;
+    uint8_t                       pParallel;
+
+    /**
+     * Issue information of outstanding chunks (offset is the key).
+     */
+    std::map<uint64_t, IssueInfo> pIssued;
+
+    /**
+     * Total number of bytes delivered (never reset).
+     */
+    uint64_t                      pDelivered;
+
+    /**
+     * Time of the last delivery, or of the last request made
+     * with nothing in flight if that was later (0 if none yet).
+     */
+    double                        pLastDelivery;
+
+    /**
+     * Recent delivery rate samples [B/s].
+     */
+    double                        pRateSamples[kSamples];
+    size_t                        pSampleIdx;
+    size_t                        pNbSamples;
+
+    /**
+     * The smallest latency seen [s] and when it was seen.
+     */
+    double                        pMinLatency;
+    double                        pMinStamp;
+
+    /**
+     * True while the round trip time is being probed.
+     */
+    bool                          pProbing;
+
+    /**
+     * Bottleneck rate (maximum recent delivery rate) [B/s].
+     */
+    uint64_t                      pBtlBw;
+
+    /**
+     * Round trip time (minimum recent latency of a chunk) [s].
+     */
+    double                        pRtProp;
+
+    /**
+     * Current chunk size, adapted to the bandwidth delay product.
+     */
+    uint32_t                      pCurChunk;
+
+    /**
+     * Current in-flight window [B].
+     */
+    uint64_t                      pWindow;
+};
+
 class XCpSrc
 {
     friend class ChunkHandler;
@@ -114,10 +301,21 @@ class XCpSrc
     /**
      * Get the transfer rate for current source
      *
-     * @return : transfer rate for current source [B/s]
+     * @return : transfer rate for current source [B/s], the estimated
+     *           bottleneck rate once we have delivery samples, otherwise
+     *           the average rate since the start
      */
     uint64_t TransferRate();
 
+    /**
+     * @return true if the source has ongoing chunks, false otherwise
+     */
+    bool HasOngoing()
+    {
+      XrdSysMutexHelper lck( pMtx );
+      return !pOngoing.empty();
+    }
+
     /**
      * Delete ChunkInfo object, and set the pointer to null.
      *
@@ -204,6 +402,33 @@ class XCpSrc
      */
     void Steal( XCpSrc *src );
 
+    /**
+     * Speculatively re-request the tail of the ongoing chunks
+     * of a slower source. Whichever copy arrives first is used,
+     * the context discards the other one.
+     *
+     * Only done if we are markedly faster than the source, or if
+     * the source's oldest chunk is long overdue.
+     *
+     * @param src : the source whose chunks we duplicate
+     */
+    void Speculate( XCpSrc *src );
+
+    /**
+     * Issue an asynchronous read of a single chunk and
+     * record when it was issued (for the delivery model).
+     *
+     * @param offset : chunk offset
+     * @param size   : chunk size
+     * @return       : status of the read request
+     */
+    XRootDStatus ReadChunk( uint64_t offset, uint64_t size );
+
+    /**
+     * @return : number of bytes we are currently waiting for
+     */
+    uint64_t InFlight();
+
     /**
      * Get more work.
      * First try to get a new block.
@@ -360,6 +585,16 @@ class XCpSrc
      * the restart
      */
     time_t                        pTransferTime;
+
+    /**
+     * Host id of the current source (used for statistics).
+     */
+    std::string                   pHost;
+
+    /**
+     * Model of the delivery path of this source.
+     */
+    XCpDeliveryModel              pModel;
 };
 
 } /* namespace XrdCl */
@@ -146,7 +146,9 @@ namespace XrdCl
       waitBarrier(0),
       protection(0),
       protRespBody(0),
-      protRespSize(0)
+      protRespSize(0),
+      roundRobin(true),
+      nextStream(0)
     {
       sidManager = new SIDManager();
       memset( sessionId, 0, 16 );
@@ -187,6 +189,8 @@ namespace XrdCl
     XrdSecProtect               *protection;
     ServerResponseBody_Protocol *protRespBody;
     unsigned int                 protRespSize;
+    bool                         roundRobin;
+    uint16_t                     nextStream;
     XrdSysMutex                  mutex;
   };
 
@@ -292,6 +296,10 @@ namespace XrdCl
     env->GetInt( "SubStreamsPerChannel", streams );
     if( streams < 1 ) streams = 1;
     info->stream.resize( streams );
+
+    std::string policy = DefaultSubStreamPolicy;
+    env->GetString( "SubStreamPolicy", policy );
+    info->roundRobin = ( policy != "random" );
   }
 
   //----------------------------------------------------------------------------
@@ -664,8 +672,14 @@ namespace XrdCl
         if( info->stream[i].status == XRootDStreamInfo::Connected )
           connected.push_back( i );
 
+      //------------------------------------------------------------------------
+      // Round robin spreads consecutive requests (i.e. the stripes of a split
+      // read) evenly over the bound substreams, random is the old behaviour
+      //------------------------------------------------------------------------
       if( connected.empty() )
         downStream = 0;
+      else if( info->roundRobin )
+        downStream = connected[info->nextStream++ % connected.size()];
       else
         downStream = connected[random()%connected.size()];
     }
@@ -1099,6 +1113,20 @@ namespace XrdCl
       case XRootDQuery::ProtocolVersion:
         result.Set( new int( info->protocolVersion ), false );
         return Status();
+
+      //------------------------------------------------------------------------
+      // Number of bound substreams responses may be returned through
+      //------------------------------------------------------------------------
+      case XRootDQuery::SubStreams:
+      {
+        int connected = 0;
+        if( info->serverFlags & kXR_isServer )
+          for( size_t i = 1; i < info->stream.size(); ++i )
+            if( info->stream[i].status == XRootDStreamInfo::Connected )
+              ++connected;
+        result.Set( new int( connected ), false );
+        return Status();
+      }
     };
     return Status( stError, errQueryNotSupported );
   }
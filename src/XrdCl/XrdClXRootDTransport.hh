@@ -46,6 +46,8 @@ namespace XrdCl
     static const uint16_t SIDManager      = 1001; //!< returns the SIDManager object
     static const uint16_t ServerFlags     = 1002; //!< returns server flags
     static const uint16_t ProtocolVersion = 1003; //!< returns the protocol version
+    static const uint16_t SubStreams      = 1004; //!< returns the number of bound
+                                                  //!< substreams reads can use
   };
 
   //----------------------------------------------------------------------------
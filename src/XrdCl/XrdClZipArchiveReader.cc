@@ -29,12 +29,19 @@
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClXRootDResponses.hh"
+#include "XrdCl/XrdClPostMaster.hh"
+#include "XrdCl/XrdClJobManager.hh"
 
 #include "XrdSys/XrdSysPthread.hh"
 
 #include <string>
 #include <map>
 #include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include <zlib.h>
 
 namespace XrdCl
 {
@@ -115,12 +122,12 @@ struct CDFH
       pOffset            = *reinterpret_cast<const uint32_t*>( buffer + 42 );
 
       uint16_t filenameLength = *reinterpret_cast<const uint16_t*>( buffer + 28 );
-      uint16_t extraLength    = *reinterpret_cast<const uint16_t*>( buffer + 30 );
       uint16_t commentLength  = *reinterpret_cast<const uint16_t*>( buffer + 32 );
+      pExtraLength            = *reinterpret_cast<const uint16_t*>( buffer + 30 );
 
       pFilename = std::string( buffer + 46, filenameLength );
 
-      pCdfhSize = kCdfhBaseSize + filenameLength +extraLength + commentLength;
+      pCdfhSize = kCdfhBaseSize + filenameLength + pExtraLength + commentLength;
     }
 
     uint16_t    pZipVersion;
@@ -132,18 +139,399 @@ struct CDFH
     uint16_t    pDiskNb;
     uint32_t    pOffset;
     std::string pFilename;
+    uint16_t    pExtraLength;
     uint16_t    pCdfhSize;
 
     static const uint16_t kCdfhBaseSize = 46;
     static const uint32_t kCdfhSign     = 0x02014b50;
 };
 
+struct LFH
+{
+    LFH( const char *buffer )
+    {
+      uint16_t filenameLength = *reinterpret_cast<const uint16_t*>( buffer + 26 );
+      uint16_t extraLength    = *reinterpret_cast<const uint16_t*>( buffer + 28 );
+
+      pLfhSize = kLfhBaseSize + filenameLength + extraLength;
+    }
+
+    uint32_t pLfhSize;
+
+    static const uint16_t kLfhBaseSize = 30;
+    static const uint32_t kLfhSign     = 0x04034b50;
+
+    //------------------------------------------------------------------------
+    // Locate the data following the Local-file-header at lfhOffset, the
+    // buffer holds the archive starting at that offset
+    //------------------------------------------------------------------------
+    static XRootDStatus GetDataOffset( const char *buffer, uint64_t length, uint64_t lfhOffset, uint64_t &dataOffset )
+    {
+      if( length < kLfhBaseSize || *reinterpret_cast<const uint32_t*>( buffer ) != kLfhSign )
+        return XRootDStatus( stError, errErrorResponse, errDataError, "Local-file-header signature not found." );
+      dataOffset = lfhOffset + LFH( buffer ).pLfhSize;
+      return XRootDStatus();
+    }
+};
+
+//----------------------------------------------------------------------------
+// Access point into a deflate stream, holds everything needed to resume
+// inflating at pOut without decompressing the member from its start
+// (the scheme of zlib's zran example).
+//----------------------------------------------------------------------------
+static const uint32_t kInflateWindow = 32768;    // deflate history window
+static const uint64_t kInflateSpan   = 1048576;  // distance between access points
+static const uint32_t kInflateChunk  = 1048576;  // compressed bytes fetched per read
+
+struct InflatePoint
+{
+    uint64_t      pOut;   // uncompressed offset
+    uint64_t      pIn;    // compressed offset of the first full byte
+    int           pBits;  // bits of the previous byte still to be consumed
+    int           pPrime; // value of those bits
+    unsigned char pWindow[kInflateWindow];
+};
+
+//----------------------------------------------------------------------------
+// Access points of a deflated member, built while reading and shared by
+// all the readers of the archive
+//----------------------------------------------------------------------------
+class ZipInflateIndex
+{
+  public:
+
+    ZipInflateIndex() : pDataOffset( 0 ) { }
+
+    ~ZipInflateIndex()
+    {
+      for( std::vector<InflatePoint*>::iterator it = pPoints.begin(); it != pPoints.end(); ++it )
+        delete *it;
+    }
+
+    //------------------------------------------------------------------------
+    // Archive offset of the compressed data, 0 if not yet known
+    //------------------------------------------------------------------------
+    uint64_t GetDataOffset() const
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      return pDataOffset;
+    }
+
+    void SetDataOffset( uint64_t offset )
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      pDataOffset = offset;
+    }
+
+    //------------------------------------------------------------------------
+    // Copy out the last access point at or before offset, false if the
+    // inflating has to start at the beginning of the member
+    //------------------------------------------------------------------------
+    bool Lookup( uint64_t offset, InflatePoint &point ) const
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      std::vector<InflatePoint*>::const_iterator it = std::upper_bound( pPoints.begin(), pPoints.end(), offset, OutLess );
+      if( it == pPoints.begin() ) return false;
+      point = **( it - 1 );
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    // Add an access point (takes the ownership), points that would end up
+    // closer than half a span to an existing one are dropped
+    //------------------------------------------------------------------------
+    void Add( InflatePoint *point )
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      std::vector<InflatePoint*>::iterator it = std::upper_bound( pPoints.begin(), pPoints.end(), point->pOut, OutLess );
+      if( ( it != pPoints.end() && ( *it )->pOut - point->pOut < kInflateSpan / 2 ) ||
+          ( it != pPoints.begin() && point->pOut - ( *( it - 1 ) )->pOut < kInflateSpan / 2 ) )
+      {
+        delete point;
+        return;
+      }
+      pPoints.insert( it, point );
+    }
+
+    //------------------------------------------------------------------------
+    // Memory held by the index
+    //------------------------------------------------------------------------
+    uint64_t Size() const
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      return sizeof( *this ) + pPoints.size() * ( sizeof( InflatePoint ) + sizeof( InflatePoint* ) );
+    }
+
+  private:
+
+    static bool OutLess( uint64_t offset, const InflatePoint *point )
+    {
+      return offset < point->pOut;
+    }
+
+    mutable XrdSysMutex        pMutex;
+    uint64_t                   pDataOffset;
+    std::vector<InflatePoint*> pPoints;
+};
+
+//----------------------------------------------------------------------------
+// Inflates the [offset, offset + size) range of a deflated member into the
+// user buffer, starting at the closest access point and adding new points
+// to the index on the way
+//----------------------------------------------------------------------------
+class ZipInflater
+{
+  public:
+
+    ZipInflater( const std::shared_ptr<ZipInflateIndex> &index, uint64_t offset, uint32_t size, void *buffer ) :
+      pIndex( index ), pOffset( offset ), pSize( size ), pBuffer( reinterpret_cast<char*>( buffer ) ),
+      pIn( 0 ), pOut( 0 ), pLast( 0 ), pCopied( 0 ), pInit( false )
+    {
+      memset( &pStrm, 0, sizeof( pStrm ) );
+    }
+
+    ~ZipInflater()
+    {
+      if( pInit ) inflateEnd( &pStrm );
+    }
+
+    XRootDStatus Init()
+    {
+      bool resume = pIndex->Lookup( pOffset, pPoint );
+      if( inflateInit2( &pStrm, -MAX_WBITS ) != Z_OK )
+        return XRootDStatus( stError, errInternal, 0, "Failed to initialize inflate stream." );
+      pInit = true;
+
+      if( resume )
+      {
+        pIn  = pPoint.pIn;
+        pOut = pLast = pPoint.pOut;
+        if( pPoint.pBits ) inflatePrime( &pStrm, pPoint.pBits, pPoint.pPrime );
+        inflateSetDictionary( &pStrm, pPoint.pWindow, kInflateWindow );
+      }
+
+      // the window of the access point doubles as the circular output
+      // buffer, so it stays valid for the points we add later on
+      pStrm.next_out  = pPoint.pWindow;
+      pStrm.avail_out = kInflateWindow;
+      return XRootDStatus();
+    }
+
+    //------------------------------------------------------------------------
+    // Inflate the next piece of compressed data (the one at NextIn()),
+    // done is set once the requested range has been produced
+    //------------------------------------------------------------------------
+    XRootDStatus Feed( const char *data, uint32_t length, bool &done )
+    {
+      pStrm.next_in  = reinterpret_cast<Bytef*>( const_cast<char*>( data ) );
+      pStrm.avail_in = length;
+      done = false;
+
+      while( pStrm.avail_in )
+      {
+        if( !pStrm.avail_out )
+        {
+          pStrm.next_out  = pPoint.pWindow;
+          pStrm.avail_out = kInflateWindow;
+        }
+
+        unsigned char *out   = pStrm.next_out;
+        uInt           avail = pStrm.avail_in;
+        int rc = inflate( &pStrm, Z_BLOCK );
+        pIn += avail - pStrm.avail_in;
+        Copy( out, pStrm.next_out - out );
+
+        if( rc == Z_STREAM_END || pOut >= pOffset + pSize )
+        {
+          done = true;
+          break;
+        }
+        if( rc != Z_OK )
+          return XRootDStatus( stError, errDataError, 0, pStrm.msg ? pStrm.msg : "Corrupted deflate stream." );
+
+        // at a block boundary, add an access point once in a span
+        if( ( pStrm.data_type & 128 ) && !( pStrm.data_type & 64 ) &&
+            pOut - pLast > kInflateSpan && pStrm.next_in > reinterpret_cast<const Bytef*>( data ) )
+          AddPoint();
+      }
+
+      return XRootDStatus();
+    }
+
+    //------------------------------------------------------------------------
+    // Compressed offset (relative to the member data) to be fed next
+    //------------------------------------------------------------------------
+    uint64_t NextIn() const
+    {
+      return pIn;
+    }
+
+    //------------------------------------------------------------------------
+    // Uncompressed offset (relative to the member) produced next
+    //------------------------------------------------------------------------
+    uint64_t NextOut() const
+    {
+      return pOut;
+    }
+
+    //------------------------------------------------------------------------
+    // Number of bytes written to the user buffer
+    //------------------------------------------------------------------------
+    uint32_t Copied() const
+    {
+      return pCopied;
+    }
+
+  private:
+
+    void Copy( const unsigned char *data, uint32_t length )
+    {
+      uint64_t start = std::max( pOut, pOffset );
+      uint64_t end   = std::min( pOut + length, pOffset + pSize );
+      if( start < end )
+      {
+        memcpy( pBuffer + ( start - pOffset ), data + ( start - pOut ), end - start );
+        pCopied += end - start;
+      }
+      pOut += length;
+    }
+
+    void AddPoint()
+    {
+      InflatePoint *point = new InflatePoint();
+      point->pOut   = pOut;
+      point->pIn    = pIn;
+      point->pBits  = pStrm.data_type & 7;
+      point->pPrime = point->pBits ? pStrm.next_in[-1] >> ( 8 - point->pBits ) : 0;
+
+      uint32_t left = pStrm.avail_out;
+      memcpy( point->pWindow, pPoint.pWindow + kInflateWindow - left, left );
+      memcpy( point->pWindow + left, pPoint.pWindow, kInflateWindow - left );
+
+      pIndex->Add( point );
+      pLast = pOut;
+    }
+
+    std::shared_ptr<ZipInflateIndex> pIndex;
+    uint64_t                         pOffset;
+    uint32_t                         pSize;
+    char                            *pBuffer;
+    z_stream                         pStrm;
+    InflatePoint                     pPoint;
+    uint64_t                         pIn;
+    uint64_t                         pOut;
+    uint64_t                         pLast;
+    uint32_t                         pCopied;
+    bool                             pInit;
+};
+
+//----------------------------------------------------------------------------
+// Central directories (and the access points of the deflated members) of
+// recently opened archives, so that reopening an archive that did not change
+// in the meantime does not fetch and parse them again. The access points
+// keep being added while the archives are read, so the size is checked
+// again whenever an archive is cached or closed.
+//----------------------------------------------------------------------------
+class ZipDirCache
+{
+  public:
+
+    struct Entry
+    {
+      uint64_t                                      pArchiveSize;
+      time_t                                        pModTime;
+      uint64_t                                      pCdOffset;
+      std::vector<CDFH>                             pRecords;
+      std::vector<std::shared_ptr<ZipInflateIndex> > pIndexes;
+      uint64_t                                      pStamp;
+
+      uint64_t Size() const
+      {
+        uint64_t size = sizeof( *this ) + pRecords.size() * sizeof( CDFH );
+        for( size_t i = 0; i < pRecords.size(); ++i )
+          size += pRecords[i].pFilename.size();
+        for( size_t i = 0; i < pIndexes.size(); ++i )
+          if( pIndexes[i] ) size += pIndexes[i]->Size();
+        return size;
+      }
+    };
+
+    static ZipDirCache& Instance()
+    {
+      static ZipDirCache cache;
+      return cache;
+    }
+
+    std::shared_ptr<Entry> Get( const std::string &key, uint64_t size, time_t modTime )
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      std::map<std::string, std::shared_ptr<Entry> >::iterator it = pEntries.find( key );
+      if( it == pEntries.end() ) return std::shared_ptr<Entry>();
+      if( it->second->pArchiveSize != size || it->second->pModTime != modTime )
+      {
+        pEntries.erase( it );
+        return std::shared_ptr<Entry>();
+      }
+      it->second->pStamp = ++pClock;
+      return it->second;
+    }
+
+    void Put( const std::string &key, const std::shared_ptr<Entry> &entry )
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      entry->pStamp = ++pClock;
+      pEntries[key] = entry;
+      TrimNoLock();
+    }
+
+    //------------------------------------------------------------------------
+    // Evict the least recently used archives until the limits are met
+    //------------------------------------------------------------------------
+    void Trim()
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      TrimNoLock();
+    }
+
+  private:
+
+    ZipDirCache() : pClock( 0 ) { }
+
+    void TrimNoLock()
+    {
+      // the sizes are taken once, the indexes may grow meanwhile
+      std::map<uint64_t, std::pair<std::string, uint64_t> > byAge;
+      std::map<std::string, std::shared_ptr<Entry> >::iterator it;
+      uint64_t size = 0;
+      for( it = pEntries.begin(); it != pEntries.end(); ++it )
+      {
+        uint64_t esize = it->second->Size();
+        byAge[it->second->pStamp] = std::make_pair( it->first, esize );
+        size += esize;
+      }
+
+      std::map<uint64_t, std::pair<std::string, uint64_t> >::iterator lru = byAge.begin();
+      for( ; lru != byAge.end() && ( pEntries.size() > kMaxEntries || size > kMaxBytes ); ++lru )
+      {
+        size -= lru->second.second;
+        pEntries.erase( lru->second.first );
+      }
+    }
+
+    static const size_t   kMaxEntries = 128;
+    static const uint64_t kMaxBytes   = 64 * 1024 * 1024;
+
+    XrdSysMutex                                      pMutex;
+    std::map<std::string, std::shared_ptr<Entry> >   pEntries;
+    uint64_t                                         pClock;
+};
+
 
 class ZipArchiveReaderImpl
 {
   public:
 
-    ZipArchiveReaderImpl( File &archive ) : pArchive( archive ), pArchiveSize( 0 ), pRefCount( 1 ), pOpen( false ) { }
+    ZipArchiveReaderImpl( File &archive ) : pArchive( archive ), pArchiveSize( 0 ), pModTime( 0 ), pCdOffset( 0 ), pRefCount( 1 ), pOpen( false ) { }
 
     ZipArchiveReaderImpl* Self()
     {
@@ -175,6 +563,22 @@ class ZipArchiveReaderImpl
 
     XRootDStatus Read( const std::string &filename, uint64_t relativeOffset, uint32_t size, void *buffer, ResponseHandler *userHandler, uint16_t timeout = 0 );
 
+    XRootDStatus ReadDeflated( size_t index, uint64_t relativeOffset, uint32_t size, void *buffer, ResponseHandler *userHandler, uint16_t timeout );
+
+    XRootDStatus ReadLocal( size_t index, uint64_t relativeOffset, uint32_t size, void *buffer, uint32_t &bytesRead );
+
+    XRootDStatus VectorRead( const std::vector<std::string> &filenames, const ChunkList &chunks, ResponseHandler *userHandler, uint16_t timeout = 0 );
+
+    XRootDStatus ReadRaw( uint64_t offset, uint32_t size, void *buffer, ResponseHandler *handler, uint16_t timeout )
+    {
+      return pArchive.Read( offset, size, buffer, handler, timeout );
+    }
+
+    XRootDStatus ReadRaw( const ChunkList &chunks, ResponseHandler *handler, uint16_t timeout )
+    {
+      return pArchive.VectorRead( chunks, 0, handler, timeout );
+    }
+
     XRootDStatus Read( uint64_t relativeOffset, uint32_t size, void *buffer, ResponseHandler *userHandler, uint16_t timeout = 0 )
     {
       if( pBoundFile.empty() )
@@ -192,6 +596,7 @@ class ZipArchiveReaderImpl
       {
         pBuffer.reset();
         ClearRecords();
+        ZipDirCache::Instance().Trim();
       }
       return st;
     }
@@ -200,11 +605,37 @@ class ZipArchiveReaderImpl
     {
       std::map<std::string, size_t>::const_iterator it = pFileToCdfh.find( filename );
       if( it == pFileToCdfh.end() ) return XRootDStatus( stError, errNotFound );
-      CDFH *cdfh = pCdRecords[it->second];
-      size = cdfh->pCompressionMethod ? cdfh->pCompressedSize : cdfh->pUncompressedSize;
+      size = pCdRecords[it->second]->pUncompressedSize;
       return XRootDStatus();
     }
 
+    const CDFH* GetRecord( size_t index ) const
+    {
+      return pCdRecords[index];
+    }
+
+    const std::shared_ptr<ZipInflateIndex>& GetIndex( size_t index ) const
+    {
+      return pIndexes[index];
+    }
+
+    //------------------------------------------------------------------------
+    // The Local-file-header of a member is followed by its data, which is
+    // followed by the next Local-file-header or the Central-directory
+    //------------------------------------------------------------------------
+    uint64_t NextRecordOffset( size_t index ) const
+    {
+      return ( index + 1 < pCdRecords.size() ) ? pCdRecords[index + 1]->pOffset : pCdOffset;
+    }
+
+    bool Lookup( const std::string &filename, size_t &index ) const
+    {
+      std::map<std::string, size_t>::const_iterator it = pFileToCdfh.find( filename );
+      if( it == pFileToCdfh.end() ) return false;
+      index = it->second;
+      return true;
+    }
+
     XRootDStatus Bind( const std::string &filename )
     {
       std::map<std::string, size_t>::const_iterator it = pFileToCdfh.find( filename );
@@ -223,6 +654,41 @@ class ZipArchiveReaderImpl
       pArchiveSize = size;
     }
 
+    //------------------------------------------------------------------------
+    // Restore the central directory from the cache if the archive has not
+    // changed since it was parsed
+    //------------------------------------------------------------------------
+    bool LoadDirectory( time_t modTime )
+    {
+      pModTime = modTime;
+      std::shared_ptr<ZipDirCache::Entry> entry = ZipDirCache::Instance().Get( pCacheKey, pArchiveSize, pModTime );
+      if( !entry ) return false;
+
+      pCdOffset = entry->pCdOffset;
+      pCdRecords.reserve( entry->pRecords.size() );
+      for( size_t i = 0; i < entry->pRecords.size(); ++i )
+      {
+        pCdRecords.push_back( new CDFH( entry->pRecords[i] ) );
+        pFileToCdfh[entry->pRecords[i].pFilename] = i;
+      }
+      pIndexes = entry->pIndexes;
+      pOpen    = true;
+      return true;
+    }
+
+    void SaveDirectory()
+    {
+      std::shared_ptr<ZipDirCache::Entry> entry( new ZipDirCache::Entry() );
+      entry->pArchiveSize = pArchiveSize;
+      entry->pModTime     = pModTime;
+      entry->pCdOffset    = pCdOffset;
+      entry->pRecords.reserve( pCdRecords.size() );
+      for( std::vector<CDFH*>::iterator it = pCdRecords.begin(); it != pCdRecords.end(); ++it )
+        entry->pRecords.push_back( **it );
+      entry->pIndexes     = pIndexes;
+      ZipDirCache::Instance().Put( pCacheKey, entry );
+    }
+
     char* LookForEocd( uint64_t size )
     {
       for( ssize_t offset = size - EOCD::kEocdBaseSize; offset >= 0; --offset )
@@ -250,6 +716,7 @@ class ZipArchiveReaderImpl
         bufferSize -= cdfh->pCdfhSize;
         pCdRecords.push_back( cdfh );
         pFileToCdfh[cdfh->pFilename] = i;
+        pIndexes.push_back( std::shared_ptr<ZipInflateIndex>( cdfh->pCompressionMethod == Z_DEFLATED ? new ZipInflateIndex() : 0 ) );
       }
 
       pOpen = true;
@@ -262,6 +729,7 @@ class ZipArchiveReaderImpl
       char *eocdBlock = LookForEocd( pArchiveSize );
       if( !eocdBlock ) return XRootDStatus( stError, errErrorResponse, errDataError, "End-of-central-directory signature not found." );
       pEocd.reset( new EOCD( eocdBlock ) );
+      pCdOffset = pEocd->pCdOffset;
 
       // If we managed to download the whole archive we don't need to
       // worry about zip64, it is so small that standard EOCD will do
@@ -278,6 +746,7 @@ class ZipArchiveReaderImpl
       XRootDStatus st = ParseCdRecords( pBuffer.get(), nbCdRecords, bufferSize );
       // successful or not we don't need it anymore
       pBuffer.reset();
+      if( st.IsOK() ) SaveDirectory();
       return st;
     }
 
@@ -292,6 +761,8 @@ class ZipArchiveReaderImpl
         delete *it;
       pCdRecords.clear();
       pFileToCdfh.clear();
+      pIndexes.clear();
+      pCdOffset = 0;
 
       pBoundFile.erase();
     }
@@ -315,8 +786,12 @@ class ZipArchiveReaderImpl
     std::unique_ptr<char[]>        pBuffer;
     std::unique_ptr<EOCD>          pEocd;
     std::unique_ptr<ZIP64_EOCD>    pZip64Eocd;
+    std::string                    pCacheKey;
+    time_t                         pModTime;
+    uint64_t                       pCdOffset;
     std::vector<CDFH*>             pCdRecords;
     std::map<std::string, size_t>  pFileToCdfh;
+    std::vector<std::shared_ptr<ZipInflateIndex> > pIndexes;
     mutable XrdSysMutex            pMutex;
     size_t                         pRefCount;
     bool                           pOpen;
@@ -475,9 +950,17 @@ class StatArchiveHandler : public ZipHandlerBase<StatInfo>
 
       // if the size of the file is smaller than the maximum comment size +
       // EOCD size simply download the whole file, otherwise download the EOCD
-      XRootDStatus st = ( size <= EOCD::kMaxCommentSize + EOCD::kEocdBaseSize + ZIP64_EOCDL::kZip64EocdlSize ) ?
-                        pImpl->ReadArchive( pUserHandler ) :
-                        pImpl->ReadEocd( pUserHandler );
+      // unless we already know the central directory of this archive
+      bool small = size <= EOCD::kMaxCommentSize + EOCD::kEocdBaseSize + ZIP64_EOCDL::kZip64EocdlSize;
+      if( !small && pImpl->LoadDirectory( response->GetModTime() ) )
+      {
+        delete response;
+        if( pUserHandler ) pUserHandler->HandleResponse( status, 0 );
+        else delete status;
+        return;
+      }
+
+      XRootDStatus st = small ? pImpl->ReadArchive( pUserHandler ) : pImpl->ReadEocd( pUserHandler );
       if( !st.IsOK() )
       {
         *status = st;
@@ -582,6 +1065,339 @@ class ZipReadHandler : public ZipHandlerBase<ChunkInfo>
 };
 
 
+//----------------------------------------------------------------------------
+// Reads a range of a deflated member: fetches the compressed data in chunks
+// from the closest access point on and inflates it until the range is done
+//----------------------------------------------------------------------------
+class ZipInflateHandler : public ZipHandlerCommon
+{
+  public:
+
+    ZipInflateHandler( ZipArchiveReaderImpl *impl, ResponseHandler *userHandler, size_t index,
+                       ZipInflater *inflater, uint64_t relativeOffset, void *buffer, uint16_t timeout ) :
+      ZipHandlerCommon( impl, userHandler ), pInflater( inflater ), pIndex( impl->GetIndex( index ) ),
+      pRelativeOffset( relativeOffset ), pBuffer( buffer ), pTimeout( timeout ), pHeader( false )
+    {
+      const CDFH *cdfh = impl->GetRecord( index );
+      pLfhOffset      = cdfh->pOffset;
+      pCompressedSize = cdfh->pCompressedSize;
+      // the Local-file-header usually carries the same name and extra field
+      pLfhSize        = LFH::kLfhBaseSize + cdfh->pFilename.size() + cdfh->pExtraLength;
+      pChunk.reset( new char[pLfhSize + kInflateChunk] );
+    }
+
+    //------------------------------------------------------------------------
+    // Issue the read of the next compressed chunk, the first read of
+    // a member also fetches its Local-file-header
+    //------------------------------------------------------------------------
+    XRootDStatus ReadNext()
+    {
+      uint64_t dataOffset = pIndex->GetDataOffset();
+      uint64_t left       = pCompressedSize - pInflater->NextIn();
+      if( !dataOffset )
+      {
+        pHeader = true;
+        return pImpl->ReadRaw( pLfhOffset, pLfhSize + std::min<uint64_t>( left, kInflateChunk ), pChunk.get(), this, pTimeout );
+      }
+      pHeader = false;
+      return pImpl->ReadRaw( dataOffset + pInflater->NextIn(), std::min<uint64_t>( left, kInflateChunk ), pChunk.get(), this, pTimeout );
+    }
+
+    virtual void HandleResponse( XRootDStatus *status, AnyObject *response )
+    {
+      ChunkInfo *chunk = 0;
+      if( status->IsOK() && response ) response->Get( chunk );
+      if( status->IsOK() && !chunk ) *status = XRootDStatus( stError, errInternal );
+
+      bool done = false;
+      if( status->IsOK() )
+      {
+        *status = Inflate( chunk, done );
+        if( status->IsOK() && !done )
+        {
+          *status = ReadNext();
+          if( status->IsOK() )
+          {
+            DeleteArgs( status, response );
+            return;
+          }
+        }
+      }
+      delete response;
+
+      if( pUserHandler )
+        pUserHandler->HandleResponse( status, status->IsOK() ? PkgResp( new ChunkInfo( pRelativeOffset, pInflater->Copied(), pBuffer ) ) : 0 );
+      else
+        delete status;
+      delete this;
+    }
+
+  private:
+
+    XRootDStatus Inflate( ChunkInfo *chunk, bool &done )
+    {
+      const char *data   = reinterpret_cast<const char*>( chunk->buffer );
+      uint32_t    length = chunk->length;
+
+      if( pHeader )
+      {
+        uint64_t dataOffset = 0;
+        XRootDStatus st = LFH::GetDataOffset( data, length, pLfhOffset, dataOffset );
+        if( !st.IsOK() ) return st;
+        pIndex->SetDataOffset( dataOffset );
+        uint64_t skip = dataOffset - pLfhOffset;
+        if( skip >= length ) return XRootDStatus();
+        data   += skip;
+        length -= skip;
+      }
+
+      XRootDStatus st = pInflater->Feed( data, length, done );
+      if( st.IsOK() && !done && ( !length || pInflater->NextIn() >= pCompressedSize ) )
+        return XRootDStatus( stError, errDataError, 0, "Truncated deflate stream." );
+      return st;
+    }
+
+    std::unique_ptr<ZipInflater>     pInflater;
+    std::shared_ptr<ZipInflateIndex> pIndex;
+    std::unique_ptr<char[]>          pChunk;
+    uint64_t                         pRelativeOffset;
+    void                            *pBuffer;
+    uint16_t                         pTimeout;
+    uint64_t                         pLfhOffset;
+    uint32_t                         pLfhSize;
+    uint32_t                         pCompressedSize;
+    bool                             pHeader;
+};
+
+
+//----------------------------------------------------------------------------
+// A file chunk of a vector read, deflated chunks keep the compressed data
+// that has to be inflated into the user buffer
+//----------------------------------------------------------------------------
+struct ZipVectorChunk
+{
+    ZipVectorChunk( size_t index, uint64_t relativeOffset, uint32_t size, void *buffer ) :
+      pIndex( index ), pRelativeOffset( relativeOffset ), pSize( size ), pBuffer( buffer ),
+      pDataOffset( 0 ), pLength( 0 ), pHeader( false ), pPartial( false ) { }
+
+    size_t                       pIndex;
+    uint64_t                     pRelativeOffset;
+    uint32_t                     pSize;
+    void                        *pBuffer;
+    std::unique_ptr<ZipInflater> pInflater;
+    std::unique_ptr<char[]>      pCompressed;
+    uint64_t                     pDataOffset; // archive offset of pCompressed
+    uint64_t                     pLength;     // bytes in pCompressed
+    bool                         pHeader;     // pCompressed starts with the LFH
+    bool                         pPartial;    // pCompressed stops short of the member end
+    XRootDStatus                 pStatus;
+};
+
+
+class ZipVectorReadHandler : public ZipHandlerCommon
+{
+  public:
+
+    ZipVectorReadHandler( ZipArchiveReaderImpl *impl, ResponseHandler *userHandler, uint16_t timeout ) :
+      ZipHandlerCommon( impl, userHandler ), pPending( 0 ), pTimeout( timeout ) { }
+
+    virtual ~ZipVectorReadHandler()
+    {
+      for( std::vector<ZipVectorChunk*>::iterator it = pChunks.begin(); it != pChunks.end(); ++it )
+        delete *it;
+    }
+
+    std::vector<ZipVectorChunk*> &GetChunks()
+    {
+      return pChunks;
+    }
+
+    //------------------------------------------------------------------------
+    // The compressed data has arrived, inflate the deflated chunks in
+    // parallel on the job manager
+    //------------------------------------------------------------------------
+    virtual void HandleResponse( XRootDStatus *status, AnyObject *response )
+    {
+      delete response;
+      if( !status->IsOK() )
+      {
+        Finish( status );
+        return;
+      }
+      delete status;
+
+      std::vector<ZipVectorChunk*> deflated;
+      for( std::vector<ZipVectorChunk*>::iterator it = pChunks.begin(); it != pChunks.end(); ++it )
+        if( ( *it )->pInflater ) deflated.push_back( *it );
+
+      if( deflated.empty() )
+      {
+        Finish( new XRootDStatus() );
+        return;
+      }
+
+      pPending = deflated.size();
+      JobManager *jobMgr = DefaultEnv::GetPostMaster()->GetJobManager();
+      for( size_t i = 0; i < deflated.size(); ++i )
+        jobMgr->QueueJob( new InflateJob( this, deflated[i] ) );
+    }
+
+    static void Inflate( ZipVectorChunk *chunk, const std::shared_ptr<ZipInflateIndex> &index, uint64_t lfhOffset )
+    {
+      // at most kMaxChunkFetch and the header, so it fits the inflater
+      const char *data   = chunk->pCompressed.get();
+      uint64_t    length = chunk->pLength;
+
+      if( chunk->pHeader )
+      {
+        uint64_t dataOffset = 0;
+        chunk->pStatus = LFH::GetDataOffset( data, length, lfhOffset, dataOffset );
+        if( !chunk->pStatus.IsOK() ) return;
+        index->SetDataOffset( dataOffset );
+        uint64_t skip = dataOffset - lfhOffset;
+        if( skip > length ) skip = length;
+        data   += skip;
+        length -= skip;
+      }
+
+      bool done = false;
+      chunk->pStatus = chunk->pInflater->Feed( data, length, done );
+      chunk->pCompressed.reset();
+      // we did not fetch enough, the inflater carries on later
+      if( chunk->pStatus.IsOK() && !done && chunk->pPartial ) return;
+      if( chunk->pStatus.IsOK() && !done )
+        chunk->pStatus = XRootDStatus( stError, errDataError, 0, "Truncated deflate stream." );
+      chunk->pLength = chunk->pInflater->Copied();
+      chunk->pInflater.reset();
+    }
+
+  private:
+
+    class InflateJob : public Job
+    {
+      public:
+
+        InflateJob( ZipVectorReadHandler *handler, ZipVectorChunk *chunk ) : pHandler( handler ), pChunk( chunk ) { }
+
+        virtual void Run( void* )
+        {
+          ZipArchiveReaderImpl *impl = pHandler->pImpl;
+          Inflate( pChunk, impl->GetIndex( pChunk->pIndex ), impl->GetRecord( pChunk->pIndex )->pOffset );
+          pHandler->InflateDone();
+          delete this;
+        }
+
+      private:
+
+        ZipVectorReadHandler *pHandler;
+        ZipVectorChunk       *pChunk;
+    };
+
+    //------------------------------------------------------------------------
+    // Collects the outcome of a chunk that is inflated reading one compressed
+    // chunk at a time
+    //------------------------------------------------------------------------
+    class ResumeHandler : public ResponseHandler
+    {
+      public:
+
+        ResumeHandler( ZipVectorReadHandler *handler, ZipVectorChunk *chunk ) : pHandler( handler ), pChunk( chunk ) { }
+
+        virtual void HandleResponse( XRootDStatus *status, AnyObject *response )
+        {
+          ChunkInfo *info = 0;
+          if( status->IsOK() && response ) response->Get( info );
+          pChunk->pStatus = *status;
+          pChunk->pLength = info ? info->length : 0;
+          delete status;
+          delete response;
+          pHandler->InflateDone();
+          delete this;
+        }
+
+      private:
+
+        ZipVectorReadHandler *pHandler;
+        ZipVectorChunk       *pChunk;
+    };
+
+    //------------------------------------------------------------------------
+    // The chunks that needed more compressed data than we fetched carry on
+    // like a plain read, false if there are none
+    //------------------------------------------------------------------------
+    bool Resume()
+    {
+      std::vector<ZipVectorChunk*> partial;
+      for( std::vector<ZipVectorChunk*>::iterator it = pChunks.begin(); it != pChunks.end(); ++it )
+        if( ( *it )->pInflater ) partial.push_back( *it );
+      if( partial.empty() ) return false;
+
+      pPending = partial.size();
+      for( size_t i = 0; i < partial.size(); ++i )
+      {
+        ZipVectorChunk *chunk = partial[i];
+        ZipInflateHandler *handler = new ZipInflateHandler( pImpl, new ResumeHandler( this, chunk ), chunk->pIndex,
+                                                            chunk->pInflater.release(), chunk->pRelativeOffset,
+                                                            chunk->pBuffer, pTimeout );
+        XRootDStatus st = handler->ReadNext();
+        if( !st.IsOK() )
+        {
+          handler->HandleResponse( new XRootDStatus( st ), 0 );
+        }
+      }
+      return true;
+    }
+
+    void InflateDone()
+    {
+      XrdSysMutexHelper scopedLock( pMutex );
+      if( --pPending ) return;
+      scopedLock.UnLock();
+
+      if( Resume() ) return;
+
+      XRootDStatus *status = new XRootDStatus();
+      for( std::vector<ZipVectorChunk*>::iterator it = pChunks.begin(); it != pChunks.end(); ++it )
+        if( !( *it )->pStatus.IsOK() )
+        {
+          *status = ( *it )->pStatus;
+          break;
+        }
+      Finish( status );
+    }
+
+    void Finish( XRootDStatus *status )
+    {
+      if( !pUserHandler )
+      {
+        delete status;
+        delete this;
+        return;
+      }
+
+      VectorReadInfo *info = 0;
+      if( status->IsOK() )
+      {
+        info = new VectorReadInfo();
+        uint32_t total = 0;
+        for( std::vector<ZipVectorChunk*>::iterator it = pChunks.begin(); it != pChunks.end(); ++it )
+        {
+          info->GetChunks().push_back( ChunkInfo( ( *it )->pRelativeOffset, ( *it )->pLength, ( *it )->pBuffer ) );
+          total += ( *it )->pLength;
+        }
+        info->SetSize( total );
+      }
+      pUserHandler->HandleResponse( status, info ? PkgResp( info ) : 0 );
+      delete this;
+    }
+
+    std::vector<ZipVectorChunk*> pChunks;
+    XrdSysMutex                  pMutex;
+    size_t                       pPending;
+    uint16_t                     pTimeout;
+};
+
+
 ZipArchiveReader::ZipArchiveReader( File &archive ) : pImpl( new ZipArchiveReaderImpl( archive ) )
 {
 
@@ -596,6 +1412,9 @@ ZipArchiveReader::~ZipArchiveReader()
 
 XRootDStatus ZipArchiveReaderImpl::Open( const std::string &url, ResponseHandler *userHandler, uint16_t timeout )
 {
+  URL archiveUrl( url );
+  pCacheKey = archiveUrl.GetHostId() + archiveUrl.GetPath();
+
   ZipOpenHandler *handler = new ZipOpenHandler( this, userHandler );
   XRootDStatus st = pArchive.Open( url, OpenFlags::Read, Access::None, handler, timeout );
   if( !st.IsOK() ) delete handler;
@@ -697,6 +1516,7 @@ XRootDStatus ZipArchiveReaderImpl::ReadCdfh( uint64_t bytesRead, ResponseHandler
 
   uint64_t offset = pZip64Eocd ? pZip64Eocd->pCdOffset : pEocd->pCdOffset;
   uint32_t size   = pZip64Eocd ? pZip64Eocd->pCdSize   : pEocd->pCdSize;
+  pCdOffset = offset;
   pBuffer.reset( new char[size] );
   ReadCdfhHandler *handler = new ReadCdfhHandler( this, userHandler, pEocd->pNbCdRec );
   XRootDStatus st = pArchive.Read( offset, size, pBuffer.get(), handler );
@@ -778,45 +1598,48 @@ XRootDStatus ZipArchiveReaderImpl::Read( const std::string &filename, uint64_t r
 {
   if( !pArchive.IsOpen() ) return XRootDStatus( stError, errInvalidOp, errInvalidOp, "Archive not opened." );
 
-  std::map<std::string, size_t>::iterator cditr = pFileToCdfh.find( filename );
-  if( cditr == pFileToCdfh.end() ) return XRootDStatus( stError, errNotFound, errNotFound, "File not found." );
-  CDFH *cdfh = pCdRecords[cditr->second];
+  size_t index = 0;
+  if( !Lookup( filename, index ) ) return XRootDStatus( stError, errNotFound, errNotFound, "File not found." );
+  CDFH *cdfh = pCdRecords[index];
 
-  // Now the problem is that at the beginning of our
-  // file there is the Local-file-header, which size
-  // is not known because of the variable size 'extra'
-  // field, so we need to know the offset of the next
-  // record and shift it by the file size.
-  // The next record is either the next LFH (next file)
-  // or the start of the Central-directory.
-  uint64_t nextRecordOffset = ( cditr->second + 1 < pCdRecords.size() ) ? pCdRecords[cditr->second + 1]->pOffset : pEocd->pCdOffset;
-  uint32_t fileSize = cdfh->pCompressionMethod ? cdfh->pCompressedSize : cdfh->pUncompressedSize;
-  uint64_t offset = nextRecordOffset - fileSize + relativeOffset;
-  uint32_t sizeTillEnd = fileSize - relativeOffset;
-  if( size > sizeTillEnd ) size = sizeTillEnd;
+  if( cdfh->pCompressionMethod == Z_DEFLATED )
+    return ReadDeflated( index, relativeOffset, size, buffer, userHandler, timeout );
+  if( cdfh->pCompressionMethod )
+    return XRootDStatus( stError, errNotSupported, errNotSupported, "Compression method not supported." );
 
   // check if we have the whole file in our local buffer
   if( pBuffer )
   {
-    if( offset + size > pArchiveSize )
+    uint32_t bytesRead = 0;
+    XRootDStatus st = ReadLocal( index, relativeOffset, size, buffer, bytesRead );
+    if( !st.IsOK() )
     {
-      if( userHandler ) userHandler->HandleResponse( new XRootDStatus( stError, errDataError ), 0 );
-      return XRootDStatus( stError, errDataError );
+      if( userHandler ) userHandler->HandleResponse( new XRootDStatus( st ), 0 );
+      return st;
     }
 
-    memcpy( buffer, pBuffer.get() + offset, size );
-
     if( userHandler )
     {
       XRootDStatus *st   = new XRootDStatus();
       AnyObject    *resp = new AnyObject();
-      ChunkInfo    *info = new ChunkInfo( relativeOffset, size, buffer );
+      ChunkInfo    *info = new ChunkInfo( relativeOffset, bytesRead, buffer );
       resp->Set( info );
       userHandler->HandleResponse( st, resp );
     }
     return XRootDStatus();
   }
 
+  // Now the problem is that at the beginning of our
+  // file there is the Local-file-header, which size
+  // is not known because of the variable size 'extra'
+  // field, so we need to know the offset of the next
+  // record and shift it by the file size.
+  // The next record is either the next LFH (next file)
+  // or the start of the Central-directory.
+  uint64_t offset = NextRecordOffset( index ) - cdfh->pUncompressedSize + relativeOffset;
+  uint32_t sizeTillEnd = cdfh->pUncompressedSize - relativeOffset;
+  if( size > sizeTillEnd ) size = sizeTillEnd;
+
   ZipReadHandler *handler = new ZipReadHandler( relativeOffset, this, userHandler );
   XRootDStatus st = pArchive.Read( offset, size, buffer, handler, timeout );
   if( !st.IsOK() ) delete handler;
@@ -824,6 +1647,177 @@ XRootDStatus ZipArchiveReaderImpl::Read( const std::string &filename, uint64_t r
   return st;
 }
 
+//------------------------------------------------------------------------
+// Read a member of an archive that we hold in memory
+//------------------------------------------------------------------------
+XRootDStatus ZipArchiveReaderImpl::ReadLocal( size_t index, uint64_t relativeOffset, uint32_t size, void *buffer, uint32_t &bytesRead )
+{
+  CDFH *cdfh = pCdRecords[index];
+  bytesRead = 0;
+  if( relativeOffset >= cdfh->pUncompressedSize ) return XRootDStatus();
+  if( size > cdfh->pUncompressedSize - relativeOffset ) size = cdfh->pUncompressedSize - relativeOffset;
+
+  if( !cdfh->pCompressionMethod )
+  {
+    uint64_t offset = NextRecordOffset( index ) - cdfh->pUncompressedSize + relativeOffset;
+    if( offset + size > pArchiveSize ) return XRootDStatus( stError, errDataError );
+    memcpy( buffer, pBuffer.get() + offset, size );
+    bytesRead = size;
+    return XRootDStatus();
+  }
+
+  uint64_t dataOffset = 0;
+  if( cdfh->pOffset >= pArchiveSize ) return XRootDStatus( stError, errDataError );
+  XRootDStatus st = LFH::GetDataOffset( pBuffer.get() + cdfh->pOffset, pArchiveSize - cdfh->pOffset, cdfh->pOffset, dataOffset );
+  if( !st.IsOK() ) return st;
+  if( dataOffset + cdfh->pCompressedSize > pArchiveSize ) return XRootDStatus( stError, errDataError );
+
+  ZipInflater inflater( pIndexes[index], relativeOffset, size, buffer );
+  st = inflater.Init();
+  if( !st.IsOK() ) return st;
+  bool done = false;
+  st = inflater.Feed( pBuffer.get() + dataOffset + inflater.NextIn(), cdfh->pCompressedSize - inflater.NextIn(), done );
+  if( !st.IsOK() ) return st;
+  if( !done ) return XRootDStatus( stError, errDataError, 0, "Truncated deflate stream." );
+  bytesRead = inflater.Copied();
+  return XRootDStatus();
+}
+
+//------------------------------------------------------------------------
+// Read a range of a deflated member
+//------------------------------------------------------------------------
+XRootDStatus ZipArchiveReaderImpl::ReadDeflated( size_t index, uint64_t relativeOffset, uint32_t size, void *buffer, ResponseHandler *userHandler, uint16_t timeout )
+{
+  CDFH *cdfh = pCdRecords[index];
+  if( relativeOffset >= cdfh->pUncompressedSize ) size = 0;
+  else if( size > cdfh->pUncompressedSize - relativeOffset ) size = cdfh->pUncompressedSize - relativeOffset;
+
+  if( pBuffer || !size )
+  {
+    uint32_t bytesRead = 0;
+    XRootDStatus st = pBuffer ? ReadLocal( index, relativeOffset, size, buffer, bytesRead ) : XRootDStatus();
+    if( !st.IsOK() ) return st;
+    if( userHandler )
+    {
+      AnyObject *resp = new AnyObject();
+      resp->Set( new ChunkInfo( relativeOffset, bytesRead, buffer ) );
+      userHandler->HandleResponse( new XRootDStatus(), resp );
+    }
+    return XRootDStatus();
+  }
+
+  ZipInflater *inflater = new ZipInflater( pIndexes[index], relativeOffset, size, buffer );
+  XRootDStatus st = inflater->Init();
+  if( !st.IsOK() )
+  {
+    delete inflater;
+    return st;
+  }
+
+  ZipInflateHandler *handler = new ZipInflateHandler( this, userHandler, index, inflater, relativeOffset, buffer, timeout );
+  st = handler->ReadNext();
+  if( !st.IsOK() ) delete handler;
+  return st;
+}
+
+//------------------------------------------------------------------------
+// Read chunks of several members with a single vector read
+//------------------------------------------------------------------------
+XRootDStatus ZipArchiveReaderImpl::VectorRead( const std::vector<std::string> &filenames, const ChunkList &chunks, ResponseHandler *userHandler, uint16_t timeout )
+{
+  // the limits of the kXR_readv request
+  static const uint32_t kMaxVectorElems = 1024;
+  static const uint32_t kMaxVectorElem  = 2097136;
+  // compressed bytes fetched up front for a chunk
+  static const uint64_t kMaxChunkFetch  = 268435456;
+
+  if( !pArchive.IsOpen() ) return XRootDStatus( stError, errInvalidOp, errInvalidOp, "Archive not opened." );
+  if( filenames.size() != chunks.size() ) return XRootDStatus( stError, errInvalidArgs );
+
+  std::unique_ptr<ZipVectorReadHandler> handler( new ZipVectorReadHandler( this, userHandler, timeout ) );
+  std::vector<ZipVectorChunk*> &vchunks = handler->GetChunks();
+  ChunkList request;
+
+  for( size_t i = 0; i < chunks.size(); ++i )
+  {
+    size_t index = 0;
+    if( !Lookup( filenames[i], index ) ) return XRootDStatus( stError, errNotFound, errNotFound, "File not found." );
+    CDFH *cdfh = pCdRecords[index];
+    if( cdfh->pCompressionMethod && cdfh->pCompressionMethod != Z_DEFLATED )
+      return XRootDStatus( stError, errNotSupported, errNotSupported, "Compression method not supported." );
+
+    uint64_t relativeOffset = chunks[i].offset;
+    uint32_t size           = chunks[i].length;
+    if( relativeOffset >= cdfh->pUncompressedSize ) size = 0;
+    else if( size > cdfh->pUncompressedSize - relativeOffset ) size = cdfh->pUncompressedSize - relativeOffset;
+
+    ZipVectorChunk *vchunk = new ZipVectorChunk( index, relativeOffset, size, chunks[i].buffer );
+    vchunks.push_back( vchunk );
+
+    if( pBuffer )
+    {
+      uint32_t bytesRead = 0;
+      XRootDStatus st = ReadLocal( index, relativeOffset, size, chunks[i].buffer, bytesRead );
+      if( !st.IsOK() ) return st;
+      vchunk->pLength = bytesRead;
+      continue;
+    }
+    if( !size ) continue;
+
+    if( !cdfh->pCompressionMethod )
+    {
+      uint64_t offset = NextRecordOffset( index ) - cdfh->pUncompressedSize + relativeOffset;
+      char    *buffer = reinterpret_cast<char*>( chunks[i].buffer );
+      for( uint32_t done = 0; done < size; done += kMaxVectorElem )
+        request.push_back( ChunkInfo( offset + done, std::min( kMaxVectorElem, size - done ), buffer + done ) );
+      vchunk->pLength = size;
+      continue;
+    }
+
+    // fetch the compressed data from the closest access point on, if we
+    // don't know yet where the data begins start from the Local-file-header;
+    // we take twice what the compression ratio of the member suggests is
+    // needed for the requested range, if that is not enough the rest is
+    // read piece by piece afterwards
+    vchunk->pInflater.reset( new ZipInflater( pIndexes[index], relativeOffset, size, chunks[i].buffer ) );
+    XRootDStatus st = vchunk->pInflater->Init();
+    if( !st.IsOK() ) return st;
+
+    uint64_t dataOffset = pIndexes[index]->GetDataOffset();
+    uint64_t end        = dataOffset ? dataOffset + cdfh->pCompressedSize : NextRecordOffset( index );
+    uint64_t wanted     = relativeOffset + size - vchunk->pInflater->NextOut();
+    uint64_t fetch      = kInflateChunk;
+    if( cdfh->pUncompressedSize )
+      fetch += uint64_t( 2.0 * wanted * cdfh->pCompressedSize / cdfh->pUncompressedSize );
+    if( fetch > kMaxChunkFetch ) fetch = kMaxChunkFetch;
+    vchunk->pHeader     = !dataOffset;
+    vchunk->pDataOffset = dataOffset ? dataOffset + vchunk->pInflater->NextIn() : cdfh->pOffset;
+    if( vchunk->pHeader ) fetch += LFH::kLfhBaseSize + cdfh->pFilename.size() + cdfh->pExtraLength;
+    vchunk->pPartial    = fetch < end - vchunk->pDataOffset;
+    vchunk->pLength     = vchunk->pPartial ? fetch : end - vchunk->pDataOffset;
+    vchunk->pCompressed.reset( new char[vchunk->pLength] );
+
+    for( uint64_t done = 0; done < vchunk->pLength; done += kMaxVectorElem )
+      request.push_back( ChunkInfo( vchunk->pDataOffset + done, std::min<uint64_t>( kMaxVectorElem, vchunk->pLength - done ),
+                                    vchunk->pCompressed.get() + done ) );
+  }
+
+  if( request.size() > kMaxVectorElems )
+    return XRootDStatus( stError, errInvalidArgs, errInvalidArgs, "Too many chunks in the vector read." );
+
+  // nothing to fetch, everything has been read from the local buffer
+  if( request.empty() )
+  {
+    ZipVectorReadHandler *h = handler.release();
+    h->HandleResponse( new XRootDStatus(), 0 );
+    return XRootDStatus();
+  }
+
+  XRootDStatus st = ReadRaw( request, handler.get(), timeout );
+  if( st.IsOK() ) handler.release();
+  return st;
+}
+
 DirectoryList* ZipArchiveReaderImpl::List()
 {
   std::string value;
@@ -842,7 +1836,7 @@ DirectoryList* ZipArchiveReaderImpl::List()
   {
     CDFH *cdfh = *itr;
     StatInfo *entry_info = new StatInfo( info->GetId(),
-                                         cdfh->pCdfhSize,
+                                         cdfh->pUncompressedSize,
                                          info->GetFlags() & ( ~StatInfo::IsWritable ), // make sure it is not listed as writable
                                          info->GetModTime() );
     DirectoryList::ListEntry *entry =
@@ -853,6 +1847,27 @@ DirectoryList* ZipArchiveReaderImpl::List()
   return list;
 }
 
+//------------------------------------------------------------------------
+// Async vector read of several files in the archive.
+//------------------------------------------------------------------------
+XRootDStatus ZipArchiveReader::VectorRead( const std::vector<std::string> &filenames, const ChunkList &chunks, ResponseHandler *handler, uint16_t timeout )
+{
+  return pImpl->VectorRead( filenames, chunks, handler, timeout );
+}
+
+//------------------------------------------------------------------------
+// Sync vector read.
+//------------------------------------------------------------------------
+XRootDStatus ZipArchiveReader::VectorRead( const std::vector<std::string> &filenames, const ChunkList &chunks, VectorReadInfo *&vReadInfo, uint16_t timeout )
+{
+  SyncResponseHandler handler;
+  Status st = VectorRead( filenames, chunks, &handler, timeout );
+  if( !st.IsOK() )
+    return st;
+
+  return MessageUtils::WaitForResponse( &handler, vReadInfo );
+}
+
 XRootDStatus ZipArchiveReader::Close( ResponseHandler *handler, uint16_t timeout )
 {
   return pImpl->Close( handler, timeout );
@@ -37,11 +37,14 @@ class File;
 //! A wrapper class for the XrdCl::File.
 //!
 //! It is an abstraction for a ZIP file containing multiple sub-files.
-//! The class does not provide any unzip utilities, it just readjusts
-//! the offset so a respective file inside of the archive can be read.
-//! It is meant for ZIP archives containing uncompressed root files,
-//! so a single file can be accessed without downloading the whole
-//! archive.
+//! Stored files are read by readjusting the offset so a respective file
+//! inside of the archive can be read, deflated files are inflated on the
+//! fly. While a deflated file is being read, access points are recorded
+//! every 1MB of uncompressed data, so that later reads at an offset resume
+//! inflating from the closest access point instead of the file start.
+//! The central directory and the access points are kept in a process-wide
+//! cache, so reopening an archive that did not change (same size and
+//! modification time) does not fetch and parse its central directory again.
 //----------------------------------------------------------------------------
 class ZipArchiveReader
 {
@@ -102,6 +105,31 @@ class ZipArchiveReader
     //------------------------------------------------------------------------
     XRootDStatus Read( const std::string &filename, uint64_t offset, uint32_t size, void *buffer, uint32_t &bytesRead, uint16_t timeout = 0 );
 
+    //------------------------------------------------------------------------
+    //! Async vector read of several files in the archive.
+    //!
+    //! All the chunks are fetched with a single vector read, the chunks of
+    //! deflated files are then inflated in parallel on the job manager.
+    //! The compressed data of a deflated file is fetched from the closest
+    //! access point up to the end of the file, so this is meant for reading
+    //! many small files at once.
+    //!
+    //! @param filenames : the name of the file of each chunk
+    //! @param chunks    : offsets (relative for the given file), sizes
+    //!                    and buffers of the chunks
+    //! @param handler   : the handler for the async operation, it gets
+    //!                    a VectorReadInfo with the relative offsets
+    //! @param timeout   : the timeout of the async operation
+    //!
+    //! @return          : OK on success, error otherwise
+    //------------------------------------------------------------------------
+    XRootDStatus VectorRead( const std::vector<std::string> &filenames, const ChunkList &chunks, ResponseHandler *handler, uint16_t timeout = 0 );
+
+    //------------------------------------------------------------------------
+    //! Sync vector read.
+    //------------------------------------------------------------------------
+    XRootDStatus VectorRead( const std::vector<std::string> &filenames, const ChunkList &chunks, VectorReadInfo *&vReadInfo, uint16_t timeout = 0 );
+
     //------------------------------------------------------------------------
     //! Bounds the reader to a file inside the archive.
     //------------------------------------------------------------------------
@@ -142,7 +170,7 @@ class ZipArchiveReader
     //!
     //! @param filename : the name of the file
     //!
-    //! @return         : the size of the file as in CDFH record
+    //! @return         : the (uncompressed) size of the file as in CDFH record
     //------------------------------------------------------------------------
     XRootDStatus GetSize( const std::string &filename, uint32_t &size ) const;
 
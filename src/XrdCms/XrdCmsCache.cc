@@ -29,6 +29,10 @@
 /******************************************************************************/
   
 #include <stdio.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <sys/types.h>
 
 #include "XrdCms/XrdCmsCache.hh"
@@ -61,17 +65,32 @@ class XrdCmsCacheJob : XrdJob
 {
 public:
 
-void   DoIt() {Cache.Recycle(myList); delete this;}
+void   DoIt() {Cache.Recycle(*myShard, myList); delete this;}
 
-       XrdCmsCacheJob(XrdCmsKeyItem *List)
-                     : XrdJob("cache scrubber"), myList(List) {}
+       XrdCmsCacheJob(XrdCmsCache::Shard *sP, XrdCmsKeyItem *List)
+                     : XrdJob("cache scrubber"), myShard(sP), myList(List) {}
       ~XrdCmsCacheJob() {}
 
 private:
 
-XrdCmsKeyItem *myList;
+XrdCmsCache::Shard *myShard;
+XrdCmsKeyItem      *myList;
 };
 
+/******************************************************************************/
+/*                         L o c a l   F u n c t i o n s                      */
+/******************************************************************************/
+
+namespace
+{
+inline long long luClock()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return static_cast<long long>(ts.tv_sec)*1000000000LL + ts.tv_nsec;
+}
+}
+
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
 /******************************************************************************/
@@ -119,15 +138,22 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
    XrdCmsKeyItem *iP;
    SMask_t xmask;
    int isrw = (Sel.Opts & XrdCmsSelect::Write), isnew = 0;
+   unsigned int bClock;
+   Shard &S = ShardOf(Sel.Path);
 
 // Serialize processing
 //
-   myMutex.Lock();
+   S.Mutex.Lock();
+   bClock = getBClock();
+
+// Whatever happens, the path is no longer known to be missing
+//
+   if (S.nxTab) nxSet(S, Sel.Path, false, bClock);
 
 // Check for fast path processing
 //
    if (  !(iP = Sel.Path.TODRef) || !(iP->Key.Equiv(Sel.Path)))
-      if ((iP = Sel.Path.TODRef = CTable.Find(Sel.Path)))
+      if ((iP = Sel.Path.TODRef = S.CTable.Find(Sel.Path)))
          Sel.Path.Ref = iP->Key.Ref;
 
 // Add/Modify the entry
@@ -137,8 +163,8 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
           {iP->Loc.deadline = QDelay + time(0);
            iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
            iP->Loc.hfvec = 0; iP->Loc.pfvec = 0; iP->Loc.qfvec = 0;
-           iP->Loc.TOD_B = BClock;
-           iP->Key.TOD = Tock;
+           iP->Loc.TOD_B = bClock;
+           iP->Key.TOD = S.Tock;
           } else {
            xmask = iP->Loc.pfvec;
            if (Sel.Opts & XrdCmsSelect::Pending) iP->Loc.pfvec |= mask;
@@ -155,11 +181,11 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
                      }
           }
       } else if (!(Sel.Opts & XrdCmsSelect::Advisory))
-                {Sel.Path.TOD = Tock;
-                 if ((iP = CTable.Add(Sel.Path)))
+                {Sel.Path.TOD = S.Tock;
+                 if ((iP = S.CTable.Add(Sel.Path)))
                     {iP->Loc.pfvec    = (Sel.Opts&XrdCmsSelect::Pending?mask:0);
                      iP->Loc.hfvec    = mask;
-                     iP->Loc.TOD_B    = BClock;
+                     iP->Loc.TOD_B    = bClock;
                      iP->Loc.qfvec    = 0;
                      iP->Loc.deadline = QDelay + time(0);
                      iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
@@ -170,7 +196,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // All done
 //
-   myMutex.UnLock();
+   S.Mutex.UnLock();
    return isnew;
 }
   
@@ -192,27 +218,32 @@ int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    XrdCmsKeyItem *iP;
    int gone4good;
+   Shard &S = ShardOf(Sel.Path);
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   S.Mutex.Lock();
 
-// Look up the entry and remove server
+// Look up the entry and remove server. If the entry is removed remember that
+// the file no longer exists anywhere.
 //
-   if ((iP = CTable.Find(Sel.Path)))
+   if ((iP = S.CTable.Find(Sel.Path)))
       {iP->Loc.hfvec &= ~mask;
        iP->Loc.pfvec &= ~mask;
        if ((gone4good = (iP->Loc.hfvec == 0)))
           {if (nilTMO) iP->Loc.lifeline = nilTMO + time(0);
-           if (!(Sel.Opts & XrdCmsSelect::Advisory)
-           &&  XrdCmsKeyItem::Unload(iP) && !CTable.Recycle(iP))
-              Say.Emsg("DelFile", "Delete failed for", iP->Key.Val);
+           if (!(Sel.Opts & XrdCmsSelect::Advisory))
+              {if (S.CTable.Unload(iP) && !S.CTable.Recycle(iP))
+                  Say.Emsg("DelFile", "Delete failed for", iP->Key.Val);
+               if (S.nxTab && !iP->Loc.roPend && !iP->Loc.rwPend)
+                  nxSet(S, Sel.Path, true, getBClock());
+              }
           }
       } else gone4good = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   S.Mutex.UnLock();
    return gone4good;
 }
   
@@ -232,18 +263,22 @@ int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    XrdCmsKeyItem *iP;
-   SMask_t bVec;
+   SMask_t bVec, vecOK;
+   long long luTime, luStart = luClock();
+   unsigned int bClock;
    int retc;
+   Shard &S = ShardOf(Sel.Path);
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   S.Mutex.Lock();
+   bClock = getBClock(&vecOK);
 
 // Look up the entry and return location information
 //
-   if ((iP = CTable.Find(Sel.Path)))
-      {if ((bVec = (iP->Loc.TOD_B < BClock 
-                 ? getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
+   if ((iP = S.CTable.Find(Sel.Path)))
+      {if ((bVec = (iP->Loc.TOD_B < bClock 
+                 ? getBVec(S, iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
           {iP->Loc.hfvec &= ~bVec; 
            iP->Loc.pfvec &= ~bVec;
            iP->Loc.qfvec &= ~mask;
@@ -258,15 +293,29 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
        if (nilTMO && retc == 1 && iP->Loc.hfvec == 0
        &&  iP->Loc.lifeline <= time(0)) retc = 0;
 
-       Sel.Vec.hf      = okVec & iP->Loc.hfvec;
-       Sel.Vec.pf      = okVec & iP->Loc.pfvec;
-       Sel.Vec.bf      = okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
+       Sel.Vec.hf      = vecOK & iP->Loc.hfvec;
+       Sel.Vec.pf      = vecOK & iP->Loc.pfvec;
+       Sel.Vec.bf      = vecOK & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
        Sel.Path.Ref    = iP->Key.Ref;
-      } else retc = 0;
 
-// All done
+// If the query is complete and no one has the file, remember that in case this
+// entry is aged out or removed before the negative information expires.
+//
+       if (S.nxTab && retc == 1 && !iP->Loc.hfvec && !iP->Loc.pfvec
+       &&  !iP->Loc.roPend && !iP->Loc.rwPend) nxSet(S, Sel.Path, true, bClock);
+       S.Stats.luHit++;
+      } else if (S.nxTab && nxFind(S, Sel.Path, bClock))
+                {Sel.Vec.hf = Sel.Vec.pf = Sel.Vec.bf = 0;
+                 S.Stats.luNeg++;
+                 retc = 1;
+                } else {S.Stats.luMiss++; retc = 0;}
+
+// Account for the time taken and we are done
 //
-   myMutex.UnLock();
+   luTime = luClock() - luStart;
+   S.Stats.luTime += luTime;
+   if (luTime > S.Stats.luMax) S.Stats.luMax = luTime;
+   S.Mutex.UnLock();
    Sel.Path.TODRef = iP;
    return retc;
 }
@@ -279,10 +328,11 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    EPNAME("UnkFile");
    XrdCmsKeyItem *iP;
+   Shard &S = ShardOf(Sel.Path);
 
 // Make sure we have the proper information. If so, lock the hash table
 //
-   myMutex.Lock();
+   S.Mutex.Lock();
 
 // Look up the entry and if valid update the unqueried vector. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -294,7 +344,7 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   S.Mutex.UnLock();
    DEBUG("rc=" <<(iP ? 1 : 0) <<" path=" <<Sel.Path.Val);
    return (iP ? 1 : 0);
 }
@@ -313,7 +363,8 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 // Make sure we have the proper information. If so, lock the hash table
 //
    if (!Sel.InfoP) return DLTime;
-   myMutex.Lock();
+   Shard &S = ShardOf(Sel.Path);
+   S.Mutex.Lock();
 
 // Look up the entry and if valid add it to the callback queue. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -328,7 +379,7 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   S.Mutex.UnLock();
    DEBUG("rc=" <<retc <<" path=" <<Sel.Path.Val);
    return retc;
 }
@@ -345,11 +396,15 @@ void XrdCmsCache::Bounce(SMask_t smask, int SNum)
 
 // Simply indicate that this server bounced
 //
-   myMutex.Lock();
-   Bounced[SNum] = ++BClock;
-   okVec |= smask;
-   if (SNum > vecHi) vecHi = SNum;
-   myMutex.UnLock();
+   bMutex.Lock();
+   unsigned int bClock = CPP_ATOMIC_LOAD(BClock, std::memory_order_relaxed)+1;
+   CPP_ATOMIC_STORE(Bounced[SNum], bClock, std::memory_order_relaxed);
+   CPP_ATOMIC_STORE(okVec, CPP_ATOMIC_LOAD(okVec, std::memory_order_relaxed)
+                           | smask, std::memory_order_release);
+   if (SNum > CPP_ATOMIC_LOAD(vecHi, std::memory_order_relaxed))
+      CPP_ATOMIC_STORE(vecHi, SNum, std::memory_order_relaxed);
+   CPP_ATOMIC_STORE(BClock, bClock, std::memory_order_release);
+   bMutex.UnLock();
 }
 
 /******************************************************************************/
@@ -366,21 +421,23 @@ void XrdCmsCache::Drop(SMask_t smask, int SNum, int xHi)
 
 // Remove the node from the list of valid nodes
 //
-   myMutex.Lock();
-   Bounced[SNum] = 0;
-   okVec &= nmask;
-   vecHi = xHi;
-   myMutex.UnLock();
+   bMutex.Lock();
+   CPP_ATOMIC_STORE(Bounced[SNum], 0u, std::memory_order_relaxed);
+   CPP_ATOMIC_STORE(vecHi, xHi, std::memory_order_relaxed);
+   CPP_ATOMIC_STORE(okVec, CPP_ATOMIC_LOAD(okVec, std::memory_order_relaxed)
+                           & nmask, std::memory_order_release);
+   bMutex.UnLock();
 }
 
 /******************************************************************************/
 /* public                           I n i t                                   */
 /******************************************************************************/
   
-int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold)
+int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold,
+                      int nxCache)
 {
-   XrdCmsKeyItem *iP;
    pthread_t tid;
+   int i;
 
 // Indicate whether we are a shared-everything setup as this changes how we
 // dispatch clients to newly discovered files (see Dispatch()).
@@ -401,6 +458,18 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
        nilTMO = static_cast<unsigned int>(nxHold);
       }
 
+// Set up the negative cache. Negative information is never kept longer than
+// the nil entries it stands in for.
+//
+   if (nilTMO && nxCache > nilTMO) nxCache = nilTMO;
+   if ((nxTMO = (nxCache > 0 ? nxCache : 0)))
+      for (i = 0; i < numShards; i++)
+          {if (!(Shards[i].nxTab = (nxEnt *)calloc(nxSlots, sizeof(nxEnt))))
+              {Say.Emsg("Init", ENOMEM, "allocate negative cache");
+               return 0;
+              }
+          }
+
 // Start the clock thread
 //
    if (XrdSysThread::Run(&tid, XrdCmsStartTickTock, (void *)this,
@@ -411,15 +480,36 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 
 // Get the first reserve of cache items
 //
-   iP = XrdCmsKeyItem::Alloc(0);
-   XrdCmsKeyItem::Unload((unsigned int)0);
-   iP->Recycle();
+   XrdCmsKeyItem::Replenish();
 
 // All done
 //
    return 1;
 }
 
+/******************************************************************************/
+/* public                     S t a t i s t i c s                             */
+/******************************************************************************/
+
+void XrdCmsCache::Statistics(XrdCmsCache::Info &Data)
+{
+   int i;
+
+// Sum up the lookup statistics across all of the shards
+//
+   memset(&Data, 0, sizeof(Data));
+   for (i = 0; i < numShards; i++)
+       {Shards[i].Mutex.Lock();
+        Data.luHit  += Shards[i].Stats.luHit;
+        Data.luMiss += Shards[i].Stats.luMiss;
+        Data.luNeg  += Shards[i].Stats.luNeg;
+        Data.luTime += Shards[i].Stats.luTime;
+        if (Shards[i].Stats.luMax > Data.luMax)
+           Data.luMax = Shards[i].Stats.luMax;
+        Shards[i].Mutex.UnLock();
+       }
+}
+
 /******************************************************************************/
 /* public                       T i c k T o c k                               */
 /******************************************************************************/
@@ -427,16 +517,21 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 void *XrdCmsCache::TickTock()
 {
    XrdCmsKeyItem *iP;
+   unsigned int Tock = 0;
+   int i;
 
-// Simply adjust the clock and trim old entries
+// Simply adjust the clock and trim old entries, one shard at a time
 //
    do {XrdSysTimer::Snooze(Tick);
-       myMutex.Lock();
        Tock = (Tock+1) & XrdCmsKeyItem::TickMask;
-       Bhistory[Tock].Start = Bhistory[Tock].End = 0;
-       iP = XrdCmsKeyItem::Unload(Tock);
-       myMutex.UnLock();
-       if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
+       for (i = 0; i < numShards; i++)
+           {Shards[i].Mutex.Lock();
+            Shards[i].Tock = Tock;
+            Shards[i].Bhistory[Tock].Start = Shards[i].Bhistory[Tock].End = 0;
+            iP = Shards[i].CTable.Unload(Tock);
+            Shards[i].Mutex.UnLock();
+            if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(&Shards[i],iP));
+           }
       } while(1);
 
 // Keep compiler happy
@@ -502,36 +597,96 @@ void XrdCmsCache::Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *iP,
 /*                               g e t B V e c                                */
 /******************************************************************************/
   
-SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
+// Caller must hold the shard mutex, which protects the shard's history of
+// previously calculated vectors. The clock is read first; a server bouncing
+// while we look is then either included or caught on the next lookup.
+//
+SMask_t XrdCmsCache::getBVec(XrdCmsCache::Shard &S, unsigned int TODa,
+                             unsigned int &TODb)
 {
    EPNAME("getBVec");
    SMask_t BVec(0);
-   long long i;
+   long long i, vHi;
+   unsigned int bClock = CPP_ATOMIC_LOAD(BClock, std::memory_order_acquire);
+   bHist &bH = S.Bhistory[TODa];
 
 // See if we can use a previously calculated bVec
 //
-   if (Bhistory[TODa].End == BClock && Bhistory[TODa].Start <= TODb)
-      {Bhits++; TODb = BClock; return Bhistory[TODa].Vec;}
+   if (bH.End == bClock && bH.Start <= TODb)
+      {S.Bhits++; TODb = bClock; return bH.Vec;}
 
 // Calculate the new vector
 //
-   for (i = 0; i <= vecHi; i++)
-       if (TODb < Bounced[i]) BVec |= 1ULL << i;
-
-   Bhistory[TODa].Vec   = BVec;
-   Bhistory[TODa].Start = TODb;
-   Bhistory[TODa].End   = BClock;
-   TODb                 = BClock;
-   Bmiss++;
-   if (!(Bmiss & 0xff)) DEBUG("hits=" <<Bhits <<" miss=" <<Bmiss);
+   vHi = CPP_ATOMIC_LOAD(vecHi, std::memory_order_relaxed);
+   for (i = 0; i <= vHi; i++)
+       if (TODb < CPP_ATOMIC_LOAD(Bounced[i], std::memory_order_relaxed))
+          BVec |= 1ULL << i;
+
+   bH.Vec   = BVec;
+   bH.Start = TODb;
+   bH.End   = bClock;
+   TODb     = bClock;
+   S.Bmiss++;
+   if (!(S.Bmiss & 0xff)) DEBUG("hits=" <<S.Bhits <<" miss=" <<S.Bmiss);
    return BVec;
 }
 
+/******************************************************************************/
+/*                                n x F i n d                                 */
+/******************************************************************************/
+
+// Caller must hold the shard mutex and pass the current bounce clock. Negative
+// entries are direct mapped and are only trusted if no server has bounced
+// since the entry was made.
+//
+bool XrdCmsCache::nxFind(XrdCmsCache::Shard &S, XrdCmsKey &Key,
+                         unsigned int bClock)
+{
+   nxEnt *nP = &S.nxTab[Key.Hash % nxSlots];
+
+   return nP->Path && nP->Hash == Key.Hash && nP->TOD_B >= bClock
+       && nP->Expires > time(0) && !strcmp(nP->Path, Key.Val);
+}
+
+/******************************************************************************/
+/*                                 n x S e t                                  */
+/******************************************************************************/
+
+// Caller must hold the shard mutex and pass the current bounce clock.
+//
+void XrdCmsCache::nxSet(XrdCmsCache::Shard &S, XrdCmsKey &Key, bool isNil,
+                        unsigned int bClock)
+{
+   nxEnt *nP = &S.nxTab[Key.Hash % nxSlots];
+   bool   isSame = nP->Path && nP->Hash == Key.Hash && !strcmp(nP->Path,Key.Val);
+
+// Remove the entry if the file is no longer known to be missing
+//
+   if (!isNil)
+      {if (isSame) {free(nP->Path); nP->Path = 0;}
+       return;
+      }
+
+// Do not extend the life of an entry that is still valid
+//
+   if (isSame && nP->TOD_B >= bClock && nP->Expires > time(0)) return;
+
+// Replace whatever was in the slot
+//
+   if (!isSame)
+      {if (nP->Path) free(nP->Path);
+       if (!(nP->Path = strdup(Key.Val))) return;
+       nP->Hash = Key.Hash;
+      }
+   nP->TOD_B   = bClock;
+   nP->Expires = time(0) + nxTMO;
+}
+
 /******************************************************************************/
 /*                               R e c y c l e                                */
 /******************************************************************************/
   
-void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
+void XrdCmsCache::Recycle(XrdCmsCache::Shard &S, XrdCmsKeyItem *theList)
 {
    XrdCmsKeyItem *iP;
    char msgBuff[100];
@@ -543,24 +698,18 @@ void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
         {theList = iP->Key.TODRef;
          if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
          if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
-         myMutex.Lock(); CTable.Recycle(iP); myMutex.UnLock();
+         S.Mutex.Lock(); S.CTable.Recycle(iP); S.Mutex.UnLock();
          numRecycled++;
         }
 
 // See if we have enough items in reserve
 //
-   myMutex.Lock();
    XrdCmsKeyItem::Stats(numHave, numFree, numNull);
    if (numFree < XrdCmsKeyItem::minFree)
-      {myMutex.UnLock();
-       if (!(numNull /= 4)) numNull = 1;
+      {if (!(numNull /= 4)) numNull = 1;
        numHave += XrdCmsKeyItem::minAlloc * numNull;
-       while(numNull--)
-            {myMutex.Lock();
-             numFree = XrdCmsKeyItem::Replenish();
-             myMutex.UnLock();
-            }
-      } else myMutex.UnLock();
+       while(numNull--) numFree = XrdCmsKeyItem::Replenish();
+      }
 
 // Log the stats
 //
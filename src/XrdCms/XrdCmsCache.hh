@@ -37,10 +37,15 @@
 #include "XrdCms/XrdCmsKey.hh"
 #include "XrdCms/XrdCmsNash.hh"
 #include "XrdCms/XrdCmsPList.hh"
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdCms/XrdCmsSelect.hh"
 #include "XrdCms/XrdCmsTypes.hh"
   
+// The cache is split into independently locked shards selected by the path
+// hash. Each shard ages its own entries and keeps a small negative cache of
+// paths that no server has so that repeated lookups do not cause a query.
+//
 class XrdCmsCache
 {
 public:
@@ -74,47 +79,107 @@ void        Bounce(SMask_t smask, int SNum);
 
 void        Drop(SMask_t mask, int SNum, int xHi);
 
-int         Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold);
+int         Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold,
+                 int nxCache=def_nxCache);
+
+struct Info {long long luHit;   // Lookups that found an entry
+             long long luMiss;  // Lookups that found nothing
+             long long luNeg;   // Lookups answered by the negative cache
+             long long luTime;  // Total lookup time in nanoseconds
+             long long luMax;   // Longest lookup time in nanoseconds
+            };
+
+void        Statistics(Info &Data);
 
 void       *TickTock();
 
-static const int min_nxTime = 60;
+static const int min_nxTime  = 60;
+static const int def_nxCache = 0;
 
-            XrdCmsCache() : okVec(0), Tick(8*60*60), Tock(0), BClock(0), 
-                            nilTMO(0),
-                            DLTime(5), QDelay(5), Bhits(0), Bmiss(0), vecHi(-1),
+            XrdCmsCache() : okVec(0), Tick(8*60*60), BClock(0), 
+                            nilTMO(0), nxTMO(0),
+                            DLTime(5), QDelay(5), vecHi(-1),
                             isDFS(0)
-                          {memset(Bounced,  0, sizeof(Bounced));
-                           memset(Bhistory, 0, sizeof(Bhistory));
+                          {for (int i = 0; i < STMax; i++)
+                               CPP_ATOMIC_STORE(Bounced[i], 0u,
+                                                std::memory_order_relaxed);
                           }
            ~XrdCmsCache() {}   // Never gets deleted
 
 private:
 
+static const int shardBits = 5;
+static const int numShards = 1 << shardBits;
+static const int nxSlots   = 1024;
+
+struct nxEnt
+      {char         *Path;
+       unsigned int  Hash;
+       unsigned int  TOD_B;     // Server currency clock when added
+       time_t        Expires;
+      };
+
+struct bHist
+      {SMask_t      Vec;
+       unsigned int Start;
+       unsigned int End;
+      };
+
+struct Shard
+      {XrdSysMutex   Mutex;
+       XrdCmsNash    CTable;
+       nxEnt        *nxTab;
+       unsigned int  Tock;
+       int           Bhits;
+       int           Bmiss;
+       Info          Stats;
+       bHist         Bhistory[XrdCmsKeyItem::TickRate];
+       char          Pad[64];
+
+                     Shard() : CTable(1597, 2584), nxTab(0), Tock(0),
+                               Bhits(0), Bmiss(0)
+                             {memset(&Stats,    0, sizeof(Stats));
+                              memset(Bhistory,  0, sizeof(Bhistory));
+                             }
+      };
+
 void          Add2Q(XrdCmsRRQInfo *Info, XrdCmsKeyItem *cp, int selOpts);
 void          Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *cinfo,
                        short roQ, short rwQ);
-SMask_t       getBVec(unsigned int todA, unsigned int &todB);
-void          Recycle(XrdCmsKeyItem *theList);
-
-struct  {SMask_t      Vec;
-         unsigned int Start;
-         unsigned int End;
-        }             Bhistory[XrdCmsKeyItem::TickRate];
-
-XrdSysMutex   myMutex;
-XrdCmsNash    CTable;
-unsigned int  Bounced[STMax];
-SMask_t       okVec;
+SMask_t       getBVec(Shard &S, unsigned int todA, unsigned int &todB);
+bool          nxFind(Shard &S, XrdCmsKey &Key, unsigned int bClock);
+void          nxSet(Shard &S, XrdCmsKey &Key, bool isNil, unsigned int bClock);
+void          Recycle(Shard &S, XrdCmsKeyItem *theList);
+
+// The bounce information is only changed under bMutex but is published with
+// atomics so that lookups never take it. A server's bounce time is stored
+// before the clock is advanced, so whoever sees a clock value also sees every
+// bounce up to it.
+//
+inline unsigned int getBClock(SMask_t *vec=0)
+                             {unsigned int bClock =
+                                 CPP_ATOMIC_LOAD(BClock, std::memory_order_acquire);
+                              if (vec) *vec = CPP_ATOMIC_LOAD(okVec,
+                                                 std::memory_order_acquire);
+                              return bClock;
+                             }
+
+inline Shard &ShardOf(XrdCmsKey &Key)
+                     {if (!Key.Hash) Key.setHash();
+                      return Shards[Key.Hash >> (32 - shardBits)];
+                     }
+
+Shard         Shards[numShards];
+XrdSysMutex   bMutex;           // Serializes server bounce updates
+CPP_ATOMIC_TYPE(unsigned int) Bounced[STMax];
+CPP_ATOMIC_TYPE(SMask_t)      okVec;
 unsigned int  Tick;
-unsigned int  Tock;
-unsigned int  BClock;
+CPP_ATOMIC_TYPE(unsigned int) BClock;
          int  nilTMO;
+         int  nxTMO;
          int  DLTime;
          int  QDelay;
-         int  Bhits;
-         int  Bmiss;
-         int  vecHi;
+CPP_ATOMIC_TYPE(int)          vecHi;
          int  isDFS;
 };
 
@@ -118,6 +118,7 @@ XrdCmsCluster::XrdCmsCluster()
      SelRcnt = 0;
      SelRtot = 0;
      SelTcnt = 0;
+     SelSeed = static_cast<unsigned int>(time(0)) | 1;
      doReset = 0;
      resetMask = 0;
      peerHost  = 0;
@@ -381,6 +382,9 @@ SMask_t XrdCmsCluster::Broadcast(SMask_t smask, const struct iovec *iod,
    int i;
    XrdCmsNode *nP;
    SMask_t bmask, unQueried(0);
+   CmsRRHdr *hP = (CmsRRHdr *)iod[0].iov_base;
+   bool isQry = Config.P_lat && iod[0].iov_len >= sizeof(CmsRRHdr)
+             && hP->rrCode == kYR_state;
 
 // Obtain a lock on the table and screen out peer nodes
 //
@@ -398,7 +402,7 @@ SMask_t XrdCmsCluster::Broadcast(SMask_t smask, const struct iovec *iod,
                      if (nP->Send(iod, iovcnt, iotot) < 0)
                         {unQueried |= nP->Mask();
                          DEBUG(nP->Ident <<" is unreachable");
-                        }
+                        } else if (isQry) nP->latQuery(hP->streamid);
                      nP->Ref2g(STMutex);
                     }
            }
@@ -1100,7 +1104,9 @@ int XrdCmsCluster::Select(SMask_t pmask, int &port, char *hbuff, int &hlen,
 //
    if (isMulti || baseFS.isDFS())
       {STMutex.Lock();
-       nP = (Config.sched_RR ? SelbyRef(pmask,selR) : SelbyLoad(pmask,selR));
+            if (Config.P_lat)   nP = SelbyLat(pmask,selR);
+       else if (Config.sched_RR) nP = SelbyRef(pmask,selR);
+       else                      nP = SelbyLoad(pmask,selR);
        if (nP) hlen = nP->netIF.GetName(hbuff, port, nType) + 1;
           else hlen = 0;
        STMutex.UnLock();
@@ -1251,12 +1257,18 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
    static const char statfmt5[] =
           "<frq><add>%lld<d>%lld</d></add><rsp>%lld<m>%lld</m></rsp>"
           "<lf>%lld</lf><ls>%lld</ls><rf>%lld</rf><rs>%lld</rs></frq>";
+   static const char statfmt6[] =
+          "<cache><lu>%lld<h>%lld</h><m>%lld</m><n>%lld</n></lu>"
+          "<lt>%lld<mx>%lld</mx></lt></cache>";
 
    static int AddFrq = (Config.RepStats & XrdCmsConfig::RepStat_frq);
    static int AddShr = (Config.RepStats & XrdCmsConfig::RepStat_shr)
                        && Config.asMetaMan();
+   static int AddCache = (Config.RepStats & XrdCmsConfig::RepStat_cache)
+                       && Config.asManager();
 
    XrdCmsRRQ::Info Frq;
+   XrdCmsCache::Info Lup;
    XrdCmsSelected *sp;
    long long SelRnum, SelWnum;
    int mlen, tlen, n = 0;
@@ -1280,12 +1292,14 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
           (sizeof(statfmt2) + 10*2 + 256 + 16) * STMax + sizeof(statfmt4);
        if (AddShr) n += sizeof(statfmt3) + 12;
        if (AddFrq) n += sizeof(statfmt4) + (10*8);
+       if (AddCache) n += sizeof(statfmt6) + (20*6);
        return n;
       }
 
 // Get the statistics
 //
    if (AddFrq) RRQ.Statistics(Frq);
+   if (AddCache) Cache.Statistics(Lup);
    mngrsp.sp = sp = List(FULLMASK, LS_NULL, oksel);
 
 // Count number of nodes we have
@@ -1336,6 +1350,15 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
        bfr += mlen; bln -= mlen; tlen += mlen;
       }
 
+// Lookup time is reported as the average and maximum in nanoseconds
+//
+   if (AddCache && bln > 0)
+      {long long luAll = Lup.luHit + Lup.luMiss + Lup.luNeg;
+       mlen = snprintf(bfr, bln, statfmt6, luAll, Lup.luHit, Lup.luMiss,
+                       Lup.luNeg, (luAll ? Lup.luTime/luAll : 0), Lup.luMax);
+       bfr += mlen; bln -= mlen; tlen += mlen;
+      }
+
 // See if we overflowed. otherwise finish up
 //
    if (sp || bln < (int)sizeof(statfmt0)) return 0;
@@ -1571,8 +1594,10 @@ int XrdCmsCluster::SelNode(XrdCmsSelect &Sel, SMask_t pmask, SMask_t amask)
    mask = pmask & peerMask;
    while(pass--)
         {if (mask)
-            {nP = (Config.sched_RR || (Sel.Opts & XrdCmsSelect::UseRef)
-                ?  SelbyRef(mask,selR) : SelbyLoad(mask,selR));
+            {     if (Sel.Opts & XrdCmsSelect::UseRef) nP = SelbyRef(mask,selR);
+             else if (Config.P_lat && !selR.selPack)  nP = SelbyLat(mask,selR);
+             else nP = (Config.sched_RR ? SelbyRef(mask,selR)
+                                        : SelbyLoad(mask,selR));
              if (nP || (selR.nPick && selR.delay)
              ||  NodeCnt < Config.SUPCount) break;
             }
@@ -1721,6 +1746,82 @@ XrdCmsNode *XrdCmsCluster::SelbyCost(SMask_t mask, XrdCmsSelector &selR)
    return sp;
 }
   
+/******************************************************************************/
+/*                              S e l b y L a t                               */
+/******************************************************************************/
+
+// Latency selection samples two eligible nodes at random and picks the one
+// with the better mix of reported load and observed response time (the
+// power of two choices). Response times are measured here, so a node that
+// slows down stops attracting new clients well before its load reports do.
+
+// Caller must have the STMutex locked. The returned node. if any, is unlocked.
+
+XrdCmsNode *XrdCmsCluster::SelbyLat(SMask_t mask, XrdCmsSelector &selR)
+{
+    XrdCmsNode *np, *sp, *cand[STMax];
+    bool reqSS = (selR.needSpace & XrdCmsNode::allowsSS) != 0;
+    int  i, n = 0, a, b, latA, latB, latM, ldA, ldB, scA, scB;
+
+// Collect the eligible nodes (preset possible, suspended, overloaded, full)
+//
+   selR.Reset(); SelTcnt++;
+   for (i = 0; i <= STHi; i++)
+       if ((np = NodeTab[i]) && (np->NodeMask & mask))
+          {if (!(selR.needNet & np->hasNet))      {selR.xNoNet= true; continue;}
+           selR.nPick++;
+           if (np->isOffline)                     {selR.xOff  = true; continue;}
+           if (np->isBad)                         {selR.xSusp = true; continue;}
+           if (!Config.sched_RR && np->myLoad > Config.MaxLoad)
+              {selR.xOvld = true; continue;}
+           if (selR.needSpace && (np->DiskFree < np->DiskMinF
+                                  || (reqSS && np->isNoStage)))
+              {selR.xFull = true; continue;}
+           cand[n++] = np;
+          }
+
+// Check for overloaded node and pick two distinct candidates
+//
+   if (!n) return calcDelay(selR);
+   if (n == 1) sp = cand[0];
+      else {SelSeed ^= SelSeed << 13; SelSeed ^= SelSeed >> 17;
+            SelSeed ^= SelSeed << 5;
+            a = SelSeed % n;
+            b = (SelSeed / n) % (n - 1);
+            if (b >= a) b++;
+
+// Score each one. Latency is scaled against the slower of the two so that
+// both factors range from 0 to 100. Loads are meaningless for round robin.
+//
+            latA = cand[a]->Latency(); latB = cand[b]->Latency();
+            latM = (latA > latB ? latA : latB);
+            if (Config.sched_RR) ldA = ldB = 0;
+               else if (selR.needSpace)
+                       {ldA = cand[a]->myMass; ldB = cand[b]->myMass;}
+               else    {ldA = cand[a]->myLoad; ldB = cand[b]->myLoad;}
+            scA = (100 - Config.P_lat) * ldA;
+            scB = (100 - Config.P_lat) * ldB;
+            if (latM)
+               {scA += Config.P_lat * (int)((100LL * latA) / latM);
+                scB += Config.P_lat * (int)((100LL * latB) / latM);
+               }
+
+// Close scores are resolved by the reference counts
+//
+            if (abs(scA - scB) <= Config.P_fuzz * 100)
+               {if (selR.needSpace)
+                   sp = (cand[a]->RefW > cand[b]->RefW+Config.DiskLinger
+                      ? cand[b] : cand[a]);
+                   else sp = (cand[a]->RefR > cand[b]->RefR ? cand[b] : cand[a]);
+               } else sp = (scA > scB ? cand[b] : cand[a]);
+           }
+
+// Return result
+//
+   RefCount(sp, (n > 1), selR.needSpace);
+   return sp;
+}
+
 /******************************************************************************/
 /*                             S e l b y L o a d                              */
 /******************************************************************************/
@@ -221,6 +221,7 @@ enum        {eExists, eDups, eROfs, eNoRep, eNoSel, eNoEnt}; // Passed to SelFai
 int         SelFail(XrdCmsSelect &Sel, int rc);
 int         SelNode(XrdCmsSelect &Sel, SMask_t  pmask, SMask_t  amask);
 XrdCmsNode *SelbyCost(SMask_t, XrdCmsSelector &selR);
+XrdCmsNode *SelbyLat (SMask_t, XrdCmsSelector &selR);
 XrdCmsNode *SelbyLoad(SMask_t, XrdCmsSelector &selR);
 XrdCmsNode *SelbyRef (SMask_t, XrdCmsSelector &selR);
 int         SelDFS(XrdCmsSelect &Sel, SMask_t amask,
@@ -245,6 +246,7 @@ long long     SelWtot;          // Total number of r/w selections (successful)
 long long     SelRcnt;          // Curr  number of r/o selections (successful)
 long long     SelRtot;          // Total number of r/o selections (successful)
 long long     SelTcnt;          // Total number of all selections
+unsigned int  SelSeed;          // Random state for SelbyLat() (STMutex)
 
 // The following is a list of IP:Port tokens that identify supervisor nodes.
 // The information is sent via the try request to redirect nodes; as needed.
@@ -384,7 +384,8 @@ int XrdCmsConfig::Configure2()
 //
    if (QryDelay < 0) QryDelay = LUPDelay;
    if (isManager) 
-      NoGo = !Cache.Init(cachelife,LUPDelay,QryDelay,baseFS.isDFS(),emptylife);
+      NoGo = !Cache.Init(cachelife,LUPDelay,QryDelay,baseFS.isDFS(),emptylife,
+                         nxcachelife);
 
 // Issue warning if the adminpath resides in /tmp
 //
@@ -677,6 +678,7 @@ void XrdCmsConfig::ConfigDefaults(void)
    P_load   = 0;
    P_mem    = 0;
    P_pag    = 0;
+   P_lat    = 0;
    AskPerf  = 10;         // Every 10 pings
    AskPing  = 60;         // Every  1 minute
    PingTick = 0;
@@ -734,6 +736,7 @@ void XrdCmsConfig::ConfigDefaults(void)
    Police   = 0;
    cachelife= 8*60*60;
    emptylife= 0;
+   nxcachelife = XrdCmsCache::def_nxCache;
    pendplife=   60*60*24*7;
    DiskLinger=0;
    ProgCH   = 0;
@@ -1075,6 +1078,8 @@ int XrdCmsConfig::setupManager()
       {Say.Say("Config round robin scheduling in effect.");
        sched_Level = 0;
       }
+   if (P_lat && isManager)
+      Say.Say("Config latency aware scheduling in effect.");
 
 // Create statistical monitoring thread
 //
@@ -1840,9 +1845,13 @@ int XrdCmsConfig::xfsxq(XrdSysError *eDest, XrdOucStream &CFile)
 
 /* Function: xfxhld
 
-   Purpose:  To parse the directive: fxhold [noloc <nls>] <sec>
+   Purpose:  To parse the directive: fxhold [noloc <nls>] [nxcache <nxs>] <sec>
 
              <nls>  number of seconds (or M, H, etc) to cache file non-existence
+             <nxs>  number of seconds (or M, H, etc) to remember that a file
+                    does not exist once its cache entry is gone; the default
+                    of 0 disables it. The value is capped by <nls> when noloc
+                    is specified.
              <sec>  number of seconds (or M, H, etc) to cache file     existence
 
    Type: Manager only, dynamic.
@@ -1860,14 +1869,28 @@ int XrdCmsConfig::xfxhld(XrdSysError *eDest, XrdOucStream &CFile)
     if (!(val = CFile.GetWord()))
        {eDest->Emsg("Config", "fxhold value not specified."); return 1;}
 
-    if (!strcmp(val, "noloc"))
-       {if (!(val = CFile.GetWord()))
-           {eDest->Emsg("Config","fxhold noloc value not specified."); return 1;}
-        if (XrdOuca2x::a2tm(*eDest, "fxhold noloc value", val, &ct,
-                                    XrdCmsCache:: min_nxTime)) return 1;
-        emptylife = ct;
-        if (!(val = CFile.GetWord())) return 0;
-       }
+    while(1)
+         {if (!strcmp(val, "noloc"))
+             {if (!(val = CFile.GetWord()))
+                 {eDest->Emsg("Config","fxhold noloc value not specified.");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2tm(*eDest, "fxhold noloc value", val, &ct,
+                                          XrdCmsCache:: min_nxTime)) return 1;
+              emptylife = ct;
+             }
+          else if (!strcmp(val, "nxcache"))
+             {if (!(val = CFile.GetWord()))
+                 {eDest->Emsg("Config","fxhold nxcache value not specified.");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2tm(*eDest, "fxhold nxcache value", val, &ct, 0))
+                 return 1;
+              nxcachelife = ct;
+             }
+          else break;
+          if (!(val = CFile.GetWord())) return 0;
+         }
 
     if (XrdOuca2x::a2tm(*eDest, "fxhold value", val, &ct, 60)) return 1;
 
@@ -2434,6 +2457,7 @@ int XrdCmsConfig::xreps(XrdSysError *eDest, XrdOucStream &CFile)
     static struct repsopts {const char *opname; int opval;} rsopts[] =
        {
         {"all",      RepStat_All},
+        {"cache",    RepStat_cache},
         {"frq",      RepStat_frq},
         {"shr",      RepStat_shr}
        };
@@ -2645,6 +2669,7 @@ int XrdCmsConfig::xrole(XrdSysError *eDest, XrdOucStream &CFile)
                                        [io <p>] [runq <p>]
                                        [mem <p>] [pag <p>] [space <p>]
                                        [fuzz <p>] [maxload <p>] [refreset <sec>]
+                                       [latency <p>]
                 [affinity [default] {none | weak | strong | strict}]
 
              <p>      is the percentage to include in the load as a value
@@ -2655,7 +2680,9 @@ int XrdCmsConfig::xrole(XrdSysError *eDest, XrdOucStream &CFile)
                       between reference counter resets. gshr is the percentage
                       share of requests that should be redirected here via the 
                       metamanager (i.e. global share). The gsdflt is the
-                      default to be used by the metamanager.
+                      default to be used by the metamanager. latency is the
+                      weight given to observed node response times when two
+                      randomly chosen nodes are compared (0 disables it).
 
    Type: Any, dynamic.
 
@@ -2677,6 +2704,7 @@ int XrdCmsConfig::xsched(XrdSysError *eDest, XrdOucStream &CFile)
         {"runq",     100, &P_load}, // Actually load, runq to avoid confusion
         {"mem",      100, &P_mem},
         {"pag",      100, &P_pag},
+        {"latency",  100, &P_lat},
         {"space",    100, &P_dsk},
         {"maxload",  100, &MaxLoad},
         {"refreset", -1,  &RefReset},
@@ -103,6 +103,7 @@ int         P_io;         // % I/O Capacity in load factor
 int         P_load;       // % MSC Capacity in load factor
 int         P_mem;        // % MEM Capacity in load factor
 int         P_pag;        // % PAG Capacity in load factor
+int         P_lat;        // % Response latency in selection (0 -> not used)
 
 char        DoMWChk;      // When true (default) perform multiple write check
 char        DoHnTry;      // When true (default) use hostnames for try redirs
@@ -187,6 +188,7 @@ XrdNetSecurity    *Police;
 //
 static const int RepStat_frq    = 0x0001; // Fast Response Queue
 static const int RepStat_shr    = 0x0002; // Share
+static const int RepStat_cache  = 0x0004; // Location cache
 static const int RepStat_All    = 0xffff; // All
 
 private:
@@ -256,6 +258,7 @@ char             *perfpgm;
 int               perfint;
 int               cachelife;
 int               emptylife;
+int               nxcachelife;
 int               pendplife;
 int               FSlim;
 };
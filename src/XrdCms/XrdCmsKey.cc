@@ -58,7 +58,7 @@ void XrdCmsKey::setHash()
 /*                           S t a t i c   D a t a                            */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::TockTable[TickRate] = {0};
+XrdSysMutex    XrdCmsKeyItem::freeMutex;
 XrdCmsKeyItem *XrdCmsKeyItem::Free    = 0;
 int            XrdCmsKeyItem::numFree = 0;
 int            XrdCmsKeyItem::numHave = 0;
@@ -68,25 +68,25 @@ int            XrdCmsKeyItem::numNull = 0;
 /* static public                   A l l o c                                  */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
+XrdCmsKeyItem *XrdCmsKeyItem::Alloc()
 {
   XrdCmsKeyItem *kP;
 
 // Try to allocate an existing item or replenish the list
 //
+   freeMutex.Lock();
    do {if ((kP = Free))
           {Free = kP->Next;
            numFree--;
-           theTock &= TickMask;
-           kP->Key.TOD    = theTock;
-           kP->Key.TODRef = TockTable[theTock];
-           TockTable[theTock] = kP;
+           freeMutex.UnLock();
+           kP->Key.TODRef = 0;
            if (!(kP->Key.Ref++)) kP->Key.Ref = 1;
             kP->Loc.roPend = kP->Loc.rwPend = 0;
            return kP;
           }
        numNull++;
-       } while(Replenish());
+       } while(AddFree());
+   freeMutex.UnLock();
 
 // We failed
 //
@@ -109,19 +109,10 @@ void XrdCmsKeyItem::Recycle()
 
 // Put entry on the free list
 //
+   freeMutex.Lock();
    Next = Free; Free = this;
    numFree++;
-}
-
-/******************************************************************************/
-/* public                         R e l o a d                                 */
-/******************************************************************************/
-  
-void XrdCmsKeyItem::Reload()
-{
-   Key.TOD &= static_cast<unsigned char>(TickMask);
-   Key.TODRef = TockTable[Key.TOD];
-   TockTable[Key.TOD] = this;
+   freeMutex.UnLock();
 }
 
 /******************************************************************************/
@@ -130,26 +121,12 @@ void XrdCmsKeyItem::Reload()
 
 int XrdCmsKeyItem::Replenish()
 {
-   EPNAME("Replenish");
-   XrdCmsKeyItem *kP;
-   int i;
-
-// Allocate a quantum of free elements and chain them into the free list
-//
-   if (!(kP = new XrdCmsKeyItem[minAlloc])) return 0;
-   DEBUG("old free " <<numFree <<" + " <<minAlloc <<" = " <<numHave+minAlloc);
+   int n;
 
-// We would do this in an initializer but that causes problems when alloacting
-// temporary items on the stack. So, manually put these on the free list.
-//
-   i = minAlloc;
-   while(i--) {kP->Next = Free; Free = kP; kP++;}
-  
-// Return the number we have free
-//
-   numHave += minAlloc;
-   numFree += minAlloc;
-   return numFree;
+   freeMutex.Lock();
+   n = AddFree();
+   freeMutex.UnLock();
+   return n;
 }
 
 /******************************************************************************/
@@ -159,52 +136,40 @@ int XrdCmsKeyItem::Replenish()
 void XrdCmsKeyItem::Stats(int &isAlloc, int &isFree, int &wasNull)
 {
 
+   freeMutex.Lock();
    isAlloc  = numHave;
    isFree   = numFree;
    wasNull  = numNull;
    numNull  = 0;
+   freeMutex.UnLock();
 }
 
 /******************************************************************************/
-/* static public                  U n l o a d                                 */
+/* static private                 A d d F r e e                               */
 /******************************************************************************/
-  
-XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
+
+// The freeMutex must be held upon entry.
+
+int XrdCmsKeyItem::AddFree()
 {
-   XrdCmsKeyItem myItem, *nP, *pP = &myItem;
+   EPNAME("Replenish");
+   XrdCmsKeyItem *kP;
+   int i;
 
-// Remove all entries from the indicated list. If any entries have been
-// reassigned to a different list, move them to the right list. Otherwise,
-// make the entry unfindable by clearing the hash code. Since item recycling
-// requires knowing the hash code, we save it elsewhere in the object.
+// Allocate a quantum of free elements and chain them into the free list
 //
-   theTock &= TickMask;
-   myItem.Key.TODRef = TockTable[theTock]; TockTable[theTock] = 0;
-   while((nP = pP->Key.TODRef))
-         if (nP->Key.TOD == theTock) 
-            {nP->Loc.HashSave = nP->Key.Hash; nP->Key.Hash = 0; pP = nP;}
-            else {pP->Key.TODRef = nP->Key.TODRef;
-                  nP->Key.TODRef = TockTable[nP->Key.TOD];
-                  TockTable[nP->Key.TOD] = nP;
-                 }
-   return myItem.Key.TODRef;
-}
+   if (!(kP = new XrdCmsKeyItem[minAlloc])) return 0;
+   DEBUG("old free " <<numFree <<" + " <<minAlloc <<" = " <<numHave+minAlloc);
 
-/******************************************************************************/
+// We would do this in an initializer but that causes problems when alloacting
+// temporary items on the stack. So, manually put these on the free list.
+//
+   i = minAlloc;
+   while(i--) {kP->Next = Free; Free = kP; kP++;}
   
-XrdCmsKeyItem *XrdCmsKeyItem::Unload(XrdCmsKeyItem *theItem)
-{
-   XrdCmsKeyItem *kP, *pP = 0;
-   unsigned int theTock = theItem->Key.TOD & TickMask;
-
-// Remove the entry from the right list
+// Return the number we have free
 //
-   kP = TockTable[theTock];
-   while(kP && kP != theItem) {pP = kP; kP = kP->Key.TODRef;}
-   if (kP)
-      {if (pP) pP->Key.TODRef     = kP->Key.TODRef;
-          else TockTable[theTock] = kP->Key.TODRef;
-       kP->Loc.HashSave = kP->Key.Hash; kP->Key.Hash = 0;
-      }
-   return kP;
+   numHave += minAlloc;
+   numFree += minAlloc;
+   return numFree;
 }
@@ -32,6 +32,10 @@
 
 #include "XrdCms/XrdCmsKey.hh"
   
+// The XrdCmsNash object holds the items of one cache shard. Items are also
+// kept in lists according to the time-of-day window (TOD) of their last
+// refresh so that a whole window can be aged out at once.
+//
 class XrdCmsNash
 {
 public:
@@ -41,6 +45,10 @@ XrdCmsKeyItem *Find(XrdCmsKey &Key);
 
 int            Recycle(XrdCmsKeyItem *rip);
 
+XrdCmsKeyItem *Unload(unsigned int   theTock);
+
+XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem);
+
 // When allocateing a new nash, specify the required starting size. Make
 // sure that the previous number is the correct Fibonocci antecedent. The
 // series is simply n[j] = n[j-1] + n[j-2].
@@ -54,6 +62,7 @@ static const int LoadMax = 80;
 
 void               Expand();
 
+XrdCmsKeyItem   *TockTable[XrdCmsKeyItem::TickRate];
 XrdCmsKeyItem  **nashtable;
 int              prevtablesize;
 int              nashtablesize;
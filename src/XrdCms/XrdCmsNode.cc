@@ -127,6 +127,10 @@ XrdCmsNode::XrdCmsNode(XrdLink *lnkp, const char *theIF, const char *nid,
     Share    =  0;
     Shrem    =  0;
     Shrin    =  0;
+    latPingT =  0;
+    latQNext =  0;
+    latEWMA  =  0;
+    memset(latQTab, 0, sizeof(latQTab));
     logload  =  Config.LogPerf;
     DropTime =  0;
     DropJob  =  0;
@@ -477,6 +481,7 @@ const char *XrdCmsNode::do_Have(XrdCmsRRData &Arg)
    if (!Config.asManager()) isnew = 1;
       else {XrdCmsSelect Sel(XrdCmsSelect::Advisory|Opts,Arg.Path,Arg.PathLen-1);
             Sel.Path.Hash = Arg.Request.streamid;
+            if (Config.P_lat) latHave(Sel.Path.Hash);
             if (baseFS.isDFS())
                {Sel.Vec.hf = pinfo.rovec; Sel.Vec.wf = pinfo.rwvec;
                 isnew       = Cache.AddFile(Sel, allNodes);
@@ -906,6 +911,7 @@ const char *XrdCmsNode::do_Pong(XrdCmsRRData &Arg)
 // Process: pong
 // Reponds: n/a
 
+   latPong();
    return 0;
 }
   
@@ -1711,6 +1717,86 @@ const char *XrdCmsNode::do_Usage(XrdCmsRRData &Arg)
    return 0;
 }
 
+/******************************************************************************/
+/*                               L a t e n c y                                */
+/******************************************************************************/
+  
+int XrdCmsNode::Latency()
+{
+   long long pingT = latPingT;
+   int lat = latEWMA;
+
+// A ping that has been outstanding for longer than the average is a better
+// estimate of how this node is responding right now.
+//
+   if (pingT)
+      {long long waitT = latNow() - pingT;
+       if (waitT > lat) lat = (waitT > INT_MAX ? INT_MAX : (int)waitT);
+      }
+   return lat;
+}
+
+/******************************************************************************/
+/*                               l a t H a v e                                */
+/******************************************************************************/
+
+void XrdCmsNode::latHave(unsigned int pHash)
+{
+   long long sample = 0;
+   int i;
+
+// Find the query this have answers, if any. Unsolicited haves are ignored.
+//
+   latMutex.Lock();
+   for (i = 0; i < latQNum; i++)
+       if (latQTab[i].When && latQTab[i].Hash == pHash)
+          {sample = latNow() - latQTab[i].When;
+           latQTab[i].When = 0;
+           break;
+          }
+   if (sample) latAdd(sample);
+   latMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                               l a t P i n g                                */
+/******************************************************************************/
+
+void XrdCmsNode::latPing()
+{
+// Only the first of several unanswered pings is timed
+//
+   latMutex.Lock();
+   if (!latPingT) latPingT = latNow();
+   latMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                               l a t P o n g                                */
+/******************************************************************************/
+
+void XrdCmsNode::latPong()
+{
+   latMutex.Lock();
+   if (latPingT) {latAdd(latNow() - latPingT); latPingT = 0;}
+   latMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                              l a t Q u e r y                               */
+/******************************************************************************/
+
+void XrdCmsNode::latQuery(unsigned int pHash)
+{
+// Remember when the query was sent; the oldest query is overwritten
+//
+   latMutex.Lock();
+   latQTab[latQNext].Hash = pHash;
+   latQTab[latQNext].When = latNow();
+   latQNext = (latQNext + 1) % latQNum;
+   latMutex.UnLock();
+}
+
 /******************************************************************************/
 /*                          R e p o r t _ U s a g e                           */
 /******************************************************************************/
@@ -1858,3 +1944,30 @@ int XrdCmsNode::getSize(const char *theSize, long long &Size)
    if (!(Size = strtoll(theSize, &eP, 10)) || *eP) return 0;
    return 1;
 }
+
+/******************************************************************************/
+/*                                l a t A d d                                 */
+/******************************************************************************/
+
+// Caller must hold latMutex. New samples carry a weight of 1/4 so that a node
+// that slows down is noticed after a handful of responses.
+//
+void XrdCmsNode::latAdd(long long sample)
+{
+   if (sample > INT_MAX) sample = INT_MAX;
+   if (!latEWMA) latEWMA = (int)sample;
+      else latEWMA += ((int)sample - latEWMA) / 4;
+   if (!latEWMA) latEWMA = 1;
+}
+
+/******************************************************************************/
+/*                                l a t N o w                                 */
+/******************************************************************************/
+
+long long XrdCmsNode::latNow()
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return static_cast<long long>(ts.tv_sec)*1000000LL + ts.tv_nsec/1000;
+}
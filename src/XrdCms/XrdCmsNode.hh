@@ -145,6 +145,18 @@ inline int    isNode(XrdLink *lp, const char *nid, int port)
                      return netID.Same(lp->NetAddr()) && port == netIF.Port();
                     }
 
+// Manager-side response time tracking. The latency is an exponentially
+// weighted moving average (in microseconds) of the ping and state query
+// round trips to this node. An outstanding ping that is older than the
+// average counts as the current latency so that a stalled node is noticed
+// before it answers.
+//
+       int    Latency();
+       void   latHave(unsigned int pHash);
+       void   latPing();
+       void   latPong();
+       void   latQuery(unsigned int pHash);
+
 inline char  *Name()   {return (myName ? myName : (char *)"?");}
 
 inline SMask_t Mask() {return NodeMask;}
@@ -232,6 +244,8 @@ static const int fsL2PFail2 = 999992;
 const  char *fsFail(const char *Who, const char *What, const char *Path, int rc);
        int   getMode(const char *theMode, mode_t &Mode);
        int   getSize(const char *theSize, long long &Size);
+       void  latAdd(long long sample);
+static long long latNow();
 
 XrdSysCondVar      nodeMutex;
 unsigned int       lkCount;  // Only Modified with global lock held
@@ -273,6 +287,17 @@ char               Shrip;        // Share of requests to skip
 char               Rsvd[2];
 int                Shrin;        // Share intervals used
 
+// The following fields track response times (see Latency()). Queries are
+// remembered in a small ring and matched against the "have" responses.
+//
+static const int   latQNum = 16;
+struct latQry {unsigned int Hash; long long When;};
+XrdSysMutex        latMutex;
+latQry             latQTab[latQNum];
+long long          latPingT;     // When the outstanding ping was sent or 0
+int                latQNext;
+int                latEWMA;      // Average round trip in microseconds
+
 // The following fields are used to keep the supervisor's free space value
 //
 static XrdSysMutex mlMutex;
@@ -1161,6 +1161,7 @@ bool XrdCmsProtocol::SendPing()
 // Send the ping
 //
    if (Link->Send((char *)&Ping, sizeof(Ping)) < 0) return false;
+   if (Config.P_lat) myNode->latPing();
    return true;
 }
   
@@ -369,6 +369,15 @@ XrdCryptoX509GetVOMSAttr_t XrdCryptoFactory::X509GetVOMSAttr()
    return 0;
 }
 
+//______________________________________________________________________________
+XrdCryptoX509GetVOMSExpire_t XrdCryptoFactory::X509GetVOMSExpire()
+{
+   // Get end of validity of VOMS attributes, if any
+
+   ABSTRACTMETHOD("XrdCryptoFactory::X509GetVOMSExpire");
+   return 0;
+}
+
 
 /* ************************************************************************** */
 /*                                                                            */
@@ -112,6 +112,9 @@ typedef int (*XrdCryptoX509CheckProxy3_t)(XrdCryptoX509 *, XrdOucString &);
 // get VOMS attributes
 typedef int (*XrdCryptoX509GetVOMSAttr_t)(XrdCryptoX509 *, XrdOucString &);
 
+// get end of validity of VOMS attributes
+typedef int (*XrdCryptoX509GetVOMSExpire_t)(XrdCryptoX509 *, time_t &);
+
 class XrdCryptoFactory
 {
 private:
@@ -183,6 +186,7 @@ public:
    virtual XrdCryptoX509SignProxyReq_t X509SignProxyReq();
    virtual XrdCryptoX509CheckProxy3_t X509CheckProxy3();
    virtual XrdCryptoX509GetVOMSAttr_t X509GetVOMSAttr();
+   virtual XrdCryptoX509GetVOMSExpire_t X509GetVOMSExpire();
 
    // Equality operator
    bool operator==(const XrdCryptoFactory factory);
@@ -36,6 +36,7 @@
 #include <stdlib.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <algorithm>
 
 #include "XrdCrypto/XrdCryptoX509Chain.hh"
 #include "XrdCrypto/XrdCryptosslAux.hh"
@@ -547,8 +548,12 @@ int XrdCryptosslX509ParseBucket(XrdSutBucket *b, XrdCryptoX509Chain *chain)
    // If we found something, and we are asked to extract a key,
    // refill the BIO and search again for the key (this is mandatory
    // as read operations modify the BIO contents; a read-only BIO
-   // may be more efficient)
-   if (nci && BIO_write(bmem,(const void *)(b->buffer),b->size) == b->size) {
+   // may be more efficient). Buckets received from peers carry no key:
+   // do not pay for a full PEM scan unless a key block is there.
+   static const char pkmark[] = "PRIVATE KEY-----";
+   bool haskey = (std::search(b->buffer, b->buffer + b->size,
+                              pkmark, pkmark + sizeof(pkmark) - 1) != b->buffer + b->size);
+   if (nci && haskey && BIO_write(bmem,(const void *)(b->buffer),b->size) == b->size) {
       RSA  *rsap = 0;
       if (!PEM_read_bio_RSAPrivateKey(bmem, &rsap, 0, 0)) {
          DEBUG("no RSA private key found in bucket ");
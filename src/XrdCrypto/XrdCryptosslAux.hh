@@ -87,6 +87,8 @@ int XrdCryptosslX509SignProxyReq(XrdCryptoX509 *, XrdCryptoRSA *,
 int XrdCryptosslX509CheckProxy3(XrdCryptoX509 *, XrdOucString &);
 // Get VOMS attributes, if any
 int XrdCryptosslX509GetVOMSAttr(XrdCryptoX509 *, XrdOucString &);
+// Get end of validity of VOMS attributes, if any
+int XrdCryptosslX509GetVOMSExpire(XrdCryptoX509 *, time_t &);
 
 /******************************************************************************/
 /*          E r r o r   L o g g i n g / T r a c i n g   F l a g s             */
@@ -515,6 +515,14 @@ XrdCryptoX509GetVOMSAttr_t XrdCryptosslFactory::X509GetVOMSAttr()
    return &XrdCryptosslX509GetVOMSAttr;
 }
 
+//______________________________________________________________________________
+XrdCryptoX509GetVOMSExpire_t XrdCryptosslFactory::X509GetVOMSExpire()
+{
+   // Get end of validity of VOMS attributes, if any
+
+   return &XrdCryptosslX509GetVOMSExpire;
+}
+
 
 /******************************************************************************/
 /*            X r d C r y p t o S s l F a c t o r y O b j e c t               */
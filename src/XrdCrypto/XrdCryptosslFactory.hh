@@ -105,6 +105,7 @@ public:
    XrdCryptoX509SignProxyReq_t X509SignProxyReq();
    XrdCryptoX509CheckProxy3_t X509CheckProxy3();
    XrdCryptoX509GetVOMSAttr_t X509GetVOMSAttr();
+   XrdCryptoX509GetVOMSExpire_t X509GetVOMSExpire();
 
    // Required SSL mutexes.
   static  XrdSysMutex*              CryptoMutexPool[SSLFACTORY_MAX_CRYPTO_MUTEX];
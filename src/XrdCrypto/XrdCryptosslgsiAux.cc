@@ -119,6 +119,8 @@ int XrdCryptosslX509Asn1PrintInfo(int tag, int xclass, int constructed, int inde
 int XrdCryptosslX509FillUnknownExt(XRDGSI_CONST unsigned char **pp, long length);
 int XrdCryptosslX509FillVOMS(XRDGSI_CONST unsigned char **pp,
                           long length, bool &getvat, XrdOucString &vat);
+void XrdCryptosslX509FillVOMSExpire(XRDGSI_CONST unsigned char *p,
+                                    long length, time_t &expire);
 
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 //                                                                           //
@@ -1198,6 +1200,81 @@ int XrdCryptosslX509GetVOMSAttr(XrdCryptoX509 *xcpi, XrdOucString &vat)
    return rc;
 }
 
+//____________________________________________________________________________
+int XrdCryptosslX509GetVOMSExpire(XrdCryptoX509 *xcpi, time_t &expire)
+{
+   // Get the end of validity of the VOMS attribute certificates in the
+   // certificate, if present; the earliest one if there are several
+   // Return 0 in case of success, 1 if VOMS info is not available, < 0 if any
+   // error occured
+   EPNAME("X509GetVOMSExpire");
+
+   // Make sure we got the right inputs
+   if (!xcpi) {
+      PRINT("invalid inputs");
+      return -1;
+   }
+
+   // Point to the cerificate
+   X509 *xpi = (X509 *)(xcpi->Opaque());
+
+   expire = -1;
+   int npiext = X509_get_ext_count(xpi);
+   for (int i = 0; i< npiext; i++) {
+      X509_EXTENSION *xpiext = X509_get_ext(xpi, i);
+      char s[256];
+      OBJ_obj2txt(s, sizeof(s), X509_EXTENSION_get_object(xpiext), 1);
+      if (strcmp(s, XRDGSI_VOMS_ACSEQ_OID)) continue;
+      XRDGSI_CONST unsigned char *pp = (XRDGSI_CONST unsigned char *) X509_EXTENSION_get_data(xpiext)->data;
+      long length = X509_EXTENSION_get_data(xpiext)->length;
+      XrdCryptosslX509FillVOMSExpire(pp, length, expire);
+      if (expire < 0) {
+         PRINT("ERROR: no validity period found in VOMS attribute certificate");
+         return -1;
+      }
+   }
+
+   // Done
+   DEBUG("expire: " << expire);
+   return (expire < 0) ? 1 : 0;
+}
+
+//____________________________________________________________________________
+void XrdCryptosslX509FillVOMSExpire(XRDGSI_CONST unsigned char *p,
+                                    long length, time_t &expire)
+{
+   // Look recursively for the validity periods of the attribute certificates,
+   // sequences of two generalized times (RFC 5755); the earliest end of
+   // validity is kept in 'expire'
+
+   XRDGSI_CONST unsigned char *tot = p + length;
+   while (p < tot) {
+      long len;
+      int tag, xclass;
+      int j = ASN1_get_object(&p, &len, &tag, &xclass, (long)(tot - p));
+      // Errors and indefinite lengths, which DER does not use, end the search
+      if ((j & 0x80) || (j == 0x21)) return;
+      if (!(j & V_ASN1_CONSTRUCTED)) {
+         p += len;
+         continue;
+      }
+      if (tag == V_ASN1_SEQUENCE && xclass == V_ASN1_UNIVERSAL) {
+         XRDGSI_CONST unsigned char *q = p;
+         ASN1_GENERALIZEDTIME *nbf = d2i_ASN1_GENERALIZEDTIME(0, &q, len);
+         ASN1_GENERALIZEDTIME *naf = nbf ? d2i_ASN1_GENERALIZEDTIME(0, &q, (long)(p + len - q)) : 0;
+         int day, sec;
+         if (naf && q == p + len && ASN1_TIME_diff(&day, &sec, 0, naf)) {
+            time_t t = time(0) + (time_t)day * 86400 + sec;
+            if (expire < 0 || t < expire) expire = t;
+         }
+         if (nbf) ASN1_GENERALIZEDTIME_free(nbf);
+         if (naf) ASN1_GENERALIZEDTIME_free(naf);
+      }
+      XrdCryptosslX509FillVOMSExpire(p, len, expire);
+      p += len;
+   }
+}
+
 //____________________________________________________________________________
 int XrdCryptosslX509FillVOMS(XRDGSI_CONST unsigned char **pp,
                           long length, bool &getvat, XrdOucString &vat)
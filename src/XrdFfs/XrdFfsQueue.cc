@@ -35,9 +35,16 @@
   extern "C" {
 #endif
 
+/*
+   The task queue is a FIFO with a task count. Every enqueued task wakes up
+   one idle worker, so a burst of tasks is spread over the workers right
+   away instead of being drained by the one worker woken up when the queue
+   became non-empty.
+*/
 struct XrdFfsQueueTasks *XrdFfsQueueTaskque_head = NULL;
 struct XrdFfsQueueTasks *XrdFfsQueueTaskque_tail = NULL;
 unsigned int XrdFfsQueueNext_task_id = 0;
+unsigned int XrdFfsQueueNtasks = 0;
 pthread_mutex_t XrdFfsQueueTaskque_mutex = PTHREAD_MUTEX_INITIALIZER;
 pthread_cond_t XrdFfsQueueTaskque_cond = PTHREAD_COND_INITIALIZER;
 
@@ -45,23 +52,17 @@ void XrdFfsQueue_enqueue(struct XrdFfsQueueTasks *task)
 {
     pthread_mutex_lock(&XrdFfsQueueTaskque_mutex);
 
-    task->id = XrdFfsQueueNext_task_id + 1;
-    XrdFfsQueueNext_task_id = task->id;
+    task->id = ++XrdFfsQueueNext_task_id;
+    task->next = NULL;
+    task->prev = XrdFfsQueueTaskque_tail;
     if (XrdFfsQueueTaskque_tail == NULL) 
-    {
         XrdFfsQueueTaskque_head = task;
-        XrdFfsQueueTaskque_tail = task;
-        task->next = NULL;
-        pthread_cond_broadcast(&XrdFfsQueueTaskque_cond);
-    }
     else
-    {
-        task->prev = XrdFfsQueueTaskque_tail;
-        task->next = NULL;
         XrdFfsQueueTaskque_tail->next = task;
-        XrdFfsQueueTaskque_tail = task;
-    }
+    XrdFfsQueueTaskque_tail = task;
+    XrdFfsQueueNtasks++;
 
+    pthread_cond_signal(&XrdFfsQueueTaskque_cond);
     pthread_mutex_unlock(&XrdFfsQueueTaskque_mutex);
     return;
 }
@@ -69,24 +70,22 @@ void XrdFfsQueue_enqueue(struct XrdFfsQueueTasks *task)
 struct XrdFfsQueueTasks *XrdFfsQueue_dequeue()
 {
     struct XrdFfsQueueTasks *head;
-    while (pthread_mutex_lock(&XrdFfsQueueTaskque_mutex) == 0)
-        if (XrdFfsQueueTaskque_head == NULL)
-        {
-            pthread_cond_wait(&XrdFfsQueueTaskque_cond, &XrdFfsQueueTaskque_mutex);
-            pthread_mutex_unlock(&XrdFfsQueueTaskque_mutex);
-        }
-        else
-            break;
+
+    pthread_mutex_lock(&XrdFfsQueueTaskque_mutex);
+    while (XrdFfsQueueTaskque_head == NULL)
+        pthread_cond_wait(&XrdFfsQueueTaskque_cond, &XrdFfsQueueTaskque_mutex);
 
     head = XrdFfsQueueTaskque_head;
     XrdFfsQueueTaskque_head = XrdFfsQueueTaskque_head->next;
+    if (XrdFfsQueueTaskque_head == NULL)
+        XrdFfsQueueTaskque_tail = NULL;
+    else
+        XrdFfsQueueTaskque_head->prev = NULL;
+    XrdFfsQueueNtasks--;
 
     head->next = NULL;
     head->prev = NULL;        
 
-    if (XrdFfsQueueTaskque_head == NULL)
-        XrdFfsQueueTaskque_tail = NULL;
-
     pthread_mutex_unlock(&XrdFfsQueueTaskque_mutex);
     return head;
 }
@@ -122,28 +121,16 @@ void XrdFfsQueue_free_task(struct XrdFfsQueueTasks *task)
 void XrdFfsQueue_wait_task(struct XrdFfsQueueTasks *task)
 {
     pthread_mutex_lock(&task->mutex);
-    if (task->done != 1)
+    while (task->done != 1)
         pthread_cond_wait(&task->cond, &task->mutex);
     pthread_mutex_unlock(&task->mutex);
 }
 
 unsigned int XrdFfsQueue_count_tasks()
 {
-    unsigned int que_len = 0;
+    unsigned int que_len;
     pthread_mutex_lock(&XrdFfsQueueTaskque_mutex);
-    if (XrdFfsQueueTaskque_head != NULL && XrdFfsQueueTaskque_tail != NULL) {
-        if (XrdFfsQueueTaskque_tail->id > XrdFfsQueueTaskque_head->id)
-            que_len = XrdFfsQueueTaskque_tail->id - XrdFfsQueueTaskque_head->id;
-        else
-// this is wrong: 
-//          que_len = (unsigned int)2147483647 - (XrdFfsQueueTaskque_head->id - XrdFfsQueueTaskque_tail->id) + 1;
-
-//not accepted by c89
-//          que_len = (unsigned int)4294967295 - (XrdFfsQueueTaskque_head->id - XrdFfsQueueTaskque_tail->id) + 1;
-
-//this is not quite correct, but I imagine that the queue will never by so long >= 2147483647
-          que_len = (unsigned int)2147483647 - (XrdFfsQueueTaskque_head->id - XrdFfsQueueTaskque_tail->id) + 1+(unsigned int)2147483647+1;
-    }
+    que_len = XrdFfsQueueNtasks;
     pthread_mutex_unlock(&XrdFfsQueueTaskque_mutex);
     return que_len;
 }
@@ -184,7 +171,7 @@ void *XrdFfsQueue_worker(void* x)
         goto loop;
 }
 
-pthread_mutex_t XrdFfsQueueWorker_mutex;
+pthread_mutex_t XrdFfsQueueWorker_mutex = PTHREAD_MUTEX_INITIALIZER;
 unsigned short XrdFfsQueueNworkers = 0;
 unsigned int XrdFfsQueueWorker_id = 0;
 
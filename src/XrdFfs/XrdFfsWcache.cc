@@ -35,8 +35,25 @@
    Note that fuse 2.8.0 pre2 or above and kernel 2.6.27 or above provide
    a big_writes option to allow > 4KByte writing. It will make this 
    smiple write caching obsolete. 
+
+   Consecutive writes are collected in a buffer which is written back
+   asynchronously once it is full (or the writes stop being consecutive),
+   so several buffers of a file can be on the wire while the application
+   keeps writing. Errors of the write-back are reported by the next write,
+   flush or fsync of the file.
+
+   Reads detect sequential access and then read ahead asynchronously in
+   buffer sized blocks. The read-ahead window starts at one buffer and is
+   doubled every time a read is served from it, up to a maximum number of
+   buffers. Random reads shrink the window back to nothing.
+
+   All buffers come from one memory pool of bounded size, read-ahead may
+   use up to half of it. When the pool is exhausted, writes fall back to
+   synchronous writes and read-ahead is skipped.
 */
-#define XrdFfsWcacheBufsize 131072
+#define XrdFfsWcacheBufsize 1048576
+#define XrdFfsWcacheMaxWrites 8   /* write-back buffers in flight per file */
+#define XrdFfsWcacheMaxRblks 16   /* read-ahead buffers per file */
 
 #if defined(__linux__)
 /* For pread()/pwrite() */
@@ -58,23 +75,143 @@
 #ifndef NOXRD
     #include "XrdFfs/XrdFfsPosix.hh"
 #endif
+#include "XrdPosix/XrdPosixCallBack.hh"
+#include "XrdPosix/XrdPosixXrootd.hh"
 
-#ifdef __cplusplus
-  extern "C" {
-#endif
+struct XrdFfsWcacheFilebuf;
 
-struct XrdFfsWcacheFilebuf {
+/* A write-back or read-ahead buffer, it is its own I/O completion callback */
+
+struct XrdFfsWcacheBlock : public XrdPosixCallBackIO {
+    void Complete(ssize_t Result);
+
+    struct XrdFfsWcacheFilebuf *file;
     off_t offset;
     size_t len;
     char *buf;
+    short write;
+    short busy;      /* I/O in progress */
+    int err;         /* errno of a failed read-ahead */
+};
+
+struct XrdFfsWcacheFilebuf {
     pthread_mutex_t *mlock;
+    pthread_cond_t *cond;
+    struct XrdFfsWcacheBlock *wblk;     /* collects consecutive writes */
+    struct XrdFfsWcacheBlock *wflight[XrdFfsWcacheMaxWrites];
+    int nwflight;
+    int werrno;                         /* first write-back error */
+    struct XrdFfsWcacheBlock *rblks[XrdFfsWcacheMaxRblks];
+    int nrblks;
+    off_t rnext;                        /* offset a sequential read would start at */
+    int rseq;
+    int rwindow;                        /* read-ahead window in buffers */
 };
 
 struct XrdFfsWcacheFilebuf *XrdFfsWcacheFbufs;
 
+/* the memory pool of the buffers */
+
+pthread_mutex_t XrdFfsWcachePool_mutex = PTHREAD_MUTEX_INITIALIZER;
+long long XrdFfsWcachePoolSize = 256LL * 1024 * 1024;
+long long XrdFfsWcachePoolUsed = 0;
+long long XrdFfsWcacheRaUsed = 0;
+int XrdFfsWcacheMaxRa = 8;
+
+static struct XrdFfsWcacheBlock *XrdFfsWcache_getblk(struct XrdFfsWcacheFilebuf *fbuf, short write)
+{
+    struct XrdFfsWcacheBlock *blk;
+    char *buf;
+
+    pthread_mutex_lock(&XrdFfsWcachePool_mutex);
+    if (XrdFfsWcachePoolUsed + XrdFfsWcacheBufsize > XrdFfsWcachePoolSize ||
+        (!write && XrdFfsWcacheRaUsed + XrdFfsWcacheBufsize > XrdFfsWcachePoolSize/2))
+    {
+        pthread_mutex_unlock(&XrdFfsWcachePool_mutex);
+        return NULL;
+    }
+    XrdFfsWcachePoolUsed += XrdFfsWcacheBufsize;
+    if (!write) XrdFfsWcacheRaUsed += XrdFfsWcacheBufsize;
+    pthread_mutex_unlock(&XrdFfsWcachePool_mutex);
+
+    buf = (char*)malloc(XrdFfsWcacheBufsize);
+    blk = (buf == NULL ? NULL : new XrdFfsWcacheBlock());
+    if (blk == NULL)
+    {
+        free(buf);
+        pthread_mutex_lock(&XrdFfsWcachePool_mutex);
+        XrdFfsWcachePoolUsed -= XrdFfsWcacheBufsize;
+        if (!write) XrdFfsWcacheRaUsed -= XrdFfsWcacheBufsize;
+        pthread_mutex_unlock(&XrdFfsWcachePool_mutex);
+        return NULL;
+    }
+    blk->file = fbuf;
+    blk->offset = 0;
+    blk->len = 0;
+    blk->buf = buf;
+    blk->write = write;
+    blk->busy = 0;
+    blk->err = 0;
+    return blk;
+}
+
+static void XrdFfsWcache_putblk(struct XrdFfsWcacheBlock *blk)
+{
+    pthread_mutex_lock(&XrdFfsWcachePool_mutex);
+    XrdFfsWcachePoolUsed -= XrdFfsWcacheBufsize;
+    if (!blk->write) XrdFfsWcacheRaUsed -= XrdFfsWcacheBufsize;
+    pthread_mutex_unlock(&XrdFfsWcachePool_mutex);
+    free(blk->buf);
+    delete blk;
+}
+
+void XrdFfsWcacheBlock::Complete(ssize_t Result)
+{
+    struct XrdFfsWcacheFilebuf *fbuf = file;
+    int i;
+
+    pthread_mutex_lock(fbuf->mlock);
+    if (write)
+    {
+        if (Result != (ssize_t)len && fbuf->werrno == 0)
+            fbuf->werrno = (Result < 0 && errno ? errno : EIO);
+        for (i = 0; i < fbuf->nwflight; i++)
+            if (fbuf->wflight[i] == this)
+            {
+                fbuf->wflight[i] = fbuf->wflight[--fbuf->nwflight];
+                break;
+            }
+        XrdFfsWcache_putblk(this);
+    }
+    else
+    {
+        if (Result < 0)
+        {
+            err = (errno ? errno : EIO);
+            len = 0;
+        }
+        else
+            len = (size_t)Result;
+        busy = 0;
+    }
+    pthread_cond_broadcast(fbuf->cond);
+    pthread_mutex_unlock(fbuf->mlock);
+}
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
 /* #include "xrdposix.h" */
 
 int XrdFfsPosix_baseFD, XrdFfsWcacheNFILES;
+
+void XrdFfsWcache_config(long long memsize, int maxra)
+{
+    if (memsize >= XrdFfsWcacheBufsize) XrdFfsWcachePoolSize = memsize;
+    if (maxra >= 0) XrdFfsWcacheMaxRa = (maxra > XrdFfsWcacheMaxRblks ? XrdFfsWcacheMaxRblks : maxra);
+}
+
 void XrdFfsWcache_init(int basefd, int maxfd)
 {
     int fd;
@@ -95,10 +232,10 @@ void XrdFfsWcache_init(int basefd, int maxfd)
     XrdFfsWcacheFbufs = (struct XrdFfsWcacheFilebuf*)malloc(sizeof(struct XrdFfsWcacheFilebuf) * XrdFfsWcacheNFILES);
     for (fd = 0; fd < XrdFfsWcacheNFILES; fd++)
     {
-        XrdFfsWcacheFbufs[fd].offset = 0;
-        XrdFfsWcacheFbufs[fd].len = 0;
-        XrdFfsWcacheFbufs[fd].buf = NULL;
+        memset(&XrdFfsWcacheFbufs[fd], 0, sizeof(struct XrdFfsWcacheFilebuf));
         XrdFfsWcacheFbufs[fd].mlock = NULL;
+        XrdFfsWcacheFbufs[fd].cond = NULL;
+        XrdFfsWcacheFbufs[fd].wblk = NULL;
     }
 }
 
@@ -111,63 +248,148 @@ int XrdFfsWcache_create(int fd)
  *          0 - error, error code in errno
  */
 {
+    struct XrdFfsWcacheFilebuf *fbuf;
+
     XrdFfsWcache_destroy(fd);
     fd -= XrdFfsPosix_baseFD;
+    if (fd < 0 || fd >= XrdFfsWcacheNFILES)
+        return 1;   /* no caching for this one, I/O goes straight through */
+    fbuf = &XrdFfsWcacheFbufs[fd];
 
-    XrdFfsWcacheFbufs[fd].offset = 0;
-    XrdFfsWcacheFbufs[fd].len = 0;
-    XrdFfsWcacheFbufs[fd].buf = (char*)malloc(XrdFfsWcacheBufsize);
-    if (XrdFfsWcacheFbufs[fd].buf == NULL)
-        return 0;
-    XrdFfsWcacheFbufs[fd].mlock = (pthread_mutex_t*)malloc(sizeof(pthread_mutex_t));
-    if (XrdFfsWcacheFbufs[fd].mlock == NULL)
+    fbuf->mlock = (pthread_mutex_t*)malloc(sizeof(pthread_mutex_t));
+    fbuf->cond = (pthread_cond_t*)malloc(sizeof(pthread_cond_t));
+    if (fbuf->mlock == NULL || fbuf->cond == NULL)
+    {
+        free(fbuf->mlock);
+        free(fbuf->cond);
+        fbuf->mlock = NULL;
+        fbuf->cond = NULL;
+        errno = ENOMEM;
         return 0;
-    errno = pthread_mutex_init(XrdFfsWcacheFbufs[fd].mlock, NULL);
+    }
+    errno = pthread_mutex_init(fbuf->mlock, NULL);
+    if (!errno)
+        errno = pthread_cond_init(fbuf->cond, NULL);
     if (errno)
+    {
+        free(fbuf->mlock);
+        free(fbuf->cond);
+        fbuf->mlock = NULL;
+        fbuf->cond = NULL;
         return 0;
+    }
     return 1;
 }
 
+/* the following helpers are called with the file mutex held */
+
+static void XrdFfsWcache_wait_writes(struct XrdFfsWcacheFilebuf *fbuf)
+{
+    while (fbuf->nwflight)
+        pthread_cond_wait(fbuf->cond, fbuf->mlock);
+}
+
+static void XrdFfsWcache_drop_readahead(struct XrdFfsWcacheFilebuf *fbuf)
+{
+    int i;
+    for (i = 0; i < fbuf->nrblks; i++)
+        while (fbuf->rblks[i]->busy)
+            pthread_cond_wait(fbuf->cond, fbuf->mlock);
+    for (i = 0; i < fbuf->nrblks; i++)
+        XrdFfsWcache_putblk(fbuf->rblks[i]);
+    fbuf->nrblks = 0;
+    fbuf->rwindow = 0;
+}
+
+/* Write back the buffer collecting writes. Buffers in flight never overlap,
+   so that the order of overlapping writes is kept. */
+static void XrdFfsWcache_writeback(int fd, struct XrdFfsWcacheFilebuf *fbuf)
+{
+    struct XrdFfsWcacheBlock *blk = fbuf->wblk;
+    int i, overlap;
+
+    fbuf->wblk = NULL;
+    if (blk->len == 0)
+    {
+        XrdFfsWcache_putblk(blk);
+        return;
+    }
+    do {
+        overlap = (fbuf->nwflight >= XrdFfsWcacheMaxWrites);
+        for (i = 0; i < fbuf->nwflight && !overlap; i++)
+            overlap = (blk->offset < (off_t)(fbuf->wflight[i]->offset + fbuf->wflight[i]->len) &&
+                       fbuf->wflight[i]->offset < (off_t)(blk->offset + blk->len));
+        if (overlap)
+            pthread_cond_wait(fbuf->cond, fbuf->mlock);
+    } while (overlap);
+
+    fbuf->wflight[fbuf->nwflight++] = blk;
+    blk->busy = 1;
+    pthread_mutex_unlock(fbuf->mlock);
+    XrdPosixXrootd::Pwrite(fd, blk->buf, blk->len, blk->offset, blk);
+    pthread_mutex_lock(fbuf->mlock);
+}
+
 void XrdFfsWcache_destroy(int fd)
 {
+    struct XrdFfsWcacheFilebuf *fbuf;
+
 /*  XrdFfsWcache_flush(fd); */
     fd -= XrdFfsPosix_baseFD;
+    if (fd < 0 || fd >= XrdFfsWcacheNFILES || XrdFfsWcacheFbufs[fd].mlock == NULL)
+        return;
+    fbuf = &XrdFfsWcacheFbufs[fd];
 
-    XrdFfsWcacheFbufs[fd].offset = 0;
-    XrdFfsWcacheFbufs[fd].len = 0;
-    if (XrdFfsWcacheFbufs[fd].buf != NULL) 
-        free(XrdFfsWcacheFbufs[fd].buf);
-    XrdFfsWcacheFbufs[fd].buf = NULL;
-    if (XrdFfsWcacheFbufs[fd].mlock != NULL)
-    {
-        pthread_mutex_destroy(XrdFfsWcacheFbufs[fd].mlock);
-        free(XrdFfsWcacheFbufs[fd].mlock);
-    }
-    XrdFfsWcacheFbufs[fd].mlock = NULL;
+    pthread_mutex_lock(fbuf->mlock);
+    XrdFfsWcache_wait_writes(fbuf);
+    XrdFfsWcache_drop_readahead(fbuf);
+    if (fbuf->wblk != NULL)
+        XrdFfsWcache_putblk(fbuf->wblk);
+    pthread_mutex_unlock(fbuf->mlock);
+
+    pthread_mutex_destroy(fbuf->mlock);
+    pthread_cond_destroy(fbuf->cond);
+    free(fbuf->mlock);
+    free(fbuf->cond);
+    memset(fbuf, 0, sizeof(struct XrdFfsWcacheFilebuf));
 }
 
 ssize_t XrdFfsWcache_flush(int fd)
+/* Write back whatever is buffered and wait for all the writes of the file
+ *
+ * returns: 0 - ok
+ *         -1 - a write-back failed, error code in errno
+ */
 {
-    ssize_t rc;
-    fd -= XrdFfsPosix_baseFD;
+    struct XrdFfsWcacheFilebuf *fbuf;
+    ssize_t rc = 0;
+    int afd = fd;
 
-    if (XrdFfsWcacheFbufs[fd].len == 0 || XrdFfsWcacheFbufs[fd].buf == NULL )
+    fd -= XrdFfsPosix_baseFD;
+    if (fd < 0 || fd >= XrdFfsWcacheNFILES || XrdFfsWcacheFbufs[fd].mlock == NULL)
         return 0;
+    fbuf = &XrdFfsWcacheFbufs[fd];
 
-    rc = XrdFfsPosix_pwrite(fd + XrdFfsPosix_baseFD, 
-                            XrdFfsWcacheFbufs[fd].buf, XrdFfsWcacheFbufs[fd].len, XrdFfsWcacheFbufs[fd].offset);
-    if (rc > 0)
+    pthread_mutex_lock(fbuf->mlock);
+    if (fbuf->wblk != NULL)
+        XrdFfsWcache_writeback(afd, fbuf);
+    XrdFfsWcache_wait_writes(fbuf);
+    if (fbuf->werrno)
     {
-        XrdFfsWcacheFbufs[fd].offset = 0;
-        XrdFfsWcacheFbufs[fd].len = 0;
+        errno = fbuf->werrno;
+        fbuf->werrno = 0;
+        rc = -1;
     }
+    pthread_mutex_unlock(fbuf->mlock);
     return rc;
 }
 
 ssize_t XrdFfsWcache_pwrite(int fd, char *buf, size_t len, off_t offset)
 {
-    ssize_t rc;
-    char *bufptr;
+    struct XrdFfsWcacheFilebuf *fbuf;
+    struct XrdFfsWcacheBlock *blk;
+    int afd = fd;
+
     fd -= XrdFfsPosix_baseFD;
     if (fd < 0)
     {
@@ -176,41 +398,188 @@ ssize_t XrdFfsWcache_pwrite(int fd, char *buf, size_t len, off_t offset)
     }
 
 /* do not use caching under these cases */
-    if (len > XrdFfsWcacheBufsize/2 || fd >= XrdFfsWcacheNFILES)
+    if (fd >= XrdFfsWcacheNFILES || XrdFfsWcacheFbufs[fd].mlock == NULL)
+        return XrdFfsPosix_pwrite(afd, buf, len, offset);
+
+    fbuf = &XrdFfsWcacheFbufs[fd];
+    pthread_mutex_lock(fbuf->mlock);
+    if (fbuf->werrno)
     {
-        rc = XrdFfsPosix_pwrite(fd + XrdFfsPosix_baseFD, buf, len, offset);
-        return rc;
+        errno = fbuf->werrno;
+        fbuf->werrno = 0;
+        pthread_mutex_unlock(fbuf->mlock);
+        return -1;
     }
 
-    pthread_mutex_lock(XrdFfsWcacheFbufs[fd].mlock);
-    rc = XrdFfsWcacheFbufs[fd].len;
+/* whatever we read ahead may be overwritten now */
+    if (fbuf->nrblks)
+        XrdFfsWcache_drop_readahead(fbuf);
 /* 
-   in the following two cases, a XrdFfsWcache_flush is required:
+   in the following two cases, the buffer is written back:
    1. current offset isnn't pointing to the tail of data in buffer
    2. adding new data will exceed the current buffer 
 */ 
-    if (offset != (off_t)(XrdFfsWcacheFbufs[fd].offset + XrdFfsWcacheFbufs[fd].len) ||
-        (off_t)(offset + len) > (XrdFfsWcacheFbufs[fd].offset + XrdFfsWcacheBufsize))
-        rc = XrdFfsWcache_flush(fd + XrdFfsPosix_baseFD);
+    blk = fbuf->wblk;
+    if (blk != NULL &&
+        (offset != (off_t)(blk->offset + blk->len) || blk->len + len > XrdFfsWcacheBufsize))
+        XrdFfsWcache_writeback(afd, fbuf);
 
-    errno = 0;
-    if (rc < 0) 
+    if (fbuf->wblk == NULL && len <= XrdFfsWcacheBufsize/2)
     {
-        errno = ENOSPC;
-        pthread_mutex_unlock(XrdFfsWcacheFbufs[fd].mlock);
-        return -1;
+        fbuf->wblk = XrdFfsWcache_getblk(fbuf, 1);
+        if (fbuf->wblk != NULL)
+            fbuf->wblk->offset = offset;
     }
 
-    bufptr = &XrdFfsWcacheFbufs[fd].buf[XrdFfsWcacheFbufs[fd].len];
-    memcpy(bufptr, buf, len);
-    if (XrdFfsWcacheFbufs[fd].len == 0)
-        XrdFfsWcacheFbufs[fd].offset = offset;
-    XrdFfsWcacheFbufs[fd].len += len;
+/* large writes and writes that find the pool exhausted go out synchronously,
+   once the writes before them are done */
+    if (fbuf->wblk == NULL)
+    {
+        XrdFfsWcache_wait_writes(fbuf);
+        pthread_mutex_unlock(fbuf->mlock);
+        return XrdFfsPosix_pwrite(afd, buf, len, offset);
+    }
 
-    pthread_mutex_unlock(XrdFfsWcacheFbufs[fd].mlock);
+    blk = fbuf->wblk;
+    memcpy(blk->buf + blk->len, buf, len);
+    blk->len += len;
+    if (blk->len == XrdFfsWcacheBufsize)
+        XrdFfsWcache_writeback(afd, fbuf);
+
+    pthread_mutex_unlock(fbuf->mlock);
     return (ssize_t)len;
 }
 
+ssize_t XrdFfsWcache_pread(int fd, char *buf, size_t len, off_t offset)
+{
+    struct XrdFfsWcacheFilebuf *fbuf;
+    struct XrdFfsWcacheBlock *blk, *issue[XrdFfsWcacheMaxRblks];
+    int afd = fd, i, j, nissue = 0, hit = 0, eof = 0;
+    size_t done = 0, n;
+    off_t pos, next, limit, end;
+    ssize_t rc;
+
+    fd -= XrdFfsPosix_baseFD;
+    if (fd < 0)
+    {
+        errno = EBADF;
+        return -1;
+    }
+    if (fd >= XrdFfsWcacheNFILES || XrdFfsWcacheFbufs[fd].mlock == NULL)
+        return XrdFfsPosix_pread(afd, buf, len, offset);
+
+    fbuf = &XrdFfsWcacheFbufs[fd];
+    pthread_mutex_lock(fbuf->mlock);
+
+/* in case the file is reading/writing, writes must land before reading */
+    if (fbuf->wblk != NULL)
+        XrdFfsWcache_writeback(afd, fbuf);
+    XrdFfsWcache_wait_writes(fbuf);
+
+/* copy out what we have read ahead, waiting for reads in flight */
+    while (done < len && !eof)
+    {
+        pos = offset + (off_t)done;
+        blk = NULL;
+        for (i = 0; i < fbuf->nrblks; i++)
+            if (fbuf->rblks[i]->offset <= pos && pos < (off_t)(fbuf->rblks[i]->offset + XrdFfsWcacheBufsize))
+            {
+                blk = fbuf->rblks[i];
+                break;
+            }
+        if (blk == NULL)
+            break;
+        if (blk->busy)
+        {
+            pthread_cond_wait(fbuf->cond, fbuf->mlock);
+            continue;
+        }
+        if (blk->err)
+            break;
+        end = blk->offset + (off_t)blk->len;
+        if (pos >= end)
+        {
+            eof = (blk->len < XrdFfsWcacheBufsize);
+            break;
+        }
+        n = (size_t)(end - pos);
+        if (n > len - done) n = len - done;
+        memcpy(buf + done, blk->buf + (pos - blk->offset), n);
+        done += n;
+        hit = 1;
+        if (done < len && blk->len < XrdFfsWcacheBufsize)
+            eof = 1;
+    }
+
+/* release the blocks the reader has moved past and the failed ones */
+    for (i = 0, j = 0; i < fbuf->nrblks; i++)
+    {
+        blk = fbuf->rblks[i];
+        if (!blk->busy && (blk->err || (off_t)(blk->offset + blk->len) <= offset + (off_t)done))
+            XrdFfsWcache_putblk(blk);
+        else
+            fbuf->rblks[j++] = blk;
+    }
+    fbuf->nrblks = j;
+
+/* sequential detection drives the read-ahead window */
+    if (offset == fbuf->rnext && offset != 0)
+    {
+        fbuf->rseq++;
+        if (fbuf->rwindow == 0)
+            fbuf->rwindow = 1;
+        else if (hit && fbuf->rwindow < XrdFfsWcacheMaxRa)
+            fbuf->rwindow = (fbuf->rwindow * 2 > XrdFfsWcacheMaxRa ? XrdFfsWcacheMaxRa : fbuf->rwindow * 2);
+    }
+    else if (!hit)
+    {
+        fbuf->rseq = 0;
+        fbuf->rwindow = 0;
+    }
+    fbuf->rnext = offset + (off_t)len;
+
+    if (fbuf->rwindow > XrdFfsWcacheMaxRa)
+        fbuf->rwindow = XrdFfsWcacheMaxRa;
+    if (fbuf->rwindow && !eof)
+    {
+        next = fbuf->rnext;
+        for (i = 0; i < fbuf->nrblks; i++)
+        {
+            blk = fbuf->rblks[i];
+            if (!blk->busy && blk->len < XrdFfsWcacheBufsize)
+                next = -1;   /* we have seen the end of the file */
+            if (next >= 0 && (off_t)(blk->offset + XrdFfsWcacheBufsize) > next)
+                next = blk->offset + XrdFfsWcacheBufsize;
+        }
+        limit = fbuf->rnext + (off_t)fbuf->rwindow * XrdFfsWcacheBufsize;
+        while (next >= 0 && next < limit && fbuf->nrblks < XrdFfsWcacheMaxRblks)
+        {
+            blk = XrdFfsWcache_getblk(fbuf, 0);
+            if (blk == NULL)
+                break;
+            blk->offset = next;
+            blk->busy = 1;
+            fbuf->rblks[fbuf->nrblks++] = blk;
+            issue[nissue++] = blk;
+            next += XrdFfsWcacheBufsize;
+        }
+    }
+    pthread_mutex_unlock(fbuf->mlock);
+
+    for (i = 0; i < nissue; i++)
+        XrdPosixXrootd::Pread(afd, issue[i]->buf, XrdFfsWcacheBufsize, issue[i]->offset, issue[i]);
+
+/* read what was not read ahead */
+    if (done < len && !eof)
+    {
+        rc = XrdFfsPosix_pread(afd, buf + done, len - done, offset + (off_t)done);
+        if (rc < 0)
+            return (done ? (ssize_t)done : -1);
+        done += (size_t)rc;
+    }
+    return (ssize_t)done;
+}
+
 #ifdef __cplusplus
   }
 #endif
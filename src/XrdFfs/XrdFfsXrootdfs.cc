@@ -80,12 +80,14 @@ struct XROOTDFS {
     bool ofsfwd;
     int  nworkers;
     int  maxfd;
+    int  cachesize;
+    int  readahead;
 };
 
 int cwdfd; // File descript of the initial working dir
 
 struct XROOTDFS xrootdfs;
-static struct fuse_opt xrootdfs_opts[14];
+static struct fuse_opt xrootdfs_opts[16];
 
 enum { OPT_KEY_HELP, OPT_KEY_SECSSS, };
 
@@ -127,6 +129,7 @@ static void* xrootdfs_init(struct fuse_conn_info *conn)
 /* put Xrootd related initialization calls here, after fuse daemonize itself. */
     XrdPosixXrootd *abc = new XrdPosixXrootd(-xrootdfs.maxfd);
     XrdFfsMisc_xrd_init(xrootdfs.rdr,xrootdfs.urlcachelife,0);
+    XrdFfsWcache_config((long long)xrootdfs.cachesize * 1024 * 1024, xrootdfs.readahead);
     XrdFfsWcache_init(abc->fdOrigin(), xrootdfs.maxfd);
 /*
    From FAQ:
@@ -794,8 +797,7 @@ static int xrootdfs_read(const char *path, char *buf, size_t size, off_t offset,
     int res;
 
     fd = (int) fi->fh;
-    XrdFfsWcache_flush(fd);  /* in case is the file is reading/writing */
-    res = XrdFfsPosix_pread(fd, buf, size, offset);
+    res = XrdFfsWcache_pread(fd, buf, size, offset);
     if (res == -1)
         res = -errno;
 
@@ -888,6 +890,17 @@ static int xrootdfs_statfs(const char *path, struct statvfs *stbuf)
  */
 }
 
+static int xrootdfs_flush(const char *path, struct fuse_file_info *fi)
+/*
+ * Called on each close() of the file, report errors of the asynchronous
+ * write-back here as release() can not return them to the application.
+ */
+{
+    if (XrdFfsWcache_flush((int) fi->fh) == -1)
+        return -errno;
+    return 0;
+}
+
 static int xrootdfs_release(const char *path, struct fuse_file_info *fi)
 {
     /* Just a stub.  This method is optional and can safely be left
@@ -989,8 +1002,10 @@ static int xrootdfs_fsync(const char *path, int isdatasync,
     int fd;
 
     fd = (int) fi->fh;
-    XrdFfsWcache_flush(fd);
-    XrdFfsPosix_fsync(fd);
+    if (XrdFfsWcache_flush(fd) == -1)
+        return -errno;
+    if (XrdFfsPosix_fsync(fd) == -1)
+        return -errno;
     return 0;
 }
 
@@ -1241,6 +1256,8 @@ static void xrootdfs_usage(const char *progname)
 "                                 Absents of this option will disable automatically refreshing\n"
 "    -o maxfd=N               number of virtual file descriptors for posix requests, default 8192 (min 2048)\n"
 "    -o nworkers=N            number of workers to handle parallel requests to data servers, default 4\n"
+"    -o cachesize=N           memory (MB) for write-back and read-ahead buffers of open files, default 256\n"
+"    -o readahead=N           maximum read-ahead window in 1MB buffers for sequential reads, default 8 (0 disables)\n"
 "    -o fastls=RDR            set to RDR when CNS is presented will cause stat() to go to redirector\n"
 "\n", progname);
 }
@@ -1294,6 +1311,7 @@ int main(int argc, char *argv[])
     xrootdfs_oper.read		= xrootdfs_read;
     xrootdfs_oper.write		= xrootdfs_write;
     xrootdfs_oper.statfs	= xrootdfs_statfs;
+    xrootdfs_oper.flush		= xrootdfs_flush;
     xrootdfs_oper.release	= xrootdfs_release;
     xrootdfs_oper.fsync		= xrootdfs_fsync;
     xrootdfs_oper.setxattr	= xrootdfs_setxattr;
@@ -1377,7 +1395,17 @@ int main(int argc, char *argv[])
     xrootdfs_opts[12].offset = offsetof(struct XROOTDFS, maxfd);
     xrootdfs_opts[12].value = 0;
 
-    xrootdfs_opts[13].templ = NULL;
+/* memory for write-back and read-ahead buffers */
+    xrootdfs_opts[13].templ = "cachesize=%d";
+    xrootdfs_opts[13].offset = offsetof(struct XROOTDFS, cachesize);
+    xrootdfs_opts[13].value = 0;
+
+/* maximum read-ahead window */
+    xrootdfs_opts[14].templ = "readahead=%d";
+    xrootdfs_opts[14].offset = offsetof(struct XROOTDFS, readahead);
+    xrootdfs_opts[14].value = 0;
+
+    xrootdfs_opts[15].templ = NULL;
 
 /* initialize struct xrootdfs */
 //    memset(&xrootdfs, 0, sizeof(xrootdfs));
@@ -1390,6 +1418,8 @@ int main(int argc, char *argv[])
     xrootdfs.urlcachelife = strdup("3650d"); /* 10 years */
     xrootdfs.nworkers = 4;
     xrootdfs.maxfd = 8192;
+    xrootdfs.cachesize = 256;
+    xrootdfs.readahead = 8;
 
 /* Get options from environment variables first */
     xrootdfs.rdr = getenv("XROOTDFS_RDRURL");
@@ -1400,6 +1430,8 @@ int main(int argc, char *argv[])
     if (getenv("XROOTDFS_OFSFWD") != NULL && ! strcmp(getenv("XROOTDFS_OFSFWD"),"1")) xrootdfs.ofsfwd = true;
     if (getenv("XROOTDFS_NWORKERS") != NULL) sscanf(getenv("XROOTDFS_NWORKERS"), "%d", &xrootdfs.nworkers);
     if (getenv("XROOTDFS_MAXFD") != NULL) sscanf(getenv("XROOTDFS_MAXFD"), "%d", &xrootdfs.maxfd);
+    if (getenv("XROOTDFS_CACHESIZE") != NULL) sscanf(getenv("XROOTDFS_CACHESIZE"), "%d", &xrootdfs.cachesize);
+    if (getenv("XROOTDFS_READAHEAD") != NULL) sscanf(getenv("XROOTDFS_READAHEAD"), "%d", &xrootdfs.readahead);
 
 /* Parse XrootdFS options, will overwrite those defined in environment variables */
     fuse_opt_parse(&args, &xrootdfs, xrootdfs_opts, xrootdfs_opt_proc);
@@ -0,0 +1,54 @@
+#!/bin/sh
+#
+# Compare sequential copies through an XrootdFS mount point with xrdcp.
+#
+# usage: xrootdfs-bench.sh <dir under the mount point> <root URL of the same dir> [size in MB]
+#
+# A test file is written and read back through the mount with dd and cp,
+# then copied with xrdcp in both directions. The throughput of every step
+# is printed in MB/s.
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 <dir under the mount point> <root URL of the same dir> [size in MB]"
+    exit 1
+fi
+
+MNTDIR=$1
+URL=$2
+SIZE=${3:-1024}
+LOCAL=${TMPDIR:-/tmp}/xrootdfs-bench.$$
+NAME=xrootdfs-bench.$$
+
+cleanup()
+{
+    rm -f $LOCAL $LOCAL.back $MNTDIR/$NAME.dd $MNTDIR/$NAME.cp $MNTDIR/$NAME.xrdcp
+}
+trap cleanup EXIT
+
+now()
+{
+    date +%s.%N
+}
+
+report()
+{
+    echo "$1" | awk -v t0=$2 -v t1=$3 -v mb=$SIZE '{ printf "%-28s %8.1f MB/s\n", $0, mb / (t1 - t0) }'
+}
+
+dd if=/dev/urandom of=$LOCAL bs=1M count=$SIZE 2>/dev/null || exit 1
+
+t0=`now`; dd if=$LOCAL of=$MNTDIR/$NAME.dd bs=1M conv=fsync 2>/dev/null; t1=`now`
+report "write: dd (mount)" $t0 $t1
+t0=`now`; cp $LOCAL $MNTDIR/$NAME.cp && sync; t1=`now`
+report "write: cp (mount)" $t0 $t1
+t0=`now`; xrdcp -s -f $LOCAL $URL/$NAME.xrdcp; t1=`now`
+report "write: xrdcp" $t0 $t1
+
+t0=`now`; dd if=$MNTDIR/$NAME.dd of=/dev/null bs=1M 2>/dev/null; t1=`now`
+report "read:  dd (mount)" $t0 $t1
+t0=`now`; cp $MNTDIR/$NAME.cp $LOCAL.back; t1=`now`
+report "read:  cp (mount)" $t0 $t1
+cmp -s $LOCAL $LOCAL.back || echo "read:  cp (mount) returned different data!"
+rm -f $LOCAL.back
+t0=`now`; xrdcp -s -f $URL/$NAME.xrdcp $LOCAL.back; t1=`now`
+report "read:  xrdcp" $t0 $t1
@@ -19,8 +19,11 @@ add_library(
   XrdFileCache/XrdFileCache.cc              XrdFileCache/XrdFileCache.hh
   XrdFileCache/XrdFileCacheConfiguration.cc
   XrdFileCache/XrdFileCachePurge.cc
+  XrdFileCache/XrdFileCachePurgeIndex.cc    XrdFileCache/XrdFileCachePurgeIndex.hh
+  XrdFileCache/XrdFileCacheEvictionPolicy.cc XrdFileCache/XrdFileCacheEvictionPolicy.hh
   XrdFileCache/XrdFileCacheFile.cc          XrdFileCache/XrdFileCacheFile.hh
   XrdFileCache/XrdFileCacheVRead.cc
+  XrdFileCache/XrdFileCacheAccessPattern.cc XrdFileCache/XrdFileCacheAccessPattern.hh
   XrdFileCache/XrdFileCacheStats.hh
   XrdFileCache/XrdFileCacheInfo.cc          XrdFileCache/XrdFileCacheInfo.hh
   XrdFileCache/XrdFileCacheIO.cc            XrdFileCache/XrdFileCacheIO.hh
@@ -75,6 +78,23 @@ target_link_libraries(
   XrdCl
   XrdUtils )
 
+#-------------------------------------------------------------------------------
+# xrdpfc_evictsim
+#-------------------------------------------------------------------------------
+add_executable(
+  xrdpfc_evictsim
+  XrdFileCache/XrdFileCacheEvictSimMain.cc
+  XrdFileCache/XrdFileCacheEvictSim.hh       XrdFileCache/XrdFileCacheEvictSim.cc
+  XrdFileCache/XrdFileCachePurgeIndex.hh     XrdFileCache/XrdFileCachePurgeIndex.cc
+  XrdFileCache/XrdFileCacheEvictionPolicy.hh XrdFileCache/XrdFileCacheEvictionPolicy.cc
+  XrdFileCache/XrdFileCacheInfo.hh           XrdFileCache/XrdFileCacheInfo.cc)
+
+target_link_libraries(
+  xrdpfc_evictsim
+  XrdServer
+  XrdCl
+  XrdUtils )
+
 #-------------------------------------------------------------------------------
 # Install
 #-------------------------------------------------------------------------------
@@ -87,12 +107,13 @@ install(
   LIBRARY DESTINATION ${CMAKE_INSTALL_LIBDIR} )
 
 install(
-  TARGETS xrdpfc_print
+  TARGETS xrdpfc_print xrdpfc_evictsim
   RUNTIME DESTINATION ${CMAKE_INSTALL_BINDIR} )
 
 
 install(
   FILES
   ${PROJECT_SOURCE_DIR}/docs/man/xrdpfc_print.8
+  ${PROJECT_SOURCE_DIR}/docs/man/xrdpfc_evictsim.8
   DESTINATION ${CMAKE_INSTALL_MANDIR}/man8 )
 
@@ -144,6 +144,7 @@ Cache::Cache() :
    m_log(0, "XrdFileCache_"),
    m_trace(0),
    m_traceID("Manager"),
+   m_evictionPolicy(0),
    m_prefetch_condVar(0),
    m_RAMblocks_used(0),
    m_isClient(false),
@@ -319,6 +320,11 @@ File* Cache::GetFile(const std::string& path, IO* iIO, long long off, long long
 
    File* file = new File(iIO, path, off, filesize);
 
+   if (file->isOpen())
+   {
+      m_purge_index.Update(file->GetLocalPath(), time(0), file->GetNDownloadedBytes(), file->GetAccessCnt());
+   }
+
    {
       XrdSysCondVarHelper lock(&m_active_cond);
 
@@ -409,6 +415,11 @@ void Cache::dec_ref_cnt(File* f)
    TRACE(Debug, "Cache::dec_ref_cnt " << f->GetLocalPath() << ", cnt after sync_check and dec_ref_cnt = " << cnt);
    if (cnt == 0)
    {
+      if (f->isOpen())
+      {
+         m_purge_index.Update(f->GetLocalPath(), time(0), f->GetNDownloadedBytes(), f->GetAccessCnt());
+      }
+
       ActiveMap_i it = m_active.find(f->GetLocalPath());
       m_active.erase(it);
       delete f;
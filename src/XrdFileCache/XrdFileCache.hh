@@ -29,6 +29,7 @@
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdFileCacheFile.hh"
 #include "XrdFileCacheDecision.hh"
+#include "XrdFileCachePurgeIndex.hh"
 
 class XrdOucStream;
 class XrdSysError;
@@ -57,10 +58,12 @@ struct Configuration
       m_diskUsageLWM(-1),
       m_diskUsageHWM(-1),
       m_purgeInterval(300),
+      m_purgeFullScanInterval(6*3600),
       m_bufferSize(1024*1024),
       m_RamAbsAvailable(0),
       m_NRamBuffers(-1),
       m_prefetch_max_blocks(10),
+      m_prefetch_adaptive(false),
       m_hdfsbsize(128*1024*1024),
       m_flushCnt(100)
    {}
@@ -74,11 +77,13 @@ struct Configuration
    long long m_diskUsageLWM;            //!< cache purge low water mark
    long long m_diskUsageHWM;            //!< cache purge high water mark
    int       m_purgeInterval;           //!< sleep interval between cache purges
+   int       m_purgeFullScanInterval;   //!< max interval between full scans of cache directory
 
    long long m_bufferSize;              //!< prefetch buffer size, default 1MB
    long long m_RamAbsAvailable;         //!< available from configuration
    int       m_NRamBuffers;             //!< number of total in-memory cache blocks, cached
    size_t    m_prefetch_max_blocks;     //!< maximum number of blocks to prefetch per file
+   bool      m_prefetch_adaptive;       //!< prefetch blocks predicted from read pattern instead of whole file
 
    long long m_hdfsbsize;               //!< used with m_hdfsmode, default 128MB
    long long m_flushCnt;                //!< nuber of unsynced blcoks on disk before flush is called
@@ -210,6 +215,11 @@ public:
 
    void ReleaseFile(File*);
 
+   //---------------------------------------------------------------------
+   //! Account for bytes of a cached file written to disk.
+   //---------------------------------------------------------------------
+   void FileWritten(const std::string &path, long long nBytes) { m_purge_index.AddBytes(path, nBytes); }
+
    void ScheduleFileSync(File* f) { schedule_file_sync(f, false); }
 
    void FileSyncDone(File*);
@@ -220,6 +230,8 @@ private:
    bool ConfigParameters(std::string, XrdOucStream&, TmpConfiguration &tmpc);
    bool ConfigXeq(char *, XrdOucStream &);
    bool xdlib(XrdOucStream &);
+   bool xevict(XrdOucStream &);
+   bool xevictlib(XrdOucStream &);
    bool xtrace(XrdOucStream &);
 
    static Cache     *m_factory;         //!< this object
@@ -235,6 +247,8 @@ private:
 
    std::vector<XrdFileCache::Decision*> m_decisionpoints;       //!< decision plugins
 
+   EvictionPolicy   *m_evictionPolicy;  //!< purge eviction policy, 0 for default lru
+
    std::map<std::string, long long> m_filesInQueue;
 
    Configuration m_configuration;           //!< configurable parameters
@@ -265,6 +279,8 @@ private:
    bool          m_in_purge;
    XrdSysCondVar m_active_cond;
 
+   PurgeIndex    m_purge_index;   //!< files on disk ordered by access time
+
    void inc_ref_cnt(File*, bool lock);
    void dec_ref_cnt(File*);
 
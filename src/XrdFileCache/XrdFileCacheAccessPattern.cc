@@ -0,0 +1,182 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include "XrdFileCacheAccessPattern.hh"
+
+using namespace XrdFileCache;
+
+namespace
+{
+const int MaxConfidence = 8;
+const int MinConfidence = -4;
+}
+
+//------------------------------------------------------------------------------
+
+AccessPattern::AccessPattern(int maxDepth) :
+   m_pattern(kUnknown),
+   m_confidence(0),
+   m_maxDepth(maxDepth),
+   m_lastFirst(-1),
+   m_lastLast(-1),
+   m_stride(0),
+   m_width(1),
+   m_taken(-1)
+{}
+
+//------------------------------------------------------------------------------
+
+AccessPattern::Pattern_e AccessPattern::classify(int firstIdx, int lastIdx, bool isVector)
+{
+   if (m_lastFirst < 0)
+      return kUnknown;
+
+   // Continues where the previous request ended.
+   if (firstIdx >= m_lastFirst && firstIdx <= m_lastLast + 1)
+      return isVector ? kClustered : kSequential;
+
+   // Vector reads of a new cluster shortly after the previous one.
+   if (isVector && firstIdx > m_lastLast && firstIdx - m_lastLast <= m_lastLast - m_lastFirst + 1)
+      return kClustered;
+
+   int stride = firstIdx - m_lastFirst;
+
+   // Same forward distance as between the previous two requests.
+   if (stride > 0 && stride == m_stride)
+      return kStrided;
+
+   return kRandom;
+}
+
+//------------------------------------------------------------------------------
+
+int AccessPattern::depth() const
+{
+   if (m_confidence <= 0 || m_pattern == kRandom || m_pattern == kUnknown)
+      return 0;
+
+   int d = 1 << (m_confidence - 1);
+   return d < m_maxDepth ? d : m_maxDepth;
+}
+
+int AccessPattern::windowEnd() const
+{
+   int d = depth();
+   if (d == 0) return -1;
+
+   if (m_pattern == kStrided)
+      return m_lastFirst + d * m_stride + m_width - 1;
+
+   return m_lastLast + d;
+}
+
+//------------------------------------------------------------------------------
+
+bool AccessPattern::Update(int firstIdx, int lastIdx, bool isVector)
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   Pattern_e p = classify(firstIdx, lastIdx, isVector);
+
+   // Reading restarted further back, previously handled window is not relevant.
+   if (firstIdx < m_lastFirst) m_taken = -1;
+
+   if (p == kRandom)
+   {
+      m_confidence = m_confidence > 0 ? m_confidence / 2 - 1 : m_confidence - 1;
+      if (m_confidence <= 0) m_pattern = kRandom;
+   }
+   else if (p != kUnknown)
+   {
+      // Sequential and clustered reads are both served by reading ahead.
+      bool same = p == m_pattern || (p != kStrided && m_pattern != kStrided && m_pattern != kRandom && m_pattern != kUnknown);
+      if (same)
+      {
+         ++m_confidence;
+      }
+      else
+      {
+         m_pattern    = p;
+         m_confidence = 1;
+         m_taken      = -1;
+      }
+   }
+   if (m_confidence > MaxConfidence) m_confidence = MaxConfidence;
+   if (m_confidence < MinConfidence) m_confidence = MinConfidence;
+
+   if (m_lastFirst >= 0 && firstIdx != m_lastFirst) m_stride = firstIdx - m_lastFirst;
+   // Within a cluster the next vector read may start before the end of the last one.
+   if ( ! (isVector && p == kClustered && lastIdx < m_lastLast))
+   {
+      m_lastLast = lastIdx;
+   }
+   m_lastFirst = firstIdx;
+   m_width     = lastIdx - firstIdx + 1;
+
+   return windowEnd() > m_taken;
+}
+
+//------------------------------------------------------------------------------
+
+int AccessPattern::Predict(std::vector<int> &blocks)
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   int d = depth();
+   if (d == 0) return -1;
+
+   if (m_pattern == kStrided)
+   {
+      for (int i = 1; i <= d; ++i)
+         for (int j = 0; j < m_width; ++j)
+            blocks.push_back(m_lastFirst + i * m_stride + j);
+   }
+   else
+   {
+      for (int i = 1; i <= d; ++i)
+         blocks.push_back(m_lastLast + i);
+   }
+
+   return windowEnd();
+}
+
+void AccessPattern::Taken(int windowEnd)
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   if (windowEnd > m_taken) m_taken = windowEnd;
+}
+
+//------------------------------------------------------------------------------
+
+int AccessPattern::GetDepth()
+{
+   XrdSysMutexHelper _lck(m_mutex);
+   return depth();
+}
+
+AccessPattern::Pattern_e AccessPattern::GetPattern()
+{
+   XrdSysMutexHelper _lck(m_mutex);
+   return m_pattern;
+}
+
+const char* AccessPattern::PatternName(Pattern_e p)
+{
+   static const char* names[] = { "unknown", "sequential", "strided", "clustered", "random" };
+   return names[p];
+}
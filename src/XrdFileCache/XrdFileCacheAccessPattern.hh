@@ -0,0 +1,103 @@
+#ifndef __XRDFILECACHE_ACCESS_PATTERN_HH__
+#define __XRDFILECACHE_ACCESS_PATTERN_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <vector>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+namespace XrdFileCache
+{
+//----------------------------------------------------------------------------
+//! Detects the access pattern of client reads on a file and predicts which
+//! blocks will be read next.
+//!
+//! Each read is classified as continuing a sequential, strided or clustered
+//! (vector reads of consecutive ROOT basket clusters) pattern. Confidence
+//! grows by one for each read that follows the current pattern and the
+//! prefetch depth doubles with it, up to the configured maximum. Reads that
+//! fit no pattern halve the confidence so that prefetching stops after a
+//! couple of random reads.
+//----------------------------------------------------------------------------
+class AccessPattern
+{
+public:
+   enum Pattern_e { kUnknown, kSequential, kStrided, kClustered, kRandom };
+
+   //---------------------------------------------------------------------
+   //! Constructor.
+   //!
+   //! @param maxDepth maximum number of blocks to predict
+   //---------------------------------------------------------------------
+   AccessPattern(int maxDepth);
+
+   //---------------------------------------------------------------------
+   //! Register a client read.
+   //!
+   //! @param firstIdx first block index of the request
+   //! @param lastIdx  last block index of the request (inclusive)
+   //! @param isVector request is part of a vector read
+   //!
+   //! @return true if predicted blocks extend beyond those marked with
+   //!         Taken()
+   //---------------------------------------------------------------------
+   bool Update(int firstIdx, int lastIdx, bool isVector);
+
+   //---------------------------------------------------------------------
+   //! Get blocks expected to be read next, nearest first.
+   //!
+   //! @param blocks output, predicted block indices
+   //!
+   //! @return end of prediction window, to be passed to Taken()
+   //---------------------------------------------------------------------
+   int Predict(std::vector<int> &blocks);
+
+   //---------------------------------------------------------------------
+   //! All predicted blocks up to windowEnd are on disk or requested.
+   //---------------------------------------------------------------------
+   void Taken(int windowEnd);
+
+   //---------------------------------------------------------------------
+   //! Current number of blocks that should be prefetched.
+   //---------------------------------------------------------------------
+   int GetDepth();
+
+   Pattern_e GetPattern();
+
+   static const char* PatternName(Pattern_e p);
+
+private:
+   Pattern_e classify(int firstIdx, int lastIdx, bool isVector);
+   int       depth() const;
+   int       windowEnd() const;
+
+   XrdSysMutex m_mutex;
+
+   Pattern_e m_pattern;     //!< current pattern
+   int       m_confidence;  //!< reads matching current pattern, halved on random
+   int       m_maxDepth;    //!< upper limit for number of predicted blocks
+
+   int       m_lastFirst;   //!< first block of previous request, -1 if none
+   int       m_lastLast;    //!< last block of previous request
+   int       m_stride;      //!< distance between first blocks of previous two requests
+   int       m_width;       //!< number of blocks in previous request
+   int       m_taken;       //!< window end already handled by prefetch
+};
+}
+
+#endif
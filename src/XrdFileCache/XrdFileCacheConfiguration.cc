@@ -68,6 +68,105 @@ bool Cache::xdlib(XrdOucStream &Config)
    return true;
 }
 
+/* Function: xevict
+
+   Purpose:  To parse the directive: evict {lru | lfu | gdsf | arc} [<parms>]
+
+             lru     remove least recently accessed files first (default)
+             lfu     remove least frequently accessed files first
+             gdsf    greedy-dual-size-frequency, prefer keeping small
+                     frequently accessed files
+             arc     adaptive balance between recency and frequency
+             <parms> optional parameters to be passed to the policy.
+
+   Output: true upon success or false upon failure.
+ */
+bool Cache::xevict(XrdOucStream &Config)
+{
+   const char*  val;
+
+   if (! (val = Config.GetWord()) || ! val[0])
+   {
+      m_log.Emsg("Config", "evict policy not specified");
+      return false;
+   }
+
+   EvictionPolicy *ep = EvictionPolicy::Create(val);
+   if (! ep)
+   {
+      m_log.Emsg("Config", "unknown evict policy", val);
+      return false;
+   }
+
+   char params[4096];
+   Config.GetRest(params, 4096);
+   if (params[0] && ! ep->ConfigEviction(params))
+   {
+      m_log.Emsg("Config", "invalid evict parameters", params);
+      delete ep;
+      return false;
+   }
+
+   delete m_evictionPolicy;
+   m_evictionPolicy = ep;
+   return true;
+}
+
+/* Function: xevictlib
+
+   Purpose:  To parse the directive: evictionlib <path> [<parms>]
+
+             <path>  the path of the eviction policy library to be used.
+             <parms> optional parameters to be passed.
+
+
+   Output: true upon success or false upon failure.
+ */
+bool Cache::xevictlib(XrdOucStream &Config)
+{
+   const char*  val;
+
+   std::string libp;
+   if (! (val = Config.GetWord()) || ! val[0])
+   {
+      m_log.Emsg("Config", "evictionlib not specified");
+      return false;
+   }
+   else
+   {
+      libp = val;
+   }
+
+   char params[4096];
+   Config.GetRest(params, 4096);
+
+   XrdOucPinLoader* myLib = new XrdOucPinLoader(&m_log, 0, "evictionlib",
+                                                libp.c_str());
+
+   EvictionPolicy *(*ep)(XrdSysError&);
+   ep = (EvictionPolicy *(*)(XrdSysError&))myLib->Resolve("XrdFileCacheGetEvictionPolicy");
+   if (! ep) {myLib->Unload(true); return false; }
+
+   EvictionPolicy * p = ep(m_log);
+   if (! p)
+   {
+      TRACE(Error, "Cache::Config() evictionlib was not able to create an eviction policy object");
+      myLib->Unload(true);
+      return false;
+   }
+   if (params[0] && ! p->ConfigEviction(params))
+   {
+      TRACE(Error, "Cache::Config() evictionlib rejected parameters " << params);
+      delete p;
+      myLib->Unload(true);
+      return false;
+   }
+
+   delete m_evictionPolicy;
+   m_evictionPolicy = p;
+   return true;
+}
+
 /* Function: xtrace
 
    Purpose:  To parse the directive: trace <level>
@@ -167,6 +266,14 @@ bool Cache::Config(XrdSysLogger *logger, const char *config_filename, const char
       {
          retval = xdlib(Config);
       }
+      else if (! strcmp(var,"pfc.evict"))
+      {
+         retval = xevict(Config);
+      }
+      else if (! strcmp(var,"pfc.evictionlib"))
+      {
+         retval = xevictlib(Config);
+      }
       else if (! strcmp(var,"pfc.trace"))
       {
          retval = xtrace(Config);
@@ -187,6 +294,8 @@ bool Cache::Config(XrdSysLogger *logger, const char *config_filename, const char
 
    Config.Close();
 
+   m_purge_index.SetPolicy(m_evictionPolicy);
+
    // sets default value for disk usage
    {
       XrdOssVSInfo sP;
@@ -265,19 +374,23 @@ bool Cache::Config(XrdSysLogger *logger, const char *config_filename, const char
       float rg =  (m_configuration.m_RamAbsAvailable)/float(1024*1024*1024);
       loff = snprintf(buff, sizeof(buff), "Config effective %s pfc configuration:\n"
                       "       pfc.blocksize %lld\n"
-                      "       pfc.prefetch %zu\n"
+                      "       pfc.prefetch %zu%s\n"
                       "       pfc.ram %.fg\n"
-                      "       pfc.diskusage %lld %lld sleep %d\n"
+                      "       pfc.diskusage %lld %lld sleep %d fullscan %d\n"
+                      "       pfc.evict %s\n"
                       "       pfc.spaces %s %s\n"
                       "       pfc.trace %d\n"
                       "       pfc.flush %lld",
                       config_filename,
                       m_configuration.m_bufferSize,
                       m_configuration.m_prefetch_max_blocks,
+                      m_configuration.m_prefetch_adaptive ? " adaptive" : "",
                       rg,
                       m_configuration.m_diskUsageLWM,
                       m_configuration.m_diskUsageHWM,
                       m_configuration.m_purgeInterval,
+                      m_configuration.m_purgeFullScanInterval,
+                      m_evictionPolicy ? m_evictionPolicy->Name() : "lru",
                       m_configuration.m_data_space.c_str(),
                       m_configuration.m_meta_space.c_str(),
                       m_trace->What,
@@ -342,6 +455,15 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          {
             return false;
          }
+         p = config.GetWord();
+      }
+      if (p && strcmp(p, "fullscan") == 0)
+      {
+         p = config.GetWord();
+         if (XrdOuca2x::a2i(m_log, "Error getting purge full scan interval", p, &m_configuration.m_purgeFullScanInterval, 60, 7*24*3600))
+         {
+            return false;
+         }
       }
    }
    else if  ( part == "blocksize" )
@@ -368,6 +490,17 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          {
             // m_log.Emsg("prefetch enabled, max blocks per file ", params);
             m_configuration.m_prefetch_max_blocks = p;
+
+            const char* mode = config.GetWord();
+            if (mode && ! strcmp(mode, "adaptive"))
+            {
+               m_configuration.m_prefetch_adaptive = true;
+            }
+            else if (mode)
+            {
+               m_log.Emsg("Config", "Error: unknown prefetch mode", mode);
+               return false;
+            }
          }
          else
          {
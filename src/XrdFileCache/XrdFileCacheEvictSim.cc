@@ -0,0 +1,167 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <map>
+
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdSys/XrdSysTrace.hh"
+#include "XrdOss/XrdOss.hh"
+#include "XrdFileCacheInfo.hh"
+#include "XrdFileCachePurgeIndex.hh"
+#include "XrdFileCacheEvictSim.hh"
+
+using namespace XrdFileCache;
+
+//------------------------------------------------------------------------------
+
+void EvictSim::Add(time_t t, long long nBytes, const std::string &path)
+{
+   if ( ! m_accesses.empty() && t < m_accesses.back().m_time) m_sorted = false;
+   m_accesses.push_back(Access(t, nBytes, path));
+}
+
+//------------------------------------------------------------------------------
+
+bool EvictSim::ReadTrace(const char *fname)
+{
+   FILE *fp = fopen(fname, "r");
+   if (! fp)
+   {
+      printf("can't open %s: %s\n", fname, strerror(errno));
+      return false;
+   }
+
+   char line[4096], path[4096];
+   long long t, n;
+   int lineNo = 0;
+   while (fgets(line, sizeof(line), fp))
+   {
+      ++lineNo;
+      if (line[0] == '#' || line[0] == '\n') continue;
+      if (sscanf(line, "%lld %lld %4095s", &t, &n, path) != 3)
+      {
+         printf("%s:%d: expected '<time> <size> <path>'\n", fname, lineNo);
+         fclose(fp);
+         return false;
+      }
+      Add(t, n, path);
+   }
+   fclose(fp);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void EvictSim::ReadInfoDir(XrdOss *oss, XrdOssDF *iOssDF, const std::string &path)
+{
+   static const size_t InfoExtLen = strlen(Info::m_infoExtension);
+   XrdOucEnv env;
+   char buff[256];
+
+   while (iOssDF->Readdir(&buff[0], 256) >= 0)
+   {
+      size_t fname_len = strlen(buff);
+      if (fname_len == 0) break;
+      if (! strncmp("..", &buff[0], 2) || ! strncmp(".", &buff[0], 1)) continue;
+
+      std::string np = path + "/" + std::string(buff);
+
+      if (fname_len > InfoExtLen && ! strcmp(&buff[fname_len - InfoExtLen], Info::m_infoExtension))
+      {
+         XrdOssDF *fh = oss->newFile("nobody");
+         XrdSysTrace tr(""); tr.What = 1;
+         Info cfi(&tr);
+         if (fh->Open(np.c_str(), O_RDONLY, 0600, env) == XrdOssOK && cfi.Read(fh, np))
+         {
+            std::string dataPath = np.substr(0, np.size() - InfoExtLen);
+            const Info::Store &store = cfi.RefStoredData();
+            for (std::vector<Info::AStat>::const_iterator it = store.m_astats.begin(); it != store.m_astats.end(); ++it)
+            {
+               Add(it->AttachTime, cfi.GetFileSize(), dataPath);
+            }
+         }
+         delete fh;
+      }
+      else
+      {
+         XrdOssDF *dh = oss->newDir("nobody");
+         if (dh->Opendir(np.c_str(), env) == XrdOssOK)
+         {
+            ReadInfoDir(oss, dh, np);
+         }
+         delete dh;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+
+bool EvictSim::Run(const char *policyName, long long hwm, long long lwm, Result &result)
+{
+   EvictionPolicy *policy = EvictionPolicy::Create(policyName);
+   if (! policy) return false;
+
+   if ( ! m_sorted)
+   {
+      std::stable_sort(m_accesses.begin(), m_accesses.end());
+      m_sorted = true;
+   }
+
+   PurgeIndex index;
+   index.SetPolicy(policy);
+
+   std::map<std::string, size_t> nAccesses;  // per cached file, reset on eviction
+   result = Result();
+
+   for (std::vector<Access>::const_iterator a = m_accesses.begin(); a != m_accesses.end(); ++a)
+   {
+      ++result.m_nReq;
+      result.m_nBytes += a->m_nBytes;
+
+      size_t &cnt = nAccesses[a->m_path];
+      if (cnt > 0)
+      {
+         ++result.m_nHit;
+         result.m_nBytesHit += a->m_nBytes;
+      }
+      index.Update(a->m_path, a->m_time, a->m_nBytes, ++cnt);
+
+      size_t    nFiles;
+      long long nCached;
+      index.GetSize(nFiles, nCached);
+      if (nCached > hwm)
+      {
+         std::vector<PurgeIndex::Candidate> candidates;
+         index.Select(nCached - lwm, candidates);
+         for (std::vector<PurgeIndex::Candidate>::iterator c = candidates.begin(); c != candidates.end(); ++c)
+         {
+            index.Remove(c->m_path);
+            nAccesses.erase(c->m_path);
+            ++result.m_nEvicted;
+         }
+      }
+   }
+
+   delete policy;
+   return true;
+}
@@ -0,0 +1,104 @@
+#ifndef __XRDFILECACHE_EVICT_SIM_HH__
+#define __XRDFILECACHE_EVICT_SIM_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <time.h>
+#include <string>
+#include <vector>
+
+class XrdOss;
+class XrdOssDF;
+
+namespace XrdFileCache
+{
+//----------------------------------------------------------------------------
+//! Replays recorded file accesses against a cache of given size and counts
+//! the hits an eviction policy would have given. Accesses are read either
+//! from a trace file with lines "<unix time> <file size> <path>" or from the
+//! access statistics kept in the cinfo files of an existing cache.
+//----------------------------------------------------------------------------
+class EvictSim
+{
+public:
+   struct Result
+   {
+      long long m_nReq;       //!< number of accesses
+      long long m_nHit;       //!< accesses to files that were cached
+      long long m_nBytes;     //!< bytes accessed
+      long long m_nBytesHit;  //!< bytes accessed in files that were cached
+      long long m_nEvicted;   //!< number of evicted files
+
+      Result() : m_nReq(0), m_nHit(0), m_nBytes(0), m_nBytesHit(0), m_nEvicted(0) {}
+   };
+
+   //---------------------------------------------------------------------
+   //! Add an access to a file of given size.
+   //---------------------------------------------------------------------
+   void Add(time_t t, long long nBytes, const std::string &path);
+
+   //---------------------------------------------------------------------
+   //! Add the accesses listed in a trace file.
+   //!
+   //! @return false if the file can not be read or is malformed
+   //---------------------------------------------------------------------
+   bool ReadTrace(const char *fname);
+
+   //---------------------------------------------------------------------
+   //! Add the accesses recorded in the cinfo files under a directory.
+   //---------------------------------------------------------------------
+   void ReadInfoDir(XrdOss *oss, XrdOssDF *iOssDF, const std::string &path);
+
+   //---------------------------------------------------------------------
+   //! Replay the accesses, oldest first. Files are purged down to the low
+   //! watermark whenever the cached bytes exceed the high watermark.
+   //!
+   //! @param policyName built-in eviction policy, see EvictionPolicy::Create
+   //! @param hwm        high watermark in bytes
+   //! @param lwm        low watermark in bytes
+   //! @param result     output counters
+   //!
+   //! @return false if the policy is not known
+   //---------------------------------------------------------------------
+   bool Run(const char *policyName, long long hwm, long long lwm, Result &result);
+
+   //---------------------------------------------------------------------
+   //! Get number of accesses.
+   //---------------------------------------------------------------------
+   size_t GetNAccesses() const { return m_accesses.size(); }
+
+private:
+   struct Access
+   {
+      time_t      m_time;
+      long long   m_nBytes;
+      std::string m_path;
+
+      Access(time_t t, long long n, const std::string &p) : m_time(t), m_nBytes(n), m_path(p) {}
+
+      bool operator<(const Access &a) const { return m_time < a.m_time; }
+   };
+
+   std::vector<Access> m_accesses;
+   bool                m_sorted;
+
+public:
+   EvictSim() : m_sorted(true) {}
+};
+}
+
+#endif
@@ -0,0 +1,160 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------
+// Command line front end of EvictSim, see xrdpfc_evictsim(8).
+//----------------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucStream.hh"
+#include "XrdOuc/XrdOucArgs.hh"
+#include "XrdOuc/XrdOuca2x.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdOfs/XrdOfsConfigPI.hh"
+#include "XrdOss/XrdOss.hh"
+#include "XrdFileCacheEvictSim.hh"
+
+using namespace XrdFileCache;
+
+//______________________________________________________________________________
+
+int main(int argc, char *argv[])
+{
+   static const char* usage = "Usage: xrdpfc_evictsim [-c config_file] [-p policy[,policy...]] -s cache_size\n"
+                              "                       [-w high_watermark] [-l low_watermark] {trace_file | cache_dir}\n\n"
+                              "Policies: lru, lfu, gdsf, arc (default all). Watermarks are fractions of cache size.\n\n";
+   const char *cfgn     = 0;
+   std::string policies = "lru,lfu,gdsf,arc";
+   long long   cacheSize = 0;
+   double      hwmf = 0.95, lwmf = 0.90;
+
+   XrdOucEnv myEnv;
+
+   XrdSysLogger log;
+   XrdSysError err(&log);
+
+   XrdOucStream Config(&err, getenv("XRDINSTANCE"), &myEnv, "=====> ");
+   XrdOucArgs Spec(&err, "pfc_evictsim: ", "c:p:s:w:l:", (const char *)0);
+
+   Spec.Set(argc-1, &argv[1]);
+   char theOpt;
+
+   while((theOpt = Spec.getopt()) != (char)-1)
+   {
+      switch(theOpt)
+      {
+      case 'c':
+      {
+         cfgn = Spec.argval;
+         int fd = open(cfgn, O_RDONLY, 0);
+         Config.Attach(fd);
+         break;
+      }
+      case 'p':
+      {
+         policies = Spec.argval;
+         break;
+      }
+      case 's':
+      {
+         if (XrdOuca2x::a2sz(err, "cache size", Spec.argval, &cacheSize, 1)) exit(1);
+         break;
+      }
+      case 'w':
+      {
+         hwmf = atof(Spec.argval);
+         break;
+      }
+      case 'l':
+      {
+         lwmf = atof(Spec.argval);
+         break;
+      }
+      default:
+      {
+         printf("%s", usage);
+         exit(1);
+      }
+      }
+   }
+
+   const char *path = Spec.getarg();
+   if (! path || cacheSize <= 0 || lwmf <= 0 || hwmf > 1 || lwmf >= hwmf)
+   {
+      printf("%s", usage);
+      exit(1);
+   }
+
+   EvictSim    sim;
+   struct stat st;
+   if (stat(path, &st) == 0 && S_ISDIR(st.st_mode))
+   {
+      // suppress oss init messages
+      int efs = open("/dev/null",O_RDWR, 0);
+      XrdSysLogger ossLog(efs);
+      XrdSysError ossErr(&ossLog, "evictsim");
+      XrdOss *oss;
+      XrdOfsConfigPI *ofsCfg = XrdOfsConfigPI::New(cfgn,&Config,&ossErr);
+      if (! ofsCfg->Load(XrdOfsConfigPI::theOssLib))
+      {
+         printf("can't load oss\n");
+         exit(1);
+      }
+      ofsCfg->Plugin(oss);
+
+      XrdOucEnv env;
+      XrdOssDF *dh = oss->newDir("nobody");
+      if (dh->Opendir(path, env) != XrdOssOK)
+      {
+         printf("can't open directory %s\n", path);
+         exit(1);
+      }
+      sim.ReadInfoDir(oss, dh, path);
+      delete dh;
+   }
+   else if ( ! sim.ReadTrace(path))
+   {
+      exit(1);
+   }
+
+   printf("%zu accesses, cache size %lld, watermarks %.2f %.2f\n\n", sim.GetNAccesses(), cacheSize, lwmf, hwmf);
+   printf("%-6s %10s %10s %8s %16s %8s %10s\n", "policy", "requests", "hits", "hit", "bytes", "bytehit", "evicted");
+
+   char *pl = strdup(policies.c_str()), *save = 0;
+   for (char *p = strtok_r(pl, ",", &save); p; p = strtok_r(0, ",", &save))
+   {
+      EvictSim::Result r;
+      if ( ! sim.Run(p, static_cast<long long>(cacheSize * hwmf), static_cast<long long>(cacheSize * lwmf), r))
+      {
+         printf("%-6s unknown policy\n", p);
+         continue;
+      }
+      printf("%-6s %10lld %10lld %7.2f%% %16lld %7.2f%% %10lld\n", p,
+             r.m_nReq, r.m_nHit, r.m_nReq ? 100.0 * r.m_nHit / r.m_nReq : 0.0,
+             r.m_nBytes, r.m_nBytes ? 100.0 * r.m_nBytesHit / r.m_nBytes : 0.0, r.m_nEvicted);
+   }
+   free(pl);
+
+   return 0;
+}
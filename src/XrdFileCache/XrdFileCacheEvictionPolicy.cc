@@ -0,0 +1,296 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include "XrdFileCacheEvictionPolicy.hh"
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <list>
+#include <map>
+
+using namespace XrdFileCache;
+
+namespace
+{
+//----------------------------------------------------------------------------
+//! Take files from the front of the list until enough bytes are collected.
+//----------------------------------------------------------------------------
+void TakeFirst(const std::vector<FileRecord*> &files, long long nBytesReq,
+               std::vector<FileRecord*> &selected)
+{
+   long long nBytesAccum = 0;
+   for (std::vector<FileRecord*>::const_iterator it = files.begin(); it != files.end() && nBytesAccum < nBytesReq; ++it)
+   {
+      selected.push_back(*it);
+      nBytesAccum += (*it)->m_nBytes;
+   }
+}
+
+//----------------------------------------------------------------------------
+//! A file and its position in the list, which breaks ties between files of
+//! the same rank in favour of the least recently accessed one.
+//----------------------------------------------------------------------------
+struct Ranked
+{
+   FileRecord *m_rec;
+   size_t      m_pos;
+};
+
+bool MoreAccesses(const Ranked &a, const Ranked &b)
+{
+   if (a.m_rec->m_nAccesses != b.m_rec->m_nAccesses) return a.m_rec->m_nAccesses > b.m_rec->m_nAccesses;
+   return a.m_pos > b.m_pos;
+}
+
+bool MoreValue(const Ranked &a, const Ranked &b)
+{
+   if (a.m_rec->m_value != b.m_rec->m_value) return a.m_rec->m_value > b.m_rec->m_value;
+   return a.m_pos > b.m_pos;
+}
+
+//----------------------------------------------------------------------------
+//! Take files of lowest rank until enough bytes are collected. The files are
+//! kept in a heap so only the ones taken are ordered, purge usually frees a
+//! small part of the cache.
+//----------------------------------------------------------------------------
+void TakeLowest(const std::vector<FileRecord*> &files, long long nBytesReq,
+                bool (*more)(const Ranked&, const Ranked&),
+                std::vector<FileRecord*> &selected)
+{
+   std::vector<Ranked> heap(files.size());
+   for (size_t i = 0; i < files.size(); ++i)
+   {
+      heap[i].m_rec = files[i];
+      heap[i].m_pos = i;
+   }
+   std::make_heap(heap.begin(), heap.end(), more);
+
+   long long nBytesAccum = 0;
+   while ( ! heap.empty() && nBytesAccum < nBytesReq)
+   {
+      std::pop_heap(heap.begin(), heap.end(), more);
+      selected.push_back(heap.back().m_rec);
+      nBytesAccum += heap.back().m_rec->m_nBytes;
+      heap.pop_back();
+   }
+}
+
+//----------------------------------------------------------------------------
+//! Least recently used.
+//----------------------------------------------------------------------------
+class LRUPolicy : public EvictionPolicy
+{
+public:
+   virtual const char* Name() const { return "lru"; }
+
+   virtual Order GetOrder() const { return kByAccessTime; }
+
+   virtual void Select(const std::vector<FileRecord*> &files, long long nBytesReq,
+                       std::vector<FileRecord*> &selected)
+   {
+      TakeFirst(files, nBytesReq, selected);
+   }
+};
+
+//----------------------------------------------------------------------------
+//! Least frequently used, ties broken by access time.
+//----------------------------------------------------------------------------
+class LFUPolicy : public EvictionPolicy
+{
+public:
+   virtual const char* Name() const { return "lfu"; }
+
+   virtual Order GetOrder() const { return kByValue; }
+
+   virtual void Accessed(FileRecord &rec) { rec.m_value = rec.m_nAccesses; }
+
+   virtual void Select(const std::vector<FileRecord*> &files, long long nBytesReq,
+                       std::vector<FileRecord*> &selected)
+   {
+      TakeLowest(files, nBytesReq, MoreAccesses, selected);
+   }
+};
+
+//----------------------------------------------------------------------------
+//! Greedy-Dual-Size-Frequency. Priority of a file is L + frequency / size,
+//! where L is raised to the priority of each evicted file so that files
+//! which are not accessed age out. Small, often used files are kept longest.
+//----------------------------------------------------------------------------
+class GDSFPolicy : public EvictionPolicy
+{
+public:
+   GDSFPolicy() : m_L(0) {}
+
+   virtual const char* Name() const { return "gdsf"; }
+
+   virtual Order GetOrder() const { return kByValue; }
+
+   virtual double GetBase() const { return m_L; }
+
+   virtual void RaiseBase(double base) { if (base > m_L) m_L = base; }
+
+   virtual void Accessed(FileRecord &rec)
+   {
+      // size in MB so priorities stay in a sensible range
+      double size = std::max(rec.m_nBytes, 1ll) / (1024.0 * 1024.0);
+      rec.m_value = m_L + rec.m_nAccesses / size;
+   }
+
+   virtual void Evicted(const FileRecord &rec)
+   {
+      if (rec.m_value > m_L) m_L = rec.m_value;
+   }
+
+   virtual void Select(const std::vector<FileRecord*> &files, long long nBytesReq,
+                       std::vector<FileRecord*> &selected)
+   {
+      TakeLowest(files, nBytesReq, MoreValue, selected);
+   }
+
+private:
+   double m_L;    //!< inflation value
+};
+
+//----------------------------------------------------------------------------
+//! Adaptive replacement, adapted to whole-file purging.
+//!
+//! Files accessed once form the recency list T1, files accessed more than
+//! once the frequency list T2. Eviction takes from T1 while it holds more
+//! than the target p bytes, otherwise from T2. Paths of evicted files are
+//! remembered in the ghost lists B1 and B2; a re-open of a file found in B1
+//! grows p, one found in B2 shrinks it.
+//----------------------------------------------------------------------------
+class ARCPolicy : public EvictionPolicy
+{
+public:
+   ARCPolicy() : m_p(0), m_maxGhosts(100000) {}
+
+   virtual const char* Name() const { return "arc"; }
+
+   virtual void Accessed(FileRecord &rec)
+   {
+      GhostMap_i gi = m_ghostMap.find(*rec.m_path);
+      if (gi == m_ghostMap.end()) return;
+
+      if (gi->second.m_fromT2)
+         m_p = std::max(m_p - rec.m_nBytes, 0ll);
+      else
+         m_p += rec.m_nBytes;
+
+      m_ghosts.erase(gi->second.m_listIt);
+      m_ghostMap.erase(gi);
+   }
+
+   virtual void Evicted(const FileRecord &rec)
+   {
+      GhostMap_i gi = m_ghostMap.find(*rec.m_path);
+      if (gi != m_ghostMap.end())
+      {
+         m_ghosts.erase(gi->second.m_listIt);
+         m_ghostMap.erase(gi);
+      }
+
+      if (m_ghostMap.size() >= m_maxGhosts && ! m_ghosts.empty())
+      {
+         m_ghostMap.erase(m_ghosts.front());
+         m_ghosts.pop_front();
+      }
+
+      Ghost &g = m_ghostMap[*rec.m_path];
+      g.m_fromT2 = rec.m_nAccesses > 1;
+      g.m_listIt = m_ghosts.insert(m_ghosts.end(), *rec.m_path);
+   }
+
+   virtual void Select(const std::vector<FileRecord*> &files, long long nBytesReq,
+                       std::vector<FileRecord*> &selected)
+   {
+      std::vector<FileRecord*> t1, t2;
+      long long t1Bytes = 0, totBytes = 0;
+      for (std::vector<FileRecord*>::const_iterator it = files.begin(); it != files.end(); ++it)
+      {
+         if ((*it)->m_nAccesses > 1)
+         {
+            t2.push_back(*it);
+         }
+         else
+         {
+            t1.push_back(*it);
+            t1Bytes += (*it)->m_nBytes;
+         }
+         totBytes += (*it)->m_nBytes;
+      }
+      if (m_p > totBytes) m_p = totBytes;
+
+      long long nBytesAccum = 0;
+      size_t i1 = 0, i2 = 0;
+      while (nBytesAccum < nBytesReq && (i1 < t1.size() || i2 < t2.size()))
+      {
+         FileRecord *rec;
+         if (i1 < t1.size() && (t1Bytes > m_p || i2 >= t2.size()))
+         {
+            rec = t1[i1++];
+            t1Bytes -= rec->m_nBytes;
+         }
+         else
+         {
+            rec = t2[i2++];
+         }
+         selected.push_back(rec);
+         nBytesAccum += rec->m_nBytes;
+      }
+   }
+
+   virtual bool ConfigEviction(const char* params)
+   {
+      const char *p = strstr(params, "ghosts");
+      if (p)
+      {
+         long n = strtol(p + 6, 0, 10);
+         if (n <= 0) return false;
+         m_maxGhosts = n;
+      }
+      return true;
+   }
+
+private:
+   struct Ghost
+   {
+      bool                             m_fromT2;
+      std::list<std::string>::iterator m_listIt;
+   };
+
+   typedef std::map<std::string, Ghost> GhostMap_t;
+   typedef GhostMap_t::iterator         GhostMap_i;
+
+   long long               m_p;          //!< target size of T1 in bytes
+   size_t                  m_maxGhosts;  //!< max number of remembered evicted files
+   std::list<std::string>  m_ghosts;     //!< evicted paths, oldest first
+   GhostMap_t              m_ghostMap;
+};
+}
+
+//------------------------------------------------------------------------------
+
+EvictionPolicy* EvictionPolicy::Create(const char* name)
+{
+   if (! strcmp(name, "lru"))  return new LRUPolicy;
+   if (! strcmp(name, "lfu"))  return new LFUPolicy;
+   if (! strcmp(name, "gdsf")) return new GDSFPolicy;
+   if (! strcmp(name, "arc"))  return new ARCPolicy;
+   return 0;
+}
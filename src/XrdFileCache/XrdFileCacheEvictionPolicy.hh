@@ -0,0 +1,133 @@
+#ifndef __XRDFILECACHE_EVICTION_POLICY_HH__
+#define __XRDFILECACHE_EVICTION_POLICY_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <time.h>
+#include <string>
+#include <vector>
+
+class XrdSysError;
+
+namespace XrdFileCache
+{
+//----------------------------------------------------------------------------
+//! State of a cached file as seen by an eviction policy.
+//----------------------------------------------------------------------------
+struct FileRecord
+{
+   const std::string *m_path;        //!< data file path
+   long long          m_nBytes;      //!< bytes on disk
+   time_t             m_accessTime;  //!< last access time
+   size_t             m_nAccesses;   //!< number of accesses recorded in cinfo file
+   double             m_value;       //!< policy private, e.g. priority
+
+   FileRecord() : m_path(0), m_nBytes(0), m_accessTime(0), m_nAccesses(0), m_value(0) {}
+};
+
+//----------------------------------------------------------------------------
+//! Base class for selecting which files are removed when the cache is full.
+//!
+//! All methods are called with the purge index locked, so implementations
+//! need no locking of their own.
+//----------------------------------------------------------------------------
+class EvictionPolicy
+{
+public:
+   //---------------------------------------------------------------------
+   //! Order in which a policy removes files.
+   //---------------------------------------------------------------------
+   enum Order
+   {
+      kByAccessTime,  //!< least recently accessed first
+      kByValue,       //!< lowest m_value first, ties by access time
+      kCustom         //!< as chosen by Select()
+   };
+
+   //--------------------------------------------------------------------------
+   //! Destructor
+   //--------------------------------------------------------------------------
+   virtual ~EvictionPolicy() {}
+
+   //---------------------------------------------------------------------
+   //! The purge index keeps its files sorted for kByAccessTime and kByValue
+   //! and then takes them in that order itself, without calling Select().
+   //---------------------------------------------------------------------
+   virtual Order GetOrder() const { return kCustom; }
+
+   //---------------------------------------------------------------------
+   //! Value files accessed now are ranked from, e.g. the GDSF inflation.
+   //! It is saved with the purge index so that m_value of the saved files
+   //! keeps its meaning after a restart.
+   //---------------------------------------------------------------------
+   virtual double GetBase() const { return 0; }
+
+   //---------------------------------------------------------------------
+   //! Raise the base to at least the given value, see GetBase().
+   //---------------------------------------------------------------------
+   virtual void RaiseBase(double base) { (void) base; }
+
+   //---------------------------------------------------------------------
+   //! Name used in configuration and trace output.
+   //---------------------------------------------------------------------
+   virtual const char* Name() const = 0;
+
+   //---------------------------------------------------------------------
+   //! File was opened, detached or found by a scan of the cache.
+   //!
+   //! @param rec file record, m_value may be modified
+   //---------------------------------------------------------------------
+   virtual void Accessed(FileRecord &rec) { (void) rec; }
+
+   //---------------------------------------------------------------------
+   //! File is about to be removed from the cache.
+   //---------------------------------------------------------------------
+   virtual void Evicted(const FileRecord &rec) { (void) rec; }
+
+   //---------------------------------------------------------------------
+   //! Choose files to be removed.
+   //!
+   //! @param files     all indexed files, least recently accessed first
+   //! @param nBytesReq number of bytes that should be freed
+   //! @param selected  files to remove, in order of removal
+   //---------------------------------------------------------------------
+   virtual void Select(const std::vector<FileRecord*> &files, long long nBytesReq,
+                       std::vector<FileRecord*> &selected) = 0;
+
+   //------------------------------------------------------------------------------
+   //! Parse configuration arguments.
+   //!
+   //! @param params configuration parameters
+   //!
+   //! @return status of configuration
+   //------------------------------------------------------------------------------
+   virtual bool ConfigEviction(const char* params)
+   {
+      (void) params;
+      return true;
+   }
+
+   //---------------------------------------------------------------------
+   //! Create one of the built-in policies: lru, lfu, gdsf or arc.
+   //!
+   //! @return new policy or 0 if name is not known
+   //---------------------------------------------------------------------
+   static EvictionPolicy* Create(const char* name);
+};
+}
+
+#endif
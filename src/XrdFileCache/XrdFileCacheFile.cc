@@ -27,6 +27,7 @@
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClFile.hh"
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdSys/XrdSysTimer.hh"
 #include "XrdOss/XrdOss.hh"
@@ -67,8 +68,16 @@ File::File(IO *io, const std::string& path, long long iOffset, long long iFileSi
    m_prefetchReadCnt(0),
    m_prefetchHitCnt(0),
    m_prefetchScore(1),
+   m_noLockBytes(0),
+   m_noLockReads(0),
+   m_pattern(0),
    m_detachTimeIsLogged(false)
 {
+   const Configuration &conf = Cache::GetInstance().RefConfiguration();
+   if (conf.m_prefetch_adaptive && conf.m_prefetch_max_blocks > 0)
+   {
+      m_pattern = new AccessPattern(conf.m_prefetch_max_blocks);
+   }
    Open();
 }
 
@@ -90,7 +99,16 @@ File::~File()
       m_output = NULL;
    }
 
-   TRACEF(Debug, "File::~File() ended, prefetch score = " <<  m_prefetchScore);
+   if (m_pattern)
+   {
+      TRACEF(Debug, "File::~File() access pattern " << AccessPattern::PatternName(m_pattern->GetPattern()) <<
+             ", prefetch depth " << m_pattern->GetDepth());
+      delete m_pattern;
+   }
+
+   Stats loc_stats = StatsSnapshot();
+   TRACEF(Debug, "File::~File() ended, prefetch score = " <<  m_prefetchScore <<
+          ", lock-free reads = " << loc_stats.m_ReadsNoLock << ", locked reads = " << loc_stats.m_ReadsLocked);
 }
 
 //------------------------------------------------------------------------------
@@ -171,7 +189,7 @@ bool File::FinalizeSyncBeforeExit()
    {
      if ( ! m_writes_during_sync.empty() || m_non_flushed_cnt > 0 || ! m_detachTimeIsLogged)
      {
-       Stats loc_stats = m_stats.Clone();
+       Stats loc_stats = StatsSnapshot();
        m_cfi.WriteIOStatDetach(loc_stats);
        m_detachTimeIsLogged = true;
        TRACEF(Debug, "File::FinalizeSyncBeforeExit scheduling sync to write detach stats");
@@ -207,8 +225,16 @@ IO* File::SetIO(IO *io)
    m_io = io;
    if (io && m_prefetchState != kComplete)
    {
-      cacheActivatePrefetch = true;
-      m_prefetchState = kOn;
+      if (m_pattern)
+      {
+         // adaptive prefetch is started by reads
+         if (m_prefetchState == kStopped) m_prefetchState = kIdle;
+      }
+      else
+      {
+         cacheActivatePrefetch = true;
+         m_prefetchState = kOn;
+      }
    }
    m_downloadCond.UnLock();
    
@@ -289,7 +315,7 @@ bool File::Open()
    m_cfi.WriteIOStatAttach();
    m_downloadCond.Lock();
    m_is_open = true;
-   m_prefetchState = (m_cfi.IsComplete()) ? kComplete : kOn;
+   m_prefetchState = (m_cfi.IsComplete()) ? kComplete : (m_pattern ? kIdle : kOn);
    m_downloadCond.UnLock();
 
    if (m_prefetchState == kOn) cache()->RegisterPrefetchFile(this);
@@ -460,6 +486,47 @@ int File::Read(char* iUserBuff, long long iUserOff, int iUserSize)
 
    Stats loc_stats;
 
+   // Fast path: when all the requested blocks are already on disk serve the
+   // request straight from the data file without taking m_downloadCond.
+   {
+      const int idx_first = iUserOff / BS;
+      const int idx_last  = (iUserOff + iUserSize - 1) / BS;
+      int       n_prefetched;
+
+      if (iUserSize > 0 &&
+          m_cfi.IsRngWrittenNoLock(offsetIdx(idx_first), offsetIdx(idx_last), n_prefetched))
+      {
+         long long rs = m_output->Read(iUserBuff, iUserOff - m_offset, iUserSize);
+         if (rs == iUserSize)
+         {
+            TRACEF(Dump, "File::Read() " << (void*)iUserBuff << " lock-free from disk size = " << rs);
+            if (n_prefetched) AtomicAdd(m_prefetchHitCnt, n_prefetched);
+            AtomicAdd(m_noLockBytes, rs);
+            AtomicAdd(m_noLockReads, 1);
+            return rs;
+         }
+         // Short reads at the end of file are expected, the locked path
+         // below sorts them out.
+         if (rs < 0)
+         {
+            TRACEF(Warning, "File::Read() lock-free read from disk failed " << rs << ", retrying with lock");
+         }
+         else
+         {
+            TRACEF(Dump, "File::Read() lock-free read from disk returned " << rs << ", retrying with lock");
+         }
+      }
+   }
+   loc_stats.m_ReadsLocked = 1;
+
+   // Reads served from disk above are not fed to the pattern detector, it
+   // only needs to follow the reads that may lead to prefetching. Unlocked
+   // check of state is fine, complete files need no prefetch.
+   if (m_pattern && iUserSize > 0 && m_prefetchState != kComplete)
+   {
+      UpdateAccessPattern(iUserOff / BS, (iUserOff + iUserSize - 1) / BS, false);
+   }
+
    // lock
    // loop over reqired blocks:
    //   - if on disk, ok;
@@ -682,13 +749,14 @@ int File::Read(char* iUserBuff, long long iUserOff, int iUserSize)
       }
 
       // update prefetch score
-      m_prefetchHitCnt += prefetchHitsRam;
+      // m_prefetchHitCnt is also updated by the lock-free path in Read().
       for (IntList_i d = blks_on_disk.begin(); d !=  blks_on_disk.end(); ++d)
       {
          if (m_cfi.TestPrefetchBit(offsetIdx(*d)))
-            m_prefetchHitCnt++;
+            prefetchHitsRam++;
       }
-      m_prefetchScore = float(m_prefetchHitCnt)/m_prefetchReadCnt;
+      AtomicAdd(m_prefetchHitCnt, prefetchHitsRam);
+      m_prefetchScore = float(AtomicGet(m_prefetchHitCnt))/m_prefetchReadCnt;
    }
 
    m_stats.AddStats(loc_stats);
@@ -735,11 +803,12 @@ void File::WriteBlockToDisk(Block* b)
    {
       XrdSysCondVarHelper _lck(m_downloadCond);
 
-      m_cfi.SetBitWritten(pfIdx);
-
+      // Prefetch bit goes first as Read() tests the written bit without lock.
       if (b->m_prefetch)
          m_cfi.SetBitPrefetch(pfIdx);
 
+      m_cfi.SetBitWritten(pfIdx);
+
       // clLog()->Dump(XrdCl::AppMsg, "File::WriteToDisk() dec_ref_count %d %s", pfIdx, lPath());
       dec_ref_count(b);
 
@@ -762,6 +831,8 @@ void File::WriteBlockToDisk(Block* b)
       }
    }
 
+   cache()->FileWritten(m_filename, size);
+
    if (schedule_sync)
    {
       cache()->ScheduleFileSync(this);
@@ -903,7 +974,11 @@ void File::Prefetch()
       if (m_prefetchState != kOn)
          return;
 
-      for (int f = 0; f < m_cfi.GetSizeInBits(); ++f)
+      if (m_pattern)
+      {
+         PrefetchPredicted(blks);
+      }
+      else for (int f = 0; f < m_cfi.GetSizeInBits(); ++f)
       {
          if ( ! m_cfi.TestBit(f))
          {
@@ -915,7 +990,7 @@ void File::Prefetch()
                cache()->RequestRAMBlock();
                blks.push_back( PrepareBlockRequest(f, true) );
                m_prefetchReadCnt++;
-               m_prefetchScore = float(m_prefetchHitCnt)/m_prefetchReadCnt;
+               m_prefetchScore = float(AtomicGet(m_prefetchHitCnt))/m_prefetchReadCnt;
                break;
             }
          }
@@ -927,7 +1002,7 @@ void File::Prefetch()
    {
       ProcessBlockRequests(blks);
    }
-   else
+   else if ( ! m_pattern)
    {
       TRACEF(Dump, "File::Prefetch no free block found ");
       m_downloadCond.Lock();
@@ -938,6 +1013,68 @@ void File::Prefetch()
 }
 
 
+//------------------------------------------------------------------------------
+
+void File::PrefetchPredicted(BlockList_t& blks)
+{
+   // Called from Prefetch() with m_downloadCond locked.
+
+   std::vector<int> predicted;
+   const int windowEnd = m_pattern->Predict(predicted);
+
+   const int firstIdx = m_offset/m_cfi.GetBufferSize();
+   const int endIdx   = firstIdx + m_cfi.GetSizeInBits();
+
+   for (std::vector<int>::iterator it = predicted.begin(); it != predicted.end(); ++it)
+   {
+      const int f = *it;
+      if (f < firstIdx || f >= endIdx || m_cfi.TestBit(offsetIdx(f)) ||
+          m_block_map.find(f) != m_block_map.end())
+         continue;
+
+      TRACEF(Dump, "File::PrefetchPredicted take block " << f);
+      cache()->RequestRAMBlock();
+      blks.push_back( PrepareBlockRequest(f, true) );
+      m_prefetchReadCnt++;
+      m_prefetchScore = float(AtomicGet(m_prefetchHitCnt))/m_prefetchReadCnt;
+      return;
+   }
+
+   // Nothing left to do in this window, wait for further reads.
+   m_pattern->Taken(windowEnd);
+   m_prefetchState = m_cfi.IsComplete() ? kComplete : kIdle;
+   cache()->DeRegisterPrefetchFile(this);
+   TRACEF(Dump, "File::PrefetchPredicted window up to " << windowEnd << " done");
+}
+
+//------------------------------------------------------------------------------
+
+void File::UpdateAccessPattern(int firstIdx, int lastIdx, bool isVector)
+{
+   if ( ! m_pattern->Update(firstIdx, lastIdx, isVector))
+      return;
+
+   XrdSysCondVarHelper _lck(m_downloadCond);
+
+   if (m_prefetchState == kIdle)
+   {
+      m_prefetchState = kOn;
+      cache()->RegisterPrefetchFile(this);
+   }
+}
+
+//------------------------------------------------------------------------------
+
+Stats File::StatsSnapshot()
+{
+   // Lock-free reads are counted apart so that they do not take the lock
+   // of m_stats.
+   Stats loc_stats = m_stats.Clone();
+   loc_stats.m_BytesDisk   += AtomicGet(m_noLockBytes);
+   loc_stats.m_ReadsNoLock += AtomicGet(m_noLockReads);
+   return loc_stats;
+}
+
 //------------------------------------------------------------------------------
 
 float File::GetPrefetchScore() const
@@ -26,6 +26,7 @@
 
 #include "XrdFileCacheInfo.hh"
 #include "XrdFileCacheStats.hh"
+#include "XrdFileCacheAccessPattern.hh"
 
 #include <string>
 #include <map>
@@ -193,6 +194,12 @@ public:
 
    long long GetFileSize() { return m_fileSize; }
 
+   //! Number of bytes written to the local data file.
+   long long GetNDownloadedBytes() const { return m_cfi.GetNDownloadedBytes(); }
+
+   //! Number of accesses recorded in cinfo file, including the current one.
+   size_t GetAccessCnt() { return m_cfi.GetAccessCnt(); }
+
    IO*  SetIO(IO* io);
    void ReleaseIO();
 
@@ -202,7 +209,7 @@ public:
    int dec_ref_cnt() { return --m_ref_cnt; }
 
 private:
-   enum PrefetchState_e { kOff=-1, kOn, kHold, kStopped, kComplete };
+   enum PrefetchState_e { kOff=-1, kOn, kHold, kStopped, kComplete, kIdle };
 
    int            m_ref_cnt;            //!< number of references from IO or sync
    
@@ -241,8 +248,13 @@ private:
    PrefetchState_e m_prefetchState;
 
    int   m_prefetchReadCnt;
-   int   m_prefetchHitCnt;
+   int   m_prefetchHitCnt;          //!< updated with atomics, see Read()
    float m_prefetchScore;              //cached
+
+   long long m_noLockBytes;         //!< bytes of lock-free reads, updated with atomics, see StatsSnapshot()
+   long long m_noLockReads;         //!< number of lock-free reads, updated with atomics
+
+   AccessPattern *m_pattern;        //!< read pattern detector for adaptive prefetch, 0 if disabled
    
    bool  m_detachTimeIsLogged;
 
@@ -260,6 +272,12 @@ private:
    
    void   ProcessBlockRequests(BlockList_t& blks);
 
+   // Adaptive prefetch
+   void   PrefetchPredicted(BlockList_t& blks);
+   void   UpdateAccessPattern(int firstIdx, int lastIdx, bool isVector);
+
+   Stats  StatsSnapshot();
+
    int    RequestBlocksDirect(DirectResponseHandler *handler, IntList_t& blocks,
                               char* buff, long long req_off, long long req_size);
 
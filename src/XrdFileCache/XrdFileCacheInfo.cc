@@ -213,14 +213,14 @@ bool Info::Read(XrdOssDF* fp, const std::string &fname)
    }
 
    // cache complete status
-   m_complete = ! IsAnythingEmptyInRng(0, m_sizeInBits);
+   UpdateDownloadCompleteStatus();
 
    // read creation time
    if (r.Read(m_store.m_creationTime)) return false;
 
    // get number of accessess
    if (r.Read(m_store.m_accessCnt, false)) m_store.m_accessCnt = 0;  // was: return false;
-   TRACE(Dump, trace_pfx << " complete "<< m_complete << " access_cnt " << m_store.m_accessCnt);
+   TRACE(Dump, trace_pfx << " complete "<< IsComplete() << " access_cnt " << m_store.m_accessCnt);
 
    // read access statistics
    int vs = m_store.m_accessCnt < m_maxNumAccess ? m_store.m_accessCnt : m_maxNumAccess;
@@ -261,9 +261,9 @@ bool Info::ReadV1(XrdOssDF* fp, const std::string &fname)
    memcpy(m_buff_written, m_store.m_buff_synced, GetSizeInBytes());
 
 
-   m_complete = ! IsAnythingEmptyInRng(0, m_sizeInBits);
+   UpdateDownloadCompleteStatus();
    if (r.ReadRaw(&m_store.m_accessCnt, sizeof(int), false)) m_store.m_accessCnt = 0;  // was: return false;
-   TRACE(Dump, trace_pfx << " complete "<< m_complete << " access_cnt " << m_store.m_accessCnt);
+   TRACE(Dump, trace_pfx << " complete "<< IsComplete() << " access_cnt " << m_store.m_accessCnt);
 
 
    size_t startFillIdx = m_store.m_accessCnt < m_maxNumAccess ? 0 : m_store.m_accessCnt - m_maxNumAccess;
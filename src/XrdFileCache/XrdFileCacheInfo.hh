@@ -23,6 +23,7 @@
 #include <assert.h>
 #include <vector>
 
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClDefaultEnv.hh"
@@ -190,6 +191,19 @@ public:
    //---------------------------------------------------------------------
    bool TestPrefetchBit(int i) const;
 
+   //---------------------------------------------------------------------
+   //! \brief Test if all blocks in the given range are downloaded.
+   //!
+   //! Can be called without holding the owning File's lock as bits are only
+   //! ever set and SetBitWritten() publishes them atomically. The result
+   //! can only be stale in the "not downloaded" direction.
+   //!
+   //! @param firstIdx first block index
+   //! @param lastIdx  last block index (inclusive)
+   //! @param nPrefetched set to the number of blocks written by prefetch
+   //---------------------------------------------------------------------
+   bool IsRngWrittenNoLock(int firstIdx, int lastIdx, int &nPrefetched) const;
+
    //---------------------------------------------------------------------
    //! Get complete status
    //---------------------------------------------------------------------
@@ -248,7 +262,7 @@ protected:
    unsigned char *m_buff_prefetch;           //!< prefetch statistics
 
    int m_sizeInBits;                         //!cached
-   bool m_complete;                          //!< cached
+   CPP_ATOMIC_TYPE(bool) m_complete;         //!< cached, read without lock by IsRngWrittenNoLock()
 
 private:
    inline unsigned char cfiBIT(int n) const { return 1 << n; }
@@ -313,7 +327,7 @@ inline long long Info::GetFileSize() const
 
 inline bool Info::IsComplete() const
 {
-   return m_complete;
+   return CPP_ATOMIC_LOAD(m_complete, std::memory_order_acquire);
 }
 
 inline bool Info::IsAnythingEmptyInRng(int firstIdx, int lastIdx) const
@@ -328,7 +342,7 @@ inline bool Info::IsAnythingEmptyInRng(int firstIdx, int lastIdx) const
 
 inline void Info::UpdateDownloadCompleteStatus()
 {
-   m_complete = ! IsAnythingEmptyInRng(0, m_sizeInBits);
+   CPP_ATOMIC_STORE(m_complete, ! IsAnythingEmptyInRng(0, m_sizeInBits), std::memory_order_release);
 }
 
 inline void Info::SetBitSynced(int i)
@@ -346,7 +360,7 @@ inline void Info::SetBitWritten(int i)
    assert(cn < GetSizeInBytes());
 
    const int off = i - cn*8;
-   m_buff_written[cn] |= cfiBIT(off);
+   AtomicOr(m_buff_written[cn], cfiBIT(off));
 }
 
 inline void Info::SetBitPrefetch(int i)
@@ -357,7 +371,25 @@ inline void Info::SetBitPrefetch(int i)
    assert(cn < GetSizeInBytes());
 
    const int off = i - cn*8;
-   m_buff_prefetch[cn] |= cfiBIT(off);
+   AtomicOr(m_buff_prefetch[cn], cfiBIT(off));
+}
+
+inline bool Info::IsRngWrittenNoLock(int firstIdx, int lastIdx, int &nPrefetched) const
+{
+   nPrefetched = 0;
+   if (firstIdx < 0 || lastIdx >= m_sizeInBits) return false;
+
+   // Bits are only ever set, so a complete file needs no further checks.
+   // The prefetch bits must be set before a block's written bit.
+   const bool complete = IsComplete();
+   for (int i = firstIdx; i <= lastIdx; ++i)
+   {
+      const int cn  = i/8;
+      const int off = i - cn*8;
+      if ( ! complete && ! (AtomicGet(m_buff_written[cn]) & cfiBIT(off))) return false;
+      if (m_buff_prefetch && (AtomicGet(m_buff_prefetch[cn]) & cfiBIT(off))) ++nPrefetched;
+   }
+   return true;
 }
 
 
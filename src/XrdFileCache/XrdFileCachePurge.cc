@@ -9,53 +9,13 @@ using namespace XrdFileCache;
 
 namespace
 {
-class FPurgeState
-{
-public:
-   struct FS
-   {
-      std::string path;
-      long long nByte;
-      FS(const char* p, long long n) : path(p), nByte(n) {}
-   };
-
-   typedef std::multimap<time_t, FS> map_t;
-   typedef map_t::iterator map_i;
-   map_t fmap;
-   
-   FPurgeState(long long iNByteReq) : nByteReq(iNByteReq), nByteAccum(0) {}
-
-   void checkFile (time_t iTime, const char* iPath,  long long iNByte)
-   {
-      if (nByteAccum < nByteReq || iTime < fmap.rbegin()->first)
-      {
-         fmap.insert(std::pair<const time_t, FS> (iTime, FS(iPath, iNByte)));
-         nByteAccum += iNByte;
-
-         // remove newest files from map if necessary
-         while (nByteAccum > nByteReq)
-         {
-            time_t nt = fmap.begin()->first;
-            std::pair<map_i, map_i> ret = fmap.equal_range(nt);
-            for (map_i it2 = ret.first; it2 != ret.second; ++it2)
-               nByteAccum -= it2->second.nByte;
-            fmap.erase(ret.first, ret.second);
-         }
-      }
-   }
-
-private:
-   long long nByteReq;
-   long long nByteAccum;
-};
-
 XrdSysTrace* GetTrace()
 {
    // needed for logging macros
    return Cache::GetInstance().GetTrace();
 }
 
-void FillFileMapRecurse( XrdOssDF* iOssDF, const std::string& path, FPurgeState& purgeState)
+void FillFileMapRecurse( XrdOssDF* iOssDF, const std::string& path, PurgeIndex& purgeIndex)
 {
    char buff[256];
    XrdOucEnv env;
@@ -91,7 +51,7 @@ void FillFileMapRecurse( XrdOssDF* iOssDF, const std::string& path, FPurgeState&
                if (cinfo.GetLatestDetachTime(accessTime))
                {
                   TRACE(Dump, "FillFileMapRecurse() checking " << buff << " accessTime  " << accessTime);
-                  purgeState.checkFile(accessTime, np.c_str(), cinfo.GetNDownloadedBytes());
+                  purgeIndex.Update(np.substr(0, np.size() - InfoExtLen), accessTime, cinfo.GetNDownloadedBytes(), cinfo.GetAccessCnt());
                }
                else
                {
@@ -106,7 +66,7 @@ void FillFileMapRecurse( XrdOssDF* iOssDF, const std::string& path, FPurgeState&
                   {
                      accessTime = fstat.st_mtime;
                      TRACE(Dump, "FillFileMapRecurse() have access time for " << np << " via stat: " << accessTime);
-                     purgeState.checkFile(accessTime, np.c_str(), cinfo.GetNDownloadedBytes());
+                     purgeIndex.Update(np.substr(0, np.size() - InfoExtLen), accessTime, cinfo.GetNDownloadedBytes(), cinfo.GetAccessCnt());
                   }
                   else
                   {
@@ -132,7 +92,7 @@ void FillFileMapRecurse( XrdOssDF* iOssDF, const std::string& path, FPurgeState&
          }
          else if (dh->Opendir(np.c_str(), env) == XrdOssOK)
          {
-            FillFileMapRecurse(dh, np, purgeState);
+            FillFileMapRecurse(dh, np, purgeIndex);
          }
 
          delete dh; dh = 0;
@@ -147,6 +107,15 @@ void Cache::CacheDirCleanup()
    XrdOss*      oss = Cache::GetInstance().GetOss();
    XrdOssVSInfo sP;
 
+   // pick up the index saved before the last shutdown, if any
+   if (m_purge_index.Load(oss, m_configuration.m_username.c_str()))
+   {
+      size_t    nFiles;
+      long long nBytes;
+      m_purge_index.GetSize(nFiles, nBytes);
+      TRACE(Info, "Cache::CacheDirCleanup() loaded index of " << nFiles << " files, " << nBytes << " bytes.");
+   }
+
    while (1)
    {
 
@@ -176,49 +145,75 @@ void Cache::CacheDirCleanup()
 
       if (bytesToRemove > 0)
       {
-         // make a sorted map of file patch by access time
-         XrdOssDF* dh = oss->newDir(m_configuration.m_username.c_str());
-         if (dh->Opendir("", env) == XrdOssOK)
+         // rebuild the index from the cache directory if it can not be trusted
+         time_t now = time(0);
+         if ( ! m_purge_index.IsUsable(now, m_configuration.m_purgeFullScanInterval))
          {
-            FPurgeState purgeState(bytesToRemove * 5 / 4); // prepare 20% more volume than required
+            XrdOssDF* dh = oss->newDir(m_configuration.m_username.c_str());
+            if (dh->Opendir("", env) == XrdOssOK)
+            {
+               PurgeIndex scanIndex;
 
-            FillFileMapRecurse(dh, "", purgeState);
+               FillFileMapRecurse(dh, "", scanIndex);
 
-            // loop over map and remove files with highest value of access time
-            struct stat fstat;
-            for (FPurgeState::map_i it = purgeState.fmap.begin(); it != purgeState.fmap.end(); ++it)
-            {
+               m_purge_index.Rebuild(scanIndex, now);
+
+               size_t    nFiles;
+               long long nBytes;
+               m_purge_index.GetSize(nFiles, nBytes);
+               TRACE(Info, "Cache::CacheDirCleanup() full scan found " << nFiles << " files, " << nBytes << " bytes.");
+            }
+            dh->Close();
+            delete dh; dh = 0;
+         }
 
-               std::string infoPath = it->second.path;
-               std::string dataPath = infoPath.substr(0, infoPath.size() - strlen(XrdFileCache::Info::m_infoExtension));
+         // loop over files with lowest value of access time
+         std::vector<PurgeIndex::Candidate> candidates;
+         m_purge_index.Select(bytesToRemove * 5 / 4, candidates); // prepare 20% more volume than required
 
-               if (IsFileActiveOrPurgeProtected(dataPath))
-                  continue;
+         struct stat fstat;
+         for (std::vector<PurgeIndex::Candidate>::iterator it = candidates.begin(); it != candidates.end(); ++it)
+         {
+            std::string &dataPath = it->m_path;
+            std::string  infoPath = dataPath + XrdFileCache::Info::m_infoExtension;
 
-               // remove info file
-               if (oss->Stat(infoPath.c_str(), &fstat) == XrdOssOK)
-               {
-                  // cinfo file can be on another oss.space, do not subtract for now.
-                  // bytesToRemove -= fstat.st_size;
-                  oss->Unlink(infoPath.c_str());
-                  TRACE(Info, "Cache::CacheDirCleanup() removed file:" <<  infoPath <<  " size: " << fstat.st_size);
-               }
+            if (IsFileActiveOrPurgeProtected(dataPath))
+               continue;
 
-               // remove data file
-               if (oss->Stat(dataPath.c_str(), &fstat) == XrdOssOK)
-               {
-                  bytesToRemove -= it->second.nByte;
+            m_purge_index.Remove(dataPath);
 
-                  oss->Unlink(dataPath.c_str());
-                  TRACE(Info, "Cache::CacheDirCleanup() removed file: %s " << dataPath << " size " << it->second.nByte);
-               }
+            // remove info file
+            if (oss->Stat(infoPath.c_str(), &fstat) == XrdOssOK)
+            {
+               // cinfo file can be on another oss.space, do not subtract for now.
+               // bytesToRemove -= fstat.st_size;
+               oss->Unlink(infoPath.c_str());
+               TRACE(Info, "Cache::CacheDirCleanup() removed file:" <<  infoPath <<  " size: " << fstat.st_size);
+            }
+
+            // remove data file
+            if (oss->Stat(dataPath.c_str(), &fstat) == XrdOssOK)
+            {
+               bytesToRemove -= it->m_nBytes;
 
-               if (bytesToRemove <= 0)
-                  break;
+               oss->Unlink(dataPath.c_str());
+               TRACE(Info, "Cache::CacheDirCleanup() removed file: %s " << dataPath << " size " << it->m_nBytes);
             }
+
+            if (bytesToRemove <= 0)
+               break;
          }
-         dh->Close();
-         delete dh; dh = 0;
+
+         // index did not hold enough to get below the low water mark, rescan on next pass
+         if (bytesToRemove > 0)
+         {
+            m_purge_index.Invalidate();
+         }
+      }
+
+      if ( ! m_purge_index.Save(oss, m_configuration.m_username.c_str()))
+      {
+         TRACE(Warning, "Cache::CacheDirCleanup() could not save index to " << PurgeIndex::s_fileName);
       }
 
       {
@@ -0,0 +1,508 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <algorithm>
+
+#include "XrdOss/XrdOss.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdFileCachePurgeIndex.hh"
+
+using namespace XrdFileCache;
+
+// The scan of the cache directory skips names starting with a dot.
+const char *PurgeIndex::s_fileName = "/.pfc-purge-index";
+
+namespace
+{
+// Layout of the saved index: magic and scan time, then a journal of records
+// each starting with a tag. An update gives access time, bytes, accesses,
+// policy value, path length and path; a removal path length and path; a base
+// record the base of the eviction policy. Later records replace earlier ones.
+const char s_magic[8] = { 'P', 'F', 'C', 'I', 'D', 'X', '0', '3' };
+
+const char s_tagUpdate = 'U';
+const char s_tagRemove = 'R';
+const char s_tagBase   = 'B';
+
+// Entries copied per lock while the whole index is written.
+const size_t s_chunkSize = 1024;
+
+// The file is rewritten once more entries were appended than this or the
+// number of indexed files, whichever is larger.
+const long long s_minCompact = 4096;
+
+template<typename T>
+void put(std::string &buf, T v)
+{
+   buf.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+template<typename T>
+bool get(const char *&p, const char *end, T &v)
+{
+   if (end - p < (long) sizeof(v)) return false;
+   memcpy(&v, p, sizeof(v));
+   p += sizeof(v);
+   return true;
+}
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::link(PathMap_i pi)
+{
+   Entry &e = pi->second;
+   e.m_timeIt = m_timeMap.insert(std::make_pair(e.m_rec.m_accessTime, &pi->first));
+   if (m_byValue)
+   {
+      ValueKey_t key(e.m_rec.m_value, e.m_rec.m_accessTime);
+      e.m_valueIt = m_valueMap.insert(std::make_pair(key, &pi->first));
+   }
+}
+
+void PurgeIndex::unlink(PathMap_i pi)
+{
+   m_timeMap.erase(pi->second.m_timeIt);
+   if (m_byValue) m_valueMap.erase(pi->second.m_valueIt);
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::update_nolock(const std::string &path, time_t atime, long long nBytes, size_t nAccesses)
+{
+   PathMap_i pi = m_pathMap.find(path);
+
+   if (pi == m_pathMap.end())
+   {
+      pi = m_pathMap.insert(std::make_pair(path, Entry())).first;
+   }
+   else
+   {
+      m_nBytes -= pi->second.m_rec.m_nBytes;
+      unlink(pi);
+   }
+
+   FileRecord &rec  = pi->second.m_rec;
+   rec.m_path       = &pi->first;
+   rec.m_nBytes     = nBytes;
+   rec.m_accessTime = atime;
+   rec.m_nAccesses  = nAccesses;
+   if (m_policy) m_policy->Accessed(rec);
+
+   link(pi);
+   log(pi);
+   m_nBytes += nBytes;
+   m_dirty   = true;
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::log(PathMap_i pi)
+{
+   // Nothing is saved until the first full write after a rescan or load.
+   if ( ! m_valid || m_needFull || pi->second.m_logGen == m_logGen) return;
+
+   m_changed.insert(pi->first);
+   pi->second.m_logGen = m_logGen;
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::Update(const std::string &path, time_t atime, long long nBytes, size_t nAccesses)
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   update_nolock(path, atime, nBytes, nAccesses);
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::AddBytes(const std::string &path, long long nBytes)
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   PathMap_i pi = m_pathMap.find(path);
+   if (pi != m_pathMap.end())
+   {
+      pi->second.m_rec.m_nBytes += nBytes;
+      log(pi);
+      m_nBytes += nBytes;
+      m_dirty   = true;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::Remove(const std::string &path)
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   PathMap_i pi = m_pathMap.find(path);
+   if (pi != m_pathMap.end())
+   {
+      if (m_policy) m_policy->Evicted(pi->second.m_rec);
+      log(pi);
+      m_nBytes -= pi->second.m_rec.m_nBytes;
+      unlink(pi);
+      m_pathMap.erase(pi);
+      m_dirty = true;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::Select(long long nBytesReq, std::vector<Candidate> &candidates)
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   // Policies with a fixed order are served from the sorted maps, only the
+   // files taken are visited.
+   if ( ! m_policy || m_policy->GetOrder() == EvictionPolicy::kByAccessTime)
+   {
+      long long nBytesAccum = 0;
+      for (TimeMap_i ti = m_timeMap.begin(); ti != m_timeMap.end() && nBytesAccum < nBytesReq; ++ti)
+      {
+         long long nb = m_pathMap[*ti->second].m_rec.m_nBytes;
+         candidates.push_back(Candidate(*ti->second, nb));
+         nBytesAccum += nb;
+      }
+      return;
+   }
+   if (m_byValue)
+   {
+      long long nBytesAccum = 0;
+      for (ValueMap_i vi = m_valueMap.begin(); vi != m_valueMap.end() && nBytesAccum < nBytesReq; ++vi)
+      {
+         long long nb = m_pathMap[*vi->second].m_rec.m_nBytes;
+         candidates.push_back(Candidate(*vi->second, nb));
+         nBytesAccum += nb;
+      }
+      return;
+   }
+
+   std::vector<FileRecord*> files, selected;
+   files.reserve(m_timeMap.size());
+   for (TimeMap_i ti = m_timeMap.begin(); ti != m_timeMap.end(); ++ti)
+   {
+      files.push_back(&m_pathMap[*ti->second].m_rec);
+   }
+
+   m_policy->Select(files, nBytesReq, selected);
+
+   for (std::vector<FileRecord*>::iterator it = selected.begin(); it != selected.end(); ++it)
+   {
+      candidates.push_back(Candidate(*(*it)->m_path, (*it)->m_nBytes));
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::Rebuild(PurgeIndex &scan, time_t scanStart)
+{
+   adopt(scan, scanStart, scanStart, false);
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::adopt(PurgeIndex &scan, time_t keepSince, time_t scanTime, bool hasValues)
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   // Rank the new entries. Files that are already indexed keep their value,
+   // re-ranking them as if just accessed would undo the aging done by the
+   // policy. Saved entries come with their value.
+   if (m_policy && ! hasValues)
+   {
+      for (PathMap_i pi = scan.m_pathMap.begin(); pi != scan.m_pathMap.end(); ++pi)
+      {
+         PathMap_i oi = m_pathMap.find(pi->first);
+         if (oi != m_pathMap.end())
+            pi->second.m_rec.m_value = oi->second.m_rec.m_value;
+         else
+            m_policy->Accessed(pi->second.m_rec);
+      }
+   }
+
+   // Keep the entries updated while the scan was running.
+   for (TimeMap_i ti = m_timeMap.lower_bound(keepSince); ti != m_timeMap.end(); ++ti)
+   {
+      const FileRecord &rec = m_pathMap[*ti->second].m_rec;
+      scan.update_nolock(*ti->second, ti->first, rec.m_nBytes, rec.m_nAccesses);
+      FileRecord &kept = scan.m_pathMap[*ti->second].m_rec;
+      kept.m_value = rec.m_value;
+      // ranked before the saved base was restored, so rank them again
+      if (hasValues && m_policy) m_policy->Accessed(kept);
+   }
+
+   m_timeMap.clear();
+   m_valueMap.clear();
+   m_pathMap.clear();
+   m_pathMap.swap(scan.m_pathMap);
+   m_timeMap.swap(scan.m_timeMap);
+   m_nBytes   = scan.m_nBytes;
+   scan.m_nBytes = 0;
+   m_valid    = true;
+   m_dirty    = true;
+   m_scanTime = scanTime;
+   m_needFull = true;
+   m_changed.clear();
+   ++m_logGen;
+
+   if (m_byValue)
+   {
+      for (PathMap_i pi = m_pathMap.begin(); pi != m_pathMap.end(); ++pi)
+      {
+         ValueKey_t key(pi->second.m_rec.m_value, pi->second.m_rec.m_accessTime);
+         pi->second.m_valueIt = m_valueMap.insert(std::make_pair(key, &pi->first));
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::Invalidate()
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   m_valid = false;
+}
+
+//------------------------------------------------------------------------------
+
+bool PurgeIndex::IsUsable(time_t now, int scanIntv)
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   return m_valid && now - m_scanTime < scanIntv;
+}
+
+//------------------------------------------------------------------------------
+
+void PurgeIndex::GetSize(size_t &nFiles, long long &nBytes)
+{
+   XrdSysMutexHelper _lck(m_mutex);
+
+   nFiles = m_pathMap.size();
+   nBytes = m_nBytes;
+}
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+void putUpdate(std::string &buf, const std::string &path, const FileRecord &rec)
+{
+   buf += s_tagUpdate;
+   put<long long>(buf, rec.m_accessTime);
+   put<long long>(buf, rec.m_nBytes);
+   put<long long>(buf, rec.m_nAccesses);
+   put<double>(buf, rec.m_value);
+   put<long long>(buf, path.size());
+   buf.append(path);
+}
+
+void putRemove(std::string &buf, const std::string &path)
+{
+   buf += s_tagRemove;
+   put<long long>(buf, path.size());
+   buf.append(path);
+}
+}
+
+bool PurgeIndex::Save(XrdOss *oss, const char *user)
+{
+   std::set<std::string> changed;
+   std::string buf;
+   bool        full;
+
+   // Take over the set of changed paths and copy out their entries. This is
+   // proportional to the changes, not to the size of the index.
+   {
+      XrdSysMutexHelper _lck(m_mutex);
+
+      if ( ! m_valid || ! m_dirty) return true;
+
+      full = m_needFull || m_nLogged > std::max(s_minCompact, (long long) m_pathMap.size());
+      m_changed.swap(changed);
+      ++m_logGen;
+      m_dirty    = false;
+      m_needFull = false;
+
+      if (full)
+      {
+         buf.append(s_magic, sizeof(s_magic));
+         put<long long>(buf, m_scanTime);
+         m_nLogged = 0;
+      }
+      buf += s_tagBase;
+      put<double>(buf, m_policy ? m_policy->GetBase() : 0);
+
+      if ( ! full)
+      {
+         for (std::set<std::string>::iterator ci = changed.begin(); ci != changed.end(); ++ci)
+         {
+            PathMap_i pi = m_pathMap.find(*ci);
+            if (pi == m_pathMap.end())
+               putRemove(buf, *ci);
+            else
+               putUpdate(buf, *ci, pi->second.m_rec);
+         }
+         m_nLogged += changed.size();
+      }
+   }
+
+   // A full copy is taken a chunk at a time. Entries that change meanwhile
+   // are already logged for the next save, replaying them again is harmless.
+   if (full)
+   {
+      std::string last;
+      bool        more = true;
+      while (more)
+      {
+         XrdSysMutexHelper _lck(m_mutex);
+
+         PathMap_i pi = last.empty() ? m_pathMap.begin() : m_pathMap.upper_bound(last);
+         for (size_t n = 0; pi != m_pathMap.end() && n < s_chunkSize; ++pi, ++n)
+         {
+            putUpdate(buf, pi->first, pi->second.m_rec);
+            last = pi->first;
+         }
+         more = pi != m_pathMap.end();
+      }
+   }
+
+   XrdOucEnv   env;
+   XrdOssDF   *fh = oss->newFile(user);
+   bool        ok = false;
+
+   if (full)
+   {
+      // Write a new file and move it over the old one, so that a crash
+      // never leaves a partial index behind.
+      std::string tmp = std::string(s_fileName) + ".new";
+      if (oss->Create(user, tmp.c_str(), 0600, env) == XrdOssOK &&
+          fh->Open(tmp.c_str(), O_RDWR, 0600, env) == XrdOssOK)
+      {
+         ok = fh->Write(buf.data(), 0, buf.size()) == (ssize_t) buf.size() && fh->Fsync() == XrdOssOK;
+         fh->Close();
+         ok = ok && oss->Rename(tmp.c_str(), s_fileName) == XrdOssOK;
+      }
+      if ( ! ok) oss->Unlink(tmp.c_str());
+   }
+   else
+   {
+      // Append without syncing, Load() drops a record cut short by a crash.
+      struct stat st;
+      if (fh->Open(s_fileName, O_RDWR, 0600, env) == XrdOssOK)
+      {
+         ok = fh->Fstat(&st) == XrdOssOK && st.st_size >= (off_t) sizeof(s_magic) &&
+              fh->Write(buf.data(), st.st_size, buf.size()) == (ssize_t) buf.size();
+         fh->Close();
+      }
+   }
+   delete fh;
+
+   // The changes taken over are not in the file, rewrite it on the next pass.
+   if ( ! ok)
+   {
+      XrdSysMutexHelper _lck(m_mutex);
+      m_dirty    = true;
+      m_needFull = true;
+   }
+   return ok;
+}
+
+//------------------------------------------------------------------------------
+
+bool PurgeIndex::Load(XrdOss *oss, const char *user)
+{
+   XrdOucEnv   env;
+   XrdOssDF   *fh = oss->newFile(user);
+   struct stat st;
+   std::string buf;
+   bool        ok = false;
+
+   if (fh->Open(s_fileName, O_RDONLY, 0600, env) == XrdOssOK)
+   {
+      if (fh->Fstat(&st) == XrdOssOK && st.st_size > (off_t) sizeof(s_magic))
+      {
+         buf.resize(st.st_size);
+         ok = fh->Read(&buf[0], 0, buf.size()) == (ssize_t) buf.size();
+      }
+      fh->Close();
+   }
+   delete fh;
+   if ( ! ok || memcmp(buf.data(), s_magic, sizeof(s_magic))) return false;
+
+   PurgeIndex  loaded;
+   const char *p    = buf.data() + sizeof(s_magic);
+   const char *end  = buf.data() + buf.size();
+   long long   scanTime, atime, nBytes, nAccesses, len;
+   double      base = 0, value;
+   char        tag;
+
+   if ( ! get(p, end, scanTime)) return false;
+
+   // A record that is cut short can only be the last one, written by an
+   // append that did not complete.
+   while (get(p, end, tag))
+   {
+      if (tag == s_tagBase)
+      {
+         if ( ! get(p, end, base)) break;
+      }
+      else if (tag == s_tagUpdate)
+      {
+         if ( ! get(p, end, atime) || ! get(p, end, nBytes) || ! get(p, end, nAccesses) ||
+              ! get(p, end, value) || ! get(p, end, len) || len < 0 || end - p < len)
+            break;
+         std::string path(p, len);
+         loaded.update_nolock(path, atime, nBytes, nAccesses);
+         loaded.m_pathMap[path].m_rec.m_value = value;
+         p += len;
+      }
+      else if (tag == s_tagRemove)
+      {
+         if ( ! get(p, end, len) || len < 0 || end - p < len) break;
+         PathMap_i pi = loaded.m_pathMap.find(std::string(p, len));
+         if (pi != loaded.m_pathMap.end())
+         {
+            loaded.m_nBytes -= pi->second.m_rec.m_nBytes;
+            loaded.unlink(pi);
+            loaded.m_pathMap.erase(pi);
+         }
+         p += len;
+      }
+      else
+      {
+         return false;
+      }
+   }
+
+   // The saved values are relative to the base of the policy that saved
+   // them; files accessed from now on must not rank below them.
+   if (m_policy)
+   {
+      XrdSysMutexHelper _lck(m_mutex);
+      m_policy->RaiseBase(base);
+   }
+   adopt(loaded, 0, scanTime, true);
+   return true;
+}
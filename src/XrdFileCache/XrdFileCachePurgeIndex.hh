@@ -0,0 +1,197 @@
+#ifndef __XRDFILECACHE_PURGE_INDEX_HH__
+#define __XRDFILECACHE_PURGE_INDEX_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <time.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdFileCacheEvictionPolicy.hh"
+
+class XrdOss;
+
+namespace XrdFileCache
+{
+//----------------------------------------------------------------------------
+//! Index of cached files ordered by access time, used by purge.
+//!
+//! The index is seeded by a full scan of the cache directory tree and then
+//! kept current as files are opened, written and detached, so that purge
+//! only needs to walk the oldest entries instead of re-reading every cinfo
+//! file. It is saved to the cache after each purge pass in which it changed
+//! and loaded again on startup, so a restart does not need a full scan
+//! either. A pass appends the entries changed since the previous one, the
+//! file is only rewritten after a rescan or load or once more entries were
+//! appended than are indexed. Which entries are purged first is decided by
+//! the EvictionPolicy; without one the least recently accessed files are
+//! chosen.
+//----------------------------------------------------------------------------
+class PurgeIndex
+{
+public:
+   struct Candidate
+   {
+      std::string m_path;     //!< data file path
+      long long   m_nBytes;   //!< bytes on disk
+
+      Candidate(const std::string &p, long long n) : m_path(p), m_nBytes(n) {}
+   };
+
+   PurgeIndex() : m_policy(0), m_byValue(false), m_nBytes(0), m_valid(false), m_dirty(false), m_scanTime(0),
+                  m_logGen(1), m_nLogged(0), m_needFull(false) {}
+
+   static const char *s_fileName; //!< name of the saved index in the cache
+
+   //---------------------------------------------------------------------
+   //! Set eviction policy, before any file is added. Ownership is not taken.
+   //---------------------------------------------------------------------
+   void SetPolicy(EvictionPolicy *policy)
+   {
+      m_policy  = policy;
+      m_byValue = policy && policy->GetOrder() == EvictionPolicy::kByValue;
+   }
+
+   //---------------------------------------------------------------------
+   //! Insert or update the entry for a data file.
+   //!
+   //! @param path   data file path
+   //! @param atime  last access time
+   //! @param nBytes number of bytes of the file on disk
+   //! @param nAccesses number of accesses recorded for the file
+   //---------------------------------------------------------------------
+   void Update(const std::string &path, time_t atime, long long nBytes, size_t nAccesses);
+
+   //---------------------------------------------------------------------
+   //! Account for bytes written to a data file that is in the index.
+   //---------------------------------------------------------------------
+   void AddBytes(const std::string &path, long long nBytes);
+
+   //---------------------------------------------------------------------
+   //! Remove the entry for a data file, if any, and notify the policy.
+   //---------------------------------------------------------------------
+   void Remove(const std::string &path);
+
+   //---------------------------------------------------------------------
+   //! Select files to be purged, according to the eviction policy.
+   //!
+   //! @param nBytesReq  select files until their sizes add up to this
+   //! @param candidates output list, in order of removal
+   //---------------------------------------------------------------------
+   void Select(long long nBytesReq, std::vector<Candidate> &candidates);
+
+   //---------------------------------------------------------------------
+   //! Replace the contents with the result of a full scan.
+   //!
+   //! Entries updated after the scan started are newer than what the scan
+   //! saw and are retained. Files that were already indexed keep the rank
+   //! the eviction policy had given them.
+   //!
+   //! @param scan      index filled by the scan
+   //! @param scanStart time at which the scan started
+   //---------------------------------------------------------------------
+   void Rebuild(PurgeIndex &scan, time_t scanStart);
+
+   //---------------------------------------------------------------------
+   //! Mark the index as not reflecting the disk content. The next purge
+   //! will then do a full scan.
+   //---------------------------------------------------------------------
+   void Invalidate();
+
+   //---------------------------------------------------------------------
+   //! \brief Check if the index can be used instead of a full scan.
+   //!
+   //! @param now      current time
+   //! @param scanIntv maximum number of seconds between full scans
+   //---------------------------------------------------------------------
+   bool IsUsable(time_t now, int scanIntv);
+
+   //---------------------------------------------------------------------
+   //! Get number of indexed files and their total size.
+   //---------------------------------------------------------------------
+   void GetSize(size_t &nFiles, long long &nBytes);
+
+   //---------------------------------------------------------------------
+   //! Write the index to the cache, if it is valid and has changed since
+   //! it was last saved or loaded. Usually only the changed entries are
+   //! appended. The index is not locked while the file is written, nor for
+   //! more than a bounded number of entries while a full copy is taken.
+   //!
+   //! @return false if the index could not be written
+   //---------------------------------------------------------------------
+   bool Save(XrdOss *oss, const char *user);
+
+   //---------------------------------------------------------------------
+   //! Read the index saved in the cache. Entries updated since startup are
+   //! newer than the saved ones and are retained. The full scan interval
+   //! keeps counting from the scan the saved index was built from.
+   //!
+   //! @return false if there is no usable saved index
+   //---------------------------------------------------------------------
+   bool Load(XrdOss *oss, const char *user);
+
+private:
+   struct Entry;
+
+   typedef std::multimap<time_t, const std::string*> TimeMap_t;
+   typedef TimeMap_t::iterator                       TimeMap_i;
+
+   typedef std::pair<double, time_t>                          ValueKey_t;
+   typedef std::multimap<ValueKey_t, const std::string*>      ValueMap_t;
+   typedef ValueMap_t::iterator                               ValueMap_i;
+
+   struct Entry
+   {
+      FileRecord   m_rec;
+      TimeMap_i    m_timeIt;
+      ValueMap_i   m_valueIt;   //!< only set for policies ordering by value
+      unsigned int m_logGen;    //!< m_logGen of the index when last logged
+
+      Entry() : m_logGen(0) {}
+   };
+
+   typedef std::map<std::string, Entry> PathMap_t;
+   typedef PathMap_t::iterator          PathMap_i;
+
+   void link(PathMap_i pi);
+   void unlink(PathMap_i pi);
+   void log(PathMap_i pi);
+   void update_nolock(const std::string &path, time_t atime, long long nBytes, size_t nAccesses);
+   void adopt(PurgeIndex &scan, time_t keepSince, time_t scanTime, bool hasValues);
+
+   XrdSysMutex     m_mutex;
+   EvictionPolicy *m_policy;  //!< eviction policy, 0 for LRU
+   bool        m_byValue;     //!< policy orders files by FileRecord::m_value
+   PathMap_t   m_pathMap;     //!< data file path to entry
+   TimeMap_t   m_timeMap;     //!< access time to data file path
+   ValueMap_t  m_valueMap;    //!< policy value and access time to path
+   long long   m_nBytes;      //!< total bytes of indexed files
+   bool        m_valid;       //!< seeded by a full scan and not invalidated
+   bool        m_dirty;       //!< changed since last saved or loaded
+   time_t      m_scanTime;    //!< start time of last full scan
+
+   std::set<std::string> m_changed;  //!< paths changed since last save
+   unsigned int m_logGen;     //!< generation of m_changed
+   long long    m_nLogged;    //!< entries appended since last full write
+   bool         m_needFull;   //!< saved file must be rewritten
+};
+}
+
+#endif
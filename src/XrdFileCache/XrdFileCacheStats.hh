@@ -35,11 +35,14 @@ public:
    //----------------------------------------------------------------------
    Stats() {
       m_BytesDisk = m_BytesRam = m_BytesMissed = 0;
+      m_ReadsNoLock = m_ReadsLocked = 0;
    }
 
    long long m_BytesDisk;         //!< number of bytes served from disk cache
    long long m_BytesRam;          //!< number of bytes served from RAM cache
    long long m_BytesMissed;       //!< number of bytes served directly from XrdCl
+   long long m_ReadsNoLock;       //!< number of reads served from disk without the file lock
+   long long m_ReadsLocked;       //!< number of reads that had to take the file lock
 
    inline void AddStats(Stats &Src)
    {
@@ -48,6 +51,8 @@ public:
       m_BytesDisk   += Src.m_BytesDisk;
       m_BytesRam    += Src.m_BytesRam;
       m_BytesMissed += Src.m_BytesMissed;
+      m_ReadsNoLock += Src.m_ReadsNoLock;
+      m_ReadsLocked += Src.m_ReadsLocked;
 
       m_MutexXfc.UnLock();
    }
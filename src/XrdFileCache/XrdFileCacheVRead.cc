@@ -92,6 +92,18 @@ int File::ReadV(const XrdOucIOVec *readV, int n)
       return -1;
    }
 
+   if (m_pattern && m_prefetchState != kComplete)
+   {
+      const long long BS = m_cfi.GetBufferSize();
+      long long minOff = readV[0].offset, maxEnd = readV[0].offset + readV[0].size;
+      for (int i = 1; i < n; ++i)
+      {
+         if (readV[i].offset < minOff) minOff = readV[i].offset;
+         if (readV[i].offset + readV[i].size > maxEnd) maxEnd = readV[i].offset + readV[i].size;
+      }
+      if (maxEnd > minOff) UpdateAccessPattern(minOff / BS, (maxEnd - 1) / BS, true);
+   }
+
    Stats loc_stats;
 
    int bytesRead = 0;
@@ -44,6 +44,7 @@
 
 #include <openssl/err.h>
 #include <openssl/ssl.h>
+#include <poll.h>
 #include <vector>
 #include <arpa/inet.h>
 #include <sstream>
@@ -51,6 +52,12 @@
 
 #define XRHTTP_TK_GRACETIME     600
 
+// Kernel TLS (and SSL_sendfile) is available starting with OpenSSL 3.0
+//
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS)
+#define HAVE_XRDHTTP_KTLS 1
+#endif
+
 
 
 /******************************************************************************/
@@ -83,6 +90,7 @@ XrdOucHash<XrdHttpProtocol::StaticPreloadInfo> *XrdHttpProtocol::staticpreload =
 
 kXR_int32 XrdHttpProtocol::myRole = kXR_isManager;
 bool XrdHttpProtocol::selfhttps2http = false;
+bool XrdHttpProtocol::usektls = false;
 bool XrdHttpProtocol::isdesthttps = false;
 char *XrdHttpProtocol::sslcafile = 0;
 char *XrdHttpProtocol::secretkey = 0;
@@ -574,7 +582,10 @@ int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
   if (ishttps && !ssldone) {
 
       if (!ssl) {
-          sbio = CreateBIO(Link);
+          // kTLS needs a real socket BIO so that OpenSSL can hand the session
+          // keys to the kernel once the handshake is done
+          if (usektls) sbio = BIO_new_socket(Link->FDnum(), BIO_NOCLOSE);
+            else sbio = CreateBIO(Link);
           BIO_set_nbio(sbio, 1);
           ssl = SSL_new(sslctx);
         }
@@ -633,6 +644,10 @@ int XrdHttpProtocol::Process(XrdLink *lp) // We ignore the argument here
 
       if (res != X509_V_OK) return -1;
       ssldone = true;
+#ifdef HAVE_XRDHTTP_KTLS
+      ktlsSend = usektls && BIO_get_ktls_send(SSL_get_wbio(ssl));
+      TRACEI(DEBUG, " kTLS send offload " << (ktlsSend ? "active" : "inactive"));
+#endif
     }
 
 
@@ -1032,6 +1047,7 @@ int XrdHttpProtocol::Config(const char *ConfigFN, XrdOucEnv *myEnv) {
       else if TS_Xeq("secxtractor", xsecxtractor);
       else if TS_Xeq3("exthandler", xexthandler);
       else if TS_Xeq("selfhttps2http", xselfhttps2http);
+      else if TS_Xeq("ktls", xktls);
       else if TS_Xeq("embeddedstatic", xembeddedstatic);
       else if TS_Xeq("listingredir", xlistredir);
       else if TS_Xeq("staticredir", xstaticredir);
@@ -1358,6 +1374,44 @@ int XrdHttpProtocol::SendData(const char *body, int bodylen) {
   return 0;
 }
 
+int XrdHttpProtocol::SendFile(int fd, long long offset, int dlen) {
+
+#ifdef HAVE_XRDHTTP_KTLS
+  ossl_ssize_t r;
+
+  if (!ktlsSend) return -1;
+
+  TRACE(REQ, "Sending " << dlen << " bytes with SSL_sendfile");
+  while (dlen > 0) {
+    r = SSL_sendfile(ssl, fd, (off_t)offset, (size_t)dlen, 0);
+    if (r <= 0) {
+      if (SSL_get_error(ssl, (int)r) == SSL_ERROR_WANT_WRITE) {
+        // Wait for the socket to drain, a client that stops reading for as
+        // long as we wait for its requests is given up on
+        struct pollfd pfd;
+        pfd.fd = Link->FDnum();
+        pfd.events = POLLOUT;
+        pfd.revents = 0;
+        int pr;
+        do pr = poll(&pfd, 1, readWait);
+        while (pr < 0 && errno == EINTR);
+        if (pr > 0 && !(pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) continue;
+        TRACE(REQ, "SSL_sendfile: socket not writable within " << readWait << " ms");
+        return -1;
+      }
+      ERR_print_errors(sslbio_err);
+      return -1;
+    }
+    offset += r;
+    dlen -= (int)r;
+  }
+  return 0;
+#else
+  (void)fd; (void)offset; (void)dlen;
+  return -1;
+#endif
+}
+
 int XrdHttpProtocol::StartSimpleResp(int code, const char *desc, const char *header_to_add, long long bodylen) {
   std::stringstream ss;
   const std::string crlf = "\r\n";
@@ -1674,6 +1728,9 @@ int XrdHttpProtocol::InitSecurity() {
 
   //SSL_CTX_set_purpose(sslctx, X509_PURPOSE_ANY);
   SSL_CTX_set_mode(sslctx, SSL_MODE_AUTO_RETRY);
+#ifdef HAVE_XRDHTTP_KTLS
+  if (usektls) SSL_CTX_set_options(sslctx, SSL_OP_ENABLE_KTLS);
+#endif
 
   //eDest.Say(" Setting verify depth to ", itoa(sslverifydepth), "'.");
   SSL_CTX_set_verify_depth(sslctx, sslverifydepth);
@@ -1781,6 +1838,7 @@ void XrdHttpProtocol::Reset() {
   SecEntity.tident = XrdHttpSecEntityTident;
   ishttps = false;
   ssldone = false;
+  ktlsSend = false;
 
   Bridge = 0;
   ssl = 0;
@@ -2337,6 +2395,46 @@ int XrdHttpProtocol::xselfhttps2http(XrdOucStream & Config) {
 
 
 
+/******************************************************************************/
+/*                                   x k t l s                                */
+/******************************************************************************/
+
+/* Function: xktls
+
+   Purpose:  To parse the directive: ktls <yes|no|0|1>
+
+             <val>    when true, https connections try to use kernel TLS so
+                      that file data can be sent with sendfile(). This needs
+                      OpenSSL 3 built with kTLS and the Linux tls module.
+
+  Output: 0 upon success or !0 upon failure.
+ */
+
+int XrdHttpProtocol::xktls(XrdOucStream & Config) {
+  char *val;
+
+  // Get the flag
+  //
+  val = Config.GetWord();
+  if (!val || !val[0]) {
+    eDest.Emsg("Config", "ktls flag not specified");
+    return 1;
+  }
+
+  // Record the value
+  //
+  usektls = (!strcasecmp(val, "true") || !strcasecmp(val, "yes") || !strcmp(val, "1"));
+
+#ifndef HAVE_XRDHTTP_KTLS
+  if (usektls) {
+    eDest.Say("Config warning: kernel TLS is not supported by this build; http.ktls ignored.");
+    usektls = false;
+  }
+#endif
+
+  return 0;
+}
+
 /******************************************************************************/
 /*                            x s e c x t r a c t o r                         */
 /******************************************************************************/
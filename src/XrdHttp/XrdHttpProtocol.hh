@@ -138,6 +138,10 @@ private:
   /// Send some generic data to the client
   int SendData(const char *body, int bodylen);
 
+  /// Send file data to the client with SSL_sendfile(), only valid when the
+  /// kernel does the TLS encryption (see ktlsSend)
+  int SendFile(int fd, long long offset, int dlen);
+
   /// Deallocate resources, in order to reutilize an object of this class
   void Cleanup();
 
@@ -168,6 +172,7 @@ private:
   static int xlistdeny(XrdOucStream &Config);
   static int xlistredir(XrdOucStream &Config);
   static int xselfhttps2http(XrdOucStream &Config);
+  static int xktls(XrdOucStream &Config);
   static int xembeddedstatic(XrdOucStream &Config);
   static int xstaticredir(XrdOucStream &Config);
   static int xstaticpreload(XrdOucStream &Config);
@@ -266,6 +271,10 @@ private:
   /// connection being established
   bool ssldone;
 
+  /// True if the kernel encrypts what we send on this https connection (kTLS),
+  /// which allows file data to be sent using sendfile()
+  bool ktlsSend;
+
   
   
   static XrdCryptoFactory *myCryptoFactory;
@@ -356,6 +365,9 @@ protected:
   
   /// If client is HTTPS, self-redirect with HTTP+token
   static bool selfhttps2http;
+
+  /// If true, try to have the kernel do the TLS record encryption (kTLS)
+  static bool usektls;
   
   /// If true, use the embedded css and icons
   static bool embeddedstatic;
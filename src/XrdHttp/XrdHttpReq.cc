@@ -281,31 +281,8 @@ int XrdHttpReq::parseRWOp(char *str) {
   }
 
 
-  // This can be largely optimized
-  if (ok) {
-
-    kXR_int32 len_ok = 0;
-    long long sz = o1.byteend - o1.bytestart + 1;
-    kXR_int32 newlen = sz;
-
-    if (filesize > 0)
-      newlen = (kXR_int32) min(filesize - o1.bytestart, sz);
-
-    rwOps.push_back(o1);
-
-    while (len_ok < newlen) {
-      ReadWriteOp nfo;
-      int len = min(newlen - len_ok, READV_MAXCHUNKSIZE);
-
-      nfo.bytestart = o1.bytestart + len_ok;
-      nfo.byteend = nfo.bytestart + len - 1;
-      len_ok += len;
-      rwOps_split.push_back(nfo);
-    }
-    length += len_ok;
-
-
-  }
+  // The ranges are validated against the file size in coalesceRWOps()
+  if (ok) rwOps.push_back(o1);
 
 
   return j;
@@ -430,30 +407,71 @@ void XrdHttpReq::clientUnMarshallReadAheadList(int nitems) {
   }
 }
 
-int XrdHttpReq::ReqReadV() {
+namespace {
+  bool rwOpLess(const ReadWriteOp &a, const ReadWriteOp &b) {
+    return a.bytestart < b.bytestart;
+  }
+}
 
+int XrdHttpReq::coalesceRWOps() {
+  std::vector<ReadWriteOp> ops;
+  ReadWriteOp o;
+
+  // Drop what lies beyond the end of the file and resolve open ended ranges
+  for (size_t i = 0; i < rwOps.size(); i++) {
+    o = rwOps[i];
+    if (o.bytestart < 0) {
+      if (o.byteend <= 0) continue;
+      o.bytestart = (o.byteend >= filesize ? 0 : filesize - o.byteend);
+      o.byteend = filesize - 1;
+    } else if (o.byteend < 0 || o.byteend > filesize - 1) o.byteend = filesize - 1;
+    if (o.bytestart >= filesize || o.byteend < o.bytestart) continue;
+    ops.push_back(o);
+  }
 
-  kXR_int64 total_len = 0;
-  rwOpPartialDone = 0;
-  // Now we build the protocol-ready read ahead list
-  //  and also put the correct placeholders inside the cache
-  int n = rwOps_split.size();
-  if (!ralist) ralist = (readahead_list *) malloc(n * sizeof (readahead_list));
+  // Sort the ranges and merge the ones that overlap or are close enough that
+  // sending the gap is cheaper than another part header (RFC 7233 4.1)
+  std::sort(ops.begin(), ops.end(), rwOpLess);
+  rwOps.clear();
+  length = 0;
+  for (size_t i = 0; i < ops.size(); i++) {
+    if (!rwOps.empty() &&
+        ops[i].bytestart <= rwOps.back().byteend + 1 + READV_MAXGAP) {
+      if (ops[i].byteend > rwOps.back().byteend) rwOps.back().byteend = ops[i].byteend;
+    } else rwOps.push_back(ops[i]);
+  }
+  for (size_t i = 0; i < rwOps.size(); i++)
+    length += rwOps[i].byteend - rwOps[i].bytestart + 1;
 
-  int j = 0;
-  for (int i = 0; i < n; i++) {
+  rwOpDone = rwOpPartialDone = 0;
+  rwOpNext = 0;
+  rwOpNextOff = 0;
+  return rwOps.size();
+}
 
-    // We can suppose that we know the length of the file
-    // Hence we can sort out requests that are out of boundary or trim them
-    if (rwOps_split[i].bytestart > filesize) continue;
-    if (rwOps_split[i].byteend > filesize - 1) rwOps_split[i].byteend = filesize - 1;
+int XrdHttpReq::ReqReadV() {
 
-    memcpy(&(ralist[j].fhandle), this->fhandle, 4);
+  // Build the next batch of at most READV_MAXCHUNKS elements, splitting the
+  // ranges so that no element exceeds the xrootd readv element size
+  if (!ralist) ralist = (readahead_list *) malloc(READV_MAXCHUNKS * sizeof (readahead_list));
+  if (!ralist) return 0;
 
-    ralist[j].offset = rwOps_split[i].bytestart;
-    ralist[j].rlen = rwOps_split[i].byteend - rwOps_split[i].bytestart + 1;
-    total_len += ralist[j].rlen;
+  int j = 0;
+  while (j < READV_MAXCHUNKS && rwOpNext < rwOps.size()) {
+    const ReadWriteOp &o = rwOps[rwOpNext];
+    long long offs = o.bytestart + rwOpNextOff;
+    int len = (int) min(o.byteend - offs + 1, (long long) READV_MAXCHUNKSIZE);
+
+    memcpy(&(ralist[j].fhandle), this->fhandle, 4);
+    ralist[j].offset = offs;
+    ralist[j].rlen = len;
     j++;
+
+    rwOpNextOff += len;
+    if (offs + len > o.byteend) {
+      rwOpNext++;
+      rwOpNextOff = 0;
+    }
   }
 
   if (j > 0) {
@@ -473,6 +491,81 @@ int XrdHttpReq::ReqReadV() {
   return (j * sizeof (struct readahead_list));
 }
 
+int XrdHttpReq::sendReadV() {
+  readahead_list *l;
+  unsigned int opDone = rwOpDone, opPartialDone = rwOpPartialDone;
+  long long chunklen = 0;
+  char *p;
+  int len;
+
+  // Walk the response once to size the chunk. The response carries a header
+  // for every element and elements arrive in the order they were requested.
+  for (int i = 0; i < iovN; i++) {
+    for (p = (char *) iovP[i].iov_base; p < (char *) iovP[i].iov_base + iovP[i].iov_len;) {
+      l = (readahead_list *) p;
+      len = ntohl(l->rlen);
+      if (opPartialDone == 0 && opDone < rwOps.size())
+        chunklen += buildPartialHdr(rwOps[opDone].bytestart, rwOps[opDone].byteend,
+                                    filesize, (char *) "123456").size();
+      chunklen += len;
+      opPartialDone += len;
+      if (opDone < rwOps.size() &&
+          opPartialDone >= rwOps[opDone].byteend - rwOps[opDone].bytestart + 1) {
+        opDone++;
+        opPartialDone = 0;
+      }
+      p += sizeof (readahead_list) + len;
+    }
+  }
+  if (opDone == rwOps.size())
+    chunklen += buildPartialHdrEnd((char *) "123456").size();
+  if (!chunklen) return 0;
+
+  // Now send the part headers and the data as one chunk
+  std::stringstream ss;
+  ss << std::hex << chunklen << std::dec << "\r\n";
+  if (prot->SendData(ss.str().c_str(), ss.str().size())) return -1;
+
+  for (int i = 0; i < iovN; i++) {
+    for (p = (char *) iovP[i].iov_base; p < (char *) iovP[i].iov_base + iovP[i].iov_len;) {
+      l = (readahead_list *) p;
+      len = ntohl(l->rlen);
+
+      if (rwOpPartialDone == 0 && rwOpDone < rwOps.size()) {
+        string s = buildPartialHdr(rwOps[rwOpDone].bytestart,
+                rwOps[rwOpDone].byteend,
+                filesize,
+                (char *) "123456");
+
+        TRACEI(REQ, "Sending multipart: " << rwOps[rwOpDone].bytestart << "-" << rwOps[rwOpDone].byteend);
+        if (prot->SendData((char *) s.c_str(), s.size())) return -1;
+      }
+
+      if (prot->SendData(p + sizeof (readahead_list), len)) return -1;
+
+      // If we sent all the data relative to the current range then pass to
+      // the next one, otherwise wait for more data
+      rwOpPartialDone += len;
+      if (rwOpDone < rwOps.size() &&
+          rwOpPartialDone >= rwOps[rwOpDone].byteend - rwOps[rwOpDone].bytestart + 1) {
+        rwOpDone++;
+        rwOpPartialDone = 0;
+      }
+      p += sizeof (readahead_list) + len;
+    }
+  }
+
+  if (rwOpDone == rwOps.size()) {
+    string s = buildPartialHdrEnd((char *) "123456");
+    if (prot->SendData((char *) s.c_str(), s.size())) return -1;
+  }
+  if (prot->SendData("\r\n", 2)) return -1;
+
+  // The last chunk ends the response body
+  if (rwOpDone == rwOps.size() && prot->ChunkResp(0, 0)) return -1;
+  return 0;
+}
+
 std::string XrdHttpReq::buildPartialHdr(long long bytestart, long long byteend, long long fsz, char *token) {
   ostringstream s;
 
@@ -517,11 +610,22 @@ int XrdHttpReq::File(XrdXrootd::Bridge::Context &info, //!< the result context
         int dlen //!< byte  count
         ) {
 
-  //prot->SendSimpleResp(200, NULL, NULL, NULL, dlen);
-  int rc = info.Send(0, 0, 0, 0);
+  // Over https the data can only go out with sendfile() if the kernel does
+  // the encryption, in which case we must send it ourselves
+  int rc, fd, len;
+  long long offs;
+
+  if (prot->ishttps) {
+    if (!prot->ktlsSend || !info.Source(fd, offs, len)) {
+      TRACE(REQ, " XrdHttpReq::File unable to send " << dlen << " bytes over https");
+      return false;
+    }
+    rc = prot->SendFile(fd, offs, len);
+  } else rc = info.Send(0, 0, 0, 0);
   TRACE(REQ, " XrdHttpReq::File dlen:" << dlen << " send rc:" << rc);
   if (rc) return false;
   writtenbytes += dlen;
+  sendfiledone = true;
   
     
   return true;
@@ -1009,6 +1113,7 @@ int XrdHttpReq::ProcessHTTPReq() {
 
             // Prepare to chunk up the request
             writtenbytes = 0;
+            sendfiledone = false;
             
             // We want to be invoked again after this request is finished
             return 0;
@@ -1019,10 +1124,11 @@ int XrdHttpReq::ProcessHTTPReq() {
         default: // Read() or Close()
         {
 
-          if ( ((reqstate == 3) && (rwOps.size() > 1)) ||
+          if ( (rwOps.size() > 1) ? (rwOpNext >= rwOps.size()) :
             (writtenbytes >= length) ) {
 
-            // Close() if this was a readv or we have finished, otherwise read the next chunk
+            // Close() if all the readv batches were sent or we have finished,
+            // otherwise read the next chunk
 
             // --------- CLOSE
 
@@ -1045,6 +1151,12 @@ int XrdHttpReq::ProcessHTTPReq() {
 
             long l;
             long long offs;
+
+            // Once the file has been sent with sendfile() the reads are done
+            // in larger chunks, as no data is copied through our buffers.
+            // Files without a descriptor are always read in small chunks.
+            bool sfok = !prot->ishttps || prot->ktlsSend;
+            long long chunk = (sfok && sendfiledone ? 8LL*1024*1024 : 1024*1024);
             
             // --------- READ
             memset(&xrdreq, 0, sizeof (xrdreq));
@@ -1053,18 +1165,18 @@ int XrdHttpReq::ProcessHTTPReq() {
             xrdreq.read.dlen = 0;
             
             if (rwOps.size() == 0) {
-              l = (long)min(filesize-writtenbytes, (long long)1024*1024);
+              l = (long)min(filesize-writtenbytes, chunk);
               offs = writtenbytes;
               xrdreq.read.offset = htonll(writtenbytes);
               xrdreq.read.rlen = htonl(l);
             } else {
-              l = min(rwOps[0].byteend - rwOps[0].bytestart + 1 - writtenbytes, (long long)1024*1024);
+              l = min(rwOps[0].byteend - rwOps[0].bytestart + 1 - writtenbytes, chunk);
               offs = rwOps[0].bytestart + writtenbytes;
               xrdreq.read.offset = htonll(offs);
               xrdreq.read.rlen = htonl(l);
             }
 
-            if (prot->ishttps) {
+            if (!sfok) {
               if (!prot->Bridge->setSF((kXR_char *) fhandle, false)) {
                 TRACE(REQ, " XrdBridge::SetSF(false) failed.");
 
@@ -1097,11 +1209,12 @@ int XrdHttpReq::ProcessHTTPReq() {
               return -1;
             }
           } else {
-            // More than one chunk to read... use readv
+            // More than one chunk to read... use readv, one bounded batch
+            // at a time. Each batch is streamed out as a chunk on arrival.
 
-            length = ReqReadV();
+            int rvlen = ReqReadV();
 
-            if (!prot->Bridge->Run((char *) &xrdreq, (char *) ralist, length)) {
+            if (!prot->Bridge->Run((char *) &xrdreq, (char *) ralist, rvlen)) {
               prot->SendSimpleResp(404, NULL, NULL, (char *) "Could not run read request.", 0);
               return -1;
             }
@@ -1779,39 +1892,34 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
                 
                 prot->SendSimpleResp(200, NULL, NULL, NULL, filesize);
                 return 0;
+              }
+
+              // Now that the size is known, settle the ranges to send
+              if (!coalesceRWOps()) {
+                char buf[64];
+                XrdOucString s = "Content-Range: bytes */";
+                sprintf(buf, "%lld", filesize);
+                s += buf;
+
+                prot->SendSimpleResp(416, (char *) "Range Not Satisfiable", (char *)s.c_str(), NULL, 0);
+                return -1;
               } else
                 if (rwOps.size() == 1) {
                 // Only one read to perform
-                int cnt = (rwOps[0].byteend - rwOps[0].bytestart + 1);
+                long long cnt = (rwOps[0].byteend - rwOps[0].bytestart + 1);
                 char buf[64];
                 
                 XrdOucString s = "Content-Range: bytes ";
-                sprintf(buf, "%lld-%lld/%d", rwOps[0].bytestart, rwOps[0].byteend, cnt);
+                sprintf(buf, "%lld-%lld/%lld", rwOps[0].bytestart, rwOps[0].byteend, filesize);
                 s += buf;
                 
                 
                 prot->SendSimpleResp(206, NULL, (char *)s.c_str(), NULL, cnt);
                 return 0;
-              } else
-                if (rwOps.size() > 1) {
-                // Multiple reads to perform, compose and send the header
-                int cnt = 0;
-                for (size_t i = 0; i < rwOps.size(); i++) {
-
-                  if (rwOps[i].bytestart > filesize) continue;
-                  if (rwOps[i].byteend > filesize - 1)
-                    rwOps[i].byteend = filesize - 1;
-
-                  cnt += (rwOps[i].byteend - rwOps[i].bytestart + 1);
-
-                  cnt += buildPartialHdr(rwOps[i].bytestart,
-                          rwOps[i].byteend,
-                          filesize,
-                          (char *) "123456").size();
-                }
-                cnt += buildPartialHdrEnd((char *) "123456").size();
-
-                prot->SendSimpleResp(206, NULL, (char *) "Content-Type: multipart/byteranges; boundary=123456", NULL, cnt);
+              } else {
+                // Multiple reads to perform. The parts are sent as the readv
+                // batches complete, so the total length is not known upfront.
+                if (prot->StartChunkedResp(206, NULL, "Content-Type: multipart/byteranges; boundary=123456")) return -1;
                 return 0;
               }
 
@@ -1840,9 +1948,6 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
             // Nothing to do if we are postprocessing a close
             if (ntohs(xrdreq.header.requestid) == kXR_close) return 1;
             
-            // Close() if this was the third state of a readv, otherwise read the next chunk
-            if ((reqstate == 3) && (ntohs(xrdreq.header.requestid) == kXR_readv)) return 1;
-
             // Prevent scenario where data is expected but none is actually read
             // E.g. Accessing files which return the results of a script
             if ((ntohs(xrdreq.header.requestid) == kXR_read) &&
@@ -1858,50 +1963,7 @@ int XrdHttpReq::PostProcessHTTPReq(bool final_) {
             TRACEI(REQ, "Got data vectors to send:" << iovN);
             if (ntohs(xrdreq.header.requestid) == kXR_readv) {
               // Readv case, we must take out each individual header and format it according to the http rules
-              readahead_list *l;
-              char *p;
-              int len;
-
-              // Cycle on all the data that is coming from the server
-              for (int i = 0; i < iovN; i++) {
-
-                for (p = (char *) iovP[i].iov_base; p < (char *) iovP[i].iov_base + iovP[i].iov_len;) {
-                  l = (readahead_list *) p;
-                  len = ntohl(l->rlen);
-
-                  // Now we have a chunk coming from the server. This may be a partial chunk
-
-                  if (rwOpPartialDone == 0) {
-                    string s = buildPartialHdr(rwOps[rwOpDone].bytestart,
-                            rwOps[rwOpDone].byteend,
-                            filesize,
-                            (char *) "123456");
-
-                    TRACEI(REQ, "Sending multipart: " << rwOps[rwOpDone].bytestart << "-" << rwOps[rwOpDone].byteend);
-                    if (prot->SendData((char *) s.c_str(), s.size())) return -1;
-                  }
-
-                  // Send all the data we have
-                  if (prot->SendData(p + sizeof (readahead_list), len)) return -1;
-
-                  // If we sent all the data relative to the current original chunk request
-                  // then pass to the next chunk, otherwise wait for more data
-                  rwOpPartialDone += len;
-                  if (rwOpPartialDone >= rwOps[rwOpDone].byteend - rwOps[rwOpDone].bytestart + 1) {
-                    rwOpDone++;
-                    rwOpPartialDone = 0;
-                  }
-
-                  p += sizeof (readahead_list);
-                  p += len;
-
-                }
-              }
-
-              if (rwOpDone == rwOps.size()) {
-                string s = buildPartialHdrEnd((char *) "123456");
-                if (prot->SendData((char *) s.c_str(), s.size())) return -1;
-              }
+              if (sendReadV()) return -1;
 
             } else
               for (int i = 0; i < iovN; i++) {
@@ -2301,10 +2363,12 @@ void XrdHttpReq::reset() {
 
   //if (xmlbody) xmlFreeDoc(xmlbody);
   rwOps.clear();
-  rwOps_split.clear();
+  rwOpNext = 0;
+  rwOpNextOff = 0;
   rwOpDone = 0;
   rwOpPartialDone = 0;
   writtenbytes = 0;
+  sendfiledone = false;
   etext.clear();
   redirdest = "";
 
@@ -55,6 +55,8 @@
 
 #define READV_MAXCHUNKS            512
 #define READV_MAXCHUNKSIZE         (1024*128)
+// Ranges closer than this are merged into one part of a multipart response
+#define READV_MAXGAP               128
 
 struct ReadWriteOp {
   // < 0 means "not specified"
@@ -109,8 +111,11 @@ public:
     //xmlbody = 0;
     depth = 0;
     ralist = 0;
+    rwOpNext = 0;
+    rwOpNextOff = 0;
     opaque = 0;
     writtenbytes = 0;
+    sendfiledone = false;
     fopened = false;
     headerok = false;
   };
@@ -128,10 +133,16 @@ public:
   /// Parse the body of a request, assuming that it's XML and that it's entirely in memory
   int parseBody(char *body, long long len);
 
-  /// Prepare the buffers for sending a readv request
+  /// Clamp, sort and merge the requested byte ranges once the file size is known
+  int coalesceRWOps();
+
+  /// Prepare the buffers for sending the next readv batch
   int ReqReadV();
   readahead_list *ralist;
 
+  /// Send the data of a readv response as the next multipart chunk
+  int sendReadV();
+
   /// Build a partial header for a multipart response
   std::string buildPartialHdr(long long bytestart, long long byteend, long long filesize, char *token);
 
@@ -185,12 +196,12 @@ public:
   bool headerok;
 
 
-  // This can be largely optimized...
-  /// The original list of multiple reads to perform
+  /// The list of byte ranges to send, sorted and merged once the file is open
   std::vector<ReadWriteOp> rwOps;
-  /// The new list got from chunking the original req respecting the xrootd
-  /// max sizes etc.
-  std::vector<ReadWriteOp> rwOps_split;
+  /// The next range (and offset within it) still to be requested via readv.
+  /// Batches are built from here so memory does not grow with the range count.
+  size_t rwOpNext;
+  long long rwOpNextOff;
 
   bool keepalive;
   long long length;  // Total size from client for PUT; total length of response TO client for GET.
@@ -244,6 +255,10 @@ public:
   /// In a long write, we track where we have arrived
   long long writtenbytes;
 
+  /// Data of the open file went out with sendfile(), i.e. the file has a
+  /// descriptor and the OFS lets us use it
+  bool sendfiledone;
+
 
 
 
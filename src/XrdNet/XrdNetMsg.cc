@@ -30,6 +30,7 @@
 
 #include <errno.h>
 #include <sys/poll.h>
+#include <sys/uio.h>
 
 #include "XrdNet/XrdNet.hh"
 #include "XrdNet/XrdNetMsg.hh"
@@ -112,6 +113,55 @@ int XrdNetMsg::Send(const struct iovec iov[], int iovcnt,
    return Send(buff, (int)(bp-buff), dest, -1);
 }
   
+/******************************************************************************/
+/*                              S e n d M a n y                               */
+/******************************************************************************/
+  
+int XrdNetMsg::SendMany(const struct iovec msgs[], int mcnt)
+{
+   int numSent = 0, retc;
+
+   if (!destOK)
+      {eDest->Emsg("Msg", "Destination not specified."); return -1;}
+
+#ifdef HAVE_SENDMMSG
+   static const int maxBatch = 64;
+   struct mmsghdr mHdr[maxBatch];
+   int i, n;
+
+   while(numSent < mcnt)
+        {n = (mcnt - numSent < maxBatch ? mcnt - numSent : maxBatch);
+         memset(mHdr, 0, sizeof(struct mmsghdr)*n);
+         for (i = 0; i < n; i++)
+             {mHdr[i].msg_hdr.msg_name    = (void *)dfltDest.SockAddr();
+              mHdr[i].msg_hdr.msg_namelen = dfltDest.SockSize();
+              mHdr[i].msg_hdr.msg_iov     = (struct iovec *)&msgs[numSent+i];
+              mHdr[i].msg_hdr.msg_iovlen  = 1;
+             }
+         do {retc = sendmmsg(FD, mHdr, n, 0);}
+            while (retc < 0 && errno == EINTR);
+         if (retc <= 0)
+            {if (retc < 0) retc = retErr(errno, &dfltDest);
+             return (numSent ? numSent : (retc < 0 ? -1 : 0));
+            }
+         numSent += retc;
+        }
+#else
+   while(numSent < mcnt)
+        {do {retc = sendto(FD, (Sokdata_t)msgs[numSent].iov_base,
+                           msgs[numSent].iov_len, 0,
+                           dfltDest.SockAddr(), dfltDest.SockSize());}
+            while (retc < 0 && errno == EINTR);
+         if (retc < 0)
+            {retc = retErr(errno, &dfltDest);
+             return (numSent ? numSent : (retc < 0 ? -1 : 0));
+            }
+         numSent++;
+        }
+#endif
+   return numSent;
+}
+  
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
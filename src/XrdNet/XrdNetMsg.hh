@@ -87,6 +87,20 @@ int           Send(const struct  iovec iov[], // Remaining parms as above
                          int     iovcnt,      // Number of elements in iovec
                    const char   *dest=0,      // Hostname to send UDP datagram
                          int     tmo=-1);     // Timeout in ms (-1 = none)
+
+//------------------------------------------------------------------------------
+//! Send several UDP messages to the default endpoint using as few system
+//! calls as possible (sendmmsg() where available).
+//!
+//! @param  msgs     The messages to send, one vector element per message.
+//! @param  mcnt     The number of elements in msgs.
+//! @return <0       No message sent due to error.
+//! @return >=0      The number of messages sent, which may be less than mcnt
+//!                  when an error or a blocked socket stopped the transfer.
+//------------------------------------------------------------------------------
+
+int           SendMany(const struct iovec msgs[], int mcnt);
+
 //------------------------------------------------------------------------------
 //! Constructor
 //!
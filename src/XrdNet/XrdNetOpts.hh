@@ -94,6 +94,11 @@
 //
 #define XRDNET_SERVER    0x10000000
 
+// Allow several server sockets to bind the same port (SO_REUSEPORT) so that
+// the kernel spreads incomming connections across them (server only).
+//
+#define XRDNET_REUSEPORT 0x20000000
+
 // Maximum backlog for incomming connections. The backlog value goes in low
 // order byte and is used only when XRDNET_SERVER is specified.
 //
@@ -51,6 +51,7 @@
 /******************************************************************************/
 
 XrdOfsPoscq::XrdOfsPoscq(XrdSysError *erp, XrdOss *oss, const char *fn)
+                        : syncCV(0)
 {
    eDest = erp;
    ossFS = oss;
@@ -58,6 +59,8 @@ XrdOfsPoscq::XrdOfsPoscq(XrdSysError *erp, XrdOss *oss, const char *fn)
    pocFD = -1;
    pocSZ = 0;
    pocIQ = 0;
+   wrSeq = syncSeq = 0;
+   isSyncing = false;
    SlotList = SlotLust = 0;
 }
   
@@ -280,15 +283,18 @@ void XrdOfsPoscq::FailIni(const char *txt)
 /*                              r e q W r i t e                               */
 /******************************************************************************/
   
-int XrdOfsPoscq::reqWrite(void *Buff, int Bsz, int Offs)
+int XrdOfsPoscq::reqWrite(void *Buff, int Bsz, int Offs, bool doSync)
 {
    int rc = 0;
 
    do {rc = pwrite(pocFD, Buff, Bsz, Offs);} while(rc < 0 && errno == EINTR);
 
-   if (rc >= 0 && Bsz > 8) rc = fsync(pocFD);
-
    if (rc < 0) {eDest->Emsg("reqWrite",errno,"write", pocFN); return 0;}
+
+// Full records must be on stable storage before we return. Rather than have
+// each writer sync on its own we join the next group commit.
+//
+   if (Bsz > 8 && doSync) return Sync();
    return 1;
 }
 
@@ -313,14 +319,16 @@ int XrdOfsPoscq::ReWrite(XrdOfsPoscq::recEnt *rP)
    oldFD = pocFD; pocFD = newFD;
    oldFN = pocFN; pocFN = newFN;
 
-// Rewrite all records if we have any
+// Rewrite all records if we have any and make them durable in one go
 //
    while(rP)
         {rP->Offset = Offs;
-         if (!reqWrite((void *)&rP->reqData, ReqSize, Offs)) {aOK = 0; break;}
+         if (!reqWrite((void *)&rP->reqData, ReqSize, Offs, false))
+            {aOK = 0; break;}
          Offs += ReqSize;
          rP = rP->Next;
         }
+   if (aOK && Offs > ReqOffs && !Sync()) aOK = 0;
 
 // If all went well, rename the file
 //
@@ -336,6 +344,43 @@ int XrdOfsPoscq::ReWrite(XrdOfsPoscq::recEnt *rP)
    return aOK;
 }
 
+/******************************************************************************/
+/*                                  S y n c                                   */
+/******************************************************************************/
+
+// Make the caller's last write durable. The first caller to arrive while no
+// sync is in progress becomes the leader and syncs every record written so
+// far; everyone who arrives meanwhile waits and is covered by the next sync.
+// A failed sync covers nobody, so each waiter then retries as leader itself.
+//
+int XrdOfsPoscq::Sync()
+{
+   long long mySeq, upTo;
+   int rc;
+
+   syncCV.Lock();
+   mySeq = ++wrSeq;
+   while(syncSeq < mySeq)
+        {if (isSyncing) {syncCV.Wait(); continue;}
+         isSyncing = true;
+         upTo = wrSeq;
+         syncCV.UnLock();
+         do {rc = fdatasync(pocFD);} while(rc < 0 && errno == EINTR);
+         if (rc < 0) rc = errno;
+         syncCV.Lock();
+         isSyncing = false;
+         if (!rc && upTo > syncSeq) syncSeq = upTo;
+         syncCV.Broadcast();
+         if (rc)
+            {syncCV.UnLock();
+             eDest->Emsg("Sync", rc, "sync", pocFN);
+             return 0;
+            }
+        }
+   syncCV.UnLock();
+   return 1;
+}
+
 /******************************************************************************/
 /*                             V e r O f f s e t                              */
 /******************************************************************************/
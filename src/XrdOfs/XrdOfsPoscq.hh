@@ -78,8 +78,9 @@ inline int     Num() {return pocIQ;}
 private:
 void   FailIni(const char *lfn);
 int    reqRead(void *Buff, int Offs);
-int    reqWrite(void *Buff, int Bsz, int Offs);
+int    reqWrite(void *Buff, int Bsz, int Offs, bool doSync=true);
 int    ReWrite(recEnt *rP);
+int    Sync();
 int    VerOffset(const char *Lfn, int Offset);
 
 struct FileSlot
@@ -88,6 +89,10 @@ struct FileSlot
       };
 
 XrdSysMutex  myMutex;
+XrdSysCondVar syncCV;    // Serializes the group commit below
+long long    wrSeq;      // Number of records written
+long long    syncSeq;    // Records known to be on stable storage
+bool         isSyncing;  // A caller is currently syncing on everyone's behalf
 XrdSysError *eDest;
 XrdOss      *ossFS;
 FileSlot    *SlotList;
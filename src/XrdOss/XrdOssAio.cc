@@ -45,6 +45,7 @@
 
 #include "XrdOss/XrdOssApi.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysPthread.hh"
@@ -96,6 +97,14 @@ const int OSS_AIO_WRITE_DONE = SIGRTMAX;
 int XrdOssFile::Fsync(XrdSfsAio *aiop)
 {
 
+// If we are using io_uring, queue the request there. Should the ring be
+// full we simply do it synchronously.
+//
+   if (XrdOssSys::AioRing)
+      {aiop->TIdent = tident;
+       if (!XrdOssSys::AioRing->Fsync(aiop, fd, rgSlot)) return 0;
+      }
+
 #ifdef _POSIX_ASYNCHRONOUS_IO
    int rc;
 
@@ -148,6 +157,13 @@ int XrdOssFile::Fsync(XrdSfsAio *aiop)
 int XrdOssFile::Read(XrdSfsAio *aiop)
 {
 
+// Queue the read in the io_uring if we are using one (see Fsync above)
+//
+   if (XrdOssSys::AioRing)
+      {aiop->TIdent = tident;
+       if (!XrdOssSys::AioRing->Read(aiop, fd, rgSlot)) return 0;
+      }
+
 #ifdef _POSIX_ASYNCHRONOUS_IO
    EPNAME("AioRead");
    int rc;
@@ -205,6 +221,14 @@ int XrdOssFile::Read(XrdSfsAio *aiop)
   
 int XrdOssFile::Write(XrdSfsAio *aiop)
 {
+
+// Queue the write in the io_uring if we are using one (see Fsync above)
+//
+   if (XrdOssSys::AioRing)
+      {aiop->TIdent = tident;
+       if (!XrdOssSys::AioRing->Write(aiop, fd, rgSlot)) return 0;
+      }
+
 #ifdef _POSIX_ASYNCHRONOUS_IO
    EPNAME("AioWrite");
    int rc;
@@ -253,6 +277,8 @@ int XrdOssFile::Write(XrdSfsAio *aiop)
 /******************************************************************************/
 
 int   XrdOssSys::AioAllOk = 0;
+
+XrdOssUring *XrdOssSys::AioRing = 0;
   
 #if defined(_POSIX_ASYNCHRONOUS_IO) && !defined(HAVE_SIGWTI)
 // The folowing is for sigwaitinfo() emulation
@@ -274,6 +300,13 @@ extern "C" {extern void XrdOssAioWSH(int, siginfo_t *, void *);}
 
 int XrdOssSys::AioInit()
 {
+
+// When io_uring is being used there is no need for the signal threads. Since
+// POSIX aio stays disabled, requests that do not fit in the ring are done
+// synchronously.
+//
+   if (AioRing) return 1;
+
 #if defined(_POSIX_ASYNCHRONOUS_IO)
    EPNAME("AioInit");
    extern void *XrdOssAioWait(void *carg);
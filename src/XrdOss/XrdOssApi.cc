@@ -41,6 +41,9 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/param.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <algorithm>
 #ifdef __solaris__
 #include <sys/vnode.h>
 #endif
@@ -54,6 +57,7 @@
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
 #include "XrdOuc/XrdOucPinLoader.hh"
@@ -374,13 +378,17 @@ int XrdOssSys::Stats(char *buff, int blen)
 {
    static const char statfmt1[] = "<stats id=\"oss\" v=\"2\">";
    static const char statfmt2[] = "</stats>";
-   static const int  statflen = sizeof(statfmt1) + sizeof(statfmt2);
+   static const char statfmtv[] = "<readv><req>%lld</req><seg>%lld</seg>"
+                                  "<io>%lld</io></readv>";
+   static const int  statflen = sizeof(statfmt1) + sizeof(statfmt2)
+                              + sizeof(statfmtv) + (16*3);
    char *bp = buff;
    int n;
 
 // If only size wanted, return what size we need
 //
-   if (!buff) return statflen + getStats(0,0);
+   if (!buff) return statflen + getStats(0,0)
+                   + (AioRing ? AioRing->Stats(0,0) : 0);
 
 // Make sure we have enough space
 //
@@ -393,6 +401,22 @@ int XrdOssSys::Stats(char *buff, int blen)
    n = getStats(bp, blen);
    bp += n; blen -= n;
 
+// Generate vector read statistics. The ratio of segments to physical reads
+// reflects the effectiveness of readv coalescing.
+//
+   if (blen > (int)(sizeof(statfmtv) + (16*3)))
+      {n = snprintf(bp, blen, statfmtv, AtomicGet(rvReqs),
+                    AtomicGet(rvSegs), AtomicGet(rvIOs));
+       bp += n; blen -= n;
+      }
+
+// Generate io_uring statistics if we are using it
+//
+   if (AioRing && blen > AioRing->Stats(0,0))
+      {n = AioRing->Stats(bp, blen);
+       bp += n; blen -= n;
+      }
+
 // Add trailer
 //
    if (blen >= (int)sizeof(statfmt2))
@@ -759,6 +783,12 @@ int XrdOssFile::Open(const char *path, int Oflag, mode_t Mode, XrdOucEnv &Env)
        if (mopts) mmFile = XrdOssMio::Map(local_path, fd, mopts);
       } else mmFile = 0;
 
+// Install the file in a fixed io_uring slot, if we have one to hand out, so
+// that async requests need not look up the descriptor each time.
+//
+   if (fd >= 0 && XrdOssSys::AioRing)
+      rgSlot = XrdOssSys::AioRing->AddFile(fd);
+
 // Return the result of this open
 //
    return (fd < 0 ? fd : XrdOssOK);
@@ -786,6 +816,7 @@ int XrdOssFile::Close(long long *retsz)
            XrdOssCache::Adjust(cacheP, buf.st_size - FSize);
         if (retsz) *retsz = buf.st_size;
        }
+    if (rgSlot >= 0) {XrdOssSys::AioRing->RemFile(rgSlot); rgSlot = -1;}
     if (close(fd)) return -errno;
     if (mmFile) {XrdOssMio::Recycle(mmFile); mmFile = 0;}
 #ifdef XRDOSSCX
@@ -905,9 +936,17 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
       }
 #endif
 
-// Read in the vector and do a pre-advise if we support that
+// Account for this request (coalesced reads account for their own I/O)
 //
-   for (i = 0; i < n; i++)
+   AtomicInc((XrdOssSS->rvReqs));
+   AtomicAdd((XrdOssSS->rvSegs), n);
+   if (XrdOssSS->rvGap < 0 || n < 2) AtomicAdd((XrdOssSS->rvIOs), n);
+
+// If coalescing is enabled, merge neighbouring elements into scatter reads.
+// Otherwise, read in the vector and do a pre-advise if we support that.
+//
+   if (XrdOssSS->rvGap >= 0 && n > 1) totBytes = ReadVC(readV, n);
+      else for (i = 0; i < n; i++)
        {do {rdsz = pread(fd, readV[i].data, readV[i].size, readV[i].offset);}
            while(rdsz < 0 && errno == EINTR);
         if (rdsz < 0 || rdsz != readV[i].size)
@@ -937,6 +976,104 @@ ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
    return totBytes;
 }
 
+/******************************************************************************/
+/*                                R e a d V C                                 */
+/******************************************************************************/
+
+/*
+  Function: Perform all the reads specified in the readV vector by merging
+            neighbouring elements into scatter reads.
+
+  Input:    readV     - A description of the reads to perform (see ReadV()).
+            n         - The size of the readV vector.
+
+  Output:   Returns the number of bytes read upon success and -errno o/w.
+
+  Notes:    Elements are sorted by offset. A run of elements that are adjacent
+            or separated by no more than rvGap bytes is read with a single
+            preadv() that scatters directly into the caller's buffers, as long
+            as the run spans no more than rvLimit bytes. Intervening bytes are
+            read into a discard buffer. Overlapping elements are never merged.
+*/
+
+#ifdef __linux__
+namespace
+{
+char rvSink[65536];
+
+struct rvOrder
+{XrdOucIOVec *vec;
+ bool operator()(int a, int b) const {return vec[a].offset < vec[b].offset;}
+      rvOrder(XrdOucIOVec *vP) : vec(vP) {}
+};
+}
+#endif
+
+ssize_t XrdOssFile::ReadVC(XrdOucIOVec *readV, int n)
+{
+#ifdef __linux__
+   static const int maxIdx = 256;
+   struct iovec iov[IOV_MAX];
+   long long bOff, eOff, nOff;
+   ssize_t rdsz, grpBytes, gapBytes, totBytes = 0;
+   int idxBuff[maxIdx], *idx, i, j, iovNum, nIO = 0;
+
+// Sort an index into the vector by offset as the vector must not be reordered
+//
+   idx = (n <= maxIdx ? idxBuff : new int[n]);
+   for (i = 0; i < n; i++) idx[i] = i;
+   std::sort(idx, idx+n, rvOrder(readV));
+
+// Issue one read for each run of mergeable elements
+//
+   i = 0;
+   while(i < n)
+        {bOff = readV[idx[i]].offset;
+         eOff = bOff + readV[idx[i]].size;
+         iov[0].iov_base = readV[idx[i]].data;
+         iov[0].iov_len  = readV[idx[i]].size;
+         iovNum = 1; gapBytes = 0;
+         for (j = i+1; j < n; j++)
+             {nOff = readV[idx[j]].offset;
+              if (nOff < eOff || nOff - eOff > XrdOssSS->rvGap
+              ||  nOff + readV[idx[j]].size - bOff > XrdOssSS->rvLimit
+              ||  iovNum >= IOV_MAX-1) break;
+              if (nOff > eOff)
+                 {iov[iovNum].iov_base = rvSink;
+                  iov[iovNum].iov_len  = nOff - eOff;
+                  gapBytes += nOff - eOff;
+                  iovNum++;
+                 }
+              iov[iovNum].iov_base = readV[idx[j]].data;
+              iov[iovNum].iov_len  = readV[idx[j]].size;
+              iovNum++;
+              eOff = nOff + readV[idx[j]].size;
+             }
+
+         grpBytes = eOff - bOff;
+         if (iovNum == 1)
+            do {rdsz = pread(fd, iov[0].iov_base, grpBytes, bOff);}
+               while(rdsz < 0 && errno == EINTR);
+            else
+            do {rdsz = preadv(fd, iov, iovNum, bOff);}
+               while(rdsz < 0 && errno == EINTR);
+         nIO++;
+         if (rdsz != grpBytes)
+            {totBytes = (rdsz < 0 ? -errno : -ESPIPE); break;}
+         totBytes += grpBytes - gapBytes;
+         i = j;
+        }
+
+// Record the number of physical reads and return
+//
+   AtomicAdd((XrdOssSS->rvIOs), nIO);
+   if (idx != idxBuff) delete [] idx;
+   return totBytes;
+#else
+   return (ssize_t)-ENOTSUP;
+#endif
+}
+
 /******************************************************************************/
 /*                               R e a d R a w                                */
 /******************************************************************************/
@@ -80,6 +80,7 @@ class oocx_CXFile;
 class XrdSfsAio;
 class XrdOssCache_FS;
 class XrdOssMioFile;
+class XrdOssUring;
   
 class XrdOssFile : public XrdOssDF
 {
@@ -110,13 +111,14 @@ int     Write(XrdSfsAio *aiop);
         // Constructor and destructor
         XrdOssFile(const char *tid)
                   {cxobj = 0; rawio = 0; cxpgsz = 0; cxid[0] = '\0';
-                   mmFile = 0; tident = tid;
+                   mmFile = 0; tident = tid; rgSlot = -1;
                   }
 
 virtual ~XrdOssFile() {if (fd >= 0) Close();}
 
 private:
 int     Open_ufs(const char *, int, int, unsigned long long);
+ssize_t ReadVC(XrdOucIOVec *readV, int n);
 
 static int      AioFailure;
 oocx_CXFile    *cxobj;
@@ -126,6 +128,7 @@ const char     *tident;
 long long       FSize;
 int             rawio;
 int             cxpgsz;
+int             rgSlot;
 char            cxid[4];
 };
 
@@ -193,6 +196,7 @@ int       Stats(char *bp, int bl);
 
 static int   AioInit();
 static int   AioAllOk;
+static XrdOssUring *AioRing;    // io_uring backend or nil when not used
 
 static int   runOld;            // Run in backward compatability mode
 
@@ -272,6 +276,15 @@ int               prActive;  //    preread activity count
 short             prDepth;   //    preread depth
 short             prQSize;   //    preread maximum allowed
 
+int               rvGap;     //    readv coalesce gap (-1 -> no coalescing)
+int               rvLimit;   //    readv coalesced read byte limit
+long long         rvReqs;    //    readv requests handled
+long long         rvSegs;    //    readv segments requested
+long long         rvIOs;     //    readv physical reads issued
+
+int               aioQDepth; //    io_uring depth (0 -> POSIX aio)
+int               aioFiles;  //    io_uring fixed file slots
+
 XrdVersionInfo   *myVersion; //    Compilation version set by constructor
    
          XrdOssSys();
@@ -336,6 +349,7 @@ void   ConfigStats(XrdSysError &Eroute);
 void   ConfigStats(dev_t Devnum, char *lP);
 int    ConfigXeq(char *, XrdOucStream &, XrdSysError &);
 void   List_Path(const char *, const char *, unsigned long long, XrdSysError &);
+int    xaio(XrdOucStream &Config, XrdSysError &Eroute);
 int    xalloc(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcache(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcachescan(XrdOucStream &Config, XrdSysError &Eroute);
@@ -346,6 +360,7 @@ int    xmemf(XrdOucStream &Config, XrdSysError &Eroute);
 int    xnml(XrdOucStream &Config, XrdSysError &Eroute);
 int    xpath(XrdOucStream &Config, XrdSysError &Eroute);
 int    xprerd(XrdOucStream &Config, XrdSysError &Eroute);
+int    xreadv(XrdOucStream &Config, XrdSysError &Eroute);
 int    xspace(XrdOucStream &Config, XrdSysError &Eroute, int *isCD=0);
 int    xspaceBuild(char *grp, char *fn, int isxa, XrdSysError &Eroute);
 int    xstg(XrdOucStream &Config, XrdSysError &Eroute);
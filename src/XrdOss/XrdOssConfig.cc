@@ -52,6 +52,7 @@
 #include "XrdOss/XrdOssOpaque.hh"
 #include "XrdOss/XrdOssSpace.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
 #include "XrdOuc/XrdOuca2x.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdSys/XrdSysError.hh"
@@ -212,6 +213,17 @@ XrdOssSys::XrdOssSys()
    prActive      = 0;
    prDepth       = 0;
    prQSize       = 0;
+#ifdef __linux__
+   rvGap         = 0;
+#else
+   rvGap         = -1;
+#endif
+   rvLimit       = 1048576;
+   rvReqs        = 0;
+   rvSegs        = 0;
+   rvIOs         = 0;
+   aioQDepth     = 0;
+   aioFiles      = 0;
    STT_Lib       = 0;
    STT_Parms     = 0;
    STT_Func      = 0;
@@ -302,8 +314,12 @@ int XrdOssSys::Configure(const char *configfn, XrdSysError &Eroute,
 //
    if (!NoGo) NoGo = ConfigStage(Eroute);
 
-// Configure async I/O
+// Configure async I/O. Should io_uring have been requested but not be usable
+// we fall back to POSIX aio.
 //
+   if (!NoGo && aioQDepth > 0
+   &&  !(AioRing = XrdOssUring::Create(Eroute, aioQDepth, aioFiles)))
+      Eroute.Say("Config warning: io_uring unavailable; using POSIX aio.");
    if (!NoGo) NoGo = !AioInit();
 
 // Initialize memory mapping setting to speed execution
@@ -371,7 +387,7 @@ int XrdOssSys::Configure(const char *configfn, XrdSysError &Eroute,
 
 void XrdOssSys::Config_Display(XrdSysError &Eroute)
 {
-     char buff[4096], *cloc;
+     char buff[4096], aiobuff[64], *cloc;
      XrdOucPList *fp;
 
      // Preset some tests
@@ -386,11 +402,17 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
      if (!ConfigFN || !ConfigFN[0]) cloc = (char *)"Default";
         else cloc = ConfigFN;
 
+     if (aioQDepth > 0) snprintf(aiobuff, sizeof(aiobuff),
+                                 "uring qdepth %d files %d", aioQDepth, aioFiles);
+        else strcpy(aiobuff, "posix");
+
      snprintf(buff, sizeof(buff), "Config effective %s oss configuration:\n"
+                                  "       oss.aio          %s\n"
                                   "       oss.alloc        %lld %d %d\n"
                                   "       oss.cachescan    %d\n"
                                   "       oss.fdlimit      %d %d\n"
                                   "       oss.maxsize      %lld\n"
+                                  "       oss.readv        %s %d limit %d\n"
                                   "%s%s%s"
                                   "%s%s%s"
                                   "%s%s%s"
@@ -400,10 +422,12 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
                                   "%s"
                                   "       oss.trace        %x\n"
                                   "       oss.xfr          %d deny %d keep %d",
-             cloc,
+             cloc, aiobuff,
              minalloc, ovhalloc, fuzalloc,
              cscanint,
              FDFence, FDLimit, MaxSize,
+             (rvGap < 0 ? "nocoalesce" : "coalesce"), (rvGap < 0 ? 0 : rvGap),
+             rvLimit,
              XrdOssConfig_Val(N2N_Lib,    namelib),
              XrdOssConfig_Val(LocalRoot,  localroot),
              XrdOssConfig_Val(RemoteRoot, remoteroot),
@@ -945,6 +969,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
     int nosubs;
     XrdOucEnv *myEnv = 0;
 
+   TS_Xeq("aio",           xaio);
    TS_Xeq("alloc",         xalloc);
    TS_Xeq("cache",         xcache);
    TS_Xeq("cachescan",     xcachescan);
@@ -955,6 +980,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    TS_Xeq("namelib",       xnml);
    TS_Xeq("path",          xpath);
    TS_Xeq("preread",       xprerd);
+   TS_Xeq("readv",         xreadv);
    TS_Xeq("space",         xspace);
    TS_Xeq("stagecmd",      xstg);
    TS_Xeq("statlib",       xstl);
@@ -1014,6 +1040,68 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
 
+/******************************************************************************/
+/*                                  x a i o                                   */
+/******************************************************************************/
+
+/* Function: xaio
+
+   Purpose:  To parse the directive: aio {posix | uring [qdepth <n>] [files <n>]}
+
+             posix      uses POSIX aio completed via real-time signals. This is
+                        the default.
+             uring      uses io_uring, falling back to POSIX aio should the
+                        kernel not support it. Requests are submitted in
+                        batches and a single thread hands completions to the
+                        scheduler.
+             qdepth     the maximum number of requests in the ring at any one
+                        time; excess requests are done synchronously. The
+                        default is 512 and the max is 32768.
+             files      the number of open files that are registered with the
+                        ring (i.e. fixed files). The default is 0, which does
+                        not register files. The max is 32768.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xaio(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    char *val;
+    int qdepth = 0, files = 0;
+
+      if (!(val = Config.GetWord()))
+         {Eroute.Emsg("Config", "aio type not specified"); return 1;}
+
+           if (!strcmp(val, "posix")) {aioQDepth = 0; return 0;}
+      else if (strcmp(val, "uring"))
+              {Eroute.Emsg("Config","invalid aio type -",val); return 1;}
+
+      qdepth = 512;
+      while((val = Config.GetWord()))
+           {     if (!strcmp(val, "qdepth"))
+                    {if (!(val = Config.GetWord()))
+                        {Eroute.Emsg("Config","aio qdepth not specified");
+                         return 1;
+                        }
+                     if (XrdOuca2x::a2i(Eroute,"aio qdepth",val,&qdepth,1,32768))
+                        return 1;
+                    }
+            else if (!strcmp(val, "files"))
+                    {if (!(val = Config.GetWord()))
+                        {Eroute.Emsg("Config","aio files not specified");
+                         return 1;
+                        }
+                     if (XrdOuca2x::a2i(Eroute,"aio files",val,&files,0,32768))
+                        return 1;
+                    }
+            else {Eroute.Emsg("Config","invalid aio option -",val); return 1;}
+           }
+
+      aioQDepth = qdepth;
+      aioFiles  = files;
+      return 0;
+}
+
 /******************************************************************************/
 /*                                x a l l o c                                 */
 /******************************************************************************/
@@ -1429,6 +1517,78 @@ int XrdOssSys::xprerd(XrdOucStream &Config, XrdSysError &Eroute)
       return 0;
 }
   
+/******************************************************************************/
+/*                                x r e a d v                                 */
+/******************************************************************************/
+
+/* Function: xreadv
+
+   Purpose:  To parse the directive: readv [coalesce [<gap>] | nocoalesce]
+                                           [limit <bytes>]
+
+             coalesce   sorts the elements of a vector read by offset and
+                        merges neighbouring elements into a single scatter
+                        read (i.e. preadv) straight into the caller's buffers.
+                        This is the default on platforms supporting preadv.
+             <gap>      the maximum number of unrequested bytes between two
+                        elements that may still be merged; the intervening
+                        bytes are read and discarded. The default is 0 (i.e.
+                        only exactly adjacent elements are merged). The max
+                        is 64K.
+             nocoalesce reads each element with a separate pread.
+             <bytes>    the maximum number of bytes a merged read may span.
+                        The default is 1M. The max is 16M.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xreadv(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    static const long long m16 = 16777216LL;
+    char *val;
+    long long gsz, lim = rvLimit;
+    int gap = rvGap;
+
+      if (!(val = Config.GetWord()))
+         {Eroute.Emsg("Config", "readv option not specified"); return 1;}
+
+      while(val)
+           {     if (!strcmp(val, "coalesce"))
+                    {gap = 0;
+                     if ((val = Config.GetWord()) && isdigit(*val))
+                        {if (XrdOuca2x::a2sz(Eroute,"readv gap",val,&gsz,0,65536))
+                            return 1;
+                         gap = static_cast<int>(gsz);
+                         val = Config.GetWord();
+                        }
+                     continue;
+                    }
+            else if (!strcmp(val, "nocoalesce")) gap = -1;
+            else if (!strcmp(val, "limit"))
+                    {if (!(val = Config.GetWord()))
+                        {Eroute.Emsg("Config","readv limit not specified");
+                         return 1;
+                        }
+                     if (XrdOuca2x::a2sz(Eroute,"readv limit",val,&lim,4096,m16))
+                        return 1;
+                    }
+            else {Eroute.Emsg("Config","invalid readv option -",val); return 1;}
+            val = Config.GetWord();
+           }
+
+#ifndef __linux__
+      if (gap >= 0)
+         {Eroute.Say("Config warning: readv coalescing not supported on this "
+                     "platform; ignored.");
+          gap = -1;
+         }
+#endif
+
+      rvGap   = gap;
+      rvLimit = static_cast<int>(lim);
+      return 0;
+}
+  
 /******************************************************************************/
 /*                                x s p a c e                                 */
 /******************************************************************************/
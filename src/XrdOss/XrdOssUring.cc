@@ -0,0 +1,443 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s U r i n g . c c                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef HAVE_IO_URING
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+#include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssUring.hh"
+#include "XrdSfs/XrdSfsAio.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+extern XrdOucTrace OssTrace;
+
+extern XrdSysError OssEroute;
+
+#ifdef HAVE_IO_URING
+
+// The low order bit of the user data tells the reaper which completion
+// routine to call. XrdSfsAio objects are always at least 8-byte aligned.
+//
+#define OSS_URING_WRITE 1ULL
+
+/******************************************************************************/
+/*                     T h r e a d   I n t e r f a c e s                      */
+/******************************************************************************/
+
+void *XrdOssUringReap(void *carg)
+{
+   XrdOssUring *ringP = (XrdOssUring *)carg;
+   ringP->Reap();
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdOssUring::XrdOssUring()
+            : ringFD(-1), sqEntries(0), sqMask(0), sqTail(0), sqArray(0),
+              sqes(0), cqMask(0), cqHead(0), cqTail(0), cqes(0),
+              inFlight(0), toSubmit(0), isSubmitting(false),
+              numOps(0), numEnters(0), numFull(0)
+{}
+
+/******************************************************************************/
+/*                                C r e a t e                                 */
+/******************************************************************************/
+
+XrdOssUring *XrdOssUring::Create(XrdSysError &Eroute, int qDepth, int nFiles)
+{
+   EPNAME("UringCreate");
+   XrdOssUring *ringP = new XrdOssUring;
+   pthread_t tid;
+   int retc;
+
+// Set up the ring. Should this fail, the caller falls back to POSIX aio.
+//
+   if (!ringP->Init(Eroute, qDepth, nFiles))
+      {delete ringP; return 0;}
+
+// Start the thread that reaps completions
+//
+   if ((retc = XrdSysThread::Run(&tid, XrdOssUringReap, (void *)ringP,
+                                 0, "io_uring reaper")))
+      {Eroute.Emsg("AioInit", retc, "create io_uring reaper thread");
+       return 0;
+      }
+   DEBUG("started io_uring reaper thread; depth=" <<ringP->sqEntries
+         <<" files=" <<ringP->freeSlots.size());
+   return ringP;
+}
+
+/******************************************************************************/
+/*                               A d d F i l e                                */
+/******************************************************************************/
+
+int XrdOssUring::AddFile(int fd)
+{
+   struct io_uring_files_update upd;
+   int slot;
+
+// Grab a free fixed file slot, if there is one
+//
+   slotMutex.Lock();
+   if (freeSlots.empty()) {slotMutex.UnLock(); return -1;}
+   slot = freeSlots.back();
+   freeSlots.pop_back();
+   slotMutex.UnLock();
+
+// Install the file in the slot. Should this fail, the file simply gets
+// used by its descriptor.
+//
+   memset(&upd, 0, sizeof(upd));
+   upd.offset = slot;
+   upd.fds    = (unsigned long)&fd;
+   if (syscall(__NR_io_uring_register, ringFD, IORING_REGISTER_FILES_UPDATE,
+               &upd, 1) != 1)
+      {slotMutex.Lock(); freeSlots.push_back(slot); slotMutex.UnLock();
+       return -1;
+      }
+   return slot;
+}
+
+/******************************************************************************/
+/*                               R e m F i l e                                */
+/******************************************************************************/
+
+void XrdOssUring::RemFile(int slot)
+{
+   struct io_uring_files_update upd;
+   int fd = -1;
+
+// Empty the slot. Requests still in flight hold their own file reference.
+//
+   memset(&upd, 0, sizeof(upd));
+   upd.offset = slot;
+   upd.fds    = (unsigned long)&fd;
+   syscall(__NR_io_uring_register, ringFD, IORING_REGISTER_FILES_UPDATE,
+           &upd, 1);
+
+   slotMutex.Lock(); freeSlots.push_back(slot); slotMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                     F s y n c   /   R e a d   /   W r i t e                */
+/******************************************************************************/
+
+int XrdOssUring::Fsync(XrdSfsAio *aiop, int fd, int slot)
+{
+   return Submit(aiop, IORING_OP_FSYNC, fd, slot, 1);
+}
+
+int XrdOssUring::Read(XrdSfsAio *aiop, int fd, int slot)
+{
+   return Submit(aiop, IORING_OP_READ, fd, slot, 0);
+}
+
+int XrdOssUring::Write(XrdSfsAio *aiop, int fd, int slot)
+{
+   return Submit(aiop, IORING_OP_WRITE, fd, slot, 1);
+}
+
+/******************************************************************************/
+/*                                  R e a p                                   */
+/******************************************************************************/
+
+void XrdOssUring::Reap()
+{
+   EPNAME("UringReap");
+   struct io_uring_cqe *cqe;
+   XrdSfsAio *aiop;
+   unsigned long long udata;
+   unsigned int head, tail, numDone;
+
+// Only this thread moves the completion head so it need not be locked. Each
+// completion is handed back via the aio object's completion routine which
+// simply schedules the associated request.
+//
+   do {head = *cqHead;
+       tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+       if (head == tail)
+          {if (Enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+              {OssEroute.Emsg("AioWait", errno, "wait for io_uring events");
+               XrdSysTimer::Wait(10);
+              }
+           continue;
+          }
+
+       numDone = 0;
+       do {cqe   = ((struct io_uring_cqe *)cqes) + (head & cqMask);
+           udata = cqe->user_data;
+           aiop  = (XrdSfsAio *)(udata & ~OSS_URING_WRITE);
+           aiop->Result = cqe->res;
+           __atomic_store_n(cqHead, ++head, __ATOMIC_RELEASE);
+
+           DEBUG((udata & OSS_URING_WRITE ? "write" : "read")
+                 <<" completed for " <<aiop->TIdent <<"; result="
+                 <<aiop->Result <<" aiocb=" <<std::hex <<aiop <<std::dec);
+
+           if (udata & OSS_URING_WRITE) aiop->doneWrite();
+              else                      aiop->doneRead();
+           numDone++;
+          } while(head != tail);
+
+       ringMutex.Lock(); inFlight -= numDone; ringMutex.UnLock();
+      } while(1);
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdOssUring::Stats(char *buff, int blen)
+{
+   static const char statfmt[] = "<uring><ops>%lld</ops><enter>%lld</enter>"
+                                 "<full>%lld</full><inq>%u</inq></uring>";
+   long long ops, enters, full;
+   unsigned int inq;
+
+// Return the maximum length if so wanted
+//
+   if (!buff) return sizeof(statfmt) + (16*4);
+
+// Get a consistent snapshot
+//
+   ringMutex.Lock();
+   ops = numOps; enters = numEnters; full = numFull; inq = inFlight;
+   ringMutex.UnLock();
+
+   return snprintf(buff, blen, statfmt, ops, enters, full, inq);
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                 E n t e r                                  */
+/******************************************************************************/
+
+int XrdOssUring::Enter(unsigned int toSub, unsigned int minComp,
+                       unsigned int flags)
+{
+   return syscall(__NR_io_uring_enter, ringFD, toSub, minComp, flags, 0, 0);
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+int XrdOssUring::Init(XrdSysError &Eroute, int qDepth, int nFiles)
+{
+   struct io_uring_params parms;
+   void *sqRing, *cqRing;
+   size_t sqLen, cqLen;
+
+// Create the ring
+//
+   memset(&parms, 0, sizeof(parms));
+   if ((ringFD = syscall(__NR_io_uring_setup, qDepth, &parms)) < 0)
+      {Eroute.Emsg("AioInit", errno, "set up io_uring");
+       return 0;
+      }
+
+// We rely on the plain read and write opcodes and on a single mapping for
+// both rings; both came with the same kernel release (5.6).
+//
+   if (!(parms.features & IORING_FEAT_SINGLE_MMAP)
+   ||  !(parms.features & IORING_FEAT_RW_CUR_POS))
+      {Eroute.Emsg("AioInit", "io_uring is too old on this kernel");
+       close(ringFD); ringFD = -1;
+       return 0;
+      }
+
+// Map in the rings and the submission entries
+//
+   sqLen = parms.sq_off.array + parms.sq_entries * sizeof(unsigned int);
+   cqLen = parms.cq_off.cqes  + parms.cq_entries * sizeof(struct io_uring_cqe);
+   if (cqLen > sqLen) sqLen = cqLen;
+   sqRing = mmap(0, sqLen, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+                 ringFD, IORING_OFF_SQ_RING);
+   if (sqRing == MAP_FAILED)
+      {Eroute.Emsg("AioInit", errno, "map io_uring");
+       close(ringFD); ringFD = -1;
+       return 0;
+      }
+   cqRing = sqRing;
+
+   sqes = mmap(0, parms.sq_entries * sizeof(struct io_uring_sqe),
+               PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+               ringFD, IORING_OFF_SQES);
+   if (sqes == MAP_FAILED)
+      {Eroute.Emsg("AioInit", errno, "map io_uring entries");
+       munmap(sqRing, sqLen); close(ringFD); ringFD = -1;
+       return 0;
+      }
+
+   sqEntries = parms.sq_entries;
+   sqMask    = *(unsigned int *)((char *)sqRing + parms.sq_off.ring_mask);
+   sqTail    =  (unsigned int *)((char *)sqRing + parms.sq_off.tail);
+   sqArray   =  (unsigned int *)((char *)sqRing + parms.sq_off.array);
+   cqMask    = *(unsigned int *)((char *)cqRing + parms.cq_off.ring_mask);
+   cqHead    =  (unsigned int *)((char *)cqRing + parms.cq_off.head);
+   cqTail    =  (unsigned int *)((char *)cqRing + parms.cq_off.tail);
+   cqes      =                   (char *)cqRing + parms.cq_off.cqes;
+
+// Register an empty fixed file table if so wanted. Files get added as they
+// are opened. Failure here is not fatal; files are then used by descriptor.
+//
+   if (nFiles > 0)
+      {std::vector<int> fdTab(nFiles, -1);
+       if (syscall(__NR_io_uring_register, ringFD, IORING_REGISTER_FILES,
+                   &fdTab[0], nFiles) < 0)
+          Eroute.Emsg("AioInit", errno, "register io_uring fixed files; "
+                                        "fixed files disabled");
+          else for (int i = nFiles-1; i >= 0; i--) freeSlots.push_back(i);
+      }
+   return 1;
+}
+
+/******************************************************************************/
+/*                                S u b m i t                                 */
+/******************************************************************************/
+
+int XrdOssUring::Submit(XrdSfsAio *aiop, int opc, int fd, int slot,
+                        int isWrite)
+{
+   EPNAME("UringSubmit");
+   static int errCnt = 0;
+   const char *tident = aiop->TIdent;
+   struct io_uring_sqe *sqe;
+   unsigned int tail, idx, batch;
+   int rc, ecode;
+
+// Never allow more requests in flight than there are submission entries.
+// This way neither ring can overflow and the caller does the I/O itself.
+//
+   ringMutex.Lock();
+   if (inFlight >= sqEntries)
+      {numFull++;
+       ringMutex.UnLock();
+       return 1;
+      }
+
+// Fill out the next submission entry and make it visible to the kernel
+//
+   tail = *sqTail;
+   idx  = tail & sqMask;
+   sqe  = ((struct io_uring_sqe *)sqes) + idx;
+   memset(sqe, 0, sizeof(struct io_uring_sqe));
+   sqe->opcode = opc;
+   if (slot >= 0) {sqe->fd = slot; sqe->flags = IOSQE_FIXED_FILE;}
+      else         sqe->fd = fd;
+   if (opc != IORING_OP_FSYNC)
+      {sqe->off  = aiop->sfsAio.aio_offset;
+       sqe->addr = (unsigned long)aiop->sfsAio.aio_buf;
+       sqe->len  = aiop->sfsAio.aio_nbytes;
+      }
+   sqe->user_data = (unsigned long long)aiop
+                  | (isWrite ? OSS_URING_WRITE : 0ULL);
+   sqArray[idx] = idx;
+   __atomic_store_n(sqTail, tail+1, __ATOMIC_RELEASE);
+   inFlight++; toSubmit++; numOps++;
+
+   TRACE(Debug, (isWrite ? "write " : "read ") <<aiop->sfsAio.aio_nbytes
+                <<'@' <<aiop->sfsAio.aio_offset <<" queued; aiocb="
+                <<std::hex <<aiop <<std::dec);
+
+// If someone else is already talking to the kernel, they will pick up our
+// entry as well. Otherwise, we hand over everything queued so far and keep
+// doing so until no more entries arrived while we were in the kernel. The
+// entries are already visible to the kernel so a failed submission can only
+// be retried (the message is issued every 1024 failures).
+//
+   if (isSubmitting) {ringMutex.UnLock(); return 0;}
+   isSubmitting = true;
+   while(toSubmit)
+        {batch = toSubmit; toSubmit = 0; numEnters++;
+         ringMutex.UnLock();
+         if ((rc = Enter(batch, 0, 0)) < 0 && (ecode = errno) != EINTR)
+            {if (ecode != EAGAIN && ecode != EBUSY && !(errCnt++ & 0x3ff))
+                OssEroute.Emsg("AioSubmit", ecode, "submit io_uring requests");
+             XrdSysTimer::Wait(1);
+            }
+         ringMutex.Lock();
+         if (rc < (int)batch) toSubmit += batch - (rc < 0 ? 0 : rc);
+        }
+   isSubmitting = false;
+   ringMutex.UnLock();
+   return 0;
+}
+
+#else
+
+/******************************************************************************/
+/*                      N o   i o _ u r i n g   S t u b s                     */
+/******************************************************************************/
+
+XrdOssUring::XrdOssUring()
+            : ringFD(-1), sqEntries(0), sqMask(0), sqTail(0), sqArray(0),
+              sqes(0), cqMask(0), cqHead(0), cqTail(0), cqes(0),
+              inFlight(0), toSubmit(0), isSubmitting(false),
+              numOps(0), numEnters(0), numFull(0)
+{}
+
+XrdOssUring *XrdOssUring::Create(XrdSysError &Eroute, int qDepth, int nFiles)
+{
+   Eroute.Say("Config warning: io_uring not supported on this platform.");
+   return 0;
+}
+
+int  XrdOssUring::AddFile(int fd) {return -1;}
+
+void XrdOssUring::RemFile(int slot) {}
+
+int  XrdOssUring::Fsync(XrdSfsAio *aiop, int fd, int slot) {return 1;}
+
+int  XrdOssUring::Read (XrdSfsAio *aiop, int fd, int slot) {return 1;}
+
+int  XrdOssUring::Write(XrdSfsAio *aiop, int fd, int slot) {return 1;}
+
+void XrdOssUring::Reap() {}
+
+int  XrdOssUring::Stats(char *buff, int blen) {return 0;}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef __XRDOSSURING_H__
+#define __XRDOSSURING_H__
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s U r i n g . h h                         */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <vector>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdSfsAio;
+class XrdSysError;
+
+// The XrdOssUring object drives asynchronous reads, writes, and syncs through
+// a Linux io_uring instead of POSIX aio. Requests are placed in the submission
+// ring by the caller and handed to the kernel in batches; a single reaper
+// thread collects completions and calls doneRead()/doneWrite() which hand the
+// request back to the scheduler. All methods return 0 when the request was
+// queued and 1 when it was not (ring full or unavailable) in which case the
+// caller must do the I/O some other way.
+//
+class XrdOssUring
+{
+public:
+
+static XrdOssUring *Create(XrdSysError &Eroute, int qDepth, int nFiles);
+
+       int          AddFile(int fd);
+
+       void         RemFile(int slot);
+
+       int          Fsync(XrdSfsAio *aiop, int fd, int slot);
+
+       int          Read (XrdSfsAio *aiop, int fd, int slot);
+
+       int          Write(XrdSfsAio *aiop, int fd, int slot);
+
+       void         Reap();
+
+       int          Stats(char *buff, int blen);
+
+                    XrdOssUring();
+                   ~XrdOssUring() {} // Never gets deleted
+
+private:
+
+int  Enter(unsigned int toSubmit, unsigned int minComplete, unsigned int flags);
+int  Init(XrdSysError &Eroute, int qDepth, int nFiles);
+int  Submit(XrdSfsAio *aiop, int opc, int fd, int slot, int isWrite);
+
+XrdSysMutex       ringMutex;
+XrdSysMutex       slotMutex;
+std::vector<int>  freeSlots;
+
+int               ringFD;
+unsigned int      sqEntries;
+unsigned int      sqMask;
+unsigned int     *sqTail;
+unsigned int     *sqArray;
+void             *sqes;
+unsigned int      cqMask;
+unsigned int     *cqHead;
+unsigned int     *cqTail;
+void             *cqes;
+
+unsigned int      inFlight;
+unsigned int      toSubmit;
+bool              isSubmitting;
+
+long long         numOps;
+long long         numEnters;
+long long         numFull;
+};
+#endif
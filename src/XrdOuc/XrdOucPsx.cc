@@ -289,6 +289,7 @@ bool XrdOucPsx::Parse(char *var, XrdOucStream &Config, XrdSysError &eDest)
    TS_Xeq("inetmode",      ParseINet);
    TS_Xeq("namelib",       ParseNLib);
    TS_Xeq("setopt",        ParseSet);
+   TS_Xeq("statcache",     ParseStat);
    TS_Xeq("trace",         ParseTrace);
 
    // No match found, complain.
@@ -717,6 +718,77 @@ void XrdOucPsx::ParseSet(const char *kword, int kval)
    setLast = item;
 }
 
+/******************************************************************************/
+/*                             P a r s e S t a t                              */
+/******************************************************************************/
+
+/* Function: ParseStat
+
+   Purpose:  To parse the directive: statcache {off | <opts>}
+
+             off       disables the stat cache (the default).
+             <opts>    one or more of the following:
+             nxttl <t> the number of seconds a non-existent object is
+                       remembered (default 10, 0 disables negative entries).
+             size <sz> the maximum amount of memory to use (default 16m).
+             ttl   <t> the number of seconds a stat result is remembered
+                       (default 60).
+
+   Output: true upon success or false upon failure.
+*/
+
+bool XrdOucPsx::ParseStat(XrdSysError *Eroute, XrdOucStream &Config)
+{
+   char *val;
+   long long llVal = 16*1024*1024;
+   int ttl = 60, nxttl = 10;
+
+// Check for off
+//
+   if ((val = Config.GetWord()) && !strcmp(val, "off"))
+      {scSize = 0; return true;}
+
+// Process the options
+//
+   while(val)
+        {     if (!strcmp(val, "size"))
+                 {if (!(val = Config.GetWord()) || !val[0])
+                     {Eroute->Emsg("Config","statcache size not specified");
+                      return false;
+                     }
+                  if (XrdOuca2x::a2sz(*Eroute,"statcache size",val,&llVal,
+                                      1024)) return false;
+                 }
+         else if (!strcmp(val, "ttl"))
+                 {if (!(val = Config.GetWord()) || !val[0])
+                     {Eroute->Emsg("Config","statcache ttl not specified");
+                      return false;
+                     }
+                  if (XrdOuca2x::a2tm(*Eroute,"statcache ttl",val,&ttl,1))
+                     return false;
+                 }
+         else if (!strcmp(val, "nxttl"))
+                 {if (!(val = Config.GetWord()) || !val[0])
+                     {Eroute->Emsg("Config","statcache nxttl not specified");
+                      return false;
+                     }
+                  if (XrdOuca2x::a2tm(*Eroute,"statcache nxttl",val,&nxttl,0))
+                     return false;
+                 }
+         else {Eroute->Emsg("Config","invalid statcache option -",val);
+               return false;
+              }
+         val = Config.GetWord();
+        }
+
+// Record the values
+//
+   scSize  = llVal;
+   scTTL   = ttl;
+   scNXTTL = nxttl;
+   return true;
+}
+
 /******************************************************************************/
 /*                            P a r s e T r a c e                             */
 /******************************************************************************/
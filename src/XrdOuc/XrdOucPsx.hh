@@ -62,6 +62,8 @@ bool      ParseNLib(XrdSysError *Eroute, XrdOucStream &Config);
 
 bool      ParseSet(XrdSysError *Eroute, XrdOucStream &Config);
 
+bool      ParseStat(XrdSysError *Eroute, XrdOucStream &Config);
+
 bool      ParseTrace(XrdSysError *Eroute, XrdOucStream &Config);
 
 void      SetRoot(const char *lroot, const char *oroot=0);
@@ -70,6 +72,7 @@ XrdOucName2Name   *theN2N;   // -> File mapper object
 XrdOucCache       *theCache;
 XrdOucCache2      *theCache2;
 char              *mCache;
+long long          scSize;   // Stat cache size (0 -> disabled)
 XrdOucTList       *setFirst;
 XrdOucTList       *setLast;
 int                maxRHCB;
@@ -77,6 +80,8 @@ int                traceLvl;
 int                debugLvl;
 int                cioWait;
 int                cioTries;
+int                scTTL;    // Stat cache positive entry lifetime
+int                scNXTTL;  // Stat cache negative entry lifetime
 bool               useV4;
 bool               xLfn2Pfn;
 bool               xPfn2Lfn;
@@ -84,8 +89,9 @@ bool               xNameLib;
 
           XrdOucPsx(XrdVersionInfo *vInfo, const char *cfn)
                    : theN2N(0), theCache(0), theCache2(0), mCache(0),
-                     setFirst(0), setLast(0), maxRHCB(0),
+                     scSize(0), setFirst(0), setLast(0), maxRHCB(0),
                      traceLvl(0), debugLvl(0), cioWait(0), cioTries(0),
+                     scTTL(0), scNXTTL(0),
                      useV4(false), xLfn2Pfn(false), xPfn2Lfn(false),
                      xNameLib(false),
                      LocalRoot(0), RemotRoot(0), N2NLib(0), N2NParms(0),
@@ -44,6 +44,7 @@
 #include "XrdPosix/XrdPosixFileRH.hh"
 #include "XrdPosix/XrdPosixMap.hh"
 #include "XrdPosix/XrdPosixPrepIO.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
 #include "XrdPosix/XrdPosixTrace.hh"
 #include "XrdPosix/XrdPosixXrootd.hh"
 #include "XrdPosix/XrdPosixXrootdPath.hh"
@@ -252,6 +253,11 @@ void XrdPosixConfig::SetConfig(XrdOucPsx &parms)
        XrdPosixGlobals::ddInterval = (parms.cioWait  < 10 ? 10 : parms.cioWait);
       }
 
+// Handle the stat cache
+//
+   if (parms.scSize > 0)
+      XrdPosixStatCache::Config(parms.scSize, parms.scTTL, parms.scNXTTL);
+
 // Handle the caching options
 //
         if (parms.theCache2)
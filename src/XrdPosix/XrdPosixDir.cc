@@ -31,6 +31,7 @@
 
 #include "XrdPosix/XrdPosixDir.hh"
 #include "XrdPosix/XrdPosixMap.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
 
 /******************************************************************************/
 /*                               G l o b a l s                                */
@@ -71,7 +72,10 @@ dirent64 *XrdPosixDir::nextEntry(dirent64 *dp)
    if (!dp) dp = myDirEnt;
    if (d_nlen > maxDlen) d_nlen = maxDlen;
 #ifndef __solaris__
-   dp->d_type   = DT_DIR;
+   if (dirEnt->GetStatInfo())
+      dp->d_type = (dirEnt->GetStatInfo()->TestFlags(XrdCl::StatInfo::IsDir)
+                 ? DT_DIR : DT_REG);
+      else dp->d_type = DT_DIR;
 #endif
 #if defined(__APPLE__) || defined(__FreeBSD__)
    dp->d_fileno = nxtEnt;
@@ -94,6 +98,7 @@ dirent64 *XrdPosixDir::nextEntry(dirent64 *dp)
 DIR *XrdPosixDir::Open()
 {
    static const size_t dEntSize = sizeof(dirent64) + maxDlen + 1;
+   XrdCl::DirListFlags::Flags dlFlag = XrdPosixGlobals::dlFlag;
    int rc;
 
 // Allocate a local dirent. Note that we get additional padding because on
@@ -102,18 +107,34 @@ DIR *XrdPosixDir::Open()
    if (!myDirEnt && !(myDirEnt = (dirent64 *)malloc(dEntSize)))
       {errno = ENOMEM; return (DIR *)0;}
 
+// When stat information is being cached, have the listing return it for each
+// entry (kXR_dstat) so that subsequent stats of the entries are local.
+//
+   if (XrdPosixStatCache::Enabled()) dlFlag |= XrdCl::DirListFlags::Stat;
+
 // Get the directory list
 //
    rc = XrdPosixMap::Result(DAdmin.Xrd.DirList(DAdmin.Url.GetPathWithParams(),
-                                               XrdPosixGlobals::dlFlag,
-                                               myDirVec, (uint16_t)0));
+                                               dlFlag, myDirVec, (uint16_t)0));
 
 // If we failed, return a zero pointer
 //
    if (rc) return (DIR *)0;
 
-// Finish up
+// Populate the stat cache from the listing
 //
    numEnt = myDirVec->GetSize();
+   if (dlFlag & XrdCl::DirListFlags::Stat)
+      {XrdCl::DirectoryList::ListEntry *dirEnt;
+       for (uint32_t i = 0; i < numEnt; i++)
+           {dirEnt = myDirVec->At(i);
+            if (dirEnt->GetStatInfo())
+               XrdPosixStatCache::Add(DAdmin.Url, dirEnt->GetName(),
+                                      *(dirEnt->GetStatInfo()));
+           }
+      }
+
+// Finish up
+//
    return (DIR *)&fdNum;
 }
@@ -41,6 +41,7 @@
 #include "XrdPosix/XrdPosixFile.hh"
 #include "XrdPosix/XrdPosixFileRH.hh"
 #include "XrdPosix/XrdPosixPrepIO.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
 #include "XrdPosix/XrdPosixTrace.hh"
 #include "XrdPosix/XrdPosixXrootdPath.hh"
 
@@ -90,7 +91,7 @@ XrdPosixFile::XrdPosixFile(bool &aOK, const char *path, XrdPosixCallBack *cbP,
              : XCio((XrdOucCacheIO2 *)this), PrepIO(0),
                mySize(0), myMtime(0), myInode(0), myMode(0),
                theCB(cbP), fLoc(0), cOpt(0),
-               isStream(Opts & isStrm ? 1 : 0)
+               isStream(Opts & isStrm ? 1 : 0), isCreat(Opts & isCrte ? 1 : 0)
 {
 // Handle path generation. This is trickt as we may have two namespaces. One
 // for the origin and one for the cache.
@@ -266,6 +267,11 @@ bool XrdPosixFile::Finalize(XrdCl::XRootDStatus *Status)
 //
    currOffset = 0;
 
+// A stat of a file being created or updated may have been cached while the
+// open was in flight. Now that it has been done drop that information again.
+//
+   if (Status && (isUpdate() || isCreate())) XrdPosixStatCache::Invalidate(fOpen);
+
 // Complete initialization. If the stat() fails, the caller will unwind the
 // whole open process (ick). In the process get correct I/O vector.
 
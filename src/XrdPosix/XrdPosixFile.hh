@@ -101,6 +101,10 @@ static void          DelayedDestroy(XrdPosixFile *fp);
 
        void          isOpen();
 
+       bool          isUpdate() {return (cOpt & XrdOucCache::optRW) != 0;}
+
+       bool          isCreate() {return isCreat != 0;}
+
        void          updLock()   {updMutex.Lock();}
 
        void          updUnLock() {updMutex.UnLock();}
@@ -174,6 +178,7 @@ static int           ddNum;
 static const int realFD = 1;
 static const int isStrm = 2;
 static const int isUpdt = 4;
+static const int isCrte = 8;
 
            XrdPosixFile(bool &aOK, const char *path, XrdPosixCallBack *cbP=0,
                         int   Opts=0);
@@ -191,5 +196,6 @@ char       *fOpen;
 char       *fLoc;
 union {int  cOpt; int numTries;};
 char        isStream;
+char        isCreat;
 };
 #endif
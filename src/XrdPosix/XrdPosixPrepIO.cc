@@ -30,6 +30,7 @@
 
 #include "XrdPosix/XrdPosixObjGuard.hh"
 #include "XrdPosix/XrdPosixPrepIO.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
 #include "XrdPosix/XrdPosixTrace.hh"
 
 /******************************************************************************/
@@ -64,6 +65,11 @@ bool XrdPosixPrepIO::Init(XrdOucCacheIOCB *iocbP)
 //
    Status = fileP->clFile.Open((std::string)fileP->Origin(), clFlags, clMode);
 
+// Drop any stat information cached while the open was deferred
+//
+   if (fileP->isUpdate() || fileP->isCreate())
+      XrdPosixStatCache::Invalidate(fileP->Origin());
+
 // If all went well, then we need to do a Stat() call on the underlying file
 //
    if (Status.IsOK()) fileP->Stat(Status);
@@ -0,0 +1,323 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d P o s i x S t a t C a c h e                      */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include "XrdCl/XrdClURL.hh"
+#include "XrdCl/XrdClXRootDResponses.hh"
+#include "XrdPosix/XrdPosixMap.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+XrdSysMutex                     XrdPosixStatCache::scMutex;
+XrdPosixStatCache::EntryMap     XrdPosixStatCache::scMap;
+std::list<const std::string*>   XrdPosixStatCache::scLRU;
+long long                       XrdPosixStatCache::scMem     = 0;
+long long                       XrdPosixStatCache::scMax     = 0;
+long long                       XrdPosixStatCache::numHits   = 0;
+long long                       XrdPosixStatCache::numMiss   = 0;
+long long                       XrdPosixStatCache::numNXHits = 0;
+int                             XrdPosixStatCache::scTTL     = 0;
+int                             XrdPosixStatCache::scNXTTL   = 0;
+bool                            XrdPosixStatCache::isOn      = false;
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+  
+void XrdPosixStatCache::Add(XrdCl::URL &url, const struct stat &sbuf)
+{
+   std::string key;
+   Entry info;
+
+// Construct the key, some URL's are not cacheable
+//
+   if (!isOn || !MakeKey(url, key)) return;
+
+// Fill out the entry and insert it
+//
+   info.mTime = sbuf.st_mtime;
+   info.size  = sbuf.st_size;
+   info.ino   = sbuf.st_ino;
+   info.rdev  = sbuf.st_rdev;
+   info.mode  = sbuf.st_mode;
+   info.isNX  = false;
+   Insert(key, info);
+}
+
+/******************************************************************************/
+
+void XrdPosixStatCache::Add(XrdCl::URL &dirUrl, const std::string &name,
+                            XrdCl::StatInfo &sInfo)
+{
+   std::string key;
+   Entry info;
+
+// Construct the key from the directory key and the entry name
+//
+   if (!isOn || !MakeKey(dirUrl, key)) return;
+   key += '/';
+   key += name;
+
+// Convert the stat information the same way a stat request would
+//
+   info.mode  = XrdPosixMap::Flags2Mode(&info.rdev, sInfo.GetFlags());
+   info.mTime = static_cast<time_t>(sInfo.GetModTime());
+   info.size  = static_cast<size_t>(sInfo.GetSize());
+   info.ino   = static_cast<ino_t>(strtoll(sInfo.GetId().c_str(), 0, 10));
+   info.isNX  = false;
+   Insert(key, info);
+}
+
+/******************************************************************************/
+/*                                 A d d N X                                  */
+/******************************************************************************/
+  
+void XrdPosixStatCache::AddNX(XrdCl::URL &url)
+{
+   std::string key;
+   Entry info;
+
+// Negative entries are only kept when they have a lifetime
+//
+   if (!isOn || scNXTTL <= 0 || !MakeKey(url, key)) return;
+
+// Insert the entry
+//
+   info.mTime = 0;
+   info.size  = 0;
+   info.ino   = 0;
+   info.rdev  = 0;
+   info.mode  = 0;
+   info.isNX  = true;
+   Insert(key, info);
+}
+
+/******************************************************************************/
+/*                                C o n f i g                                 */
+/******************************************************************************/
+  
+void XrdPosixStatCache::Config(long long maxMem, int ttl, int nxttl)
+{
+   XrdSysMutexHelper mHelp(scMutex);
+
+// Set the parameters. The cache is only enabled with memory and a lifetime.
+//
+   scMax   = maxMem;
+   scTTL   = ttl;
+   scNXTTL = nxttl;
+   isOn    = maxMem > 0 && ttl > 0;
+
+// Drop anything that no longer fits
+//
+   while(!scLRU.empty() && scMem > scMax) Erase(scMap.find(*scLRU.back()));
+}
+
+/******************************************************************************/
+/* Private:                        E r a s e                                  */
+/******************************************************************************/
+  
+void XrdPosixStatCache::Erase(EntryMap::iterator it)
+{
+// Remove the entry and account for it (the mutex must be held)
+//
+   scMem -= Size(it->first);
+   scLRU.erase(it->second.lruP);
+   scMap.erase(it);
+}
+  
+/******************************************************************************/
+/*                                   G e t                                    */
+/******************************************************************************/
+  
+int XrdPosixStatCache::Get(XrdCl::URL &url, struct stat &sbuf)
+{
+   std::string key;
+   EntryMap::iterator it;
+
+// Construct the key
+//
+   if (!isOn || !MakeKey(url, key)) return 0;
+
+// Find the entry, dropping it if it has expired
+//
+   XrdSysMutexHelper mHelp(scMutex);
+   it = scMap.find(key);
+   if (it == scMap.end()) {numMiss++; return 0;}
+   if (it->second.expT <= time(0)) {Erase(it); numMiss++; return 0;}
+
+// Move the entry to the front of the lru list
+//
+   scLRU.splice(scLRU.begin(), scLRU, it->second.lruP);
+
+// Handle negative entries
+//
+   if (it->second.isNX) {numNXHits++; errno = ENOENT; return -1;}
+
+// Fill out the stat buffer
+//
+   sbuf.st_size   = it->second.size;
+   sbuf.st_blocks = it->second.size/512+1;
+   sbuf.st_atime  = sbuf.st_mtime = sbuf.st_ctime = it->second.mTime;
+   sbuf.st_ino    = it->second.ino;
+   sbuf.st_rdev   = it->second.rdev;
+   sbuf.st_mode   = it->second.mode;
+   numHits++;
+   return 1;
+}
+
+/******************************************************************************/
+/* Private:                       I n s e r t                                 */
+/******************************************************************************/
+  
+void XrdPosixStatCache::Insert(const std::string &key, const Entry &info)
+{
+   EntryMap::iterator it;
+   int eSize = Size(key);
+
+// Entries that could never fit are not kept
+//
+   if (eSize > scMax) return;
+
+// Add or replace the entry and put it at the front of the lru list
+//
+   XrdSysMutexHelper mHelp(scMutex);
+   it = scMap.find(key);
+   if (it != scMap.end()) scLRU.erase(it->second.lruP);
+      else {it = scMap.insert(EntryMap::value_type(key, info)).first;
+            scMem += eSize;
+           }
+   it->second      = info;
+   it->second.expT = time(0) + (info.isNX ? scNXTTL : scTTL);
+   scLRU.push_front(&(it->first));
+   it->second.lruP = scLRU.begin();
+
+// Evict the least recently used entries until we are within bounds
+//
+   while(scMem > scMax) Erase(scMap.find(*scLRU.back()));
+}
+
+/******************************************************************************/
+/*                            I n v a l i d a t e                             */
+/******************************************************************************/
+  
+void XrdPosixStatCache::Invalidate(const char *path, bool subTree)
+{
+   if (isOn)
+      {XrdCl::URL url((std::string)path);
+       if (url.IsValid()) Invalidate(url, subTree);
+      }
+}
+
+/******************************************************************************/
+
+void XrdPosixStatCache::Invalidate(XrdCl::URL &url, bool subTree)
+{
+   EntryMap::iterator it;
+   std::string key, pfx;
+   std::string::size_type slash;
+
+// Construct the key
+//
+   if (!isOn || !MakeKey(url, key)) return;
+   XrdSysMutexHelper mHelp(scMutex);
+
+// Remove the entry itself
+//
+   if ((it = scMap.find(key)) != scMap.end()) Erase(it);
+
+// The parent directory changed as well (its mtime, at least)
+//
+   if ((slash = key.rfind('/')) != std::string::npos
+   &&  (it = scMap.find(key.substr(0, slash))) != scMap.end()) Erase(it);
+
+// Remove everything underneath a directory that was renamed or removed
+//
+   if (subTree)
+      {pfx = key + '/';
+       it = scMap.lower_bound(pfx);
+       while(it != scMap.end() && !it->first.compare(0, pfx.size(), pfx))
+            Erase(it++);
+      }
+}
+
+/******************************************************************************/
+/* Private:                      M a k e K e y                                */
+/******************************************************************************/
+  
+bool XrdPosixStatCache::MakeKey(XrdCl::URL &url, std::string &key)
+{
+   const std::string &path = url.GetPath();
+   std::string::size_type i;
+
+// Requests for a server's local view of a file are never cached
+//
+   if (url.GetParams().count("oss.lcl")) return false;
+
+// The key is the host id followed by the path with redundant slashes removed
+//
+   key = url.GetHostId();
+   key.reserve(key.size() + path.size() + 1);
+   for (i = 0; i < path.size(); i++)
+       {if (path[i] == '/' && key[key.size()-1] == '/') continue;
+        if (i == 0 && path[i] != '/') key += '/';
+        key += path[i];
+       }
+   if (key[key.size()-1] == '/') key.erase(key.size()-1);
+   return true;
+}
+
+/******************************************************************************/
+/* Private:                         S i z e                                   */
+/******************************************************************************/
+  
+int XrdPosixStatCache::Size(const std::string &key)
+{
+// Approximate the memory used: the key, the map node and the lru node
+//
+   return static_cast<int>(key.size() + sizeof(EntryMap::value_type)
+                         + sizeof(const std::string*) + 64);
+}
+  
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+  
+void XrdPosixStatCache::Stats(long long &hits, long long &miss,
+                              long long &nxhits)
+{
+   XrdSysMutexHelper mHelp(scMutex);
+
+   hits   = numHits;
+   miss   = numMiss;
+   nxhits = numNXHits;
+}
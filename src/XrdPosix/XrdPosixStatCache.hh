@@ -0,0 +1,112 @@
+#ifndef __XRDPOSIXSTATCACHE_HH__
+#define __XRDPOSIXSTATCACHE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d P o s i x S t a t C a c h e                      */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <list>
+#include <map>
+#include <string>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+namespace XrdCl {class StatInfo; class URL;}
+
+/******************************************************************************/
+/*                     X r d P o s i x S t a t C a c h e                      */
+/******************************************************************************/
+
+// The stat cache holds recent stat results, positive and negative, keyed by
+// the host id and path of the target URL. Only the fields that come from the
+// origin (size, mtime, inode, rdev and mode) are kept; Get() overlays them on
+// a stat buffer the caller has already initialized. Entries expire after a
+// fixed time and are removed whenever this process changes the object they
+// describe. The cache is bounded by the approximate amount of memory used by
+// its entries and evicts the least recently used ones past that bound.
+  
+class XrdPosixStatCache
+{
+public:
+
+static void Add(XrdCl::URL &url, const struct stat &sbuf);
+
+static void Add(XrdCl::URL &dirUrl, const std::string &name,
+                XrdCl::StatInfo &sInfo);
+
+static void AddNX(XrdCl::URL &url);
+
+static void Config(long long maxMem, int ttl, int nxttl);
+
+static bool Enabled() {return isOn;}
+
+static int  Get(XrdCl::URL &url, struct stat &sbuf);
+
+static void Invalidate(const char *path, bool subTree=false);
+
+static void Invalidate(XrdCl::URL &url,  bool subTree=false);
+
+static void Stats(long long &hits, long long &miss, long long &nxhits);
+
+            XrdPosixStatCache() {}
+           ~XrdPosixStatCache() {}
+
+private:
+
+struct Entry
+      {std::list<const std::string*>::iterator lruP;
+       time_t  expT;
+       time_t  mTime;
+       size_t  size;
+       ino_t   ino;
+       dev_t   rdev;
+       mode_t  mode;
+       bool    isNX;
+      };
+
+typedef std::map<std::string, Entry> EntryMap;
+
+static void Erase(EntryMap::iterator it);
+static void Insert(const std::string &key, const Entry &info);
+static bool MakeKey(XrdCl::URL &url, std::string &key);
+static int  Size(const std::string &key);
+
+static XrdSysMutex                   scMutex;
+static EntryMap                      scMap;
+static std::list<const std::string*> scLRU;
+static long long                     scMem;
+static long long                     scMax;
+static long long                     numHits;
+static long long                     numMiss;
+static long long                     numNXHits;
+static int                           scTTL;
+static int                           scNXTTL;
+static bool                          isOn;
+};
+#endif
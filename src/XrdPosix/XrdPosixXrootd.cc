@@ -65,6 +65,7 @@
 #include "XrdPosix/XrdPosixFileRH.hh"
 #include "XrdPosix/XrdPosixMap.hh"
 #include "XrdPosix/XrdPosixPrepIO.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
 #include "XrdPosix/XrdPosixTrace.hh"
 #include "XrdPosix/XrdPosixXrootd.hh"
 #include "XrdPosix/XrdPosixXrootdPath.hh"
@@ -224,12 +225,17 @@ XrdPosixXrootd::~XrdPosixXrootd()
 int XrdPosixXrootd::Access(const char *path, int amode)
 {
    XrdPosixAdmin admin(path);
+   struct stat   stBuf;
    mode_t stMode;
    bool   aOK = true;
+   int    rc;
 
-// Issue the stat and verify that all went well
+// Use a recent stat result if we have one, otherwise issue the stat
 //
-   if (!admin.Stat(&stMode)) return -1;
+   if ((rc = XrdPosixStatCache::Get(admin.Url, stBuf)))
+      {if (rc < 0) return -1;
+       stMode = stBuf.st_mode;
+      } else if (!admin.Stat(&stMode)) return -1;
 
 // Translate the mode bits
 //
@@ -261,6 +267,12 @@ int XrdPosixXrootd::Close(int fildes)
    if (!(fP = XrdPosixObject::ReleaseFile(fildes)))
       {errno = EBADF; return -1;}
 
+// Any stat information we may have cached for an updated or created file is
+// now stale
+//
+   if (fP->isUpdate() || fP->isCreate())
+      XrdPosixStatCache::Invalidate(fP->Origin());
+
 // Close the file if there is no active I/O (possible caching). Delete the
 // object if the close was successful (it might not be).
 //
@@ -385,9 +397,10 @@ int XrdPosixXrootd::Fsync(int fildes)
 //
    if (!(fp = XrdPosixObject::File(fildes))) return -1;
 
-// Do the sync
+// Do the sync. Anything a stat returned before this point may now be stale.
 //
    if (fp->XCio->Sync() < 0) return Fault(fp, errno);
+   XrdPosixStatCache::Invalidate(fp->Origin());
    fp->UnLock();
    return 0;
 }
@@ -422,6 +435,7 @@ int XrdPosixXrootd::Ftruncate(int fildes, off_t offset)
 // Do the trunc
 //
    if (fp->XCio->Trunc(offset) < 0) return Fault(fp, errno);
+   XrdPosixStatCache::Invalidate(fp->Origin());
    fp->UnLock();
    return 0;
 }
@@ -514,10 +528,12 @@ int XrdPosixXrootd::Mkdir(const char *path, mode_t mode)
 
 // Issue the mkdir
 //
-   return XrdPosixMap::Result(admin.Xrd.MkDir(admin.Url.GetPathWithParams(),
-                                              flags,
-                                              XrdPosixMap::Mode2Access(mode))
-                                             );
+   int rc = XrdPosixMap::Result(admin.Xrd.MkDir(admin.Url.GetPathWithParams(),
+                                                flags,
+                                                XrdPosixMap::Mode2Access(mode))
+                                               );
+   XrdPosixStatCache::Invalidate(admin.Url);
+   return rc;
 }
 
 /******************************************************************************/
@@ -559,6 +575,7 @@ int XrdPosixXrootd::Open(const char *path, int oflags, mode_t mode,
                                    : XrdCl::OpenFlags::Delete);
        XOflags |= XrdCl::OpenFlags::MakePath;
        XOmode   = XrdPosixMap::Mode2Access(mode);
+       Opts    |= XrdPosixFile::isCrte;
       }
       else if (oflags & O_TRUNC && Opts & XrdPosixFile::isUpdt)
               XOflags |= XrdCl::OpenFlags::Delete;
@@ -574,6 +591,11 @@ int XrdPosixXrootd::Open(const char *path, int oflags, mode_t mode,
 //
    if (!aOK) {delete fp; return -1;}
 
+// Creating or updating the file makes any stat information we have stale
+//
+   if (Opts & (XrdPosixFile::isUpdt | XrdPosixFile::isCrte))
+      XrdPosixStatCache::Invalidate(path);
+
 // If we have a cache, then issue a prepare as the cache may want to defer the
 // open request ans we have a lot more work to do.
 //
@@ -996,8 +1018,14 @@ int XrdPosixXrootd::Rename(const char *oldpath, const char *newpath)
 
 // Issue the rename
 //
-  return XrdPosixMap::Result(admin.Xrd.Mv(admin.Url.GetPathWithParams(),
-                             newUrl.GetPathWithParams()));
+  int rc = XrdPosixMap::Result(admin.Xrd.Mv(admin.Url.GetPathWithParams(),
+                               newUrl.GetPathWithParams()));
+
+// Both names (and anything underneath them) have changed
+//
+  XrdPosixStatCache::Invalidate(admin.Url, true);
+  XrdPosixStatCache::Invalidate(newUrl,    true);
+  return rc;
 }
 
 /******************************************************************************/
@@ -1039,7 +1067,9 @@ int XrdPosixXrootd::Rmdir(const char *path)
 
 // Issue the rmdir
 //
-   return XrdPosixMap::Result(admin.Xrd.RmDir(admin.Url.GetPathWithParams()));
+   int rc = XrdPosixMap::Result(admin.Xrd.RmDir(admin.Url.GetPathWithParams()));
+   XrdPosixStatCache::Invalidate(admin.Url, true);
+   return rc;
 }
 
 /******************************************************************************/
@@ -1096,9 +1126,17 @@ int XrdPosixXrootd::Stat(const char *path, struct stat *buf)
       if (rc < 0) {errno = -rc; return -1;}
      }
 
-// Issue the stat and verify that all went well
+// Check if we have a recent answer for this object
 //
-   if (!admin.Stat(&stFlags, &stMtime, &stSize, &stId, &stRdev)) return -1;
+   int rc = XrdPosixStatCache::Get(admin.Url, *buf);
+   if (rc) return (rc > 0 ? 0 : -1);
+
+// Issue the stat and verify that all went well. Remember missing objects.
+//
+   if (!admin.Stat(&stFlags, &stMtime, &stSize, &stId, &stRdev))
+      {if (errno == ENOENT) XrdPosixStatCache::AddNX(admin.Url);
+       return -1;
+      }
 
 // Return what little we can
 //
@@ -1108,6 +1146,7 @@ int XrdPosixXrootd::Stat(const char *path, struct stat *buf)
    buf->st_ino    = stId;
    buf->st_rdev   = stRdev;
    buf->st_mode   = stFlags;
+   XrdPosixStatCache::Add(admin.Url, *buf);
    return 0;
 }
 
@@ -1259,7 +1298,9 @@ int XrdPosixXrootd::Truncate(const char *path, off_t Size)
 // Issue the truncate to the origin
 //
    std::string urlp = admin.Url.GetPathWithParams();
-   return XrdPosixMap::Result(admin.Xrd.Truncate(urlp,tSize));
+   int rc = XrdPosixMap::Result(admin.Xrd.Truncate(urlp,tSize));
+   XrdPosixStatCache::Invalidate(admin.Url);
+   return rc;
 }
 
 /******************************************************************************/
@@ -1284,7 +1325,9 @@ int XrdPosixXrootd::Unlink(const char *path)
 
 // Issue the UnLink
 //
-   return XrdPosixMap::Result(admin.Xrd.Rm(admin.Url.GetPathWithParams()));
+   int rc = XrdPosixMap::Result(admin.Xrd.Rm(admin.Url.GetPathWithParams()));
+   XrdPosixStatCache::Invalidate(admin.Url);
+   return rc;
 }
 
 /******************************************************************************/
@@ -459,6 +459,7 @@ int XrdPssSys::ConfigXeq(char *var, XrdOucStream &Config)
    TS_Xeq("origin",        xorig);
    TS_Xeq("permit",        xperm);
    TS_PSX("setopt",        ParseSet);
+   TS_PSX("statcache",     ParseStat);
    TS_PSX("trace",         ParseTrace);
 
    // Copy the variable name as this may change because it points to an
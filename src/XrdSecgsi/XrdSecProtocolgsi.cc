@@ -158,6 +158,7 @@ XrdSecgsiAuthzKey_t XrdSecProtocolgsi::AuthzKey = 0;
 int    XrdSecProtocolgsi::AuthzCertFmt = -1;
 int    XrdSecProtocolgsi::GMAPCacheTimeOut = -1;
 int    XrdSecProtocolgsi::AuthzCacheTimeOut = 43200;  // 12h, default
+int    XrdSecProtocolgsi::VChainCacheTimeOut = 3600;  // 1h, default
 String XrdSecProtocolgsi::SrvAllowedNames;
 int    XrdSecProtocolgsi::VOMSAttrOpt = 1;
 XrdSecgsiAuthz_t XrdSecProtocolgsi::VOMSFun = 0;
@@ -179,6 +180,7 @@ XrdSutCache  XrdSecProtocolgsi::cacheCert(8,13); // Server certificates info cac
 XrdSutCache  XrdSecProtocolgsi::cachePxy(8,13);  // Client proxies cache (Fibonacci-based sizes)
 XrdSutCache  XrdSecProtocolgsi::cacheGMAPFun; // Entries mapped by GMAPFun (default size 144)
 XrdSutCache  XrdSecProtocolgsi::cacheAuthzFun; // Entities filled by AuthzFun (default size 144)
+XrdSutCache  XrdSecProtocolgsi::cacheVChain; // Verified client chains (default size 144)
 //
 // Services
 XrdOucGMap *XrdSecProtocolgsi::servGMap = 0; // Grid map service
@@ -191,6 +193,10 @@ GSIStack<XrdCryptoX509Crl>  XrdSecProtocolgsi::stackCRL; // Stack of CRL in use
 time_t XrdSecProtocolgsi::lastGMAPCheck = -1; // Time of last check
 XrdSysMutex XrdSecProtocolgsi::mutexGMAP;  // Mutex to control GMAP reloads
 //
+// Verified chain cache control vars
+time_t XrdSecProtocolgsi::lastVChainTrim = -1; // Time of last purge
+XrdSysMutex XrdSecProtocolgsi::mutexVChain;  // Mutex to control the purges
+//
 // Running options / settings
 int  XrdSecProtocolgsi::Debug       = 0; // [CS] Debug level
 bool XrdSecProtocolgsi::Server      = 1; // [CS] If server mode 
@@ -799,6 +805,10 @@ char *XrdSecProtocolgsi::Init(gsiOptions opt, XrdOucErrInfo *erp)
          GMAPCacheTimeOut = opt.gmapto;
          DEBUG("grid-map cache entries expire after "<<GMAPCacheTimeOut<<" secs");
       }
+      //
+      // Expiration of verified chain cache entries (0 disables the cache)
+      VChainCacheTimeOut = (opt.vchainto > 0) ? opt.vchainto : 0;
+      DEBUG("verified chain cache entries expire after "<<VChainCacheTimeOut<<" secs");
 
       //
       // Request for proxy export for authorization
@@ -1839,7 +1849,9 @@ int XrdSecProtocolgsi::Authenticate(XrdSecCredentials *cred,
          Entity.moninfo = strdup(hs->Chain->EECname());
       }
 
-      if (VOMSAttrOpt > 0) {
+      if (VOMSAttrOpt > 0 && hs->ChainOK && LoadVChain(Entity)) {
+         DEBUG("VOMS attributes taken from the verified chain cache");
+      } else if (VOMSAttrOpt > 0) {
          if (VOMSFun) {
             // Fill the information needed by the external function
             if (VOMSCertFmt == 1) {
@@ -1875,6 +1887,9 @@ int XrdSecProtocolgsi::Authenticate(XrdSecCredentials *cred,
          NOTIFY("VOMS: Entity.endorsements: "<< (Entity.endorsements ? Entity.endorsements : "<none>"));
       }
 
+      // Remember that this chain was verified, together with the VOMS info
+      if (!hs->ChainOK) SaveVChain(Entity);
+
       // Here prepare/extract the information for authorization
       spxy = "";
       bpxy = 0;
@@ -2211,6 +2226,173 @@ int XrdSecProtocolgsi::ExtractVOMS(X509Chain *c, XrdSecEntity &ent)
    return (!ent.vorg ? -1 : 0);
 }
 
+/******************************************************************************/
+/*                V e r i f i e d   C h a i n   C a c h e                     */
+/******************************************************************************/
+
+//_____________________________________________________________________________
+static bool VChainCheck(XrdSutCacheEntry *e, void *a) {
+   // A verified chain entry is good until the expiration time saved in buf2
+   time_t ts_ref = (time_t)(*((XrdSutCacheArg_t *)a)).arg1;
+   kXR_int32 expire = 0;
+   if (!e || e->status != kCE_ok || e->buf2.len != sizeof(expire)) return false;
+   memcpy(&expire, e->buf2.buf, sizeof(expire));
+   return (expire > ts_ref);
+}
+
+//_____________________________________________________________________________
+bool XrdSecProtocolgsi::CheckVChain(XrdSutBucket *bck)
+{
+   // Check whether the client chain in bucket 'bck' (already parsed into
+   // hs->Chain) has been verified recently. The chain is identified by a
+   // digest of its exported form, which covers the certificate signatures.
+   // Entries expire with the first certificate in the chain or after
+   // VChainCacheTimeOut secs, whichever comes first. Revocation is checked
+   // again against the current CRL, as this may have been refreshed.
+   // The fingerprint is saved in hs->ChainFP; returns true if the chain
+   // does not need to be verified again.
+   EPNAME("CheckVChain");
+
+   hs->ChainFP = "";
+   hs->ChainOK = 0;
+   if (VChainCacheTimeOut <= 0 || !bck || bck->size <= 0) return 0;
+
+   // Compute the fingerprint
+   XrdCryptoMsgDigest *md = sessionCF->MsgDigest("sha256");
+   if (!md) return 0;
+   md->Update(bck->buffer, bck->size);
+   md->Final();
+   hs->ChainFP = md->AsHexString();
+   delete md;
+   if (hs->Chain->CAhash()) {
+      hs->ChainFP += ':';
+      hs->ChainFP += hs->Chain->CAhash();
+   }
+
+   // Look it up
+   XrdSutCacheEntry *cent = cacheVChain.Get(hs->ChainFP.c_str());
+   if (!cent) return 0;
+   XrdSutCERef ceref;
+   ceref.Set(&(cent->rwmtx));
+   kXR_int32 expire = 0;
+   if (cent->status == kCE_ok && cent->buf2.len == sizeof(expire))
+      memcpy(&expire, cent->buf2.buf, sizeof(expire));
+   ceref.UnLock();
+   if (expire <= hs->TimeStamp) return 0;
+
+   // Put the chain in order, as Verify() would have done
+   if (hs->Chain->Reorder() != 0) return 0;
+
+   // Check the current CRL, if any
+   if (hs->Crl) {
+      XrdCryptoX509 *xc = hs->Chain->Begin();
+      while (xc) {
+         if (xc->type != XrdCryptoX509::kCA &&
+             hs->Crl->IsRevoked(xc->SerialNumberString().c_str(), hs->TimeStamp)) {
+            NOTIFY("certificate in cached chain has been revoked: "<<xc->Subject());
+            return 0;
+         }
+         xc = hs->Chain->Next();
+      }
+   }
+
+   hs->ChainOK = 1;
+   return 1;
+}
+
+//_____________________________________________________________________________
+bool XrdSecProtocolgsi::LoadVChain(XrdSecEntity &ent)
+{
+   // Fill the VOMS related fields of 'ent' from the verified chain cache
+   // entry for the current chain; return false if not available.
+
+   if (hs->ChainFP.length() <= 0) return 0;
+
+   XrdSutCacheEntry *cent = cacheVChain.Get(hs->ChainFP.c_str());
+   if (!cent) return 0;
+   XrdSutCERef ceref;
+   ceref.Set(&(cent->rwmtx));
+   if (cent->status != kCE_ok || !cent->buf1.buf || cent->buf1.len <= 0) return 0;
+
+   // The fields are stored as a sequence of null-terminated strings
+   char **fld[4] = {&ent.vorg, &ent.role, &ent.grps, &ent.endorsements};
+   const char *p = cent->buf1.buf;
+   for (int i = 0; i < 4; i++) {
+      SafeFree(*fld[i]);
+      if (*p) *fld[i] = strdup(p);
+      p += strlen(p) + 1;
+   }
+   return 1;
+}
+
+//_____________________________________________________________________________
+void XrdSecProtocolgsi::SaveVChain(XrdSecEntity &ent)
+{
+   // Save the current chain, just verified, in the verified chain cache
+   // together with the VOMS related fields of 'ent'.
+   EPNAME("SaveVChain");
+
+   if (hs->ChainFP.length() <= 0) return;
+
+   // The entry cannot outlive any certificate in the chain, nor the VOMS
+   // attributes stored with it their attribute certificate
+   XrdCryptoX509GetVOMSExpire_t X509GetVOMSExpire = 0;
+   if (ent.vorg || ent.role || ent.grps || ent.endorsements)
+      X509GetVOMSExpire = sessionCF->X509GetVOMSExpire();
+   kXR_int32 expire = hs->TimeStamp + VChainCacheTimeOut;
+   XrdCryptoX509 *xc = hs->Chain->Begin();
+   while (xc) {
+      if (xc->type != XrdCryptoX509::kCA) {
+         if (xc->NotAfter() < expire) expire = xc->NotAfter();
+         time_t acexpire;
+         int rc = X509GetVOMSExpire ? (*X509GetVOMSExpire)(xc, acexpire) : 1;
+         if (rc < 0) return;
+         if (rc == 0 && acexpire < expire) expire = acexpire;
+      }
+      xc = hs->Chain->Next();
+   }
+   if (expire <= hs->TimeStamp) return;
+
+   // Expired entries are returned write-locked so that we refresh them
+   bool rdlock = false;
+   XrdSutCacheArg_t arg = {hs->TimeStamp, 0, 0, 0};
+   XrdSutCacheEntry *cent = cacheVChain.Get(hs->ChainFP.c_str(), rdlock,
+                                            VChainCheck, (void *) &arg);
+   if (!cent) return;
+   XrdSutCERef ceref;
+   ceref.Set(&(cent->rwmtx));
+   // Still valid, or someone else is filling it
+   if (rdlock) return;
+
+   // Store the fields as a sequence of null-terminated strings
+   const char *fld[4] = {ent.vorg, ent.role, ent.grps, ent.endorsements};
+   int i, len = 0;
+   for (i = 0; i < 4; i++) len += (fld[i] ? strlen(fld[i]) : 0) + 1;
+   char *vbuf = new char[len], *p = vbuf;
+   for (i = 0; i < 4; i++) {
+      if (fld[i]) { strcpy(p, fld[i]); p += strlen(fld[i]); }
+      *p++ = 0;
+   }
+   cent->buf1.SetBuf(vbuf, len);
+   delete[] vbuf;
+   cent->buf2.SetBuf((const char *) &expire, sizeof(expire));
+   cent->mtime = hs->TimeStamp;
+   cent->status = kCE_ok;
+   ceref.UnLock();
+   DEBUG("saved chain "<<hs->ChainFP<<" (expires in "<<(expire - hs->TimeStamp)<<" secs)");
+
+   // Every VChainCacheTimeOut secs drop the chains which have expired, so that
+   // chains seen only once do not pile up
+   if (mutexVChain.CondLock()) {
+      if (hs->TimeStamp - lastVChainTrim >= VChainCacheTimeOut) {
+         lastVChainTrim = hs->TimeStamp;
+         int left = cacheVChain.Trim(VChainCheck, (void *) &arg);
+         DEBUG("purged expired chains: "<<left<<" left in cache");
+      }
+      mutexVChain.UnLock();
+   }
+}
+
 /******************************************************************************/
 /*                        E n a b l e T r a c i n g                           */
 /******************************************************************************/
@@ -2278,6 +2460,7 @@ void gsiOptions::Print(XrdOucTrace *t)
       } else {
          if (authzfunparms) POPTS(t, " Authorization function parms: ignored (no authz function defined)");
       }
+      POPTS(t, " Verified chain cache entries expiration (secs): " << vchainto);
       POPTS(t, " Client proxy availability in XrdSecEntity.endorsement: "<< authzpxy);
       POPTS(t, " VOMS option: "<< vomsat);
       if (vomsfun) {
@@ -2526,6 +2709,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       //              [-authzfun:<authz_function>]
       //              [-authzfunparms:<authz_function_init_parameters>]
       //              [-authzto:<authz_cache_entry_validity_in_secs>]
+      //              [-vchainto:<verified_chain_cache_entry_validity_in_secs>]
       //              [-gmapto:<grid_map_cache_entry_validity_in_secs>]
       //              [-gmapopt:<grid_map_check_option>]
       //              [-dlgpxy:<proxy_req_option>]
@@ -2560,6 +2744,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       int ogmap = 1;
       int gmapto = 600;
       int authzto = -1;
+      int vchainto = 3600;
       int dlgpxy = 0;
       int authzpxy = 0;
       int vomsat = 1;
@@ -2607,6 +2792,8 @@ char *XrdSecProtocolgsiInit(const char mode,
                authzfunparms = (const char *)(op+15);
             } else if (!strncmp(op, "-authzto:",9)) {
                authzto = atoi(op+9);
+            } else if (!strncmp(op, "-vchainto:",10)) {
+               vchainto = atoi(op+10);
             } else if (!strncmp(op, "-gmapto:",8)) {
                gmapto = atoi(op+8);
             } else if (!strncmp(op, "-dlgpxy:",8)) {
@@ -2647,6 +2834,7 @@ char *XrdSecProtocolgsiInit(const char mode,
       opts.ogmap = ogmap;
       opts.gmapto = gmapto;
       opts.authzto = authzto;
+      opts.vchainto = vchainto;
       opts.dlgpxy = (dlgpxy >= 0 && dlgpxy <= 1) ? dlgpxy : 0;
       opts.authzpxy = authzpxy;
       opts.vomsat = vomsat;
@@ -3565,13 +3753,18 @@ int XrdSecProtocolgsi::ServerDoCert(XrdSutBuffer *br,  XrdSutBuffer **bm,
       return -1;
    }
    //
-   // Verify the chain
-   x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
-   XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
-   if (!(hs->Chain->Verify(ecode, &vopt))) {
-      cmsg = "certificate chain verification failed: ";
-      cmsg += hs->Chain->LastError();
-      return -1;
+   // Verify the chain, unless we have verified the very same one recently:
+   // in such a case we only need to check it against the current CRL
+   if (CheckVChain(bck)) {
+      DEBUG("chain found in the verified chain cache");
+   } else {
+      x509ChainVerifyOpt_t vopt = {0,static_cast<int>(hs->TimeStamp),-1,hs->Crl};
+      XrdCryptoX509Chain::EX509ChainErr ecode = XrdCryptoX509Chain::kNone;
+      if (!(hs->Chain->Verify(ecode, &vopt))) {
+         cmsg = "certificate chain verification failed: ";
+         cmsg += hs->Chain->LastError();
+         return -1;
+      }
    }
 
    //
@@ -187,6 +187,7 @@ public:
    char  *authzfun;// [s] file with the function to fill entities [0]
    char  *authzfunparms;// [s] parameters for the function to fill entities [0]
    int    authzto; // [s] validity in secs of authz cache entries [-1 => unlimited]
+   int    vchainto; // [s] validity in secs of verified chain cache entries [3600; 0 => no cache]
    int    ogmap;  // [s] gridmap file checking option
    int    dlgpxy; // [c] explicitely ask the creation of a delegated proxy; default 0
                   // [s] ask client for proxies; default: do not accept delegated proxies
@@ -209,6 +210,7 @@ public:
                   proxy = 0; valid = 0; deplen = 0; bits = 512;
                   gridmap = 0; gmapto = 600;
                   gmapfun = 0; gmapfunparms = 0; authzfun = 0; authzfunparms = 0; authzto = -1;
+                  vchainto = 3600;
                   ogmap = 1; dlgpxy = 0; sigpxy = 1; srvnames = 0;
                   exppxy = 0; authzpxy = 0;
                   vomsat = 1; vomsfun = 0; vomsfunparms = 0; moninfo = 0; hashcomp = 1; trustdns = true; }
@@ -335,6 +337,7 @@ private:
    static XrdSecgsiAuthzKey_t AuthzKey; 
    static int              AuthzCertFmt; 
    static int              AuthzCacheTimeOut;
+   static int              VChainCacheTimeOut;
    static int              PxyReqOpts;
    static int              AuthzPxyWhat;
    static int              AuthzPxyWhere;
@@ -359,6 +362,7 @@ private:
    static XrdSutCache   cachePxy;  // Client proxies cache; 
    static XrdSutCache   cacheGMAPFun; // Cache for entries mapped by GMAPFun
    static XrdSutCache   cacheAuthzFun; // Cache for entities filled by AuthzFun
+   static XrdSutCache   cacheVChain; // Verified client chains and their VOMS info
    //
    // Services
    static XrdOucGMap      *servGMap;  // Grid mapping service 
@@ -371,6 +375,10 @@ private:
    static time_t           lastGMAPCheck; // time of last check on GMAP
    static XrdSysMutex      mutexGMAP;     // mutex to control GMAP reloads
    //
+   // Verified chain cache control vars
+   static time_t           lastVChainTrim; // time of last purge of expired chains
+   static XrdSysMutex      mutexVChain;    // mutex to control the purges
+   //
    // Running options / settings
    static int              Debug;          // [CS] Debug level
    static bool             Server;         // [CS] If server mode 
@@ -480,6 +488,11 @@ private:
 
    // VOMS parsing
    int ExtractVOMS(X509Chain *c, XrdSecEntity &ent);
+
+   // Verified chain cache handling
+   bool CheckVChain(XrdSutBucket *bck);
+   bool LoadVChain(XrdSecEntity &ent);
+   void SaveVChain(XrdSecEntity &ent);
 };
 
 class gsiHSVars {
@@ -502,12 +515,15 @@ public:
    int               Options;       // Handshake options;
    int               HashAlg;       // Hash algorithm of peer hash name;
    XrdSutBuffer     *Parms;         // Buffer with server parms on first iteration 
+   String            ChainFP;       // Fingerprint of the client chain (servers)
+   bool              ChainOK;       // Chain found in the verified chain cache
 
    gsiHSVars() { Iter = 0; TimeStamp = -1; CryptoMod = "";
                  RemVers = -1; Rcip = 0;
                  Cbck = 0;
                  ID = ""; Cref = 0; Pent = 0; Chain = 0; Crl = 0; PxyChain = 0;
-                 RtagOK = 0; Tty = 0; LastStep = 0; Options = 0; HashAlg = 0; Parms = 0;}
+                 RtagOK = 0; Tty = 0; LastStep = 0; Options = 0; HashAlg = 0; Parms = 0;
+                 ChainFP = ""; ChainOK = 0;}
 
    ~gsiHSVars() { SafeDelete(Cref);
                   if (Options & kOptsDelChn) {
@@ -35,6 +35,7 @@
 #include <string.h>
 
 #include <sys/types.h>
+#include <sys/time.h>
 #include <pwd.h>
 
 #include "XrdOuc/XrdOucString.hh"
@@ -49,6 +50,8 @@
 #include "XrdCrypto/XrdCryptoX509Req.hh"
 #include "XrdCrypto/XrdCryptoX509Chain.hh"
 #include "XrdCrypto/XrdCryptoX509Crl.hh"
+#include "XrdCrypto/XrdCryptoCipher.hh"
+#include "XrdCrypto/XrdCryptoMsgDigest.hh"
 
 #include "XrdCrypto/XrdCryptosslAux.hh"
 
@@ -74,6 +77,7 @@ int          CAnum = 0;
 XrdOucString CAcert[5];
 int          Dbg = 0;
 int          Help = 0;
+int          Bench = 0;
 
 //
 // For error logging and tracing
@@ -105,6 +109,63 @@ static void pline(const char *t)
    printf("\n");
 }
 
+static double tnow()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+//
+// Server side cost of a handshake with the client chain in 'cbck': cipher
+// agreement (if 'refcip' is defined) plus either a full chain verification
+// or, if 'cached', the fingerprint computed for chains found in the verified
+// chain cache
+static bool hsloop(int n, bool cached, XrdCryptoX509 *xCA, XrdSutBucket *cbck,
+                   XrdCryptoCipher *refcip, double &rate)
+{
+   XrdCryptoX509ParseBucket_t ParseBucket = gCryptoFactory->X509ParseBucket();
+   int lpub = 0;
+   char *spub = (refcip) ? refcip->Public(lpub) : 0;
+   bool ok = 1;
+   double t0 = tnow();
+   for (int i = 0; i < n; i++) {
+      // Client and server finalize the session cipher
+      if (spub) {
+         XrdCryptoCipher *ccip = gCryptoFactory->Cipher(0, spub, lpub, "aes-128-cbc");
+         if (!ccip) return 0;
+         int lcpub = 0;
+         char *cpub = ccip->Public(lcpub);
+         XrdCryptoCipher *scip = gCryptoFactory->Cipher(*refcip);
+         ok = (scip && scip->Finalize(cpub, lcpub, "aes-128-cbc"));
+         delete[] cpub;
+         delete ccip;
+         delete scip;
+         if (!ok) return 0;
+      }
+      // Import and check the client chain
+      XrdCryptogsiX509Chain *ch = new XrdCryptogsiX509Chain(xCA, gCryptoFactory);
+      (*ParseBucket)(cbck, ch);
+      if (cached) {
+         XrdCryptoMsgDigest *md = gCryptoFactory->MsgDigest("sha256");
+         md->Update(cbck->buffer, cbck->size);
+         md->Final();
+         ok = (md->AsHexString() != 0 && ch->Reorder() == 0);
+         delete md;
+      } else {
+         XrdCryptoX509Chain::EX509ChainErr ecod = XrdCryptoX509Chain::kNone;
+         x509ChainVerifyOpt_t vopt = { kOptsRfc3820, 0, -1, 0};
+         ok = ch->Verify(ecod, &vopt);
+      }
+      ch->Cleanup(1);
+      delete ch;
+      if (!ok) return 0;
+   }
+   rate = n / (tnow() - t0);
+   if (spub) delete[] spub;
+   return 1;
+}
+
 static void printHelp()
 {
    printf(" \n");
@@ -120,10 +181,12 @@ static void printHelp()
    printf("      X509_CERT_DIR   [/etc/grid-security/certificates/] CA certificates and CRL directories\n");
    printf(" \n");
    printf(" Usage:\n");
-   printf("      xrdgsitest [-v,--verbose] [-h,--help] \n");
+   printf("      xrdgsitest [-v,--verbose] [-h,--help] [-b,--bench <n>]\n");
    printf(" \n");
    printf("      -h, --help             Print this screen\n");
    printf("      -v, --verbose          Dump all details\n");
+   printf("      -b, --bench <n>        Time <n> server side handshakes, with and without\n");
+   printf("                             the verified chain cache\n");
    printf(" \n");
    printf(" The output is a list of PASSED/FAILED test, interleaved with details when the verbose option\n");
    printf(" is chosen.\n");
@@ -145,6 +208,9 @@ int main( int argc, char **argv )
       if (!strcmp(argv[i], "-vv")) Dbg = 2;
       // Help
       if (!strcmp(argv[i], "-h") || !strcmp(argv[i], "--help")) Help = 1;
+      // Handshake benchmark
+      if ((!strcmp(argv[i], "-b") || !strcmp(argv[i], "--bench")) && i+1 < argc)
+         Bench = atoi(argv[++i]);
    }
 
    // Print help if required
@@ -517,6 +583,23 @@ int main( int argc, char **argv )
       pdots("Loading CA1 crl", 0);
    }
 
+   //
+   if (Bench > 0) {
+      pline("");
+      pline("Handshake benchmark");
+      XrdCryptoCipher *refcip = gCryptoFactory->Cipher(0,0,0);
+      if (!refcip) pdots("Creating reference cipher (timing chain checks only)", 0);
+      double rfull = 0, rcached = 0;
+      bool ok = hsloop(Bench, 0, xCA[nCA], chainbck, refcip, rfull);
+      if (ok) ok = hsloop(Bench, 1, xCA[nCA], chainbck, refcip, rcached);
+      pdots("Handshake benchmark", ok);
+      if (ok) {
+         printf("|| full chain verification:  %10.1f handshakes/s\n", rfull);
+         printf("|| verified chain cache hit: %10.1f handshakes/s\n", rcached);
+      }
+      delete refcip;
+   }
+
    pline("");
    exit(0);
 }
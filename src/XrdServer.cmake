@@ -33,6 +33,7 @@ add_library(
   XrdXrootd/XrdXrootdMonFile.cc         XrdXrootd/XrdXrootdMonFile.hh
   XrdXrootd/XrdXrootdMonFMap.cc         XrdXrootd/XrdXrootdMonFMap.hh
   XrdXrootd/XrdXrootdMonitor.cc         XrdXrootd/XrdXrootdMonitor.hh
+  XrdXrootd/XrdXrootdMonSender.cc       XrdXrootd/XrdXrootdMonSender.hh
 
   XrdXrootd/XrdXrootdPio.cc             XrdXrootd/XrdXrootdPio.hh
   XrdXrootd/XrdXrootdPrepare.cc         XrdXrootd/XrdXrootdPrepare.hh
@@ -113,6 +114,7 @@ add_library(
   XrdOss/XrdOssSpace.cc        XrdOss/XrdOssSpace.hh
   XrdOss/XrdOssStage.cc        XrdOss/XrdOssStage.hh
   XrdOss/XrdOssStat.cc         XrdOss/XrdOssStatInfo.hh
+  XrdOss/XrdOssUring.cc        XrdOss/XrdOssUring.hh
                                XrdOss/XrdOssUnlink.cc
                                XrdOss/XrdOssError.hh
                                XrdOss/XrdOss.hh
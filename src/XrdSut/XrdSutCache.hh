@@ -143,10 +143,39 @@ public:
       return cent;
    }
 
+   int Trim(XrdSutCacheGet_t condition, void *arg = 0) {
+      // Remove the entries for which condition, applied with arguments 'arg',
+      // returns false, i.e. those that Get() would have to refresh. Entries
+      // in use (locked) are left alone.
+      // Returns the number of entries left.
+      XrdSutCacheTrim_t targ = {condition, arg};
+
+      // Exclusive access to the table
+      XrdSysMutexHelper raii(mtx);
+
+      table.Apply(TrimEntry, (void *) &targ);
+      return table.Num();
+   }
+
    inline int Num() { return table.Num(); }
    inline void Reset() { return table.Purge(); }
 
 private:
+   typedef struct {
+      XrdSutCacheGet_t condition;
+      void *arg;
+   } XrdSutCacheTrim_t;
+
+   static int TrimEntry(const char *, XrdSutCacheEntry *cent, void *a) {
+      // Entries are only locked through Get(), which needs the table mutex
+      // that we hold: if we can write-lock an entry nobody else has it
+      XrdSutCacheTrim_t *targ = (XrdSutCacheTrim_t *)a;
+      if (!cent || !cent->rwmtx.CondWriteLock()) return 0;
+      bool keep = (*(targ->condition))(cent, targ->arg);
+      cent->rwmtx.UnLock();
+      return (keep ? 0 : -1);
+   }
+
    XrdSysRecMutex         mtx;  // Protect access to table
    XrdOucHash<XrdSutCacheEntry> table; // table with content
 };
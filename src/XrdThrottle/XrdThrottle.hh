@@ -24,10 +24,12 @@ typedef std::auto_ptr<XrdSfsFile> unique_sfs_ptr;
 #endif
 
 class FileSystem;
+class DeferredIO;
 
 class File : public XrdSfsFile {
 
 friend class FileSystem;
+friend class DeferredIO;
 
 public:
 
@@ -99,8 +101,14 @@ private:
    virtual
    ~File();
 
+   int
+   Throttle(XrdSfsAio *aioparm, bool isRead);
+
+   void
+   DoAio(XrdSfsAio *aioparm, bool isRead);
+
    unique_sfs_ptr m_sfs;
-   int m_uid; // A unique identifier for this user; has no meaning except for the fairshare.
+   XrdThrottleBucket *m_bucket; // The user's bucket; null until the file is opened.
    std::string m_loadshed;
    std::string m_user;
    XrdThrottleManager &m_throttle;
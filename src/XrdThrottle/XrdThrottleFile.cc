@@ -6,6 +6,35 @@
 
 using namespace XrdThrottle;
 
+namespace XrdThrottle {
+
+/*
+ * An asynchronous request waiting out its throttle delay on the deferral
+ * wheel; it runs on a scheduler thread once the delay has expired.
+ */
+class DeferredIO : public XrdThrottleDeferred
+{
+public:
+
+   DeferredIO(File &file, XrdSfsAio *aioparm, bool isRead)
+      : XrdThrottleDeferred("throttled aio"), m_file(file), m_aio(aioparm), m_read(isRead)
+   {}
+
+   virtual void DoIt()
+   {
+      m_file.m_throttle.Release(m_file.m_bucket);
+      m_file.DoAio(m_aio, m_read);
+      delete this;
+   }
+
+private:
+   File      &m_file;
+   XrdSfsAio *m_aio;
+   bool       m_read;
+};
+
+}
+
 #define DO_LOADSHED if (m_throttle.CheckLoadShed(m_loadshed)) \
 { \
    unsigned port; \
@@ -18,7 +47,7 @@ using namespace XrdThrottle;
 
 #define DO_THROTTLE(amount) \
 DO_LOADSHED \
-m_throttle.Apply(amount, 1, m_uid); \
+m_throttle.Apply(amount, 1, m_bucket); \
 XrdThrottleTimer xtimer = m_throttle.StartIOTimer();
 
 File::File(const char                     *user,
@@ -31,14 +60,16 @@ File::File(const char                     *user,
 #else
    : m_sfs(sfs),
 #endif
-     m_uid(0),
+     m_bucket(0),
      m_user(user),
      m_throttle(throttle),
      m_eroute(eroute)
 {}
 
 File::~File()
-{}
+{
+   m_throttle.Detach(m_bucket);
+}
 
 int
 File::open(const char                *fileName,
@@ -47,7 +78,7 @@ File::open(const char                *fileName,
            const XrdSecEntity        *client,
            const char                *opaque)
 {
-   m_uid = XrdThrottleManager::GetUid(client->name);
+   if (!m_bucket) m_bucket = m_throttle.Attach(client);
    m_throttle.PrepLoadShed(opaque, m_loadshed);
    return m_sfs->open(fileName, openMode, createMode, client, opaque);
 }
@@ -99,12 +130,8 @@ File::read(XrdSfsFileOffset   fileOffset,
 
 int
 File::read(XrdSfsAio *aioparm)
-{  // We disable all AIO-based reads.
-   aioparm->Result = this->read((XrdSfsFileOffset)aioparm->sfsAio.aio_offset,
-                                          (char *)aioparm->sfsAio.aio_buf,
-                                  (XrdSfsXferSize)aioparm->sfsAio.aio_nbytes);
-   aioparm->doneRead();
-   return SFS_OK;
+{
+   return Throttle(aioparm, true);
 }
 
 XrdSfsXferSize
@@ -119,13 +146,51 @@ File::write(      XrdSfsFileOffset   fileOffset,
 int
 File::write(XrdSfsAio *aioparm)
 {
-   aioparm->Result = this->write((XrdSfsFileOffset)aioparm->sfsAio.aio_offset,
-                                           (char *)aioparm->sfsAio.aio_buf,
-                                   (XrdSfsXferSize)aioparm->sfsAio.aio_nbytes);
-   aioparm->doneRead();
+   return Throttle(aioparm, false);
+}
+
+/*
+ * Asynchronous requests are never made to wait on a thread: a delayed request
+ * is parked on the deferral wheel and completed from there.
+ */
+int
+File::Throttle(XrdSfsAio *aioparm, bool isRead)
+{
+   long long delay = m_throttle.Reserve(aioparm->sfsAio.aio_nbytes, 1, m_bucket);
+   if (delay)
+   {
+      m_throttle.Defer(new DeferredIO(*this, aioparm, isRead), delay);
+   }
+   else
+   {
+      DoAio(aioparm, isRead);
+   }
    return SFS_OK;
+}
 
-   return m_sfs->write(aioparm);
+/*
+ * The IO itself is still done synchronously so that it can be timed.
+ */
+void
+File::DoAio(XrdSfsAio *aioparm, bool isRead)
+{
+   XrdThrottleTimer xtimer = m_throttle.StartIOTimer();
+   if (isRead)
+   {
+      aioparm->Result = m_sfs->read((XrdSfsFileOffset)aioparm->sfsAio.aio_offset,
+                                              (char *)aioparm->sfsAio.aio_buf,
+                                      (XrdSfsXferSize)aioparm->sfsAio.aio_nbytes);
+      xtimer.StopTimer();
+      aioparm->doneRead();
+   }
+   else
+   {
+      aioparm->Result = m_sfs->write((XrdSfsFileOffset)aioparm->sfsAio.aio_offset,
+                                               (char *)aioparm->sfsAio.aio_buf,
+                                       (XrdSfsXferSize)aioparm->sfsAio.aio_nbytes);
+      xtimer.StopTimer();
+      aioparm->doneWrite();
+   }
 }
 
 int
@@ -165,7 +230,11 @@ File::SendData(XrdSfsDio         *sfDio,
                XrdSfsFileOffset   offset,
                XrdSfsXferSize     size)
 {
-   DO_THROTTLE(size);
+   // A long delay is handed back to the client as a wait rather than held here.
+   DO_LOADSHED
+   int stall = m_throttle.Admit(size, 1, m_bucket);
+   if (stall) return stall;
+   XrdThrottleTimer xtimer = m_throttle.StartIOTimer();
    return m_sfs->SendData(sfDio, offset, size);
 }
 
@@ -1,5 +1,6 @@
 
 #include "XrdOfs/XrdOfs.hh"
+#include "XrdOuc/XrdOucEnv.hh"
 
 #include "XrdThrottle/XrdThrottle.hh"
 
@@ -64,6 +65,7 @@ FileSystem::Disc(const XrdSecEntity *client)
 void
 FileSystem::EnvInfo(XrdOucEnv *envP)
 {
+   if (envP) m_throttle.SetScheduler(static_cast<XrdScheduler *>(envP->GetPtr("XrdScheduler*")));
    m_sfs_ptr->EnvInfo(envP);
 }
 
@@ -90,7 +92,9 @@ int
 FileSystem::getStats(char *buff,
                      int   blen)
 {
-   return m_sfs_ptr->getStats(buff, blen);
+   if (!buff) return m_sfs_ptr->getStats(0, 0) + m_throttle.Stats(0, 0);
+   int len = m_sfs_ptr->getStats(buff, blen);
+   return len + m_throttle.Stats(buff+len, blen-len);
 }
 
 const char *
@@ -171,11 +171,20 @@ FileSystem::Configure(XrdSysError & log, XrdSfsFileSystem *native_fs)
 /* Function: xthrottle
 
    Purpose:  To parse the directive: throttle [data <drate>] [iops <irate>] [concurrency <climit>] [interval <rint>]
+                                              [userdata <udrate>] [useriops <uirate>]
+                                              [groupdata <gdrate>] [groupiops <girate>]
+                                              [stall <secs>]
 
              <drate>    maximum bytes per second through the server.
              <irate>    maximum IOPS per second through the server.
              <climit>   maximum number of concurrent IO connections.
              <rint>     minimum interval in milliseconds between throttle re-computing.
+             <udrate>   maximum bytes per second for any one user.
+             <uirate>   maximum IOPS per second for any one user.
+             <gdrate>   maximum bytes per second for any one VO or group.
+             <girate>   maximum IOPS per second for any one VO or group.
+             <secs>     delay, in seconds, past which a read is bounced back to
+                        the client to retry (0 never bounces); defaults to 1.
 
    Output: 0 upon success or !0 upon failure.
 */
@@ -183,6 +192,8 @@ int
 FileSystem::xthrottle(XrdOucStream &Config)
 {
     long long drate = -1, irate = -1, rint = 1000, climit = -1;
+    long long udrate = -1, uirate = -1, gdrate = -1, girate = -1;
+    int stall = 1;
     char *val;
 
     while ((val = Config.GetWord()))
@@ -211,6 +222,36 @@ FileSystem::xthrottle(XrdOucStream &Config)
              {m_eroute.Emsg("Config", "Concurrency limit not specified."); return 1;}
           if (XrdOuca2x::a2sz(m_eroute,"Concurrency limit value",val,&climit,1)) return 1;
        }
+       else if (strcmp("userdata", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_eroute.Emsg("Config", "user data throttle limit not specified."); return 1;}
+          if (XrdOuca2x::a2sz(m_eroute,"user data throttle value",val,&udrate,1)) return 1;
+       }
+       else if (strcmp("useriops", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_eroute.Emsg("Config", "user IOPS throttle limit not specified."); return 1;}
+          if (XrdOuca2x::a2sz(m_eroute,"user IOPS throttle value",val,&uirate,1)) return 1;
+       }
+       else if (strcmp("groupdata", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_eroute.Emsg("Config", "group data throttle limit not specified."); return 1;}
+          if (XrdOuca2x::a2sz(m_eroute,"group data throttle value",val,&gdrate,1)) return 1;
+       }
+       else if (strcmp("groupiops", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_eroute.Emsg("Config", "group IOPS throttle limit not specified."); return 1;}
+          if (XrdOuca2x::a2sz(m_eroute,"group IOPS throttle value",val,&girate,1)) return 1;
+       }
+       else if (strcmp("stall", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_eroute.Emsg("Config", "stall threshold not specified."); return 1;}
+          if (XrdOuca2x::a2tm(m_eroute,"stall threshold value",val,&stall,0)) return 1;
+       }
        else
        {
           m_eroute.Emsg("Config", "Warning - unknown throttle option specified", val, ".");
@@ -218,6 +259,7 @@ FileSystem::xthrottle(XrdOucStream &Config)
     }
 
     m_throttle.SetThrottles(drate, irate, climit, static_cast<float>(rint)/1000.0);
+    m_throttle.SetClassThrottles(udrate, uirate, gdrate, girate, stall);
     return 0;
 }
 
@@ -1,6 +1,11 @@
-
 #include "XrdThrottleManager.hh"
 
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+#include "Xrd/XrdScheduler.hh"
+#include "XrdSec/XrdSecEntity.hh"
 #include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysTimer.hh"
 
@@ -13,7 +18,10 @@ const char *
 XrdThrottleManager::TraceID = "ThrottleManager";
 
 const
-int XrdThrottleManager::m_max_users = 1024;
+int XrdThrottleManager::m_wheel_slots = 512;
+
+const
+int XrdThrottleManager::m_wheel_tick_ms = 10;
 
 #if defined(__linux__)
 int clock_id;
@@ -22,6 +30,33 @@ int XrdThrottleTimer::clock_id = clock_getcpuclockid(0, &clock_id) != ENOENT ? C
 int XrdThrottleTimer::clock_id = 0;
 #endif
 
+/*
+ * Add the tokens accumulated over secs; at most one interval worth of tokens
+ * may be banked, so an idle class cannot save up an arbitrary burst.
+ */
+void
+XrdThrottleTokens::Refill(double secs, double interval)
+{
+   if (m_rate < 0) return;
+   double burst = m_rate * interval;
+   m_level += m_rate * secs;
+   if (m_level > burst) m_level = burst;
+}
+
+/*
+ * Take the tokens for a request and return how long, in microseconds, the
+ * request must wait until the debt it leaves behind has been repaid.
+ */
+long long
+XrdThrottleTokens::Take(double amount)
+{
+   m_used += amount;
+   if (m_rate < 0) return 0;
+   m_level -= amount;
+   if (m_level >= 0) return 0;
+   return static_cast<long long>(-m_level / m_rate * 1000000.0);
+}
+
 XrdThrottleManager::XrdThrottleManager(XrdSysError *lP, XrdOucTrace *tP) :
    m_trace(tP),
    m_log(lP),
@@ -29,7 +64,15 @@ XrdThrottleManager::XrdThrottleManager(XrdSysError *lP, XrdOucTrace *tP) :
    m_bytes_per_second(-1),
    m_ops_per_second(-1),
    m_concurrency_limit(-1),
-   m_last_round_allocation(100*1024),
+   m_user_bytes(-1),
+   m_user_ops(-1),
+   m_group_bytes(-1),
+   m_group_ops(-1),
+   m_stall_us(1000000),
+   m_global("global", 0),
+   m_user_count(0),
+   m_wheel_pos(0),
+   m_sched(0),
    m_io_counter(0),
    m_loadshed_host(""),
    m_loadshed_port(0),
@@ -44,19 +87,13 @@ void
 XrdThrottleManager::Init()
 {
    TRACE(DEBUG, "Initializing the throttle manager.");
-   // Initialize all our shares to zero.
-   m_primary_bytes_shares.reserve(m_max_users);
-   m_secondary_bytes_shares.reserve(m_max_users);
-   m_primary_ops_shares.reserve(m_max_users);
-   m_secondary_ops_shares.reserve(m_max_users);
-   // Allocate each user 100KB and 10 ops to bootstrap;
-   for (int i=0; i<m_max_users; i++)
-   {
-      m_primary_bytes_shares[i] = m_last_round_allocation;
-      m_secondary_bytes_shares[i] = 0;
-      m_primary_ops_shares[i] = 10;
-      m_secondary_ops_shares[i] = 0;
-   }
+   // The global bucket starts out full; groups and users are created on demand.
+   m_global.m_bytes.m_cap = m_global.m_bytes.m_rate = m_bytes_per_second;
+   m_global.m_ops.m_cap = m_global.m_ops.m_rate = m_ops_per_second;
+   m_global.m_bytes.m_level = m_bytes_per_second * m_interval_length_seconds;
+   m_global.m_ops.m_level = m_ops_per_second * m_interval_length_seconds;
+   m_global.m_last_ns = Now();
+   m_wheel.assign(m_wheel_slots, static_cast<XrdThrottleDeferred *>(0));
 
    m_io_wait.tv_sec = 0;
    m_io_wait.tv_nsec = 0;
@@ -66,89 +103,344 @@ XrdThrottleManager::Init()
    if ((rc = XrdSysThread::Run(&tid, XrdThrottleManager::RecomputeBootstrap, static_cast<void *>(this), 0, "Buffer Manager throttle")))
       m_log->Emsg("ThrottleManager", rc, "create throttle thread");
 
+   if (IsThrottling() && (rc = XrdSysThread::Run(&tid, XrdThrottleManager::WheelBootstrap, static_cast<void *>(this), 0, "Throttle deferral wheel")))
+      m_log->Emsg("ThrottleManager", rc, "create throttle deferral thread");
+}
+
+long long
+XrdThrottleManager::Now()
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+/*
+ * Find (or create) the bucket for the user behind a client.  Users are
+ * tracked exactly, by name, beneath the bucket of their VO or, failing
+ * that, their first group.
+ */
+XrdThrottleBucket *
+XrdThrottleManager::Attach(const XrdSecEntity *client)
+{
+   std::string user = (client && client->name && client->name[0]) ? client->name : "nobody";
+   std::string group = "*";
+   if (client && client->vorg && client->vorg[0])
+   {
+      group = client->vorg;
+   }
+   else if (client && client->grps && client->grps[0])
+   {
+      group = client->grps;
+      group.erase(std::min(group.find(' '), group.size()));
+   }
+
+   XrdSysMutexHelper lock(m_bucket_mutex);
+   long long now = Now();
+
+   XrdThrottleBucket *&gb = m_global.m_children[group];
+   if (!gb)
+   {
+      gb = new XrdThrottleBucket(group, &m_global);
+      gb->m_bytes.m_cap = m_group_bytes;
+      gb->m_ops.m_cap = m_group_ops;
+      Join(*gb);
+      gb->m_bytes.m_level = gb->m_bytes.m_rate * m_interval_length_seconds;
+      gb->m_ops.m_level = gb->m_ops.m_rate * m_interval_length_seconds;
+      gb->m_last_ns = now;
+      TRACE(DEBUG, "Created throttle group " << group);
+   }
+
+   XrdThrottleBucket *&ub = gb->m_children[user];
+   if (!ub)
+   {
+      ub = new XrdThrottleBucket(user, gb);
+      ub->m_bytes.m_cap = m_user_bytes;
+      ub->m_ops.m_cap = m_user_ops;
+      Join(*ub);
+      ub->m_bytes.m_level = ub->m_bytes.m_rate * m_interval_length_seconds;
+      ub->m_ops.m_level = ub->m_ops.m_rate * m_interval_length_seconds;
+      ub->m_last_ns = now;
+      gb->m_refs++;
+      m_user_count++;
+      TRACE(DEBUG, "Created throttle user " << user << " in group " << group);
+   }
+   ub->m_refs++;
+   return ub;
+}
+
+/*
+ * Give a new child an even split of its parent until the next recompute.
+ */
+void
+XrdThrottleManager::Join(XrdThrottleBucket &child)
+{
+   XrdThrottleBucket &parent = *child.m_parent;
+   double count = parent.m_children.size();
+   child.m_bytes.m_rate = parent.m_bytes.m_rate < 0 ? -1 : std::max(parent.m_bytes.m_rate / count, 1.0);
+   child.m_ops.m_rate = parent.m_ops.m_rate < 0 ? -1 : std::max(parent.m_ops.m_rate / count, 1.0);
+   if (child.m_bytes.m_cap > 0 && (child.m_bytes.m_rate < 0 || child.m_bytes.m_cap < child.m_bytes.m_rate))
+      child.m_bytes.m_rate = child.m_bytes.m_cap;
+   if (child.m_ops.m_cap > 0 && (child.m_ops.m_rate < 0 || child.m_ops.m_cap < child.m_ops.m_rate))
+      child.m_ops.m_rate = child.m_ops.m_cap;
+}
+
+/*
+ * Drop a file's reference to its user; the bucket itself is pruned by the
+ * recompute thread once it has been idle for an interval.
+ */
+void
+XrdThrottleManager::Detach(XrdThrottleBucket *user)
+{
+   if (!user) return;
+   XrdSysMutexHelper lock(m_bucket_mutex);
+   user->m_refs--;
 }
 
 /*
- * Take as many shares as possible to fulfill the request; update
- * request with current remaining value, or zero if satisfied.
+ * Must be called with the bucket's mutex held unless lock is set.
  */
 inline void
-XrdThrottleManager::GetShares(int &shares, int &request)
+XrdThrottleManager::Refill(XrdThrottleBucket &bucket, long long now, bool lock)
 {
-   int remaining;
-   AtomicFSub(remaining, shares, request);
-   if (remaining > 0)
+   if (lock)
    {
-      request -= (remaining < request) ? remaining : request;
+      XrdSysMutexHelper helper(bucket.m_mutex);
+      Refill(bucket, now, false);
+      return;
    }
+   double secs = (now - bucket.m_last_ns) / 1e9;
+   if (secs <= 0) return;
+   bucket.m_bytes.Refill(secs, m_interval_length_seconds);
+   bucket.m_ops.Refill(secs, m_interval_length_seconds);
+   bucket.m_last_ns = now;
 }
 
 /*
- * Iterate through all of the secondary shares, attempting 
- * to steal enough to fulfill the request.
+ * Charge a request to the user, its group and the global bucket and return
+ * the delay, in microseconds, before it may proceed.  A delayed request is
+ * counted as queued until the caller reports it with Release() or Refund().
+ *
+ * Only one bucket is locked at a time.  The caller holds a reference to the
+ * user (and so, indirectly, to its group), so the path cannot be pruned.
+ */
+long long
+XrdThrottleManager::Reserve(int reqsize, int reqops, XrdThrottleBucket *user)
+{
+   XrdThrottleBucket *first = user ? user : &m_global;
+   long long delay = 0;
+
+   long long now = Now();
+   for (XrdThrottleBucket *cur = first; cur; cur = cur->m_parent)
+   {
+      XrdSysMutexHelper lock(cur->m_mutex);
+      Refill(*cur, now);
+      long long bytes_delay = cur->m_bytes.Take(reqsize);
+      long long ops_delay = cur->m_ops.Take(reqops);
+      delay = std::max(delay, std::max(bytes_delay, ops_delay));
+      cur->m_stats.m_requests++;
+      cur->m_stats.m_bytes += reqsize;
+   }
+   if (delay)
+   {
+      for (XrdThrottleBucket *cur = first; cur; cur = cur->m_parent)
+      {
+         XrdSysMutexHelper lock(cur->m_mutex);
+         XrdThrottleStats &stats = cur->m_stats;
+         cur->m_saturated = true;
+         stats.m_delayed++;
+         stats.m_delay_us += delay;
+         if (delay > stats.m_max_us) stats.m_max_us = delay;
+         if (++stats.m_queued > stats.m_max_queued) stats.m_max_queued = stats.m_queued;
+      }
+   }
+
+   if (delay)
+   {
+      TRACE(BANDWIDTH, "Delaying request of " << reqsize << " bytes from " << first->Name() << " by " << delay << "us.");
+      AtomicBeg(m_compute_var);
+      AtomicInc(m_loadshed_limit_hit);
+      AtomicEnd(m_compute_var);
+   }
+   return delay;
+}
+
+/*
+ * A delayed request has been let through.
  */
 void
-XrdThrottleManager::StealShares(int uid, int &reqsize, int &reqops)
+XrdThrottleManager::Release(XrdThrottleBucket *user)
 {
-   if (!reqsize && !reqops) return;
-   TRACE(BANDWIDTH, "Stealing shares to fill request of " << reqsize << " bytes");
-   TRACE(IOPS, "Stealing shares to fill request of " << reqops << " ops.");
+   for (XrdThrottleBucket *cur = user ? user : &m_global; cur; cur = cur->m_parent)
+   {
+      XrdSysMutexHelper lock(cur->m_mutex);
+      cur->m_stats.m_queued--;
+   }
+}
 
-   for (int i=uid+1; i % m_max_users == uid; i++)
+/*
+ * A delayed request was bounced back to the client; return its tokens so the
+ * retry is not charged twice.
+ */
+void
+XrdThrottleManager::Refund(int reqsize, int reqops, XrdThrottleBucket *user)
+{
+   for (XrdThrottleBucket *cur = user ? user : &m_global; cur; cur = cur->m_parent)
    {
-      if (reqsize) GetShares(m_secondary_bytes_shares[i % m_max_users], reqsize);
-      if (reqops)  GetShares(m_secondary_ops_shares[  i % m_max_users], reqops);
+      XrdSysMutexHelper lock(cur->m_mutex);
+      cur->m_bytes.m_used -= reqsize;
+      cur->m_ops.m_used -= reqops;
+      if (cur->m_bytes.m_rate >= 0) cur->m_bytes.m_level += reqsize;
+      if (cur->m_ops.m_rate >= 0) cur->m_ops.m_level += reqops;
+      cur->m_stats.m_queued--;
+      cur->m_stats.m_stalled++;
    }
+}
 
-   TRACE(BANDWIDTH, "After stealing shares, " << reqsize << " of request bytes remain.");
-   TRACE(IOPS, "After stealing shares, " << reqops << " of request ops remain.");
+/*
+ * Apply the throttle to a request that has to complete on this thread and
+ * cannot be handed back to the client (the synchronous read and write calls
+ * return a byte count, so there is no way to ask for a retry).  If there are
+ * no limits set, returns immediately; otherwise waits out the delay, up to
+ * the cap of Wait().  Debt beyond that stays with the buckets and delays the
+ * class's following requests instead.
+ */
+void
+XrdThrottleManager::Apply(int reqsize, int reqops, XrdThrottleBucket *user)
+{
+   long long delay = Reserve(reqsize, reqops, user);
+   if (delay)
+   {
+      Wait(delay);
+      Release(user);
+   }
 }
 
 /*
- * Apply the throttle.  If there are no limits set, returns immediately.  Otherwise,
- * this applies the limits as best possible, stalling the thread if necessary.
+ * Hold the calling thread for a delay, but never longer than the stall
+ * threshold (or one interval when stalls are disabled) so that a large debt
+ * cannot park a scheduler thread indefinitely.
  */
 void
-XrdThrottleManager::Apply(int reqsize, int reqops, int uid)
+XrdThrottleManager::Wait(long long delay_us)
 {
-   if (m_bytes_per_second < 0)
-      reqsize = 0;
-   if (m_ops_per_second < 0)
-      reqops = 0;
-   while (reqsize || reqops)
+   long long cap_us = m_stall_us > 0 ? m_stall_us
+                    : static_cast<long long>(m_interval_length_seconds * 1000000.0);
+   if (delay_us > cap_us) delay_us = cap_us;
+   long long delay_ms = (delay_us + 999) / 1000;
+   if (delay_ms > 0) XrdSysTimer::Wait(static_cast<int>(delay_ms));
+}
+
+/*
+ * Apply the throttle to a request that can be retried by the client.  A delay
+ * shorter than the stall threshold is waited out here and 0 is returned;
+ * otherwise the request is not charged and the number of seconds the client
+ * should wait before retrying is returned.
+ */
+int
+XrdThrottleManager::Admit(int reqsize, int reqops, XrdThrottleBucket *user)
+{
+   long long delay = Reserve(reqsize, reqops, user);
+   if (!delay) return 0;
+   if (m_stall_us > 0 && delay >= m_stall_us)
    {
-      // Subtract the requested out of the shares
-      AtomicBeg(m_compute_var);
-      GetShares(m_primary_bytes_shares[uid], reqsize);
-      if (reqsize)
+      Refund(reqsize, reqops, user);
+      long long secs = (delay + 999999) / 1000000;
+      return static_cast<int>(std::min(secs, 3600LL));
+   }
+   Wait(delay);
+   Release(user);
+   return 0;
+}
+
+/*
+ * Park a request on the deferral wheel until its delay has expired.  This
+ * does not tie up a thread; the wheel hands the job to the scheduler.
+ */
+void
+XrdThrottleManager::Defer(XrdThrottleDeferred *job, long long delay_us)
+{
+   long long tick_us = m_wheel_tick_ms * 1000LL;
+   long long ticks = (delay_us + tick_us - 1) / tick_us;
+   if (ticks < 1) ticks = 1;
+
+   XrdSysMutexHelper lock(m_wheel_mutex);
+   int slot = static_cast<int>((m_wheel_pos + ticks) % m_wheel_slots);
+   job->m_rounds = static_cast<int>((ticks - 1) / m_wheel_slots);
+   job->NextJob = m_wheel[slot];
+   m_wheel[slot] = job;
+}
+
+void *
+XrdThrottleManager::WheelBootstrap(void *instance)
+{
+   XrdThrottleManager * manager = static_cast<XrdThrottleManager*>(instance);
+   manager->Wheel();
+   return NULL;
+}
+
+/*
+ * Turn the deferral wheel, one slot per tick.  If the thread falls behind it
+ * catches up by turning several slots at once.
+ */
+void
+XrdThrottleManager::Wheel()
+{
+   long long tick_ns = m_wheel_tick_ms * 1000000LL;
+   long long next = Now() + tick_ns;
+   while (1)
+   {
+      long long now = Now();
+      if (now < next)
       {
-         TRACE(BANDWIDTH, "Using secondary shares; request has " << reqsize << " bytes left.");
-         GetShares(m_secondary_bytes_shares[uid], reqsize);
-         TRACE(BANDWIDTH, "Finished with secondary shares; request has " << reqsize << " bytes left.");
+         XrdSysTimer::Wait(static_cast<int>((next - now + 999999) / 1000000));
+         continue;
       }
-      else
+      next += tick_ns;
+
+      XrdThrottleDeferred *job, *keep = 0;
+      XrdJob *first = 0, *last = 0;
+      int num = 0;
+      m_wheel_mutex.Lock();
+      m_wheel_pos = (m_wheel_pos + 1) % m_wheel_slots;
+      job = m_wheel[m_wheel_pos];
+      while (job)
       {
-         TRACE(BANDWIDTH, "Filled byte shares out of primary; " << m_primary_bytes_shares[uid] << " left.");
+         XrdThrottleDeferred *next_job = static_cast<XrdThrottleDeferred *>(job->NextJob);
+         if (job->m_rounds > 0)
+         {
+            job->m_rounds--;
+            job->NextJob = keep;
+            keep = job;
+         }
+         else
+         {
+            job->NextJob = 0;
+            if (last) last->NextJob = job;
+            else first = job;
+            last = job;
+            num++;
+         }
+         job = next_job;
       }
-      GetShares(m_primary_ops_shares[uid], reqops);
-      if (reqops)
+      m_wheel[m_wheel_pos] = keep;
+      m_wheel_mutex.UnLock();
+
+      if (!num) continue;
+      if (m_sched)
       {
-         GetShares(m_secondary_ops_shares[uid], reqops);
+         m_sched->Schedule(num, first, last);
       }
-      StealShares(uid, reqsize, reqops);
-      AtomicEnd(m_compute_var);
-
-      if (reqsize || reqops)
+      else
       {
-         if (reqsize) TRACE(BANDWIDTH, "Sleeping to wait for throttle fairshare.");
-         if (reqops) TRACE(IOPS, "Sleeping to wait for throttle fairshare.");
-         m_compute_var.Wait();
-         AtomicBeg(m_compute_var);
-         AtomicInc(m_loadshed_limit_hit);
-         AtomicEnd(m_compute_var);
+         while (first)
+         {
+            XrdJob *next_job = first->NextJob;
+            first->DoIt();
+            first = next_job;
+         }
       }
    }
-
 }
 
 void *
@@ -171,73 +463,174 @@ XrdThrottleManager::Recompute()
    }
 }
 
+namespace
+{
+// Orders children by demand, with unbounded demand (negative) last.
+class DemandOrder
+{
+public:
+   DemandOrder(const std::vector<double> &want) : m_want(want) {}
+   bool operator()(size_t a, size_t b) const
+   {
+      if (m_want[a] < 0) return false;
+      if (m_want[b] < 0) return true;
+      return m_want[a] < m_want[b];
+   }
+private:
+   const std::vector<double> &m_want;
+};
+
+/*
+ * Max-min fair division of total between children wanting want[i] each
+ * (negative for as much as possible); the allotment replaces the demand.
+ */
+void
+FairShare(double total, std::vector<double> &want)
+{
+   std::vector<size_t> order(want.size());
+   for (size_t i = 0; i < order.size(); i++) order[i] = i;
+   std::sort(order.begin(), order.end(), DemandOrder(want));
+   double remaining = total;
+   for (size_t i = 0; i < order.size(); i++)
+   {
+      double share = remaining / (order.size() - i);
+      double &alloc = want[order[i]];
+      if (alloc < 0 || alloc > share) alloc = share;
+      remaining -= alloc;
+   }
+}
+}
+
+/*
+ * Divide the parent's effective rates between its children.  A child that
+ * was delayed during the last interval asks for as much as possible; any
+ * other child is offered twice its usage (but never less than a quarter of
+ * an even split) so it can ramp up without being delayed first.  A child's
+ * own cap, if set, always applies.
+ */
+void
+XrdThrottleManager::Share(XrdThrottleBucket &parent)
+{
+   size_t count = parent.m_children.size();
+   if (!count) return;
+
+   std::vector<double> bytes_want, ops_want;
+   bytes_want.reserve(count);
+   ops_want.reserve(count);
+   for (XrdThrottleBucket::Children::iterator it = parent.m_children.begin(); it != parent.m_children.end(); ++it)
+   {
+      XrdThrottleBucket &child = *it->second;
+      XrdSysMutexHelper lock(child.m_mutex);
+      double used_bytes = child.m_bytes.m_used / m_interval_length_seconds;
+      double used_ops = child.m_ops.m_used / m_interval_length_seconds;
+      bytes_want.push_back(child.m_saturated ? -1 : std::max(2 * used_bytes, parent.m_bytes.m_rate / (4 * count)));
+      ops_want.push_back(child.m_saturated ? -1 : std::max(2 * used_ops, parent.m_ops.m_rate / (4 * count)));
+   }
+   if (parent.m_bytes.m_rate >= 0) FairShare(parent.m_bytes.m_rate, bytes_want);
+   if (parent.m_ops.m_rate >= 0) FairShare(parent.m_ops.m_rate, ops_want);
+
+   size_t i = 0;
+   for (XrdThrottleBucket::Children::iterator it = parent.m_children.begin(); it != parent.m_children.end(); ++it, ++i)
+   {
+      XrdThrottleBucket &child = *it->second;
+      double bytes_rate = parent.m_bytes.m_rate < 0 ? -1 : std::max(bytes_want[i], 1.0);
+      double ops_rate = parent.m_ops.m_rate < 0 ? -1 : std::max(ops_want[i], 1.0);
+      if (child.m_bytes.m_cap > 0 && (bytes_rate < 0 || child.m_bytes.m_cap < bytes_rate)) bytes_rate = child.m_bytes.m_cap;
+      if (child.m_ops.m_cap > 0 && (ops_rate < 0 || child.m_ops.m_cap < ops_rate)) ops_rate = child.m_ops.m_cap;
+      XrdSysMutexHelper lock(child.m_mutex);
+      child.m_bytes.m_rate = bytes_rate;
+      child.m_ops.m_rate = ops_rate;
+   }
+}
+
+/*
+ * Forget children with no references, nothing queued and no debt left.
+ */
+void
+XrdThrottleManager::Prune(XrdThrottleBucket &parent)
+{
+   XrdThrottleBucket::Children::iterator it = parent.m_children.begin();
+   while (it != parent.m_children.end())
+   {
+      XrdThrottleBucket *child = it->second;
+      child->m_mutex.Lock();
+      bool busy = child->m_stats.m_queued || child->m_bytes.m_level < 0 || child->m_ops.m_level < 0;
+      child->m_mutex.UnLock();
+      if (child->m_refs || busy)
+      {
+         ++it;
+         continue;
+      }
+      TRACE(DEBUG, "Removing idle throttle class " << child->Name());
+      if (parent.m_parent)
+      {
+         parent.m_refs--;
+         m_user_count--;
+      }
+      parent.m_children.erase(it++);
+      delete child;
+   }
+}
+
 /*
  * The heart of the manager approach.
  *
- * This routine periodically recomputes the shares of each current user.
- * Each user has a "primary" and a "secondary" share.  At the end of the
- * each time interval, the remaining primary share is moved to secondary.
- * A user can utilize both shares; if both are gone, they must block until
- * the next recompute interval.
- *
- * The secondary share can be "stolen" by any other user; so, if a user
- * is idle or under-utilizing, their share can be used by someone else.
- * However, they can never be completely starved, as no one can steal
- * primary share.
- *
- * In this way, we violate the throttle for an interval, but never starve.
- *
+ * This routine periodically recomputes the rates of each group and user.
+ * The global rate is divided between the groups that were active during the
+ * last interval and each group's rate between its active users.  Users and
+ * groups that went idle are released.  Requests themselves never wait for
+ * this routine; the buckets refill continuously at whatever rate was last
+ * computed.
  */
 void
 XrdThrottleManager::RecomputeInternal()
 {
-   // Compute total shares for this interval; 
    float intervals_per_second = 1.0/m_interval_length_seconds;
-   float total_bytes_shares = m_bytes_per_second / intervals_per_second;
-   float total_ops_shares   = m_ops_per_second / intervals_per_second;
 
-   // Compute the number of active users; a user is active if they used
-   // any primary share during the last interval;
-   AtomicBeg(m_compute_var);
-   float active_users = 0;
-   long bytes_used = 0;
-   for (int i=0; i<m_max_users; i++)
+   m_bucket_mutex.Lock();
+   long long now = Now();
+   Refill(m_global, now, true);
+   for (XrdThrottleBucket::Children::iterator git = m_global.m_children.begin(); git != m_global.m_children.end(); ++git)
    {
-      int primary = AtomicFAZ(m_primary_bytes_shares[i]);
-      if (primary != m_last_round_allocation)
+      XrdThrottleBucket &group = *git->second;
+      Refill(group, now, true);
+      for (XrdThrottleBucket::Children::iterator uit = group.m_children.begin(); uit != group.m_children.end(); ++uit)
       {
-         active_users++;
-         if (primary >= 0)
-            m_secondary_bytes_shares[i] = primary;
-         primary = AtomicFAZ(m_primary_ops_shares[i]);
-         if (primary >= 0)
-             m_secondary_ops_shares[i] = primary;
-         bytes_used += (primary < 0) ? m_last_round_allocation : (m_last_round_allocation-primary);
+         Refill(*uit->second, now, true);
       }
+      Prune(group);
    }
+   Prune(m_global);
 
-   if (active_users == 0)
-   {
-      active_users++;
-   }
-
-   // Note we allocate the same number of shares to *all* users, not
-   // just the active ones.  If a new user becomes active in the next
-   // interval, we'll go over our bandwidth budget just a bit.
-   m_last_round_allocation = static_cast<int>(total_bytes_shares / active_users);
-   int ops_shares = static_cast<int>(total_ops_shares / active_users);
-   TRACE(BANDWIDTH, "Round byte allocation " << m_last_round_allocation << " ; last round used " << bytes_used << ".");
-   TRACE(IOPS, "Round ops allocation " << ops_shares);
-   for (int i=0; i<m_max_users; i++)
+   Share(m_global);
+   for (XrdThrottleBucket::Children::iterator git = m_global.m_children.begin(); git != m_global.m_children.end(); ++git)
    {
-      m_primary_bytes_shares[i] = m_last_round_allocation;
-      m_primary_ops_shares[i] = ops_shares;
+      XrdThrottleBucket &group = *git->second;
+      Share(group);
+      for (XrdThrottleBucket::Children::iterator uit = group.m_children.begin(); uit != group.m_children.end(); ++uit)
+      {
+         XrdThrottleBucket &user = *uit->second;
+         XrdSysMutexHelper lock(user.m_mutex);
+         TRACE(BANDWIDTH, "User " << user.Name() << " in " << group.Name() << " used " << static_cast<long long>(user.m_bytes.m_used) << " bytes; new rate " << static_cast<long long>(user.m_bytes.m_rate) << " bytes/s.");
+         TRACE(IOPS, "User " << user.Name() << " in " << group.Name() << " used " << static_cast<long long>(user.m_ops.m_used) << " ops; new rate " << static_cast<long long>(user.m_ops.m_rate) << " ops/s.");
+         user.m_bytes.m_used = user.m_ops.m_used = 0;
+         user.m_saturated = false;
+      }
+      XrdSysMutexHelper lock(group.m_mutex);
+      group.m_bytes.m_used = group.m_ops.m_used = 0;
+      group.m_saturated = false;
    }
+   m_global.m_mutex.Lock();
+   TRACE(BANDWIDTH, "Last interval used " << static_cast<long long>(m_global.m_bytes.m_used) << " bytes across " << m_global.m_children.size() << " groups and " << m_user_count << " users.");
+   m_global.m_bytes.m_used = m_global.m_ops.m_used = 0;
+   m_global.m_saturated = false;
+   m_global.m_mutex.UnLock();
+   m_bucket_mutex.UnLock();
 
    // Reset the loadshed limit counter.
+   AtomicBeg(m_compute_var);
    int limit_hit = AtomicFAZ(m_loadshed_limit_hit);
    TRACE(DEBUG, "Throttle limit hit " << limit_hit << " times during last interval.");
-
    AtomicEnd(m_compute_var);
 
    // Update the IO counters
@@ -258,21 +651,54 @@ XrdThrottleManager::RecomputeInternal()
 }
 
 /*
- * Do a simple hash across the username.
+ * Format the statistics of one class.
+ */
+int
+XrdThrottleManager::Report(char *buff, int blen, const char *level, XrdThrottleBucket &bucket)
+{
+   static const char fmt[] = "<class><lvl>%s</lvl><name>%.64s</name>"
+          "<req>%lld</req><bytes>%lld</bytes><dly>%lld</dly><dlyus>%lld</dlyus>"
+          "<dlymax>%lld</dlymax><stall>%lld</stall><q>%d</q><qmax>%d</qmax></class>";
+   static const int fmtsz = sizeof(fmt) + 64 + (6*20) + (2*10);
+
+   if (!buff) return fmtsz;
+   if (blen < fmtsz) return 0;
+
+   bucket.m_mutex.Lock();
+   XrdThrottleStats stats = bucket.m_stats;
+   bucket.m_mutex.UnLock();
+   return sprintf(buff, fmt, level, bucket.Name().c_str(), stats.m_requests,
+                  stats.m_bytes, stats.m_delayed, stats.m_delay_us, stats.m_max_us,
+                  stats.m_stalled, stats.m_queued, stats.m_max_queued);
+}
+
+/*
+ * Report the global class, every group and the number of users being tracked.
+ * Per-user statistics are too numerous for the summary; they are traced on
+ * every recompute instead.
  */
 int
-XrdThrottleManager::GetUid(const char *username)
+XrdThrottleManager::Stats(char *buff, int blen)
 {
-   const char *cur = username;
-   int hval = 0;
-   while (cur && *cur && *cur != '@' && *cur != '.')
+   static const char head[] = "<stats id=\"throttle\"><users>%d</users><groups>%d</groups>";
+   static const char tail[] = "</stats>";
+   static const int  maxgroups = 32;
+   static const int  headsz = sizeof(head) + (2*10);
+
+   if (!buff) return headsz + (maxgroups+1)*Report(0, 0, 0, m_global) + sizeof(tail);
+   if (blen < headsz + (int)sizeof(tail)) return 0;
+
+   XrdSysMutexHelper lock(m_bucket_mutex);
+   int len = sprintf(buff, head, m_user_count, static_cast<int>(m_global.m_children.size()));
+   blen -= sizeof(tail);
+   len += Report(buff+len, blen-len, "global", m_global);
+   int n = 0;
+   for (XrdThrottleBucket::Children::iterator it = m_global.m_children.begin(); it != m_global.m_children.end() && n < maxgroups; ++it, ++n)
    {
-      hval += *cur;
-      hval %= m_max_users;
-      cur++;
+      len += Report(buff+len, blen-len, "group", *it->second);
    }
-   //cerr << "Calculated UID " << hval << " for " << username << endl;
-   return hval;
+   strcpy(buff+len, tail);
+   return len + sizeof(tail) - 1;
 }
 
 /*
@@ -3,18 +3,23 @@
  * XrdThrottleManager
  *
  * This class provides an implementation of a throttle manager.
- * The throttled manager purposely pause if the bandwidth, IOPS
- * rate, or number of outstanding IO requests  is sustained above 
+ * The throttled manager purposely delays IO if the bandwidth, IOPS
+ * rate, or number of outstanding IO requests is sustained above
  * a certain level.
  *
  * The XrdThrottleManager is user-aware and provides fairshare.
  *
- * This works by having a separate thread periodically refilling
- * each user's shares.
+ * Limits are enforced by a hierarchy of token buckets: a global bucket,
+ * one bucket per VO (or group) and one bucket per user within it.  Each
+ * request takes its bytes and ops from every bucket on its path and is
+ * delayed until the most indebted of them would have refilled.  The delay
+ * is computed up front, so a request is never parked waiting for other
+ * requests; callers either wait out a short delay, hand the request to
+ * the deferral wheel or tell the client to come back later.
  *
- * Note that we do not actually keep close track of users, but rather
- * put them into a hash.  This way, we can pretend there's a constant
- * number of users and use a lock-free algorithm.
+ * A separate thread periodically divides each bucket's rate between its
+ * active children (max-min fair, based on the last interval's usage) and
+ * forgets users that have gone idle.
  */
 
 #ifndef __XrdThrottleManager_hh_
@@ -28,16 +33,110 @@
 #define unlikely(x)     x
 #endif
 
+#include <map>
 #include <string>
 #include <vector>
 #include <time.h>
 
+#include "Xrd/XrdJob.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
+class XrdScheduler;
+class XrdSecEntity;
 class XrdSysError;
 class XrdOucTrace;
 class XrdThrottleTimer;
 
+/*
+ * Tokens for one resource (bytes or ops) of a bucket.  A negative level is
+ * debt owed by requests that have already been admitted.
+ */
+struct XrdThrottleTokens
+{
+   double m_cap;   // Configured limit per second; negative if unlimited
+   double m_rate;  // Effective rate per second; negative if unlimited
+   double m_level; // Tokens currently available
+   double m_used;  // Tokens taken during the current interval
+
+   void      Refill(double secs, double interval);
+
+   long long Take(double amount);
+
+   XrdThrottleTokens() : m_cap(-1), m_rate(-1), m_level(0), m_used(0) {}
+};
+
+/*
+ * Per-class statistics; a class is the global bucket, a group or a user.
+ */
+struct XrdThrottleStats
+{
+   long long m_requests;  // Requests admitted
+   long long m_bytes;     // Bytes requested
+   long long m_delayed;   // Requests that had to be delayed
+   long long m_delay_us;  // Total delay imposed, in microseconds
+   long long m_max_us;    // Largest delay imposed, in microseconds
+   long long m_stalled;   // Requests bounced back to the client to retry
+   int       m_queued;    // Requests currently delayed
+   int       m_max_queued;
+
+   XrdThrottleStats() : m_requests(0), m_bytes(0), m_delayed(0), m_delay_us(0),
+                        m_max_us(0), m_stalled(0), m_queued(0), m_max_queued(0) {}
+};
+
+/*
+ * A node in the bucket hierarchy.  The tokens, statistics and saturation flag
+ * are protected by the bucket's own mutex so that requests of different
+ * classes do not contend; the hierarchy itself (children and references) is
+ * protected by the manager's bucket mutex.  Rates are only changed while
+ * holding both.
+ */
+class XrdThrottleBucket
+{
+friend class XrdThrottleManager;
+
+public:
+
+const std::string &Name() const {return m_name;}
+
+private:
+
+            XrdThrottleBucket(const std::string &name, XrdThrottleBucket *parent)
+                             : m_name(name), m_parent(parent), m_last_ns(0),
+                               m_saturated(false), m_refs(0) {}
+
+           ~XrdThrottleBucket() {}
+
+typedef std::map<std::string, XrdThrottleBucket *> Children;
+
+XrdSysMutex         m_mutex;
+std::string         m_name;
+XrdThrottleBucket  *m_parent;
+Children            m_children;
+XrdThrottleTokens   m_bytes;
+XrdThrottleTokens   m_ops;
+long long           m_last_ns;   // Time of the last refill
+bool                m_saturated; // Delayed at least once this interval
+int                 m_refs;      // Open files (users) or children (groups)
+XrdThrottleStats    m_stats;
+};
+
+/*
+ * A request waiting on the deferral wheel.  When its delay has expired it is
+ * handed to the scheduler (or run inline if there is none).
+ */
+class XrdThrottleDeferred : public XrdJob
+{
+friend class XrdThrottleManager;
+
+public:
+
+            XrdThrottleDeferred(const char *desc="") : XrdJob(desc), m_rounds(0) {}
+virtual    ~XrdThrottleDeferred() {}
+
+private:
+int         m_rounds; // Full turns of the wheel still to wait
+};
+
 class XrdThrottleManager
 {
 
@@ -47,21 +146,44 @@ public:
 
 void        Init();
 
-void        Apply(int reqsize, int reqops, int uid);
+void        Apply(int reqsize, int reqops, XrdThrottleBucket *user);
+
+long long   Reserve(int reqsize, int reqops, XrdThrottleBucket *user);
+
+void        Release(XrdThrottleBucket *user);
+
+void        Refund(int reqsize, int reqops, XrdThrottleBucket *user);
 
-bool        IsThrottling() {return (m_ops_per_second > 0) || (m_bytes_per_second > 0);}
+void        Defer(XrdThrottleDeferred *job, long long delay_us);
+
+int         Admit(int reqsize, int reqops, XrdThrottleBucket *user);
+
+bool        IsThrottling() {return (m_ops_per_second > 0) || (m_bytes_per_second > 0)
+                                || (m_user_bytes > 0) || (m_user_ops > 0)
+                                || (m_group_bytes > 0) || (m_group_ops > 0);}
 
 void        SetThrottles(float reqbyterate, float reqoprate, int concurrency, float interval_length)
             {m_interval_length_seconds = interval_length; m_bytes_per_second = reqbyterate;
              m_ops_per_second = reqoprate; m_concurrency_limit = concurrency;}
 
+void        SetClassThrottles(float userbyterate, float useroprate,
+                              float groupbyterate, float groupoprate, int stall)
+            {m_user_bytes = userbyterate; m_user_ops = useroprate;
+             m_group_bytes = groupbyterate; m_group_ops = groupoprate;
+             m_stall_us = stall * 1000000LL;}
+
+void        SetScheduler(XrdScheduler *sched) {m_sched = sched;}
+
+int         Stats(char *buff, int blen);
+
 void        SetLoadShed(std::string &hostname, unsigned port, unsigned frequency)
             {m_loadshed_host = hostname; m_loadshed_port = port; m_loadshed_frequency = frequency;}
 
 //int         Stats(char *buff, int blen, int do_sync=0) {return m_pool.Stats(buff, blen, do_sync);}
 
-static
-int         GetUid(const char *username);
+XrdThrottleBucket *Attach(const XrdSecEntity *client);
+
+void        Detach(XrdThrottleBucket *user);
 
 XrdThrottleTimer StartIOTimer();
 
@@ -88,11 +210,25 @@ void        RecomputeInternal();
 static
 void *      RecomputeBootstrap(void *pp);
 
-int         WaitForShares();
+void        Join(XrdThrottleBucket &child);
 
-void        GetShares(int &shares, int &request);
+void        Share(XrdThrottleBucket &parent);
 
-void        StealShares(int uid, int &reqsize, int &reqops);
+void        Prune(XrdThrottleBucket &parent);
+
+void        Refill(XrdThrottleBucket &bucket, long long now, bool lock=false);
+
+void        Wheel();
+
+void        Wait(long long delay_us);
+
+static
+void *      WheelBootstrap(void *pp);
+
+int         Report(char *buff, int blen, const char *level, XrdThrottleBucket &bucket);
+
+static
+long long   Now();
 
 XrdOucTrace * m_trace;
 XrdSysError * m_log;
@@ -105,14 +241,27 @@ float       m_bytes_per_second;
 float       m_ops_per_second;
 int         m_concurrency_limit;
 
-// Maintain the shares
+// Per-class limits and the point past which requests are bounced to the client
+float       m_user_bytes;
+float       m_user_ops;
+float       m_group_bytes;
+float       m_group_ops;
+long long   m_stall_us;
+
+// The bucket hierarchy: global -> groups -> users
+XrdSysMutex       m_bucket_mutex; // Protects the hierarchy, not the tokens
+XrdThrottleBucket m_global;
+int               m_user_count;
+
+// Deferral wheel
+static const
+int         m_wheel_slots;
 static const
-int         m_max_users;
-std::vector<int> m_primary_bytes_shares;
-std::vector<int> m_secondary_bytes_shares;
-std::vector<int> m_primary_ops_shares;
-std::vector<int> m_secondary_ops_shares;
-int         m_last_round_allocation;
+int         m_wheel_tick_ms;
+XrdSysMutex m_wheel_mutex;
+std::vector<XrdThrottleDeferred *> m_wheel;
+int         m_wheel_pos;
+XrdScheduler *m_sched;
 
 // Active IO counter
 int         m_io_counter;
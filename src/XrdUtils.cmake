@@ -173,13 +173,16 @@ add_library(
   # XrdCks
   #-----------------------------------------------------------------------------
   XrdCks/XrdCksAssist.cc           XrdCks/XrdCksAssist.hh
+  XrdCks/XrdCksCalcadler32.cc      XrdCks/XrdCksCalcadler32.hh
   XrdCks/XrdCksCalccrc32.cc        XrdCks/XrdCksCalccrc32.hh
+  XrdCks/XrdCksCalccrc32c.cc       XrdCks/XrdCksCalccrc32c.hh
   XrdCks/XrdCksCalcmd5.cc          XrdCks/XrdCksCalcmd5.hh
   XrdCks/XrdCksConfig.cc           XrdCks/XrdCksConfig.hh
   XrdCks/XrdCksLoader.cc           XrdCks/XrdCksLoader.hh
   XrdCks/XrdCksManager.cc          XrdCks/XrdCksManager.hh
   XrdCks/XrdCksManOss.cc           XrdCks/XrdCksManOss.hh
-                                   XrdCks/XrdCksCalcadler32.hh
+  XrdCks/XrdCksCPU.cc              XrdCks/XrdCksCPU.hh
+                                   XrdCks/XrdCksKernel.hh
                                    XrdCks/XrdCksCalc.hh
                                    XrdCks/XrdCksData.hh
                                    XrdCks/XrdCks.hh
@@ -267,6 +267,28 @@ virtual int   Send(const
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+//! Obtain the source of the data of a pending File() callback.
+//!
+//! The Source() method may be used instead of Send() when the caller must
+//! transmit the data itself (e.g. with SSL_sendfile()). It only succeeds when
+//! the data is a single contiguous segment of one file. Calling Source() does
+//! not send anything; the caller becomes responsible for sending the data.
+//!
+//! @param  fdnum   set to the file descriptor holding the data.
+//! @param  offset  set to the file offset of the data.
+//! @param  dlen    set to the number of bytes to be sent.
+//!
+//! @return true    the arguments have been set.
+//!         false   the data cannot be described this way; use Send().
+//-----------------------------------------------------------------------------
+
+virtual bool  Source(int &fdnum, long long &offset, int &dlen)
+{
+  (void)fdnum; (void)offset; (void)dlen;
+  return false;
+}
+
 //-----------------------------------------------------------------------------
 //! Constructor and Destructor
 //-----------------------------------------------------------------------------
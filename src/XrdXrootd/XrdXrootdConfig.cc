@@ -298,7 +298,10 @@ int XrdXrootdProtocol::Configure(char *parms, XrdProtocol_Config *pi)
        if (!osFS)
           {eDest.Emsg("Config", "Unable to load file system wrapper.");
            return 0;
-          } else osFS->EnvInfo(&myEnv);
+          } else {
+           SI->setFS(osFS);
+           osFS->EnvInfo(&myEnv);
+          }
       }
 
 // Check if the diglib should be loaded. We only support the builtin one. In
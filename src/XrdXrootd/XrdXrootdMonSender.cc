@@ -0,0 +1,319 @@
+/******************************************************************************/
+/*                                                                            */
+/*                 X r d X r o o t d M o n S e n d e r . c c                  */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include "XrdNet/XrdNetMsg.hh"
+#include "XrdSys/XrdSysAtomics.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdXrootd/XrdXrootdMonSender.hh"
+#include "XrdXrootd/XrdXrootdTrace.hh"
+
+/******************************************************************************/
+/*                     S t a t i c   A l l o c a t i o n                      */
+/******************************************************************************/
+
+XrdSysError              *XrdXrootdMonSender::eDest    = 0;
+XrdNetMsg                *XrdXrootdMonSender::Dest1    = 0;
+const char               *XrdXrootdMonSender::Name1    = 0;
+int                       XrdXrootdMonSender::Mode1    = 0;
+XrdNetMsg                *XrdXrootdMonSender::Dest2    = 0;
+const char               *XrdXrootdMonSender::Name2    = 0;
+int                       XrdXrootdMonSender::Mode2    = 0;
+XrdXrootdMonSender::Ring *XrdXrootdMonSender::ringList = 0;
+XrdSysMutex               XrdXrootdMonSender::ringMutex;
+pthread_key_t             XrdXrootdMonSender::ringKey;
+XrdSysSemaphore           XrdXrootdMonSender::sndSem(0);
+int                       XrdXrootdMonSender::sndIdle  = 0;
+unsigned int              XrdXrootdMonSender::pktSeq   = 0;
+long long                 XrdXrootdMonSender::numSent  = 0;
+long long                 XrdXrootdMonSender::numDrop  = 0;
+int                       XrdXrootdMonSender::maxDepth = 0;
+bool                      XrdXrootdMonSender::isActive = false;
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+  
+extern XrdOucTrace       *XrdXrootdTrace;
+
+/******************************************************************************/
+/*                         L o c a l   F u n c t i o n s                      */
+/******************************************************************************/
+
+namespace
+{
+struct SeqOrder
+      {template<class T> bool operator()(const T &a, const T &b) const
+                                        {return (int)(a.Seq - b.Seq) < 0;}
+      };
+}
+
+/******************************************************************************/
+/* Private:                      C o l l e c t                                */
+/******************************************************************************/
+
+// Move up to pMax queued packets out of the rings, releasing any ring whose
+// owner has gone away once it is empty. Returns the number of packets moved.
+
+int XrdXrootdMonSender::Collect(Packet *pVec, int pMax)
+{
+   Ring *rP, *pP = 0, *nP;
+   unsigned int head, tail;
+   int n, pNum = 0;
+
+   ringMutex.Lock();
+   rP = ringList;
+   while(rP && pNum < pMax)
+        {nP   = rP->Next;
+         head = rP->Head;
+         tail = AtomicGet(rP->Tail);
+         if (head == tail)
+            {if (AtomicGet(rP->Orphan))
+                {if (pP) pP->Next = nP;
+                    else ringList = nP;
+                 free(rP);
+                } else pP = rP;
+             rP = nP;
+             continue;
+            }
+         n = (int)(tail - head);
+         if (n > pMax - pNum) n = pMax - pNum;
+         for (int i = 0; i < n; i++) pVec[pNum++] = rP->Slot[(head+i) & ringMask];
+         AtomicAdd(rP->Head, n);
+         pP = rP; rP = nP;
+        }
+   ringMutex.UnLock();
+   return pNum;
+}
+
+/******************************************************************************/
+/* Private:                      G e t R i n g                                */
+/******************************************************************************/
+  
+XrdXrootdMonSender::Ring *XrdXrootdMonSender::GetRing()
+{
+   Ring *rP;
+
+// Allocate a fresh ring for this thread
+//
+   if (!(rP = (Ring *)calloc(1, sizeof(Ring)))) return 0;
+   if (pthread_setspecific(ringKey, rP)) {free(rP); return 0;}
+
+// Add it to the list of rings the sender looks at
+//
+   ringMutex.Lock();
+   rP->Next = ringList; ringList = rP;
+   ringMutex.UnLock();
+   return rP;
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+  
+bool XrdXrootdMonSender::Init(XrdSysError *errp, XrdNetMsg *dest1,
+                              const char  *name1, int mode1,
+                              XrdNetMsg   *dest2, const char *name2, int mode2)
+{
+#ifdef HAVE_ATOMICS
+   pthread_t tid;
+   int rc;
+
+// Record the destinations
+//
+   eDest = errp;
+   Dest1 = dest1; Name1 = name1; Mode1 = mode1;
+   Dest2 = dest2; Name2 = name2; Mode2 = mode2;
+
+// Each thread gets its own ring, released when the thread exits
+//
+   if ((rc = pthread_key_create(&ringKey, RingDone)))
+      {eDest->Emsg("Monitor", rc, "create monitor ring key");
+       return false;
+      }
+
+// Start the sender
+//
+   if ((rc = XrdSysThread::Run(&tid, XrdXrootdMonSender::Start, 0, 0,
+                               "Monitor sender")))
+      {eDest->Emsg("Monitor", rc, "start monitor sender");
+       return false;
+      }
+   isActive = true;
+   return true;
+#else
+   return false;
+#endif
+}
+
+/******************************************************************************/
+/* Private:                     R i n g D o n e                               */
+/******************************************************************************/
+
+// Called at thread exit. The sender frees the ring after draining it.
+
+void XrdXrootdMonSender::RingDone(void *rP)
+{
+   AtomicInc(((Ring *)rP)->Orphan);
+}
+  
+/******************************************************************************/
+/*                                  S e n d                                   */
+/******************************************************************************/
+  
+void XrdXrootdMonSender::Send(int mmode, void *buff, int blen)
+{
+#ifdef HAVE_ATOMICS
+   Ring *rP;
+   Packet *pP;
+   unsigned int tail;
+   int depth;
+
+// Get this thread's ring
+//
+   if (!(rP = (Ring *)pthread_getspecific(ringKey)) && !(rP = GetRing()))
+      {AtomicInc(numDrop); return;}
+
+// Drop the packet if the sender has fallen behind
+//
+   tail  = rP->Tail;
+   depth = (int)(tail - AtomicGet(rP->Head));
+   if (depth >= ringSize) {AtomicInc(numDrop); return;}
+   if (depth >= maxDepth) maxDepth = depth+1;
+
+// Fill out the next slot and then publish it
+//
+   pP = &rP->Slot[tail & ringMask];
+   if (!(pP->Data = (char *)malloc(blen))) {AtomicInc(numDrop); return;}
+   memcpy(pP->Data, buff, blen);
+   pP->Dlen = blen;
+   pP->Mode = mmode;
+   pP->Seq  = AtomicInc(pktSeq);
+   AtomicInc(rP->Tail);
+
+// Wake up the sender if it is waiting for work
+//
+   if (AtomicCAS(sndIdle, 1, 0)) sndSem.Post();
+#endif
+}
+
+/******************************************************************************/
+/* Private:                       S e n d e r                                 */
+/******************************************************************************/
+  
+void XrdXrootdMonSender::Sender()
+{
+   static Packet pVec[maxBatch];
+   int pNum;
+
+// Drain the rings, sleeping only after announcing that we are idle and
+// finding nothing more to do (a producer that saw us idle posts a wakeup).
+//
+   while(1)
+        {if (!(pNum = Collect(pVec, maxBatch)))
+            {AtomicCAS(sndIdle, 0, 1);
+             if (!(pNum = Collect(pVec, maxBatch))) {sndSem.Wait(); continue;}
+             AtomicCAS(sndIdle, 1, 0);
+            }
+
+         // Rings are drained one after the other; restore the order in
+         // which the packets were produced before shipping them.
+         //
+         std::sort(pVec, pVec+pNum, SeqOrder());
+         if (Dest1) Ship(Dest1, Name1, Mode1, pVec, pNum);
+         if (Dest2) Ship(Dest2, Name2, Mode2, pVec, pNum);
+         for (int i = 0; i < pNum; i++) free(pVec[i].Data);
+        }
+}
+
+/******************************************************************************/
+/* Private:                         S h i p                                   */
+/******************************************************************************/
+  
+void XrdXrootdMonSender::Ship(XrdNetMsg *dest, const char *dName, int dMode,
+                              Packet *pVec, int pNum)
+{
+#ifndef NODEBUG
+   const char *TraceID = "Monitor";
+#endif
+   struct iovec ioV[maxBatch];
+   int i, ioN = 0, rc;
+
+// Select the packets wanted by this destination
+//
+   for (i = 0; i < pNum; i++)
+       if (pVec[i].Mode & dMode)
+          {ioV[ioN].iov_base = pVec[i].Data;
+           ioV[ioN].iov_len  = pVec[i].Dlen;
+           ioN++;
+          }
+   if (!ioN) return;
+
+// Send them all off and account for the ones that did not make it
+//
+   rc = dest->SendMany(ioV, ioN);
+   if (rc < 0) rc = 0;
+   AtomicAdd(numSent, rc);
+   if (rc < ioN) AtomicAdd(numDrop, ioN-rc);
+   TRACE(DEBUG, rc <<'/' <<ioN <<" packets sent to " <<dName);
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+  
+void *XrdXrootdMonSender::Start(void *carg)
+{
+   Sender();
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+  
+void XrdXrootdMonSender::Stats(long long &sent, long long &drops,
+                               int &qDepth, int &qMax)
+{
+   Ring *rP;
+
+   sent   = AtomicGet(numSent);
+   drops  = AtomicGet(numDrop);
+   qMax   = maxDepth;
+   qDepth = 0;
+   if (!isActive) return;
+
+   ringMutex.Lock();
+   rP = ringList;
+   while(rP) {qDepth += (int)(AtomicGet(rP->Tail) - rP->Head); rP = rP->Next;}
+   ringMutex.UnLock();
+}
@@ -0,0 +1,110 @@
+#ifndef __XRDXROOTDMONSENDER_HH__
+#define __XRDXROOTDMONSENDER_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                 X r d X r o o t d M o n S e n d e r . h h                  */
+/*                                                                            */
+/* (c) 2026 by the Board of Trustees of the Leland Stanford, Jr., University  */
+/*                            All Rights Reserved                             */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <pthread.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdNetMsg;
+class XrdSysError;
+
+/******************************************************************************/
+/*              C l a s s   X r d X r o o t d M o n S e n d e r               */
+/******************************************************************************/
+
+// Monitoring packets are handed off by the thread that built them into a
+// ring owned by that thread. A single sender thread drains all of the rings
+// and ships the packets to each destination in batches. When a ring is full
+// the packet is dropped and counted rather than blocking the request thread.
+//
+class XrdXrootdMonSender
+{
+public:
+
+static bool Active() {return isActive;}
+
+static bool Init(XrdSysError *errp, XrdNetMsg *dest1, const char *name1,
+                 int mode1, XrdNetMsg *dest2, const char *name2, int mode2);
+
+static void Send(int mmode, void *buff, int blen);
+
+static void Stats(long long &sent, long long &drops, int &qDepth, int &qMax);
+
+static void *Start(void *carg);
+
+private:
+
+static const int    ringSize  = 256;    // Power of 2
+static const int    ringMask  = ringSize-1;
+static const int    maxBatch  = 256;
+
+struct Packet
+      {char         *Data;
+       int           Dlen;
+       int           Mode;
+       unsigned int  Seq;
+      };
+
+struct Ring
+      {Ring         *Next;
+       unsigned int  Head;                // Only updated by the sender
+       char          Pad1[64-sizeof(unsigned int)];
+       unsigned int  Tail;                // Only updated by the owning thread
+       char          Pad2[64-sizeof(unsigned int)];
+       int           Orphan;              // Owning thread has exited
+       Packet        Slot[ringSize];
+      };
+
+static int          Collect(Packet *pVec, int pMax);
+static Ring        *GetRing();
+static void         RingDone(void *rP);
+static void         Sender();
+static void         Ship(XrdNetMsg *dest, const char *dName, int dMode,
+                         Packet *pVec, int pNum);
+
+static XrdSysError     *eDest;
+static XrdNetMsg       *Dest1;
+static const char      *Name1;
+static int              Mode1;
+static XrdNetMsg       *Dest2;
+static const char      *Name2;
+static int              Mode2;
+static Ring            *ringList;
+static XrdSysMutex      ringMutex;
+static pthread_key_t    ringKey;
+static XrdSysSemaphore  sndSem;
+static int              sndIdle;
+static unsigned int     pktSeq;
+static long long        numSent;
+static long long        numDrop;
+static int              maxDepth;
+static bool             isActive;
+};
+#endif
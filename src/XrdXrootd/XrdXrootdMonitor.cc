@@ -49,6 +49,7 @@
 #include "Xrd/XrdScheduler.hh"
 #include "XrdXrootd/XrdXrootdMonitor.hh"
 #include "XrdXrootd/XrdXrootdMonFile.hh"
+#include "XrdXrootd/XrdXrootdMonSender.hh"
 #include "XrdXrootd/XrdXrootdTrace.hh"
 
 /******************************************************************************/
@@ -594,6 +595,13 @@ int XrdXrootdMonitor::Init(XrdScheduler *sp,    XrdSysError *errp,
           }
       }
 
+// Hand packets off to a background sender when we can. Otherwise, they are
+// sent synchronously by the thread that produced them.
+//
+   if (!XrdXrootdMonSender::Init(eDest, InetDest1, Dest1, monMode1,
+                                        InetDest2, Dest2, monMode2))
+      eDest->Emsg("Monitor", "Monitor packets will be sent synchronously.");
+
 // If there is a destination that is only collecting file events, then
 // allocate a global monitor object but don't start the timer just yet.
 //
@@ -1053,6 +1061,11 @@ int XrdXrootdMonitor::Send(int monMode, void *buff, int blen)
     static XrdSysMutex sendMutex;
     int rc1, rc2;
 
+    if (XrdXrootdMonSender::Active())
+       {XrdXrootdMonSender::Send(monMode, buff, blen);
+        return 0;
+       }
+
     sendMutex.Lock();
     if (monMode & monMode1 && InetDest1)
        {rc1  = InetDest1->Send((char *)buff, blen);
@@ -31,6 +31,7 @@
   
 #include "Xrd/XrdStats.hh"
 #include "XrdSfs/XrdSfsInterface.hh"
+#include "XrdXrootd/XrdXrootdMonSender.hh"
 #include "XrdXrootd/XrdXrootdResponse.hh"
 #include "XrdXrootd/XrdXrootdStats.hh"
  
@@ -88,11 +89,14 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
    "<sig><ok>%d</ok><bad>%d</bad><ign>%d</ign></sig>"
    "<aio><num>%lld</num><max>%d</max><rej>%lld</rej></aio>"
    "<err>%d</err><rdr>%lld</rdr><dly>%d</dly>"
-   "<lgn><num>%d</num><af>%d</af><au>%d</au><ua>%d</ua></lgn></stats>";
+   "<lgn><num>%d</num><af>%d</af><au>%d</au><ua>%d</ua></lgn>"
+   "<mon><pkt>%lld</pkt><drop>%lld</drop><qd>%d</qd><qmax>%d</qmax></mon>"
+   "</stats>";
 //                                   1 2 3 4 5 6 7 8
    static const long long LLMax = 0x7fffffffffffffffLL;
    static const int       INMax = 0x7fffffff;
-   int len;
+   long long monSent, monDrop;
+   int len, monQD, monQMax;
 
 // If no buffer, caller wants the maximum size we will generate
 //
@@ -104,10 +108,15 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                       INMax, INMax,
                       INMax, INMax, INMax,
                       LLMax, INMax, LLMax, INMax, LLMax, INMax,
-                      INMax, INMax, INMax, INMax);
+                      INMax, INMax, INMax, INMax,
+                      LLMax, LLMax, INMax, INMax);
        return len + (fsP ? fsP->getStats(0,0) : 0);
       }
 
+// Get the monitoring counters
+//
+   XrdXrootdMonSender::Stats(monSent, monDrop, monQD, monQMax);
+
 // Format our statistics
 //
    statsMutex.Lock();
@@ -118,7 +127,8 @@ int XrdXrootdStats::Stats(char *buff, int blen, int do_sync)
                   putfCnt, miscCnt,
                   aokSCnt, badSCnt, ignSCnt,
                   AsyncNum, AsyncMax, AsyncRej, errorCnt, redirCnt, stallCnt,
-                  LoginAT, AuthBad, LoginAU, LoginUA);
+                  LoginAT, AuthBad, LoginAU, LoginUA,
+                  monSent, monDrop, monQD, monQMax);
    statsMutex.UnLock();
 
 // Now include filesystem statistics and return
@@ -86,3 +86,23 @@ int XrdXrootdTransSend::Send(const struct iovec *headP, int headN,
    delete [] sfVec;
    return (k < 0 ? -1 : 0);
 }
+
+/******************************************************************************/
+/*                                S o u r c e                                 */
+/******************************************************************************/
+
+bool XrdXrootdTransSend::Source(int &fdnum, long long &offset, int &dlen)
+{
+// Only a single file segment can be described (element 0 of a vector is
+// reserved for the response header).
+//
+   if (sfFD >= 0)
+      {fdnum = sfFD; offset = sfOff; dlen = sfLen;
+       return true;
+      }
+   if (sfFD == -2 && sfVP[1].fdnum >= 0)
+      {fdnum = sfVP[1].fdnum; offset = sfVP[1].offset; dlen = sfVP[1].sendsz;
+       return true;
+      }
+   return false;
+}
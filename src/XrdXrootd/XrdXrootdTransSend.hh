@@ -49,6 +49,8 @@ public:
                    int           tailN  //!< array count
                   );
 
+        bool  Source(int &fdnum, long long &offset, int &dlen);
+
               XrdXrootdTransSend(XrdLink *lP, kXR_char *sid, kXR_unt16 req,
                                  long long offset, int dlen, int fdnum)
                                 : Context(lP, sid, req),
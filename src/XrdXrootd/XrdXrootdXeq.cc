@@ -120,6 +120,118 @@ namespace
 {
 static const int op_isOpen    = 0x00010000;
 static const int op_isRead    = 0x00020000;
+
+/******************************************************************************/
+/*                   R e a d V   P i p e l i n e   H e l p e r s              */
+/******************************************************************************/
+
+// Lay out the elements of a read vector, starting at vBeg, into a response
+// buffer of Quantum bytes. Each element is preceded by its response header and
+// its data pointer is set to the corresponding place in the buffer. Returns
+// the index of the first element that did not fit and the buffer length used.
+//
+int rvLayout(XrdOucIOVec *rdVec, int vBeg, int vNum,
+             char *buff, int Quantum, int &bLen)
+{
+   const int hdrSZ = sizeof(readahead_list);
+   struct readahead_list respHdr;
+   int i, Qleft = Quantum;
+
+   for (i = vBeg; i < vNum && Qleft >= rdVec[i].size + hdrSZ; i++)
+       {memcpy(respHdr.fhandle, &rdVec[i].info, sizeof(respHdr.fhandle));
+        respHdr.rlen   = htonl(rdVec[i].size);
+        respHdr.offset = htonll(rdVec[i].offset);
+        memcpy(buff, &respHdr, hdrSZ);
+        rdVec[i].data = buff + hdrSZ;
+        buff  += rdVec[i].size + hdrSZ;
+        Qleft -= rdVec[i].size + hdrSZ;
+       }
+   bLen = Quantum - Qleft;
+   return i;
+}
+
+// Read the elements vBeg through vEnd-1 of a laid out read vector issuing one
+// readv() per run of elements that refer to the same file. Returns true upon
+// success. Otherwise, returns false with the failing file and its result.
+//
+bool rvRead(XrdXrootdFile **rvFile, XrdOucIOVec *rdVec, int vBeg, int vEnd,
+            XrdXrootdFile *&eFile, XrdSfsXferSize &eRC)
+{
+   XrdSfsXferSize rdAmt, xfrSZ;
+   int i;
+
+   while(vBeg < vEnd)
+        {rdAmt = rdVec[vBeg].size;
+         for (i = vBeg+1; i < vEnd && rvFile[i] == rvFile[vBeg]; i++)
+             rdAmt += rdVec[i].size;
+         xfrSZ = rvFile[vBeg]->XrdSfsp->readv(&rdVec[vBeg], i-vBeg);
+         if (xfrSZ != rdAmt) {eFile = rvFile[vBeg]; eRC = xfrSZ; return false;}
+         vBeg = i;
+        }
+   return true;
+}
+
+// A read-ahead of the next readv response buffer that runs in a scheduler
+// thread while the current buffer is being sent. Should the job not have
+// started by the time its result is needed, the requester claims it and does
+// the read itself. This avoids deadlocks should all scheduler threads be busy.
+// Whoever finishes last with the job object deletes it.
+//
+class XrdXrootdRVJob : public XrdJob
+{
+public:
+
+void DoIt()
+     {jobCV.Lock();
+      if (jobState == isClaimed) {jobCV.UnLock(); delete this; return;}
+      jobState = isRunning;
+      jobCV.UnLock();
+      jobOK = rvRead(jobFile, jobVec, jobBeg, jobEnd, jobEFile, jobERC);
+      jobCV.Lock();
+      jobState = isDone;
+      jobCV.Signal();
+      jobCV.UnLock();
+     }
+
+bool Finish(XrdXrootdFile *&eFile, XrdSfsXferSize &eRC)
+     {XrdXrootdFile **fileP = jobFile;
+      XrdOucIOVec *vecP = jobVec;
+      int vBeg = jobBeg, vEnd = jobEnd;
+      bool aOK;
+      jobCV.Lock();
+      if (jobState == isQueued)
+         {jobState = isClaimed;
+          jobCV.UnLock();
+          return rvRead(fileP, vecP, vBeg, vEnd, eFile, eRC);
+         }
+      while(jobState != isDone) jobCV.Wait();
+      jobCV.UnLock();
+      if (!(aOK = jobOK)) {eFile = jobEFile; eRC = jobERC;}
+      delete this;
+      return aOK;
+     }
+
+     XrdXrootdRVJob(XrdXrootdFile **fileP, XrdOucIOVec *vecP, int vBeg,
+                    int vEnd)
+                   : XrdJob("readv pipeline"), jobCV(0), jobFile(fileP),
+                     jobVec(vecP), jobEFile(0), jobERC(0), jobBeg(vBeg),
+                     jobEnd(vEnd), jobState(isQueued), jobOK(false) {}
+    ~XrdXrootdRVJob() {}
+
+private:
+
+enum jState {isQueued = 0, isRunning, isDone, isClaimed};
+
+XrdSysCondVar   jobCV;
+XrdXrootdFile **jobFile;
+XrdOucIOVec    *jobVec;
+XrdXrootdFile  *jobEFile;
+XrdSfsXferSize  jobERC;
+int             jobBeg;
+int             jobEnd;
+jState          jobState;
+bool            jobOK;
+};
 }
  
 /******************************************************************************/
@@ -2125,17 +2237,26 @@ int XrdXrootdProtocol::do_ReadV()
 // it and put all the individual buffers in a single one it's up to the
 // client to interpret it. Code originally developed by Leandro Franco, CERN.
 // The readv file system code originally added by Brian Bockelman, UNL.
+// When the response spans more than one buffer, the next buffer is read by
+// a scheduler thread while the current one is being sent so that disk and
+// network I/O overlap.
 //
    const int hdrSZ = sizeof(readahead_list);
-   struct XrdOucIOVec     rdVec[maxRvecsz+1];
-   struct readahead_list *raVec, respHdr;
+   struct XrdOucIOVec     rdVec[maxRvecsz];
+   XrdXrootdFile         *rvFile[maxRvecsz];
+   struct readahead_list *raVec;
+   XrdXrootdRVJob        *rvJob;
+   XrdXrootdFile         *runFile, *eFile;
+   XrdBuffer             *pBuff = 0;
    long long totSZ;
-   XrdSfsXferSize rdVAmt, rdVXfr, xfrSZ = 0;
-   int rdVBeg, rdVBreak, rdVNow, rdVNum, rdVecNum;
-   int currFH, i, k, Quantum, Qleft, rdVecLen = Request.header.dlen;
+   XrdSfsXferSize xfrSZ, runXfr;
+   char *rvBuff[2];
+   int currFH, i, k, Quantum, rdVecNum, rdVecLen = Request.header.dlen;
+   int bNow, bLen, nLen, qBeg, qEnd, nEnd, runBeg, rc;
    int rvMon = Monitor.InOut();
    int ioMon = (rvMon > 1);
-   char *buffp, vType = (ioMon ? XROOTD_MON_READU : XROOTD_MON_READV);
+   bool aOK, more;
+   char vType = (ioMon ? XROOTD_MON_READU : XROOTD_MON_READV);
 
 // Compute number of elements in the read vector and make sure we have no
 // partial elements.
@@ -2171,107 +2292,127 @@ int XrdXrootdProtocol::do_ReadV()
         memcpy(&rdVec[i].info, raVec[i].fhandle, sizeof(int));
        }
 
-// Now add an extra dummy element to force flushing of the read vector.
-//
-   rdVec[i].offset = -1;
-   rdVec[i].size   =  0;
-   rdVec[i].info   = -1;
-   rdVBreak = rdVecNum;
-   rdVecNum++;
-
 // We limit the total size of the read to be 2GB for convenience
 //
    if (totSZ > 0x7fffffffLL)
       return Response.Send(kXR_NoMemory, "Total readv transfer is too large");
 
-// Calculate the transfer unit which will be the smaller of the maximum
-// transfer unit and the actual amount we need to transfer.
-//
-   if ((Quantum = static_cast<int>(totSZ)) > maxTransz) Quantum = maxTransz;
-   
-// Now obtain the right size buffer
-//
-   if ((Quantum < halfBSize && Quantum > 1024) || Quantum > argp->bsize)
-      {if ((k = getBuff(1, Quantum)) <= 0) return k;}
-      else if (hcNow < hcNext) hcNow++;
-
 // Check that we really have at least one file open. This needs to be done 
 // only once as this code runs in the control thread.
 //
    if (!FTab) return Response.Send(kXR_FileNotOpen,
                               "readv does not refer to an open file");
 
-// Preset the previous and current file handle to be the handle of the first
-// element and make sure the file is actually open.
+// Resolve the file associated with each element, making sure that each file
+// is actually open. We do this up front as the reads may be done by another
+// thread which must not access the file table.
 //
    currFH = rdVec[0].info;
-   memcpy(respHdr.fhandle, &currFH, sizeof(respHdr.fhandle));
    if (!(myFile = FTab->Get(currFH))) return Response.Send(kXR_FileNotOpen,
                                       "readv does not refer to an open file");
-
-// Setup variables for running through the list.
-//
-   Qleft = Quantum; buffp = argp->buff; rvSeq++;
-   rdVBeg = rdVNow = 0; rdVXfr = rdVAmt = 0;
-
-// Now run through the elements
-//
    for (i = 0; i < rdVecNum; i++)
        {if (rdVec[i].info != currFH)
-           {xfrSZ = myFile->XrdSfsp->readv(&rdVec[rdVNow], i-rdVNow);
-            if (xfrSZ != rdVAmt) break;
-            rdVNum = i - rdVBeg; rdVXfr += rdVAmt;
-            myFile->Stats.rvOps(rdVXfr, rdVNum);
-            if (rvMon)
-               {Monitor.Agent->Add_rv(myFile->Stats.FileID, htonl(rdVXfr),
-                                              htons(rdVNum), rvSeq, vType);
-                if (ioMon) for (k = rdVBeg; k < i; k++)
-                    Monitor.Agent->Add_rd(myFile->Stats.FileID,
-                            htonl(rdVec[k].size), htonll(rdVec[k].offset));
-               }
-            rdVXfr = rdVAmt = 0;
-            if (i == rdVBreak) break;
-            rdVBeg = rdVNow = i; currFH = rdVec[i].info;
-            memcpy(respHdr.fhandle, &currFH, sizeof(respHdr.fhandle));
+           {currFH = rdVec[i].info;
             if (!(myFile = FTab->Get(currFH)))
                return Response.Send(kXR_FileNotOpen,
                                     "readv does not refer to an open file");
+           }
+        rvFile[i] = myFile;
+       }
+
+// Calculate the transfer unit which will be the smaller of the maximum
+// transfer unit and the actual amount we need to transfer.
+//
+   if ((Quantum = static_cast<int>(totSZ)) > maxTransz) Quantum = maxTransz;
+   
+// Now obtain the right size buffer
+//
+   if ((Quantum < halfBSize && Quantum > 1024) || Quantum > argp->bsize)
+      {if ((k = getBuff(1, Quantum)) <= 0) return k;}
+      else if (hcNow < hcNext) hcNow++;
+
+// Lay out and read the first buffer full of data
+//
+   rvBuff[0] = argp->buff; bNow = 0; rvSeq++;
+   qBeg = 0;
+   qEnd = rvLayout(rdVec, 0, rdVecNum, rvBuff[0], Quantum, bLen);
+   aOK  = rvRead(rvFile, rdVec, 0, qEnd, eFile, xfrSZ);
+
+// If the response needs more than one buffer, get a second one so that we can
+// read the next buffer while sending the current one. Should we not get one,
+// we simply read and send serially using a single buffer.
+//
+   if (qEnd < rdVecNum && (pBuff = BPool->Obtain(Quantum)))
+      rvBuff[1] = pBuff->buff;
+
+// Now run through the buffers, accounting for each one as it gets sent
+//
+   runFile = rvFile[0]; runBeg = 0; runXfr = 0; rc = 0;
+   while(aOK)
+        {for (i = qBeg; i < qEnd || i == rdVecNum; i++)
+             {if (i == rdVecNum || rvFile[i] != runFile)
+                 {runFile->Stats.rvOps(runXfr, i-runBeg);
+                  if (rvMon)
+                     {Monitor.Agent->Add_rv(runFile->Stats.FileID,htonl(runXfr),
+                                            htons(i-runBeg), rvSeq, vType);
+                      if (ioMon) for (k = runBeg; k < i; k++)
+                         Monitor.Agent->Add_rd(runFile->Stats.FileID,
+                               htonl(rdVec[k].size), htonll(rdVec[k].offset));
+                     }
+                  if (i == rdVecNum) break;
+                  runFile = rvFile[i]; runBeg = i; runXfr = 0;
+                 }
+              runXfr += rdVec[i].size;
+              TRACEP(FS,"fh=" <<rdVec[i].info <<" readV " << rdVec[i].size
+                          <<'@' <<rdVec[i].offset);
+             }
+
+         // Start reading the next buffer, if any, while we send this one
+         //
+         rvJob = 0;
+         if ((more = (qEnd < rdVecNum)) && pBuff)
+            {nEnd = rvLayout(rdVec,qEnd,rdVecNum,rvBuff[bNow^1],Quantum,nLen);
+             rvJob = new XrdXrootdRVJob(rvFile, rdVec, qEnd, nEnd);
+             Sched->Schedule((XrdJob *)rvJob);
             }
 
-        if (Qleft < (rdVec[i].size + hdrSZ))
-           {if (rdVAmt)
-               {xfrSZ = myFile->XrdSfsp->readv(&rdVec[rdVNow], i-rdVNow);
-                if (xfrSZ != rdVAmt) break;
-               }
-            if (Response.Send(kXR_oksofar,argp->buff,Quantum-Qleft) < 0)
-               return -1;
-            Qleft = Quantum;
-            buffp = argp->buff;
-            rdVNow = i; rdVXfr += rdVAmt; rdVAmt = 0;
-           }
+         // Send the current buffer. This is the last response if no more
+         // elements are left.
+         //
+         if (!more) {rc = Response.Send(rvBuff[bNow], bLen); break;}
+         if (Response.Send(kXR_oksofar, rvBuff[bNow], bLen) < 0)
+            {if (rvJob) rvJob->Finish(eFile, xfrSZ);
+             rc = -1;
+             break;
+            }
 
-        xfrSZ = rdVec[i].size; rdVAmt += xfrSZ;
-        respHdr.rlen   = htonl(xfrSZ);
-        respHdr.offset = htonll(rdVec[i].offset);
-        memcpy(buffp, &respHdr, hdrSZ);
-        rdVec[i].data = buffp + hdrSZ;
-        buffp += (xfrSZ+hdrSZ); Qleft -= (xfrSZ+hdrSZ);
-        TRACEP(FS,"fh=" <<currFH <<" readV " << xfrSZ <<'@' <<rdVec[i].offset);
-       }
+         // Obtain the next buffer either from the pipeline or by reading it
+         //
+         if (rvJob) {aOK = rvJob->Finish(eFile, xfrSZ); bNow ^= 1;}
+            else {nEnd = rvLayout(rdVec,qEnd,rdVecNum,rvBuff[bNow],Quantum,nLen);
+                  aOK  = rvRead(rvFile, rdVec, qEnd, nEnd, eFile, xfrSZ);
+                 }
+         qBeg = qEnd; qEnd = nEnd; bLen = nLen;
+        }
 
-// Check if we have an error here. This is indicated when rdVAmt is not zero.
+// Release the pipeline buffer, if any
 //
-   if (rdVAmt)
-      {if (xfrSZ >= 0)
+   if (pBuff) BPool->Release(pBuff);
+
+// Check if we have an error here.
+//
+   if (!aOK)
+      {myFile = eFile;
+       if (xfrSZ >= 0)
           {xfrSZ = SFS_ERROR;
            myFile->XrdSfsp->error.setErrInfo(-ENODATA,"readv past EOF");
           }
        return fsError(xfrSZ, 0, myFile->XrdSfsp->error, 0, 0);
       }
 
-// All done, return result of the last segment or just zero
+// All done, return result of the last send
 //
-   return (Quantum != Qleft ? Response.Send(argp->buff, Quantum-Qleft) : 0);
+   return rc;
 }
 
 /******************************************************************************/
@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <XrdCl/XrdClFileSystem.hh>
+#include <XrdSys/XrdSysPthread.hh>
+#include "CppUnitXrdHelpers.hh"
+
+#include <sys/time.h>
+#include <iostream>
+
+#include "TestEnv.hh"
+
+using namespace XrdClTests;
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class RoundTripBenchmark: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( RoundTripBenchmark );
+      CPPUNIT_TEST( PingBenchmark );
+    CPPUNIT_TEST_SUITE_END();
+    void PingBenchmark();
+};
+
+//------------------------------------------------------------------------------
+// Benchmarks live in their own registry so that they only run when asked for
+// by name (Benchmarks/RoundTripBenchmark) and never as a part of All Tests
+//------------------------------------------------------------------------------
+CPPUNIT_TEST_SUITE_NAMED_REGISTRATION( RoundTripBenchmark, "Benchmarks" );
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Keep a fixed number of pings in flight until the requested number of
+  // round trips has completed
+  //----------------------------------------------------------------------------
+  class PingWindow: public XrdCl::ResponseHandler
+  {
+    public:
+      PingWindow( XrdCl::FileSystem &fs, uint32_t total ):
+        pFs( fs ), pTotal( total ), pIssued( 0 ), pDone( 0 ), pFailed( 0 ),
+        pCond( 0 ) {}
+
+      //------------------------------------------------------------------------
+      // Issue the next ping if there is one left to do
+      //------------------------------------------------------------------------
+      bool Issue()
+      {
+        pCond.Lock();
+        if( pIssued >= pTotal )
+        {
+          pCond.UnLock();
+          return false;
+        }
+        ++pIssued;
+        pCond.UnLock();
+
+        XrdCl::XRootDStatus st = pFs.Ping( this );
+        if( !st.IsOK() )
+          Done( false );
+        return true;
+      }
+
+      virtual void HandleResponse( XrdCl::XRootDStatus *status,
+                                   XrdCl::AnyObject    *response )
+      {
+        bool ok = status->IsOK();
+        delete status;
+        delete response;
+        Issue();
+        Done( ok );
+      }
+
+      //------------------------------------------------------------------------
+      // Wait for all the round trips to complete
+      //------------------------------------------------------------------------
+      uint32_t Wait()
+      {
+        XrdSysCondVarHelper lck( pCond );
+        while( pDone < pTotal )
+          pCond.Wait();
+        return pFailed;
+      }
+
+    private:
+      void Done( bool ok )
+      {
+        XrdSysCondVarHelper lck( pCond );
+        if( !ok )
+          ++pFailed;
+        if( ++pDone == pTotal )
+          pCond.Broadcast();
+      }
+
+      XrdCl::FileSystem &pFs;
+      uint32_t           pTotal;
+      uint32_t           pIssued;
+      uint32_t           pDone;
+      uint32_t           pFailed;
+      XrdSysCondVar      pCond;
+  };
+
+  double Now()
+  {
+    timeval tv;
+    gettimeofday( &tv, 0 );
+    return tv.tv_sec + tv.tv_usec / 1e6;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Measure round trips per second with many requests outstanding
+//------------------------------------------------------------------------------
+void RoundTripBenchmark::PingBenchmark()
+{
+  using namespace XrdCl;
+
+  Env *testEnv = TestEnv::GetEnv();
+
+  std::string address;
+  CPPUNIT_ASSERT( testEnv->GetString( "MainServerURL", address ) );
+  URL url( address );
+  CPPUNIT_ASSERT( url.IsValid() );
+
+  FileSystem fs( url );
+  CPPUNIT_ASSERT_XRDST( fs.Ping() );
+
+  const uint32_t total      = 200000;
+  const uint32_t inFlight[] = { 1, 16, 256, 4096 };
+
+  for( size_t i = 0; i < sizeof( inFlight ) / sizeof( uint32_t ); ++i )
+  {
+    PingWindow window( fs, total );
+    double start = Now();
+    for( uint32_t j = 0; j < inFlight[i]; ++j )
+      window.Issue();
+    CPPUNIT_ASSERT( window.Wait() == 0 );
+    double elapsed = Now() - start;
+
+    std::cout << "[RoundTripBenchmark] in flight: " << inFlight[i];
+    std::cout << ", round trips: " << total;
+    std::cout << ", seconds: " << elapsed;
+    std::cout << ", round trips/s: " << (uint64_t)( total / elapsed );
+    std::cout << std::endl;
+  }
+}
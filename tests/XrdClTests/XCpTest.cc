@@ -0,0 +1,284 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "CppUnitXrdHelpers.hh"
+#include "XrdCl/XrdClXCpSrc.hh"
+#include "XrdCl/XrdClXCpCtx.hh"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <map>
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class XCpTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( XCpTest );
+      CPPUNIT_TEST( ModelConvergenceTest );
+      CPPUNIT_TEST( ModelWindowBoundsTest );
+      CPPUNIT_TEST( ModelProbeRttTest );
+      CPPUNIT_TEST( SpeculationTest );
+      CPPUNIT_TEST( DuplicateChunkTest );
+    CPPUNIT_TEST_SUITE_END();
+    void ModelConvergenceTest();
+    void ModelWindowBoundsTest();
+    void ModelProbeRttTest();
+    void SpeculationTest();
+    void DuplicateChunkTest();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( XCpTest );
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // A source behind a link with the given bottleneck rate and round trip
+  // time, read the way XCpSrc reads: at least one chunk and at most twice
+  // the number of parallel chunks in flight, otherwise bounded by the
+  // window of the model
+  //----------------------------------------------------------------------------
+  class SimulatedLink
+  {
+    public:
+      SimulatedLink( XrdCl::XCpDeliveryModel &model, double rate, double rtt,
+                     uint8_t parallel ):
+        pModel( model ), pRate( rate ), pRtt( rtt ), pParallel( parallel ),
+        pNow( 0 ), pBusy( 0 ), pOffset( 0 ), pInFlight( 0 ), pMinWindow( -1 ) {}
+
+      //------------------------------------------------------------------------
+      // Run until the given number of chunks has been delivered
+      //------------------------------------------------------------------------
+      void Run( size_t deliveries )
+      {
+        for( size_t i = 0; i < deliveries; ++i )
+        {
+          while( pPending.empty() || ( pInFlight < pModel.Window() &&
+                 pPending.size() < size_t( pParallel ) * 2 ) )
+          {
+            uint64_t length = pModel.ChunkSize();
+            pModel.Issued( pOffset, pInFlight, pNow );
+            pBusy = std::max( pNow + pRtt, pBusy ) + length / pRate;
+            pPending.insert( std::make_pair( pBusy, std::make_pair( pOffset, length ) ) );
+            pOffset   += length;
+            pInFlight += length;
+          }
+
+          Pending::iterator itr = pPending.begin();
+          pNow = itr->first;
+          pModel.Delivered( itr->second.first, itr->second.second, pNow );
+          pInFlight -= itr->second.second;
+          pPending.erase( itr );
+          pMinWindow = std::min( pMinWindow, pModel.Window() );
+        }
+      }
+
+      //------------------------------------------------------------------------
+      // Deliver everything that is in flight
+      //------------------------------------------------------------------------
+      void Drain()
+      {
+        Pending::iterator itr;
+        for( itr = pPending.begin() ; itr != pPending.end() ; ++itr )
+        {
+          pNow = itr->first;
+          pModel.Delivered( itr->second.first, itr->second.second, pNow );
+        }
+        pPending.clear();
+        pInFlight = 0;
+      }
+
+      double   Now()       const { return pNow; }
+      uint64_t Requested() const { return pOffset; }
+      uint64_t MinWindow() const { return pMinWindow; }
+
+    private:
+      typedef std::multimap<double, std::pair<uint64_t, uint64_t> > Pending;
+
+      XrdCl::XCpDeliveryModel &pModel;
+      double                   pRate;
+      double                   pRtt;
+      uint8_t                  pParallel;
+      double                   pNow;
+      double                   pBusy;
+      uint64_t                 pOffset;
+      uint64_t                 pInFlight;
+      uint64_t                 pMinWindow;
+      Pending                  pPending;
+  };
+}
+
+//------------------------------------------------------------------------------
+// The model finds the rate and the round trip time of the link
+//------------------------------------------------------------------------------
+void XCpTest::ModelConvergenceTest()
+{
+  const uint32_t chunkSize = 1048576;
+  XrdCl::XCpDeliveryModel model( chunkSize, 4 );
+  CPPUNIT_ASSERT( model.BtlBw() == 0 );
+  CPPUNIT_ASSERT( model.ChunkSize() == chunkSize );
+  CPPUNIT_ASSERT( model.Window() == uint64_t( chunkSize ) * 4 );
+
+  SimulatedLink link( model, 1e8, 0.02, 4 );
+  link.Run( 500 );
+
+  // the round trip time includes the transfer of a chunk (10.5ms)
+  CPPUNIT_ASSERT( model.BtlBw() > 0.99e8 && model.BtlBw() < 1.01e8 );
+  CPPUNIT_ASSERT( model.RtProp() > 0.030 && model.RtProp() < 0.031 );
+
+  // the window is twice the bandwidth delay product
+  CPPUNIT_ASSERT( model.Window() > 6000000 && model.Window() < 6200000 );
+  CPPUNIT_ASSERT( model.ChunkSize() == chunkSize );
+
+  // which is enough to keep the link busy
+  CPPUNIT_ASSERT( link.Requested() / link.Now() > 0.95e8 );
+
+  // a reset forgets everything
+  model.Reset();
+  CPPUNIT_ASSERT( model.BtlBw() == 0 );
+  CPPUNIT_ASSERT( model.RtProp() == 0 );
+  CPPUNIT_ASSERT( model.Window() == uint64_t( chunkSize ) * 4 );
+}
+
+//------------------------------------------------------------------------------
+// The window and the chunk size never leave the configured bounds
+//------------------------------------------------------------------------------
+void XCpTest::ModelWindowBoundsTest()
+{
+  // a long fat link would need more than twice the configured chunks
+  XrdCl::XCpDeliveryModel fat( 8388608, 4 );
+  SimulatedLink fatLink( fat, 1e9, 0.5, 4 );
+  fatLink.Run( 200 );
+  CPPUNIT_ASSERT( fat.Window() == uint64_t( 8388608 ) * 4 * 2 );
+  CPPUNIT_ASSERT( fat.ChunkSize() == 8388608 );
+
+  // a short thin one gets the smallest chunks
+  XrdCl::XCpDeliveryModel thin( 8388608, 4 );
+  SimulatedLink thinLink( thin, 1e7, 0.001, 4 );
+  thinLink.Run( 200 );
+  CPPUNIT_ASSERT( thin.ChunkSize() == 1048576 );
+  CPPUNIT_ASSERT( thin.Window() >= 2 * 1048576 && thin.Window() < 2300000 );
+  CPPUNIT_ASSERT( thinLink.Requested() / thinLink.Now() > 0.95e7 );
+
+  // in between chunks are 64k aligned
+  XrdCl::XCpDeliveryModel mid( 8388608, 4 );
+  SimulatedLink midLink( mid, 1e9, 0.002, 4 );
+  midLink.Run( 500 );
+  CPPUNIT_ASSERT( mid.ChunkSize() > 1048576 && mid.ChunkSize() < 8388608 );
+  CPPUNIT_ASSERT( mid.ChunkSize() % 65536 == 0 );
+
+  // chunks never get bigger than configured
+  XrdCl::XCpDeliveryModel small( 262144, 2 );
+  SimulatedLink smallLink( small, 1e8, 0.05, 2 );
+  smallLink.Run( 200 );
+  CPPUNIT_ASSERT( small.ChunkSize() == 262144 );
+  CPPUNIT_ASSERT( small.Window() == 262144 * 2 * 2 );
+}
+
+//------------------------------------------------------------------------------
+// A full pipeline is drained now and then to measure the round trip
+// time again, which keeps the estimate from creeping up with the queue
+//------------------------------------------------------------------------------
+void XCpTest::ModelProbeRttTest()
+{
+  XrdCl::XCpDeliveryModel model( 1048576, 4 );
+  SimulatedLink link( model, 1e8, 0.02, 4 );
+  link.Run( 5000 );
+
+  CPPUNIT_ASSERT( link.Now() > 30 );
+  CPPUNIT_ASSERT( link.MinWindow() == 0 );
+  CPPUNIT_ASSERT( model.RtProp() > 0.030 && model.RtProp() < 0.031 );
+  CPPUNIT_ASSERT( link.Requested() / link.Now() > 0.9e8 );
+}
+
+//------------------------------------------------------------------------------
+// The conditions for requesting chunks of another source
+//------------------------------------------------------------------------------
+void XCpTest::SpeculationTest()
+{
+  XrdCl::XCpDeliveryModel fast( 8388608, 4 ), slow( 8388608, 4 ),
+                          peer( 8388608, 4 ), fresh( 8388608, 4 );
+  SimulatedLink fastLink( fast, 1e9, 0.01, 4 );
+  fastLink.Run( 200 );
+  SimulatedLink slowLink( slow, 1e8, 0.01, 4 );
+  slowLink.Run( 200 );
+  SimulatedLink peerLink( peer, 1.2e8, 0.01, 4 );
+  peerLink.Run( 200 );
+
+  // only a markedly faster source speculates
+  CPPUNIT_ASSERT( fast.Outpaces( slow ) );
+  CPPUNIT_ASSERT( !slow.Outpaces( fast ) );
+  CPPUNIT_ASSERT( !peer.Outpaces( slow ) );
+  CPPUNIT_ASSERT( !slow.Outpaces( peer ) );
+  CPPUNIT_ASSERT( !fresh.Outpaces( slow ) );
+  CPPUNIT_ASSERT( fast.Outpaces( fresh ) );
+
+  // a source with nothing outstanding or nothing known is never overdue
+  CPPUNIT_ASSERT( !fresh.Overdue( 0, 1000 ) );
+  fresh.Issued( 0, 0, 0 );
+  CPPUNIT_ASSERT( !fresh.Overdue( 1048576, 1000 ) );
+
+  XrdCl::XCpDeliveryModel model( 1048576, 4 );
+  SimulatedLink link( model, 1e8, 0.02, 4 );
+  link.Run( 200 );
+  link.Drain();
+  CPPUNIT_ASSERT( model.BtlBw() > 0.99e8 && model.BtlBw() < 1.01e8 );
+  CPPUNIT_ASSERT( model.RtProp() > 0.030 && model.RtProp() < 0.031 );
+  double now = link.Now();
+  CPPUNIT_ASSERT( !model.Overdue( 0, now + 1000 ) );
+
+  // with 1MB in flight a chunk is expected within ~41ms,
+  // it is overdue once it takes more than four times that
+  model.Issued( 0, 0, now );
+  CPPUNIT_ASSERT( !model.Overdue( 1048576, now + 0.15 ) );
+  CPPUNIT_ASSERT( model.Overdue( 1048576, now + 0.2 ) );
+
+  // the oldest outstanding chunk counts, a cancelled one does not
+  model.Issued( 1048576, 1048576, now + 0.15 );
+  CPPUNIT_ASSERT( model.Overdue( 2097152, now + 0.3 ) );
+  model.Cancelled( 0 );
+  CPPUNIT_ASSERT( !model.Overdue( 1048576, now + 0.3 ) );
+}
+
+//------------------------------------------------------------------------------
+// A chunk requested from two sources is passed on only once
+//------------------------------------------------------------------------------
+void XCpTest::DuplicateChunkTest()
+{
+  std::vector<std::string> urls;
+  XrdCl::XCpCtx *ctx = new XrdCl::XCpCtx( urls, 16777216, 2, 1048576, 4, 16777216 );
+
+  CPPUNIT_ASSERT( ctx->RegisterSpeculative( 1048576, "host1:1094" ) );
+  CPPUNIT_ASSERT( !ctx->RegisterSpeculative( 1048576, "host2:1094" ) );
+
+  for( int i = 0; i < 3; ++i )
+  {
+    XrdCl::ChunkInfo *chunk = new XrdCl::ChunkInfo( 1048576, 1024, new char[1024] );
+    ctx->PutChunk( chunk );
+  }
+
+  std::string stats = ctx->GetStats();
+  CPPUNIT_ASSERT( stats.find( "host1:1094: 0B in 0 chunks" ) != std::string::npos );
+  CPPUNIT_ASSERT( stats.find( "1 speculative" ) != std::string::npos );
+  CPPUNIT_ASSERT( stats.find( "host2:1094" ) == std::string::npos );
+  CPPUNIT_ASSERT( stats.find( "duplicate chunks discarded: 2" ) != std::string::npos );
+
+  ctx->Delete();
+}
@@ -0,0 +1,364 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by European Organization for Nuclear Research (CERN)
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "Utils.hh"
+#include "CppUnitXrdHelpers.hh"
+#include "XrdCl/XrdClFile.hh"
+#include "XrdCl/XrdClZipArchiveReader.hh"
+
+#include <zlib.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class ZipTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( ZipTest );
+      CPPUNIT_TEST( InflateTest );
+      CPPUNIT_TEST( AccessPointTest );
+      CPPUNIT_TEST( VectorReadTest );
+      CPPUNIT_TEST( DirCacheTest );
+    CPPUNIT_TEST_SUITE_END();
+    void InflateTest();
+    void AccessPointTest();
+    void VectorReadTest();
+    void DirCacheTest();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ZipTest );
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // A member of the archive and its uncompressed content
+  //----------------------------------------------------------------------------
+  struct Member
+  {
+    Member( const std::string &name, const std::string &data, bool deflate ) :
+      name( name ), data( data ), deflate( deflate ) { }
+
+    std::string name;
+    std::string data;
+    bool        deflate;
+  };
+
+  void Put16( std::string &out, uint16_t value )
+  {
+    out += char( value & 0xff );
+    out += char( value >> 8 );
+  }
+
+  void Put32( std::string &out, uint32_t value )
+  {
+    Put16( out, value & 0xffff );
+    Put16( out, value >> 16 );
+  }
+
+  //----------------------------------------------------------------------------
+  // Raw deflate, the way it is stored in a ZIP archive
+  //----------------------------------------------------------------------------
+  std::string Deflate( const std::string &data )
+  {
+    z_stream strm;
+    memset( &strm, 0, sizeof( strm ) );
+    CPPUNIT_ASSERT( deflateInit2( &strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY ) == Z_OK );
+    std::string out( deflateBound( &strm, data.size() ), 0 );
+    strm.next_in   = reinterpret_cast<Bytef*>( const_cast<char*>( data.data() ) );
+    strm.avail_in  = data.size();
+    strm.next_out  = reinterpret_cast<Bytef*>( &out[0] );
+    strm.avail_out = out.size();
+    CPPUNIT_ASSERT( deflate( &strm, Z_FINISH ) == Z_STREAM_END );
+    out.resize( strm.total_out );
+    deflateEnd( &strm );
+    return out;
+  }
+
+  //----------------------------------------------------------------------------
+  // Write a ZIP archive with the given members to path
+  //----------------------------------------------------------------------------
+  void WriteArchive( const std::string &path, const std::vector<Member> &members )
+  {
+    std::string archive, cd;
+    for( size_t i = 0; i < members.size(); ++i )
+    {
+      const Member &m    = members[i];
+      std::string   data = m.deflate ? Deflate( m.data ) : m.data;
+      uint32_t      crc  = crc32( 0, reinterpret_cast<const Bytef*>( m.data.data() ), m.data.size() );
+      uint32_t      lfh  = archive.size();
+
+      // Local-file-header
+      Put32( archive, 0x04034b50 );
+      Put16( archive, 20 );                    // version needed
+      Put16( archive, 0 );                     // flags
+      Put16( archive, m.deflate ? 8 : 0 );     // compression method
+      Put16( archive, 0 );                     // mod time
+      Put16( archive, 0 );                     // mod date
+      Put32( archive, crc );
+      Put32( archive, data.size() );
+      Put32( archive, m.data.size() );
+      Put16( archive, m.name.size() );
+      Put16( archive, 0 );                     // extra length
+      archive += m.name;
+      archive += data;
+
+      // Central-directory-file-header
+      Put32( cd, 0x02014b50 );
+      Put16( cd, 20 );                         // version made by
+      Put16( cd, 20 );                         // version needed
+      Put16( cd, 0 );                          // flags
+      Put16( cd, m.deflate ? 8 : 0 );          // compression method
+      Put16( cd, 0 );                          // mod time
+      Put16( cd, 0 );                          // mod date
+      Put32( cd, crc );
+      Put32( cd, data.size() );
+      Put32( cd, m.data.size() );
+      Put16( cd, m.name.size() );
+      Put16( cd, 0 );                          // extra length
+      Put16( cd, 0 );                          // comment length
+      Put16( cd, 0 );                          // disk number
+      Put16( cd, 0 );                          // internal attributes
+      Put32( cd, 0 );                          // external attributes
+      Put32( cd, lfh );
+      cd += m.name;
+    }
+
+    // End-of-central-directory
+    uint32_t cdOffset = archive.size();
+    archive += cd;
+    Put32( archive, 0x06054b50 );
+    Put16( archive, 0 );                       // disk number
+    Put16( archive, 0 );                       // disk with the CD
+    Put16( archive, members.size() );
+    Put16( archive, members.size() );
+    Put32( archive, cd.size() );
+    Put32( archive, cdOffset );
+    Put16( archive, 0 );                       // comment length
+
+    FILE *f = fopen( path.c_str(), "w" );
+    CPPUNIT_ASSERT( f );
+    CPPUNIT_ASSERT( fwrite( archive.data(), 1, archive.size(), f ) == archive.size() );
+    CPPUNIT_ASSERT( fclose( f ) == 0 );
+  }
+
+  std::string RandomData( uint32_t size )
+  {
+    std::string data( size, 0 );
+    CPPUNIT_ASSERT( XrdClTests::Utils::GetRandomBytes( &data[0], size ) == size );
+    return data;
+  }
+
+  std::string TextData( uint32_t size )
+  {
+    std::string data;
+    for( uint32_t line = 0; data.size() < size; ++line )
+    {
+      char buffer[64];
+      snprintf( buffer, sizeof( buffer ), "line %u of the compressible member\n", line );
+      data += buffer;
+    }
+    data.resize( size );
+    return data;
+  }
+
+  //----------------------------------------------------------------------------
+  // The members used by the tests: a compressible one, a stored one and
+  // one that compresses well only past its beginning, so that the compression
+  // ratio of the member says little about its head
+  //----------------------------------------------------------------------------
+  std::vector<Member> Members()
+  {
+    const uint32_t MB = 1024*1024;
+    std::vector<Member> members;
+    members.push_back( Member( "text.txt",   TextData( 8*MB ),   true  ) );
+    members.push_back( Member( "stored.dat", RandomData( 256*1024 ), false ) );
+    members.push_back( Member( "mixed.dat",  RandomData( 4*MB ) + std::string( 60*MB, 0 ), true ) );
+    return members;
+  }
+
+  //----------------------------------------------------------------------------
+  // Read a range of a member and compare it with the original content
+  //----------------------------------------------------------------------------
+  void CheckRead( XrdCl::ZipArchiveReader &zip, const Member &m, uint64_t offset, uint32_t size )
+  {
+    std::string buffer( size, 0 );
+    uint32_t bytesRead = 0;
+    CPPUNIT_ASSERT_XRDST( zip.Read( m.name, offset, size, &buffer[0], bytesRead ) );
+    std::string expected = offset < m.data.size() ? m.data.substr( offset, size ) : std::string();
+    CPPUNIT_ASSERT( bytesRead == expected.size() );
+    CPPUNIT_ASSERT( buffer.compare( 0, bytesRead, expected ) == 0 );
+  }
+}
+
+//------------------------------------------------------------------------------
+// Read deflated members at the beginning, in the middle and past the end
+//------------------------------------------------------------------------------
+void ZipTest::InflateTest()
+{
+  using namespace XrdCl;
+  const char *archivePath = "/tmp/xrdcl-ziptest-inflate.zip";
+
+  std::vector<Member> members = Members();
+  WriteArchive( archivePath, members );
+
+  File archive;
+  ZipArchiveReader zip( archive );
+  CPPUNIT_ASSERT_XRDST( zip.Open( archivePath ) );
+
+  uint32_t size = 0;
+  CPPUNIT_ASSERT_XRDST( zip.GetSize( "text.txt", size ) );
+  CPPUNIT_ASSERT( size == members[0].data.size() );
+
+  CheckRead( zip, members[0], 0, 4096 );
+  CheckRead( zip, members[0], 3*1024*1024 + 17, 100000 );
+  CheckRead( zip, members[0], members[0].data.size() - 100, 4096 );
+  CheckRead( zip, members[1], 1000, 5000 );
+
+  CPPUNIT_ASSERT_XRDST( zip.Close() );
+  remove( archivePath );
+}
+
+//------------------------------------------------------------------------------
+// Read far into a member, then earlier and later, the later reads start
+// from the access points added by the first one
+//------------------------------------------------------------------------------
+void ZipTest::AccessPointTest()
+{
+  using namespace XrdCl;
+  const char *archivePath = "/tmp/xrdcl-ziptest-accesspoint.zip";
+
+  std::vector<Member> members = Members();
+  WriteArchive( archivePath, members );
+
+  File archive;
+  ZipArchiveReader zip( archive );
+  CPPUNIT_ASSERT_XRDST( zip.Open( archivePath ) );
+
+  CheckRead( zip, members[2], 50*1024*1024, 65536 );
+  CheckRead( zip, members[2], 3*1024*1024 + 5, 300000 );
+  CheckRead( zip, members[2], 10*1024*1024 + 1, 65536 );
+  CheckRead( zip, members[2], 62*1024*1024, 4*1024*1024 );
+  CheckRead( zip, members[0], 7*1024*1024, 65536 );
+  CheckRead( zip, members[0], 2*1024*1024, 65536 );
+
+  CPPUNIT_ASSERT_XRDST( zip.Close() );
+  remove( archivePath );
+}
+
+//------------------------------------------------------------------------------
+// Vector read across stored and deflated members, the chunk in the head of
+// the mixed member needs more compressed data than its ratio suggests
+//------------------------------------------------------------------------------
+void ZipTest::VectorReadTest()
+{
+  using namespace XrdCl;
+  const char *archivePath = "/tmp/xrdcl-ziptest-vectorread.zip";
+
+  std::vector<Member> members = Members();
+  WriteArchive( archivePath, members );
+
+  File archive;
+  ZipArchiveReader zip( archive );
+  CPPUNIT_ASSERT_XRDST( zip.Open( archivePath ) );
+
+  struct
+  {
+    size_t   member;
+    uint64_t offset;
+    uint32_t size;
+  } testset[] =
+  {
+    { 2, 3*1024*1024,     65536 },
+    { 0, 1024,            4096  },
+    { 1, 100,             1000  },
+    { 0, 6*1024*1024 + 3, 70000 },
+    { 2, 40*1024*1024,    8192  }
+  };
+  const size_t n = sizeof( testset ) / sizeof( testset[0] );
+
+  std::vector<std::string> filenames;
+  std::vector<std::string> buffers( n );
+  ChunkList chunks;
+  for( size_t i = 0; i < n; ++i )
+  {
+    buffers[i].resize( testset[i].size );
+    filenames.push_back( members[testset[i].member].name );
+    chunks.push_back( ChunkInfo( testset[i].offset, testset[i].size, &buffers[i][0] ) );
+  }
+
+  VectorReadInfo *info = 0;
+  CPPUNIT_ASSERT_XRDST( zip.VectorRead( filenames, chunks, info ) );
+  CPPUNIT_ASSERT( info );
+  CPPUNIT_ASSERT( info->GetChunks().size() == n );
+  for( size_t i = 0; i < n; ++i )
+  {
+    const std::string &data = members[testset[i].member].data;
+    CPPUNIT_ASSERT( info->GetChunks()[i].length == testset[i].size );
+    CPPUNIT_ASSERT( buffers[i] == data.substr( testset[i].offset, testset[i].size ) );
+  }
+  delete info;
+
+  CPPUNIT_ASSERT_XRDST( zip.Close() );
+  remove( archivePath );
+}
+
+//------------------------------------------------------------------------------
+// Reopening an archive reuses its directory unless the archive has changed
+//------------------------------------------------------------------------------
+void ZipTest::DirCacheTest()
+{
+  using namespace XrdCl;
+  const char *archivePath = "/tmp/xrdcl-ziptest-dircache.zip";
+
+  std::vector<Member> members;
+  members.push_back( Member( "a.txt", TextData( 200000 ), true ) );
+  members.push_back( Member( "b.dat", RandomData( 100000 ), false ) );
+  WriteArchive( archivePath, members );
+
+  for( int i = 0; i < 2; ++i )
+  {
+    File archive;
+    ZipArchiveReader zip( archive );
+    CPPUNIT_ASSERT_XRDST( zip.Open( archivePath ) );
+    CheckRead( zip, members[0], 150000, 1000 );
+    CheckRead( zip, members[1], 0, 1000 );
+    CPPUNIT_ASSERT_XRDST( zip.Close() );
+  }
+
+  // a different archive at the same place must not be served from the cache
+  members.clear();
+  members.push_back( Member( "c.dat", RandomData( 70000 ), false ) );
+  members.push_back( Member( "a.txt", TextData( 300000 ), true ) );
+  WriteArchive( archivePath, members );
+
+  File archive;
+  ZipArchiveReader zip( archive );
+  CPPUNIT_ASSERT_XRDST( zip.Open( archivePath ) );
+  uint32_t size = 0;
+  CPPUNIT_ASSERT_XRDST( zip.GetSize( "a.txt", size ) );
+  CPPUNIT_ASSERT( size == 300000 );
+  CPPUNIT_ASSERT_XRDST_NOTOK( zip.GetSize( "b.dat", size ), errNotFound );
+  CheckRead( zip, members[0], 60000, 10000 );
+  CheckRead( zip, members[1], 250000, 1000 );
+  CPPUNIT_ASSERT_XRDST( zip.Close() );
+  remove( archivePath );
+}
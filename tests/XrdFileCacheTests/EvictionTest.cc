@@ -0,0 +1,285 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "XrdFileCache/XrdFileCacheEvictionPolicy.hh"
+#include "XrdFileCache/XrdFileCacheEvictSim.hh"
+#include "XrdFileCache/XrdFileCachePurgeIndex.hh"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace XrdFileCache;
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class EvictionTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( EvictionTest );
+      CPPUNIT_TEST( SelectTest );
+      CPPUNIT_TEST( TraceTest );
+      CPPUNIT_TEST( ReplayTest );
+      CPPUNIT_TEST( SizeAwareTest );
+      CPPUNIT_TEST( IndexTest );
+    CPPUNIT_TEST_SUITE_END();
+    void SelectTest();
+    void TraceTest();
+    void ReplayTest();
+    void SizeAwareTest();
+    void IndexTest();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( EvictionTest );
+
+namespace
+{
+  const long long MB = 1024 * 1024;
+
+  //----------------------------------------------------------------------------
+  // Files given in order of access time, as the purge index hands them out
+  //----------------------------------------------------------------------------
+  struct Files
+  {
+    std::vector<std::string> paths;
+    std::vector<FileRecord>  records;
+    std::vector<FileRecord*> list;
+
+    void Add( const std::string &path, long long nBytes, size_t nAccesses )
+    {
+      paths.push_back( path );
+      FileRecord rec;
+      rec.m_nBytes     = nBytes;
+      rec.m_accessTime = records.size();
+      rec.m_nAccesses  = nAccesses;
+      records.push_back( rec );
+    }
+
+    void Finish( EvictionPolicy &policy )
+    {
+      for( size_t i = 0; i < records.size(); ++i )
+      {
+        records[i].m_path = &paths[i];
+        policy.Accessed( records[i] );
+        list.push_back( &records[i] );
+      }
+    }
+  };
+
+  std::string Selected( EvictionPolicy &policy, Files &files, long long nBytesReq )
+  {
+    std::vector<FileRecord*> selected;
+    policy.Select( files.list, nBytesReq, selected );
+    std::string names;
+    for( size_t i = 0; i < selected.size(); ++i )
+      names += *selected[i]->m_path;
+    return names;
+  }
+
+  std::string Selected( PurgeIndex &index, long long nBytesReq )
+  {
+    std::vector<PurgeIndex::Candidate> candidates;
+    index.Select( nBytesReq, candidates );
+    std::string names;
+    for( size_t i = 0; i < candidates.size(); ++i )
+      names += candidates[i].m_path;
+    return names;
+  }
+
+  EvictSim::Result Run( EvictSim &sim, const char *policy, long long hwm, long long lwm )
+  {
+    EvictSim::Result r;
+    CPPUNIT_ASSERT( sim.Run( policy, hwm, lwm, r ) );
+    return r;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Policies choose the right files, in order, until enough bytes are freed
+//------------------------------------------------------------------------------
+void EvictionTest::SelectTest()
+{
+  std::unique_ptr<EvictionPolicy> lru( EvictionPolicy::Create( "lru" ) );
+  std::unique_ptr<EvictionPolicy> lfu( EvictionPolicy::Create( "lfu" ) );
+  std::unique_ptr<EvictionPolicy> gdsf( EvictionPolicy::Create( "gdsf" ) );
+  CPPUNIT_ASSERT( lru.get() && lfu.get() && gdsf.get() );
+  CPPUNIT_ASSERT( EvictionPolicy::Create( "fifo" ) == 0 );
+
+  Files f1;
+  f1.Add( "a", 100, 3 );
+  f1.Add( "b", 100, 1 );
+  f1.Add( "c", 100, 2 );
+  f1.Add( "d", 100, 1 );
+  f1.Finish( *lru );
+  CPPUNIT_ASSERT( Selected( *lru, f1, 150 ) == "ab" );
+  CPPUNIT_ASSERT( Selected( *lru, f1, 0 ) == "" );
+
+  // least accesses first, ties go to the least recently accessed file
+  Files f2 = f1;
+  f2.list.clear();
+  f2.Finish( *lfu );
+  CPPUNIT_ASSERT( Selected( *lfu, f2, 150 ) == "bd" );
+  CPPUNIT_ASSERT( Selected( *lfu, f2, 250 ) == "bdc" );
+  CPPUNIT_ASSERT( Selected( *lfu, f2, 1000 ) == "bdca" );
+
+  // a big file accessed once goes before small ones accessed as often
+  Files f3;
+  f3.Add( "s", 1 * MB, 2 );
+  f3.Add( "B", 100 * MB, 2 );
+  f3.Add( "t", 2 * MB, 1 );
+  f3.Finish( *gdsf );
+  CPPUNIT_ASSERT( Selected( *gdsf, f3, 1 ) == "B" );
+  CPPUNIT_ASSERT( Selected( *gdsf, f3, 101 * MB ) == "Bt" );
+}
+
+//------------------------------------------------------------------------------
+// Trace files are read and malformed ones are rejected
+//------------------------------------------------------------------------------
+void EvictionTest::TraceTest()
+{
+  const char *trace = "/tmp/xrdpfc-evicttest.trace";
+
+  FILE *fp = fopen( trace, "w" );
+  CPPUNIT_ASSERT( fp );
+  fprintf( fp, "# time size path\n\n20 100 /store/b\n10 100 /store/a\n30 100 /store/a\n" );
+  fclose( fp );
+
+  EvictSim sim;
+  CPPUNIT_ASSERT( sim.ReadTrace( trace ) );
+  CPPUNIT_ASSERT( sim.GetNAccesses() == 3 );
+
+  // accesses are replayed in time order, whatever the order in the file
+  EvictSim::Result r = Run( sim, "lru", 1000, 900 );
+  CPPUNIT_ASSERT( r.m_nReq == 3 && r.m_nHit == 1 && r.m_nBytes == 300 && r.m_nBytesHit == 100 );
+  CPPUNIT_ASSERT( r.m_nEvicted == 0 );
+  CPPUNIT_ASSERT( ! sim.Run( "fifo", 1000, 900, r ) );
+
+  fp = fopen( trace, "w" );
+  CPPUNIT_ASSERT( fp );
+  fprintf( fp, "10 100 /store/a\n20 /store/b\n" );
+  fclose( fp );
+
+  EvictSim bad;
+  CPPUNIT_ASSERT( ! bad.ReadTrace( trace ) );
+  CPPUNIT_ASSERT( ! bad.ReadTrace( "/tmp/xrdpfc-evicttest.nonexistent" ) );
+  remove( trace );
+}
+
+//------------------------------------------------------------------------------
+// Hits and evictions of a short replay, where LRU and LFU differ
+//------------------------------------------------------------------------------
+void EvictionTest::ReplayTest()
+{
+  EvictSim sim;
+  sim.Add( 1, 100, "A" );
+  sim.Add( 2, 100, "A" );
+  sim.Add( 3, 100, "A" );
+  sim.Add( 4, 100, "B" );
+  sim.Add( 5, 100, "C" );    // over the high watermark, one file has to go
+  sim.Add( 6, 100, "A" );
+
+  // LRU evicts A, the least recently used, and misses it again
+  EvictSim::Result r = Run( sim, "lru", 250, 200 );
+  CPPUNIT_ASSERT( r.m_nReq == 6 );
+  CPPUNIT_ASSERT( r.m_nHit == 2 );
+  CPPUNIT_ASSERT( r.m_nEvicted == 2 );
+
+  // LFU evicts B, accessed only once, and keeps A
+  r = Run( sim, "lfu", 250, 200 );
+  CPPUNIT_ASSERT( r.m_nHit == 3 );
+  CPPUNIT_ASSERT( r.m_nEvicted == 1 );
+
+  // nothing is evicted when everything fits
+  r = Run( sim, "arc", 1000, 900 );
+  CPPUNIT_ASSERT( r.m_nHit == 3 );
+  CPPUNIT_ASSERT( r.m_nEvicted == 0 );
+}
+
+//------------------------------------------------------------------------------
+// Small, often reused files survive a stream of big one-shot files with the
+// size-aware policy but not with LRU
+//------------------------------------------------------------------------------
+void EvictionTest::SizeAwareTest()
+{
+  EvictSim sim;
+  time_t   t = 0;
+  char     name[32];
+  for( int round = 0; round < 20; ++round )
+  {
+    for( int i = 0; i < 4; ++i )
+    {
+      snprintf( name, sizeof( name ), "/conditions/%d", i );
+      sim.Add( ++t, 1 * MB, name );
+    }
+    for( int i = 0; i < 3; ++i )
+    {
+      snprintf( name, sizeof( name ), "/aod/%d.%d", round, i );
+      sim.Add( ++t, 40 * MB, name );
+    }
+  }
+
+  EvictSim::Result lru  = Run( sim, "lru", 100 * MB, 80 * MB );
+  EvictSim::Result gdsf = Run( sim, "gdsf", 100 * MB, 80 * MB );
+  CPPUNIT_ASSERT( lru.m_nReq == 140 && gdsf.m_nReq == 140 );
+  // every conditions file but the first access of each is a hit
+  CPPUNIT_ASSERT( gdsf.m_nHit == 19 * 4 );
+  CPPUNIT_ASSERT( lru.m_nHit < gdsf.m_nHit );
+}
+
+//------------------------------------------------------------------------------
+// The purge index takes files in the policy's order and a rescan keeps the
+// rank the policy had given to files already indexed
+//------------------------------------------------------------------------------
+void EvictionTest::IndexTest()
+{
+  std::unique_ptr<EvictionPolicy> lfu( EvictionPolicy::Create( "lfu" ) );
+  PurgeIndex byAccesses;
+  byAccesses.SetPolicy( lfu.get() );
+  byAccesses.Update( "a", 1, 100, 3 );
+  byAccesses.Update( "b", 2, 100, 1 );
+  byAccesses.Update( "c", 3, 100, 2 );
+  byAccesses.Update( "d", 4, 100, 1 );
+  CPPUNIT_ASSERT( Selected( byAccesses, 150 ) == "bd" );
+  CPPUNIT_ASSERT( Selected( byAccesses, 1000 ) == "bdca" );
+
+  // evicting "a" ages the cache, "c" is ranked above the older "b"
+  std::unique_ptr<EvictionPolicy> gdsf( EvictionPolicy::Create( "gdsf" ) );
+  PurgeIndex index;
+  index.SetPolicy( gdsf.get() );
+  index.Update( "a", 1, MB, 1 );
+  index.Update( "b", 3, MB, 1 );
+  index.Remove( "a" );
+  index.Update( "c", 2, MB, 1 );
+  CPPUNIT_ASSERT( Selected( index, 1 ) == "b" );
+
+  // a rescan must not rank "b" as if it had just been accessed
+  PurgeIndex scan;
+  scan.Update( "b", 3, MB, 1 );
+  scan.Update( "c", 2, MB, 1 );
+  scan.Update( "d", 2, MB, 1 );
+  index.Rebuild( scan, 100 );
+  CPPUNIT_ASSERT( Selected( index, 1 ) == "b" );
+  CPPUNIT_ASSERT( Selected( index, 3 * MB ) == "bcd" );
+
+  size_t    nFiles;
+  long long nBytes;
+  index.GetSize( nFiles, nBytes );
+  CPPUNIT_ASSERT( nFiles == 3 && nBytes == 3 * MB );
+}
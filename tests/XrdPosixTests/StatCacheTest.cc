@@ -0,0 +1,227 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by Board of Trustees of the Leland Stanford, Jr., University
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include <cppunit/extensions/HelperMacros.h>
+#include "XrdCl/XrdClURL.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+
+//------------------------------------------------------------------------------
+// Declaration
+//------------------------------------------------------------------------------
+class StatCacheTest: public CppUnit::TestCase
+{
+  public:
+    CPPUNIT_TEST_SUITE( StatCacheTest );
+      CPPUNIT_TEST( TTLTest );
+      CPPUNIT_TEST( LRUTest );
+      CPPUNIT_TEST( InvalidateTest );
+    CPPUNIT_TEST_SUITE_END();
+    void TTLTest();
+    void LRUTest();
+    void InvalidateTest();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( StatCacheTest );
+
+namespace
+{
+  const char *host = "root://localhost:1094/";
+
+  //----------------------------------------------------------------------------
+  // Start from an empty cache, a zero size evicts everything
+  //----------------------------------------------------------------------------
+  void Reset( long long maxMem, int ttl, int nxttl )
+  {
+    XrdPosixStatCache::Config( 0, 0, 0 );
+    XrdPosixStatCache::Config( maxMem, ttl, nxttl );
+  }
+
+  void Add( const std::string &path, size_t size )
+  {
+    XrdCl::URL  url( host + path );
+    struct stat sbuf;
+    memset( &sbuf, 0, sizeof( sbuf ) );
+    sbuf.st_size  = size;
+    sbuf.st_mtime = 1000;
+    sbuf.st_mode  = S_IFREG | 0644;
+    XrdPosixStatCache::Add( url, sbuf );
+  }
+
+  void AddNX( const std::string &path )
+  {
+    XrdCl::URL url( host + path );
+    XrdPosixStatCache::AddNX( url );
+  }
+
+  //----------------------------------------------------------------------------
+  // Returns the cached size, -1 for a cached ENOENT and -2 when not cached
+  //----------------------------------------------------------------------------
+  long long Get( const std::string &path )
+  {
+    XrdCl::URL  url( host + path );
+    struct stat sbuf;
+    memset( &sbuf, 0, sizeof( sbuf ) );
+    errno = 0;
+    int rc = XrdPosixStatCache::Get( url, sbuf );
+    if( rc < 0 ) return errno == ENOENT ? -1 : -3;
+    if( rc == 0 ) return -2;
+    return sbuf.st_size;
+  }
+
+  std::string Name( int i )
+  {
+    char buff[32];
+    snprintf( buff, sizeof( buff ), "/lru/f%03d", i );
+    return buff;
+  }
+}
+
+//------------------------------------------------------------------------------
+// Positive and negative entries are served until their lifetime is over
+//------------------------------------------------------------------------------
+void StatCacheTest::TTLTest()
+{
+  long long hits, miss, nxhits;
+
+  Reset( 1024 * 1024, 1, 1 );
+  CPPUNIT_ASSERT( XrdPosixStatCache::Enabled() );
+  Add( "/ttl/file", 42 );
+  AddNX( "/ttl/missing" );
+  CPPUNIT_ASSERT( Get( "/ttl/file" ) == 42 );
+  CPPUNIT_ASSERT( Get( "//ttl//file/" ) == 42 );
+  CPPUNIT_ASSERT( Get( "/ttl/missing" ) == -1 );
+  CPPUNIT_ASSERT( Get( "/ttl/other" ) == -2 );
+  XrdPosixStatCache::Stats( hits, miss, nxhits );
+
+  // the lifetime is in seconds, wait for both entries to expire
+  sleep( 2 );
+  CPPUNIT_ASSERT( Get( "/ttl/file" ) == -2 );
+  CPPUNIT_ASSERT( Get( "/ttl/missing" ) == -2 );
+
+  long long hits2, miss2, nxhits2;
+  XrdPosixStatCache::Stats( hits2, miss2, nxhits2 );
+  CPPUNIT_ASSERT( hits2 == hits && nxhits2 == nxhits && miss2 == miss + 2 );
+
+  // negative entries are only kept when they have a lifetime of their own
+  Reset( 1024 * 1024, 60, 0 );
+  AddNX( "/ttl/missing" );
+  CPPUNIT_ASSERT( Get( "/ttl/missing" ) == -2 );
+
+  // a server's local view of a file is never cached
+  Add( "/ttl/file?oss.lcl=1", 7 );
+  CPPUNIT_ASSERT( Get( "/ttl/file?oss.lcl=1" ) == -2 );
+  CPPUNIT_ASSERT( Get( "/ttl/file" ) == -2 );
+
+  // nothing is cached when disabled
+  Reset( 0, 60, 60 );
+  CPPUNIT_ASSERT( !XrdPosixStatCache::Enabled() );
+  Add( "/ttl/file", 42 );
+  CPPUNIT_ASSERT( Get( "/ttl/file" ) == -2 );
+}
+
+//------------------------------------------------------------------------------
+// Past the memory bound the least recently used entries are evicted
+//------------------------------------------------------------------------------
+void StatCacheTest::LRUTest()
+{
+  const int nFiles = 100;
+
+  Reset( 2048, 60, 60 );
+  for( int i = 0; i < nFiles; ++i )
+    Add( Name( i ), i );
+
+  // only the newest entries fit, checking them oldest first keeps their order
+  int nCached = 0;
+  for( int i = 0; i < nFiles; ++i )
+  {
+    long long size = Get( Name( i ) );
+    if( size == -2 )
+    {
+      CPPUNIT_ASSERT( nCached == 0 );
+      continue;
+    }
+    CPPUNIT_ASSERT( size == i );
+    ++nCached;
+  }
+  CPPUNIT_ASSERT( nCached >= 2 && nCached < nFiles );
+  CPPUNIT_ASSERT( Get( Name( nFiles - 1 ) ) == nFiles - 1 );
+
+  // using the oldest entry saves it, the next oldest one goes instead
+  int oldest = nFiles - nCached;
+  CPPUNIT_ASSERT( Get( Name( oldest ) ) == oldest );
+  Add( Name( nFiles ), nFiles );
+  CPPUNIT_ASSERT( Get( Name( oldest ) ) == oldest );
+  CPPUNIT_ASSERT( Get( Name( oldest + 1 ) ) == -2 );
+  CPPUNIT_ASSERT( Get( Name( nFiles ) ) == nFiles );
+
+  // shrinking the cache drops entries right away
+  Reset( 1024 * 1024, 60, 60 );
+  Add( Name( 0 ), 0 );
+  XrdPosixStatCache::Config( 1, 60, 60 );
+  CPPUNIT_ASSERT( Get( Name( 0 ) ) == -2 );
+}
+
+//------------------------------------------------------------------------------
+// Changing an object drops it and its parent, renaming or removing a
+// directory drops everything underneath it as well
+//------------------------------------------------------------------------------
+void StatCacheTest::InvalidateTest()
+{
+  Reset( 1024 * 1024, 60, 60 );
+  Add( "/d", 1 );
+  Add( "/d/a", 2 );
+  Add( "/d/a/b", 3 );
+  Add( "/d/a/b/c", 4 );
+  Add( "/d/ab", 5 );
+  Add( "/e", 6 );
+  AddNX( "/e/x" );
+
+  XrdCl::URL url( std::string( host ) + "/d//a/" );
+  XrdPosixStatCache::Invalidate( url, true );
+  CPPUNIT_ASSERT( Get( "/d" ) == -2 );
+  CPPUNIT_ASSERT( Get( "/d/a" ) == -2 );
+  CPPUNIT_ASSERT( Get( "/d/a/b" ) == -2 );
+  CPPUNIT_ASSERT( Get( "/d/a/b/c" ) == -2 );
+  CPPUNIT_ASSERT( Get( "/d/ab" ) == 5 );
+  CPPUNIT_ASSERT( Get( "/e" ) == 6 );
+
+  // without a subtree only the object and its parent go
+  Add( "/d", 1 );
+  Add( "/d/a", 2 );
+  Add( "/d/a/b", 3 );
+  XrdPosixStatCache::Invalidate( ( std::string( host ) + "/d/a" ).c_str() );
+  CPPUNIT_ASSERT( Get( "/d" ) == -2 );
+  CPPUNIT_ASSERT( Get( "/d/a" ) == -2 );
+  CPPUNIT_ASSERT( Get( "/d/a/b" ) == 3 );
+
+  // creating a file drops the negative entry cached for it
+  CPPUNIT_ASSERT( Get( "/e/x" ) == -1 );
+  XrdPosixStatCache::Invalidate( ( std::string( host ) + "/e/x" ).c_str() );
+  CPPUNIT_ASSERT( Get( "/e/x" ) == -2 );
+  CPPUNIT_ASSERT( Get( "/e" ) == -2 );
+
+  // entries of other servers are left alone
+  XrdCl::URL other( "root://otherhost:1094//d/ab" );
+  XrdPosixStatCache::Invalidate( other, true );
+  CPPUNIT_ASSERT( Get( "/d/ab" ) == 5 );
+}
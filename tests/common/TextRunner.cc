@@ -111,11 +111,16 @@ int main( int argc, char **argv)
   // Print help
   //----------------------------------------------------------------------------
   CppUnit::Test *all = CppUnit::TestFactoryRegistry::getRegistry().makeTest();
+  CppUnit::Test *benchmarks =
+    CppUnit::TestFactoryRegistry::getRegistry( "Benchmarks" ).makeTest();
   if( argc == 2 )
   {
     std::cerr << "Select your tests:" << std::endl << std::endl;
     printTests( all );
     std::cerr << std::endl;
+    std::cerr << "Or your benchmarks:" << std::endl << std::endl;
+    printTests( benchmarks );
+    std::cerr << std::endl;
     return 1;
   }
 
@@ -126,6 +131,8 @@ int main( int argc, char **argv)
   for( int i = 2; i < argc; ++i )
   {
     CppUnit::Test *t = findTest( all, std::string( argv[i]) );
+    if( !t )
+      t = findTest( benchmarks, std::string( argv[i]) );
     if( !t )
     {
       std::cerr << "Unable to find: " << argv[i] << std::endl;